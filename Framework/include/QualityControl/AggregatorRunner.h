@@ -62,7 +62,8 @@ class Aggregator;
 namespace repository
 {
 class DatabaseInterface;
-}
+class DatabaseUploader;
+} // namespace repository
 } // namespace o2::quality_control
 
 class TClass;
@@ -122,6 +123,19 @@ class AggregatorRunner : public framework::Task
   /// If all checks belong to the same detector we use it, otherwise we use "MANY"
   static std::string getDetectorName(const std::vector<std::shared_ptr<Aggregator>>& aggregators);
 
+  using QualityObjectsWithAggregatorNameVector = std::vector<std::pair<std::string, core::QualityObjectsType>>;
+
+  /**
+   * \brief Runs the aggregators which are ready according to the UpdatePolicyManager, in order.
+   *
+   * The QualityObjects produced by an aggregator are added to the map and their revisions are updated,
+   * so that they can be used by the following aggregators.
+   */
+  static QualityObjectsWithAggregatorNameVector runAggregators(const std::vector<std::shared_ptr<Aggregator>>& aggregators,
+                                                               UpdatePolicyManager& updatePolicyManager,
+                                                               core::QualityObjectsMapType& qualityObjects,
+                                                               const core::Activity& activity);
+
  private:
   /**
    * \brief For each aggregator, check if the data is ready and, if so, call its own aggregation method.
@@ -130,7 +144,6 @@ class AggregatorRunner : public framework::Task
    * call its `aggregate()` method.
    * This method is usually called upon reception of fresh inputs data.
    */
-  using QualityObjectsWithAggregatorNameVector = std::vector<std::pair<std::string, core::QualityObjectsType>>;
   QualityObjectsWithAggregatorNameVector aggregate();
 
   /**
@@ -187,6 +200,7 @@ class AggregatorRunner : public framework::Task
   std::vector<std::shared_ptr<Aggregator>> mAggregators;
   std::unordered_map<std::string, std::shared_ptr<Aggregator>> mAggregatorsMap;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
+  std::unique_ptr<o2::quality_control::repository::DatabaseUploader> mUploader; // only if asynchronous upload is enabled
   AggregatorRunnerConfig mRunnerConfig;
   std::vector<AggregatorConfig> mAggregatorsConfig;
   core::QualityObjectsMapType mQualityObjects; // where we cache the incoming quality objects and the output of the aggregators
@@ -18,9 +18,11 @@
 #define QC_REPOSITORY_CCDBDATABASE_H
 
 #include "QualityControl/DatabaseInterface.h"
+#include "QualityControl/DatabaseCache.h"
 #include <Common/Timer.h>
 #include <boost/property_tree/ptree_fwd.hpp>
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace o2::ccdb
@@ -28,6 +30,11 @@ namespace o2::ccdb
 class CcdbApi;
 }
 
+namespace o2::quality_control::core
+{
+class ThreadPool;
+}
+
 namespace o2::quality_control::repository
 {
 
@@ -83,6 +90,8 @@ class CcdbDatabase : public DatabaseInterface
   // retrieval - general
   std::string retrieveJson(std::string path, long timestamp, const std::map<std::string, std::string>& metadata) override;
   TObject* retrieveTObject(std::string path, const std::map<std::string, std::string>& metadata, long timestamp = Timestamp::Current, std::map<std::string, std::string>* headers = nullptr) override;
+  /// Runs up to "retrievalThreads" (see the database configuration) requests concurrently.
+  std::vector<RetrievalResult> retrieveMany(const std::vector<RetrievalRequest>& requests) override;
 
   void disconnect() override;
   void prepareTaskDataContainer(std::string taskName) override;
@@ -106,6 +115,16 @@ class CcdbDatabase : public DatabaseInterface
    */
   boost::property_tree::ptree getListingAsPtree(const std::string& path, const std::map<std::string, std::string>& metadata = {}, bool latestOnly = false);
 
+  /**
+   * Return the listing of folder and/or objects in the subpath, in JSON as returned by the server
+   * @param path the folder we want to list the children of.
+   * @param metadata metadata to filter queried objects.
+   * @param latestOnly return only the latest object matching the path and metadata.
+   * @param createdNotBefore return only the objects created at this time (ms since epoch) or later, ignored if negative.
+   * @return The list of folder and/or objects in JSON
+   */
+  std::string getListingAsJson(const std::string& path, const std::map<std::string, std::string>& metadata = {}, bool latestOnly = false, long createdNotBefore = -1);
+
   /**
    * Return validity of the latest matching object
    * @param path the folder we want to list the children of.
@@ -123,17 +142,37 @@ class CcdbDatabase : public DatabaseInterface
 
   void setMaxObjectSize(size_t maxObjectSize) override;
 
+  const DatabaseCache* getCache() const override;
+
  private:
   void init();
+  void initApi(o2::ccdb::CcdbApi& api) const;
+  /// Returns the CcdbApi of the current retrieval thread, or the main one.
+  o2::ccdb::CcdbApi& getApi();
+
+  /**
+   * Retrieves the object from the cache, or from the database if it is not cached yet.
+   * @param latestVersion The version of the latest object given by a listing. If it is not provided, a cached version
+   *                      valid at the timestamp is served only after the database confirms it did not change (ETag).
+   */
+  TObject* retrieveCachedTObject(const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers, std::optional<DatabaseCache::Version> latestVersion);
+  /// Returns the validity in the headers of a retrieved object, if any.
+  static std::optional<core::ValidityInterval> getValidity(const std::map<std::string, std::string>& headers);
+  /// Returns the ID of a retrieved object, which the CCDB sends as its ETag, or an empty string.
+  static std::string getVersionId(const std::map<std::string, std::string>& headers);
+
+  DatabaseCache::Version getLatestObjectVersion(const std::string& path, const std::map<std::string, std::string>& metadata);
+  DatabaseCache::Version getLatestObjectVersionFromListing(const std::string& path, const std::map<std::string, std::string>& metadata);
 
   /**
    * Return the listing of folder and/or objects in the subpath.
    * @param subpath The folder we want to list the children of.
    * @param accept The format of the returned string as an \"Accept\", i.e. text/plain, application/json, text/xml
    * @param latestOnly Return only the latest matching object/folder
+   * @param createdNotBefore Return only the objects created at this time or later, ignored if negative
    * @return The listing of folder and/or objects in the format requested and as returned by the http server.
    */
-  std::string getListingAsString(const std::string& subpath = "", const std::string& accept = "text/plain", bool latestOnly = false);
+  std::string getListingAsString(const std::string& subpath = "", const std::string& accept = "text/plain", bool latestOnly = false, long createdNotBefore = -1);
 
   /**
    * Takes care of the possible errors returned by the storage calls.
@@ -164,6 +203,9 @@ class CcdbDatabase : public DatabaseInterface
   int mFailureDelay = 60;          // 60 seconds delay between attempts to store things in the database
   bool mDatabaseFailure = false;
   AliceO2::Common::Timer mFailureTimer;
+  std::unique_ptr<DatabaseCache> mCache; // only if enabled in the configuration
+  size_t mRetrievalThreads = 4;
+  std::unique_ptr<core::ThreadPool> mRetrievalPool; // created with the first concurrent retrieval
 };
 
 } // namespace o2::quality_control::repository
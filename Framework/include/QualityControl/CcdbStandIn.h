@@ -0,0 +1,110 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CcdbStandIn.h
+///
+
+#ifndef QC_REPOSITORY_CCDBSTANDIN_H
+#define QC_REPOSITORY_CCDBSTANDIN_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace o2::quality_control::repository
+{
+
+/// \brief A local, in-memory HTTP server which emulates the subset of the CCDB REST API used by CcdbApi.
+///
+/// It supports storing objects (multipart POST), retrieving them by path, timestamp and metadata (GET and HEAD, with
+/// ETag revalidation), listing the objects or their latest versions in JSON and plain text (/browse, /latest, with the
+/// If-Not-Before and If-Not-After filters), downloading by id and truncating paths.
+/// It is meant for benchmarks and tests, so that the database clients can be exercised without a real CCDB,
+/// thus it does not implement replicas, redirections or object preservation.
+/// Each connection is served by its own thread.
+class CcdbStandIn
+{
+ public:
+  /// \brief Starts listening on localhost. The port is chosen by the system if 0.
+  explicit CcdbStandIn(uint16_t port = 0);
+  ~CcdbStandIn();
+  CcdbStandIn(const CcdbStandIn&) = delete;
+  CcdbStandIn& operator=(const CcdbStandIn&) = delete;
+
+  /// \brief Returns the URL to be given to the database clients, e.g. "http://127.0.0.1:34567".
+  std::string getUrl() const;
+  uint16_t getPort() const;
+  /// \brief Stops accepting new connections and closes the existing ones. Called by the destructor.
+  void stop();
+
+  size_t getNumberOfObjects() const;
+  uint64_t getNumberOfRequests() const;
+
+  struct Request {
+    std::string method;
+    std::string target;
+    std::map<std::string, std::string> headers; ///< names in lower case
+    std::string body;
+  };
+  struct Response {
+    int status = 200;
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string body;
+    bool withBody = true;
+  };
+
+  /// \brief Handles one request, independently of the transport.
+  Response handle(const Request& request);
+  /// \brief Calls the observer with each request before it is handled, e.g. to check the headers sent by a client in tests.
+  /// It has to be set before sending requests.
+  void setRequestObserver(std::function<void(const Request&)> observer) { mRequestObserver = std::move(observer); }
+
+ private:
+  struct Version;
+  struct Connection;
+
+  void accept();
+  void serve(std::shared_ptr<Connection> connection);
+
+  Response store(const std::string& path, const std::map<std::string, std::string>& query, const Request& request);
+  Response retrieve(const std::string& path, const Request& request);
+  Response list(const std::string& path, bool latestOnly, const Request& request);
+  Response truncate(const std::string& path);
+
+  struct Impl;
+  std::unique_ptr<Impl> mImpl;
+  uint16_t mPort = 0;
+
+  mutable std::shared_mutex mStorageMutex;
+  std::map<std::string, std::vector<std::shared_ptr<const Version>>> mObjects; // path -> versions in the order of creation
+  std::map<std::string, std::shared_ptr<const Version>> mObjectsById;
+  uint64_t mLastCreated = 0;
+  uint64_t mNextId = 1;
+  std::atomic<uint64_t> mRequests = 0;
+  std::function<void(const Request&)> mRequestObserver;
+
+  std::thread mAcceptThread;
+  std::mutex mConnectionsMutex;
+  std::vector<std::pair<std::shared_ptr<Connection>, std::thread>> mConnections;
+  std::atomic<bool> mRunning = true;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_CCDBSTANDIN_H
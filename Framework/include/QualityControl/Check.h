@@ -68,7 +68,17 @@ class Check
   void init();
   void reset();
 
-  core::QualityObjectsType check(std::map<std::string, std::shared_ptr<o2::quality_control::core::MonitorObject>>& moMap);
+  /**
+   * \brief Run the check on the MonitorObjects it is interested in and beautify them.
+   *
+   * @param moMap All the MonitorObjects known to the CheckRunner. It is not modified.
+   * @param deferBeautify If true, the beautification is postponed until beautifyDeferred() or clearDeferred() is called.
+   */
+  core::QualityObjectsType check(const std::map<std::string, std::shared_ptr<o2::quality_control::core::MonitorObject>>& moMap, bool deferBeautify = false);
+  /// \brief Performs the beautifications postponed by check().
+  void beautifyDeferred();
+  /// \brief Drops the beautifications postponed by check() without performing them.
+  void clearDeferred() { mDeferredBeautifications.clear(); }
 
   const std::string& getName() const { return mCheckConfig.name; };
   o2::framework::OutputSpec getOutputSpec() const { return mCheckConfig.qoSpec; };
@@ -99,6 +109,7 @@ class Check
 
   CheckConfig mCheckConfig;
   CheckInterface* mCheckInterface = nullptr;
+  std::vector<std::pair<std::map<std::string, std::shared_ptr<core::MonitorObject>>, core::Quality>> mDeferredBeautifications;
 };
 
 } // namespace o2::quality_control::checker
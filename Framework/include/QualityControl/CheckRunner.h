@@ -34,18 +34,21 @@
 #include "QualityControl/CheckRunnerConfig.h"
 #include "QualityControl/Check.h"
 #include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCache.h"
 #include "QualityControl/QualityObject.h"
 #include "QualityControl/UpdatePolicyManager.h"
 
 namespace o2::quality_control::core
 {
 class ServiceDiscovery;
-}
+class ThreadPool;
+} // namespace o2::quality_control::core
 
 namespace o2::quality_control::repository
 {
 class DatabaseInterface;
-}
+class DatabaseUploader;
+} // namespace o2::quality_control::repository
 
 namespace o2::framework
 {
@@ -132,6 +135,19 @@ class CheckRunner : public framework::Task
   /// If all checks belong to the same detector we use it, otherwise we use "MANY"
   static std::string getDetectorName(const std::vector<CheckConfig> checks);
 
+  /**
+   * \brief Runs the Checks on the MonitorObjects, concurrently if a ThreadPool is provided.
+   *
+   * In the concurrent case, the beautifications are performed sequentially once all the Checks are done,
+   * in the order of the Checks. If any Check throws, the other ones are still awaited, their beautifications
+   * are dropped and the first exception is rethrown.
+   *
+   * @return The QualityObjects of each Check, in the order of the Checks.
+   */
+  static std::vector<QualityObjectsType> runChecks(const std::vector<Check*>& checks,
+                                                   const std::map<std::string, std::shared_ptr<MonitorObject>>& moMap,
+                                                   ThreadPool* pool);
+
  private:
   /**
    * \brief Evaluate the quality of a MonitorObject.
@@ -139,6 +155,8 @@ class CheckRunner : public framework::Task
    * The Check's associated with this MonitorObject are run and a global quality is built by
    * taking the worse quality encountered. The MonitorObject is modified by setting its quality
    * and by calling the "beautifying" methods of the Check's.
+   * If "checkParallelism" is larger than 1, the ready Check's are executed concurrently.
+   * The QualityObjects are returned in the order of the Check's in any case.
    *
    * @param mo The MonitorObject to evaluate and whose quality will be set according
    *        to the worse quality encountered while running the Check's.
@@ -148,6 +166,8 @@ class CheckRunner : public framework::Task
   /**
    * \brief Store the QualityObjects in the database.
    *
+   * If the asynchronous upload is enabled, the objects are only enqueued and this method returns immediately.
+   *
    * @param qualityObjects QOs to be stored in DB.
    */
   void store(QualityObjectsType& qualityObjects, long validFrom);
@@ -194,8 +214,7 @@ class CheckRunner : public framework::Task
    * When data is received it can be 1. a TObjArray filled with MonitorObjects,
    * 2. a TObjArray filled with TObjects or 3. a TObject. The two latter happen
    * in case an external device is sending the data.
-   * This method first transform the data in order to have a TObjArray of MonitorObjects.
-   * It then stores these objects in the cache.
+   * The data is adopted by the cache without copies, TObjects are encapsulated in MonitorObjects.
    * @param ctx
    */
   void prepareCacheData(framework::InputRecord& inputRecord);
@@ -218,9 +237,11 @@ class CheckRunner : public framework::Task
   std::shared_ptr<Activity> mActivity; // shareable with the Checks
   CheckRunnerConfig mConfig;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mDatabase;
+  std::unique_ptr<o2::quality_control::repository::DatabaseUploader> mUploader; // only if asynchronous upload is enabled
   std::unordered_set<std::string> mInputStoreSet;
   std::vector<std::shared_ptr<MonitorObject>> mMonitorObjectStoreVector;
   UpdatePolicyManager updatePolicyManager;
+  std::unique_ptr<ThreadPool> mCheckPool; // only if checks should run in parallel
   bool mReceivedEOS = false;
 
   // DPL
@@ -228,7 +249,7 @@ class CheckRunner : public framework::Task
   o2::framework::Outputs mOutputs;
 
   // Checks cache
-  std::map<std::string, std::shared_ptr<MonitorObject>> mMonitorObjects;
+  MonitorObjectCache mMonitorObjectCache;
 
   // Service discovery
   std::shared_ptr<ServiceDiscovery> mServiceDiscovery;
@@ -33,6 +33,7 @@ struct CheckRunnerConfig {
   core::LogDiscardParameters infologgerDiscardParameters;
   core::Activity fallbackActivity;
   framework::Options options{};
+  size_t checkParallelism = 1;
 };
 
 } // namespace o2::quality_control::checker
@@ -44,6 +44,7 @@ struct CommonSpec {
   LogDiscardParameters infologgerDiscardParameters;
   double postprocessingPeriod = 30.0;
   std::string bookkeepingUrl;
+  size_t checkParallelism = 1;
 };
 
 } // namespace o2::quality_control::core
@@ -0,0 +1,136 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DatabaseCache.h
+///
+
+#ifndef QC_REPOSITORY_DATABASECACHE_H
+#define QC_REPOSITORY_DATABASECACHE_H
+
+#include "QualityControl/ValidityInterval.h"
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+class TObject;
+
+namespace o2::quality_control::repository
+{
+
+/// \brief Configuration of the retrieval cache, read from the "database" section of the config.
+///
+/// The relevant keys are "cache" (default false), "cacheSizeMB" (default 256) and "cacheListingTtlMs" (default 1000).
+struct DatabaseCacheConfig {
+  bool enabled = false;
+  size_t maxBytes = 256 * 1024 * 1024;
+  std::chrono::milliseconds listingTtl{ 1000 };
+
+  static DatabaseCacheConfig fromDatabaseConfig(const std::unordered_map<std::string, std::string>& databaseConfig);
+};
+
+/// \brief Memory-bounded cache of the objects retrieved from a database, with memoization of the latest object listings.
+///
+/// Objects are kept with the headers they were received with, in the order of their last use, and the least recently used
+/// ones are evicted once the estimated size of the cached objects exceeds the configured limit.
+/// The versions of an object are indexed by their validity, so they can be found by any timestamp within their validity.
+/// The version returned by a listing is found with its validity and its ID in the database, since an object can be stored
+/// again with the same validity.
+/// The statistics are counted by the caller with markHit(), markRevalidated() and markMissed(), once it knows the outcome of a request.
+/// The version of the latest object matching a path and metadata is remembered for a short time, so the sources
+/// of one update which refer to the same object share the listing request.
+/// The cache is thread-safe.
+class DatabaseCache
+{
+ public:
+  /// \brief A version of an object, as listed by the database.
+  struct Version {
+    core::ValidityInterval validity;
+    std::string id; ///< e.g. the object ID in the CCDB, which differs for each upload
+  };
+
+  struct Entry {
+    std::shared_ptr<const TObject> object;
+    std::map<std::string, std::string> headers;
+    Version version;
+    size_t bytes = 0;
+  };
+
+  struct Stats {
+    uint64_t hits = 0;        ///< objects served from the cache without contacting the database
+    uint64_t revalidated = 0; ///< objects served from the cache after the database confirmed they did not change
+    uint64_t misses = 0;      ///< objects downloaded
+    uint64_t evictions = 0;
+    uint64_t listingHits = 0;
+    uint64_t listingMisses = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+    double hitRate = 0; ///< (hits + revalidated) / all object requests
+  };
+
+  explicit DatabaseCache(DatabaseCacheConfig config);
+
+  /// \brief Creates the key identifying an object, without its version.
+  static std::string makeKey(const std::string& path, const std::map<std::string, std::string>& metadata);
+  /// \brief Creates the key identifying e.g. a listing. The suffix is appended to the key of the object.
+  static std::string makeKey(const std::string& path, const std::map<std::string, std::string>& metadata, const std::string& suffix);
+
+  /// \brief Returns the version of the object with exactly this validity and ID and marks it as recently used, or nullptr.
+  std::shared_ptr<const Entry> find(const std::string& key, const Version& version);
+  /// \brief Returns the version of the object with the latest start of validity which is valid at the timestamp, or nullptr.
+  std::shared_ptr<const Entry> findValidAt(const std::string& key, core::validity_time_t timestamp);
+  /// \brief Caches a version of the object, replacing any previous one with the same start of validity, and adopts it.
+  std::shared_ptr<const Entry> insert(const std::string& key, Version version, TObject* object, std::map<std::string, std::string> headers);
+  /// \brief To be called when an object was served from the cache without contacting the database.
+  void markHit();
+  /// \brief To be called when the database confirmed that the cached entry is still up-to-date.
+  void markRevalidated();
+  /// \brief To be called when the object had to be downloaded, or could not be retrieved.
+  void markMissed();
+
+  std::optional<Version> findListing(const std::string& key);
+  void insertListing(const std::string& key, Version version);
+
+  Stats getStats() const;
+
+  /// \brief Creates a copy of a cached object which is owned by the caller.
+  static TObject* copy(const TObject& object);
+
+ private:
+  using LruList = std::list<std::pair<std::string, std::shared_ptr<const Entry>>>;
+
+  static size_t estimateSize(const TObject& object, const std::map<std::string, std::string>& headers);
+  std::shared_ptr<const Entry> use(LruList::iterator it);
+  void erase(LruList::iterator it);
+  void evict();
+
+  DatabaseCacheConfig mConfig;
+  mutable std::mutex mMutex;
+  LruList mLru; // the most recently used entries are at the front
+  std::unordered_map<std::string, std::map<core::validity_time_t, LruList::iterator>> mIndex; // the versions of each object by their start of validity
+  struct Listing {
+    Version version;
+    std::chrono::steady_clock::time_point expiry;
+  };
+  std::unordered_map<std::string, Listing> mListings;
+  Stats mStats;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_DATABASECACHE_H
@@ -31,6 +31,8 @@
 namespace o2::quality_control::repository
 {
 
+class DatabaseCache;
+
 /// \brief The interface to the MonitorObject's repository.
 ///
 /// \author Barthélémy von Haller
@@ -146,6 +148,42 @@ class DatabaseInterface
    */
   virtual std::shared_ptr<o2::quality_control::core::QualityObject> retrieveQO(std::string qoPath, long timestamp = Timestamp::Current, const core::Activity& activity = {}) = 0;
 
+  /// \brief A MonitorObject or QualityObject to be retrieved by retrieveMany.
+  struct RetrievalRequest {
+    enum class Type {
+      MonitorObject,
+      QualityObject
+    };
+    Type type = Type::MonitorObject;
+    std::string path; ///< path of the object without the provenance prefix and without its name
+    std::string name; ///< name of the object, it can be empty for QualityObjects if the path is the full path
+    long timestamp = Timestamp::Current;
+    core::Activity activity{};
+  };
+
+  /// \brief The result of a RetrievalRequest, only the member corresponding to the requested type can be set.
+  struct RetrievalResult {
+    std::shared_ptr<o2::quality_control::core::MonitorObject> monitorObject;
+    std::shared_ptr<o2::quality_control::core::QualityObject> qualityObject;
+  };
+
+  /**
+   * \brief Look up several objects and return them.
+   * Look up several MonitorObjects and QualityObjects, as retrieveMO and retrieveQO would.
+   * The implementations may run the requests concurrently, the default one runs them one after the other.
+   * @param requests The objects to retrieve.
+   * @return The results in the order of the requests. The results of objects which were not found are empty.
+   */
+  virtual std::vector<RetrievalResult> retrieveMany(const std::vector<RetrievalRequest>& requests)
+  {
+    std::vector<RetrievalResult> results;
+    results.reserve(requests.size());
+    for (const auto& request : requests) {
+      results.push_back(retrieve(request));
+    }
+    return results;
+  }
+
   /**
    * \brief Look up an object and return it.
    * Look up an object and return it if found or nullptr if not. It is a raw pointer because we might need it to build a MO.
@@ -195,6 +233,11 @@ class DatabaseInterface
 
   virtual void setMaxObjectSize(size_t maxObjectSize) = 0;
 
+  /**
+   * Returns the cache of the retrieved objects, if the implementation has one and it is enabled.
+   */
+  virtual const DatabaseCache* getCache() const { return nullptr; }
+
   /**
    * Return validity of the latest matching object
    * @param path the folder we want to list the children of.
@@ -202,6 +245,17 @@ class DatabaseInterface
    * @return validity of the latest matching object
    */
   virtual core::ValidityInterval getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata = {}) = 0;
+
+ protected:
+  /// \brief Retrieves the object of one request of retrieveMany.
+  RetrievalResult retrieve(const RetrievalRequest& request)
+  {
+    if (request.type == RetrievalRequest::Type::MonitorObject) {
+      return { retrieveMO(request.path, request.name, request.timestamp, request.activity), nullptr };
+    }
+    auto qoPath = request.name.empty() ? request.path : request.path + "/" + request.name;
+    return { nullptr, retrieveQO(qoPath, request.timestamp, request.activity) };
+  }
 };
 
 } // namespace o2::quality_control::repository
@@ -0,0 +1,126 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DatabaseUploader.h
+///
+
+#ifndef QC_REPOSITORY_DATABASEUPLOADER_H
+#define QC_REPOSITORY_DATABASEUPLOADER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+class MonitorObject;
+class QualityObject;
+} // namespace o2::quality_control::core
+
+namespace o2::quality_control::repository
+{
+
+class DatabaseInterface;
+
+/// \brief Configuration of the asynchronous upload, read from the "database" section of the config.
+///
+/// The relevant keys are "asyncUpload" (default false), "uploadThreads" (default 1) and "uploadQueueSize" (default 1000).
+struct DatabaseUploaderConfig {
+  bool enabled = false;
+  size_t threads = 1;
+  size_t queueSize = 1000;
+
+  static DatabaseUploaderConfig fromDatabaseConfig(const std::unordered_map<std::string, std::string>& databaseConfig);
+};
+
+/// \brief Stores MonitorObjects and QualityObjects in the QCDB on a pool of background threads.
+///
+/// Objects are put in a bounded queue and uploaded one by one by worker threads, each of them owning its own
+/// database backend. If an object with the same path is still waiting in the queue, it is replaced by the
+/// newer version (coalescing), which moves to the end of the queue. If the queue is full, the object which
+/// has been waiting the longest since its last update is dropped.
+/// Two versions of the same path are never uploaded concurrently, so they reach the database in order.
+class DatabaseUploader
+{
+ public:
+  using BackendFactory = std::function<std::shared_ptr<DatabaseInterface>()>;
+
+  struct Stats {
+    size_t queueDepth = 0;
+    uint64_t enqueued = 0;
+    uint64_t stored = 0;
+    uint64_t coalesced = 0;
+    uint64_t dropped = 0;
+    uint64_t failed = 0;
+    double meanLatencyMs = 0; ///< between enqueue and the end of the upload, since the last call to collectStats()
+    double maxLatencyMs = 0;  ///< between enqueue and the end of the upload, since the last call to collectStats()
+  };
+
+  /// \param backendFactory called once per worker thread to create a connected database backend.
+  DatabaseUploader(const BackendFactory& backendFactory, DatabaseUploaderConfig config);
+  ~DatabaseUploader();
+
+  DatabaseUploader(const DatabaseUploader&) = delete;
+  DatabaseUploader& operator=(const DatabaseUploader&) = delete;
+
+  void enqueue(std::shared_ptr<const core::MonitorObject> mo);
+  void enqueue(std::shared_ptr<const core::QualityObject> qo);
+
+  /// \brief Returns a factory creating and connecting backends with DatabaseFactory, as described by the config.
+  static BackendFactory backendFactoryFor(const std::unordered_map<std::string, std::string>& databaseConfig);
+
+  /// \brief Blocks until all the objects enqueued so far have been uploaded (or failed).
+  void flush();
+
+  /// \brief Returns the counters and resets the latency statistics.
+  Stats collectStats();
+
+ private:
+  struct Entry {
+    std::string path;
+    std::shared_ptr<const core::MonitorObject> mo;
+    std::shared_ptr<const core::QualityObject> qo;
+    std::chrono::steady_clock::time_point enqueuedAt;
+  };
+
+  void push(Entry&& entry);
+  void workerLoop(std::shared_ptr<DatabaseInterface> backend);
+  bool hasUploadableEntry() const; // expects the lock to be held
+  Entry takeUploadableEntry();     // expects the lock to be held and an uploadable entry
+
+  DatabaseUploaderConfig mConfig;
+  std::list<Entry> mQueue;
+  std::unordered_map<std::string, std::list<Entry>::iterator> mQueueIndex; // path -> pending entry
+  std::unordered_set<std::string> mPathsInFlight;
+  std::mutex mMutex;
+  std::condition_variable mWorkAvailable;
+  std::condition_variable mWorkDone;
+  bool mStopping = false;
+  std::vector<std::thread> mWorkers;
+
+  Stats mStats;
+  double mLatencySumMs = 0;
+  uint64_t mLatencyCount = 0;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_DATABASEUPLOADER_H
@@ -0,0 +1,42 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    LazyObjectInterface.h
+///
+
+#ifndef QUALITYCONTROL_LAZYOBJECTINTERFACE_H
+#define QUALITYCONTROL_LAZYOBJECTINTERFACE_H
+
+#include <Rtypes.h>
+
+namespace o2::quality_control::core
+{
+
+/// \brief Interface of objects which travel without the part of their content which can be derived from the rest.
+///
+/// Such an object keeps only its primary content (e.g. the numerator and the denominator of a ratio) up to date,
+/// which keeps the merging and the serialization cheap. The derived content is computed once, when the CheckRunner receives the object,
+/// before it is checked and stored, or when the RootFileSink writes it to a file.
+class LazyObjectInterface
+{
+ public:
+  virtual ~LazyObjectInterface() = default;
+
+  /// \brief Computes the derived content if it is not up to date. Does nothing otherwise.
+  virtual void computeLazyContent() = 0;
+
+  ClassDef(LazyObjectInterface, 0);
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QUALITYCONTROL_LAZYOBJECTINTERFACE_H
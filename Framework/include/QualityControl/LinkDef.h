@@ -14,6 +14,7 @@
 #pragma link C++ class o2::quality_control::postprocessing::PostProcessingInterface + ;
 #pragma link C++ class o2::quality_control::postprocessing::TrendingTask + ;
 #pragma link C++ class o2::quality_control::core::MonitorObjectCollection + ;
+#pragma link C++ class o2::quality_control::core::LazyObjectInterface + ;
 #pragma link C++ class o2::quality_control::core::ValidityInterval + ;
 #pragma link C++ class o2::quality_control::postprocessing::SliceInfo + ;
 #pragma link C++ class std::vector<o2::quality_control::postprocessing::SliceInfo> + ;
@@ -0,0 +1,88 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ListingWatcher.h
+///
+
+#ifndef QC_REPOSITORY_LISTINGWATCHER_H
+#define QC_REPOSITORY_LISTINGWATCHER_H
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace o2::quality_control::repository
+{
+
+/// \brief One object in a CCDB listing, i.e. its scalar headers and metadata as strings.
+using ListingEntry = std::map<std::string, std::string>;
+
+/// \brief Parses a CCDB listing in JSON and returns its "objects", without building a DOM of the whole document.
+///
+/// Nested arrays and objects of the entries are skipped. Returns std::nullopt if the document is malformed
+/// or does not contain the "objects" array.
+std::optional<std::vector<ListingEntry>> parseListing(std::string_view json);
+
+/// \brief Watches the latest versions of objects in CCDB, sharing the listing requests among all the watchers of a process.
+///
+/// The watches of the objects in the same folder of the same database and with the same metadata filter are grouped together.
+/// A group asks for the latest version of all its objects with one listing request, at most once per poll period,
+/// no matter how many watches it serves. Once it knows the content of the folder, it asks only for the objects created
+/// since the last poll, which typically results in an empty, cheap response. The whole folder is listed again
+/// periodically and whenever a new object is watched.
+/// The watcher is thread-safe.
+class ListingWatcher
+{
+ public:
+  struct Group;
+
+  /// \brief A subscription to the latest version of an object. The object is not watched anymore once it is destroyed.
+  class Watch
+  {
+   public:
+    Watch(std::shared_ptr<Group> group, std::string path);
+    ~Watch();
+    Watch(const Watch&) = delete;
+    Watch& operator=(const Watch&) = delete;
+
+    /// \brief Returns the listing entry of the latest version of the object, polling the database if the last poll is too old.
+    std::optional<ListingEntry> getLatest();
+
+   private:
+    std::shared_ptr<Group> mGroup;
+    std::string mPath;
+  };
+
+  static ListingWatcher& getInstance();
+
+  /// \brief Starts watching the object with the full path in the database, filtered with the metadata.
+  std::unique_ptr<Watch> watch(const std::string& databaseUrl, const std::string& path, const std::map<std::string, std::string>& metadata = {});
+
+  /// \brief Sets the minimum period between two listing requests of a group, for the existing and the future groups.
+  void setPollPeriod(std::chrono::milliseconds pollPeriod);
+
+ private:
+  ListingWatcher() = default;
+
+  std::mutex mMutex;
+  std::map<std::string, std::weak_ptr<Group>> mGroups;
+  std::chrono::milliseconds mPollPeriod{ 1000 };
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_LISTINGWATCHER_H
@@ -0,0 +1,74 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MonitorObjectCache.h
+///
+
+#ifndef QC_CHECKER_MONITOROBJECTCACHE_H
+#define QC_CHECKER_MONITOROBJECTCACHE_H
+
+#include "QualityControl/ValidityInterval.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TObject;
+
+namespace o2::quality_control::core
+{
+class Activity;
+class MonitorObject;
+} // namespace o2::quality_control::core
+
+namespace o2::quality_control::checker
+{
+
+/// \brief Keeps the latest version of each MonitorObject received by a CheckRunner.
+///
+/// The received objects are adopted as they are, without copies.
+/// Objects which are not MonitorObjects (e.g. coming from external tasks) are encapsulated in a MonitorObject.
+/// If nobody else holds the MonitorObject created for the previous version of such an object,
+/// it is reused and only its payload is replaced.
+/// Objects which a MonitorObjectCollection lists as unchanged are taken from the cache with an updated validity.
+/// Objects implementing LazyObjectInterface get their derived content computed on reception.
+class MonitorObjectCache
+{
+ public:
+  /// \brief Adopts a received object and updates the cache with the MonitorObjects it contains.
+  /// \param received A TObjArray of MonitorObjects or TObjects, or a single TObject. The ownership is taken.
+  /// \param taskName The task name given to the objects which are not MonitorObjects.
+  /// \param detectorName The detector name given to the objects which are not MonitorObjects.
+  /// \param activity The activity given to the objects which are not MonitorObjects.
+  /// \return The MonitorObjects which were updated, in the order of reception.
+  std::vector<std::shared_ptr<core::MonitorObject>> ingest(std::unique_ptr<TObject> received, const std::string& taskName,
+                                                           const std::string& detectorName, const core::Activity& activity);
+
+  const std::map<std::string, std::shared_ptr<core::MonitorObject>>& getMonitorObjects() const { return mMonitorObjects; }
+  size_t getNumberReusedShells() const { return mNumberReusedShells; }
+  void clear();
+
+ private:
+  /// updates the validity of a cached object which was listed as unchanged by the sender
+  std::shared_ptr<core::MonitorObject> refresh(const std::string& fullName, core::ValidityInterval validity);
+  /// encapsulates an object which is not a MonitorObject, reusing the previous shell if possible
+  std::shared_ptr<core::MonitorObject> encapsulate(TObject* object, const std::string& taskName,
+                                                   const std::string& detectorName, const core::Activity& activity);
+
+  std::map<std::string, std::shared_ptr<core::MonitorObject>> mMonitorObjects;
+  size_t mNumberReusedShells = 0;
+};
+
+} // namespace o2::quality_control::checker
+
+#endif // QC_CHECKER_MONITOROBJECTCACHE_H
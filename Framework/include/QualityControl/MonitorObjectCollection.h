@@ -17,7 +17,10 @@
 #ifndef QUALITYCONTROL_MONITOROBJECTCOLLECTION_H
 #define QUALITYCONTROL_MONITOROBJECTCOLLECTION_H
 
+#include "QualityControl/ValidityInterval.h"
+
 #include <string>
+#include <vector>
 #include <TObjArray.h>
 #include <Mergers/MergeInterface.h>
 
@@ -42,11 +45,19 @@ class MonitorObjectCollection : public TObjArray, public mergers::MergeInterface
 
   MergeInterface* cloneMovingWindow() const override;
 
+  /// \brief Lists an object which is not sent, because it did not change since the previous publication.
+  /// When merged, such an object only extends the validity of the corresponding object in the target collection.
+  void addUnchangedObject(const std::string& name, ValidityInterval validity);
+  const std::vector<std::string>& getUnchangedObjects() const;
+  ValidityInterval getUnchangedObjectsValidity() const;
+
  private:
   std::string mDetector = "TST";
   std::string mTaskName = "Test";
+  std::vector<std::string> mUnchangedObjects;
+  ValidityInterval mUnchangedObjectsValidity = gInvalidValidityInterval;
 
-  ClassDefOverride(MonitorObjectCollection, 2);
+  ClassDefOverride(MonitorObjectCollection, 3);
 };
 
 } // namespace o2::quality_control::core
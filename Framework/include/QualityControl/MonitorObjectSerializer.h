@@ -0,0 +1,63 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MonitorObjectSerializer.h
+///
+
+#ifndef QC_CORE_MONITOROBJECTSERIALIZER_H
+#define QC_CORE_MONITOROBJECTSERIALIZER_H
+
+#include <TMessage.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+class MonitorObjectCollection;
+class ThreadPool;
+
+/// \brief Serializes the MonitorObjects of a collection concurrently, each of them into a separate message.
+///
+/// Each message contains a MonitorObjectCollection with one MonitorObject, so that the consumers can treat it
+/// as any other collection published by a task. The first message also carries the list of unchanged objects of the
+/// original collection. If the collection has no MonitorObject, one message with an empty collection is produced.
+/// The messages are ready to be sent with the ROOT serialization method.
+class MonitorObjectSerializer
+{
+ public:
+  struct Part {
+    std::string objectName; ///< empty if the part does not contain any MonitorObject
+    std::unique_ptr<TMessage> message;
+    double durationMs = 0; ///< time spent to serialize the part
+  };
+
+  explicit MonitorObjectSerializer(size_t nThreads);
+  ~MonitorObjectSerializer();
+
+  /// \brief Serializes the MonitorObjects of the collection, the returned parts keep the order of the collection.
+  std::vector<Part> serialize(const MonitorObjectCollection& collection);
+
+  size_t getNThreads() const;
+
+  /// \brief Serializes the whole collection into one message, as DPL does for ROOT-serialized objects.
+  static std::unique_ptr<TMessage> serializeCollection(const MonitorObjectCollection& collection);
+
+ private:
+  std::unique_ptr<ThreadPool> mPool;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_MONITOROBJECTSERIALIZER_H
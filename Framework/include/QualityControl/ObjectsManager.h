@@ -24,9 +24,11 @@
 #include <Mergers/Mergeable.h>
 // stl
 #include <concepts>
+#include <functional>
 #include <string>
 #include <memory>
 #include <type_traits>
+#include <unordered_map>
 
 class TObject;
 
@@ -134,7 +136,38 @@ class ObjectsManager
    */
   MonitorObject* getMonitorObject(const std::string& objectName);
 
-  MonitorObjectCollection* getNonOwningArray() const;
+  MonitorObjectCollection* getNonOwningArray();
+
+  /**
+   * \brief Creates a collection of the objects which were modified since the previous call.
+   * The objects which did not change are only listed as unchanged in the collection.
+   * Histograms are considered as modified if their number of entries changed, or if they were marked with setModified().
+   * Other objects are always considered as modified.
+   * @return A collection which does not own the objects, it must be deleted by the caller.
+   */
+  MonitorObjectCollection* getNonOwningArrayOfModified();
+
+  /**
+   * \brief Creates a collection which owns copies of the MonitorObjects of the provided collection and of their objects.
+   * It allows to publish the objects of a cycle while the originals are already being filled in the next one.
+   * @param array A collection of MonitorObjects, e.g. obtained with getNonOwningArray().
+   * @param copier Creates a copy of the object of a MonitorObject.
+   * @return A collection which owns the copies, it must be deleted by the caller.
+   */
+  static MonitorObjectCollection* copyArray(const MonitorObjectCollection& array, const std::function<TObject*(const TObject&)>& copier);
+
+  /**
+   * \brief Marks the object as modified, so it is published again even if its number of entries did not change.
+   * @param objectName Name of the object.
+   * @throw ObjectNotFoundError if object is not found.
+   */
+  void setModified(const std::string& objectName);
+
+  /**
+   * \brief Informs that the objects were reset.
+   * A reset object is considered as modified, unless it is still empty and it was empty at its previous publication.
+   */
+  void setAllReset();
 
   /**
    * \brief Add metadata to a MonitorObject.
@@ -234,6 +267,23 @@ class ObjectsManager
  private:
   std::unique_ptr<MonitorObjectCollection> mMonitorObjects;
   std::map<MonitorObject*, PublicationPolicy> mPublicationPoliciesForMOs;
+  struct ModificationState {
+    double publishedEntries = -1; // -1 means that the object was never published
+    bool modified = true;
+    bool reset = false;
+  };
+  std::map<const MonitorObject*, ModificationState> mModificationStates;
+  // Indexes of the objects in mMonitorObjects, so that they can be found without scanning the collection.
+  // Removed objects leave empty slots in mMonitorObjects, which are compacted only once they are numerous enough
+  // or when the collection is about to be exposed.
+  struct Registration {
+    std::string name;
+    int slot;
+  };
+  std::unordered_map<std::string, MonitorObject*> mObjectsByName;
+  std::unordered_map<const TObject*, MonitorObject*> mObjectsByPayload;
+  std::unordered_map<const MonitorObject*, Registration> mRegistrations;
+  size_t mEmptySlots = 0;
   std::string mTaskName;
   std::string mTaskClass;
   std::string mDetectorName;
@@ -243,6 +293,10 @@ class ObjectsManager
   std::vector<std::string> mMovingWindowsList;
 
   void startPublishingImpl(TObject* obj, PublicationPolicy, bool ignoreMergeableWarning);
+  bool isModified(const MonitorObject* mo) const;
+  MonitorObject* findMonitorObject(const std::string& objectName) const;
+  void removeMonitorObject(MonitorObject* mo);
+  void compact();
 };
 
 } // namespace o2::quality_control::core
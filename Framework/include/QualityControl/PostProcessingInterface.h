@@ -17,6 +17,7 @@
 #ifndef QUALITYCONTROL_POSTPROCESSINTERFACE_H
 #define QUALITYCONTROL_POSTPROCESSINTERFACE_H
 
+#include <memory>
 #include <string>
 #include <boost/property_tree/ptree_fwd.hpp>
 #include "QualityControl/Triggers.h"
@@ -27,6 +28,11 @@
 namespace o2::quality_control::postprocessing
 {
 
+/// \brief Base of the data which a post-processing task prepares ahead of an update, see PostProcessingInterface::prepareUpdate.
+struct PreparedUpdate {
+  virtual ~PreparedUpdate() = default;
+};
+
 /// \brief  Skeleton of a post-processing task.
 ///
 /// Abstract class defining the skeleton and the common interface of a post-processing task.
@@ -65,6 +71,24 @@ class PostProcessingInterface : public core::UserCodeInterface
   /// \param services Interface containing optional interfaces, for example DatabaseInterface
   virtual void update(Trigger trigger, framework::ServiceRegistryRef services) = 0;
 
+  /// \brief Preparation of an update of a post-processing task, in the backfill mode.
+  /// When the task is run over a list of timestamps with the backfill mode enabled, the preparation of the upcoming
+  /// updates is called concurrently in several threads, while update() or finishUpdate() are called in the order of
+  /// the triggers. The task can retrieve its inputs and compute here whatever does not depend on the state modified
+  /// by the updates. It must not modify the state of the task. The default implementation does nothing.
+  /// \param trigger  Trigger which will cause the update
+  /// \param services Interface containing optional interfaces, for example DatabaseInterface. It is not the one given
+  ///                 to update(), the DatabaseInterface in particular is a separate instance for each thread.
+  /// \return The prepared data, to be given to finishUpdate(). If nullptr, update() is called instead.
+  virtual std::unique_ptr<PreparedUpdate> prepareUpdate(Trigger trigger, framework::ServiceRegistryRef services);
+
+  /// \brief Update of a post-processing task with the data prepared by prepareUpdate().
+  /// The default implementation ignores the prepared data and calls update().
+  /// \param trigger  Trigger which caused the update
+  /// \param services Interface containing optional interfaces, for example DatabaseInterface
+  /// \param prepared The data returned by prepareUpdate() for this trigger, never nullptr
+  virtual void finishUpdate(Trigger trigger, framework::ServiceRegistryRef services, std::unique_ptr<PreparedUpdate> prepared);
+
   /// \brief Finalization of a post-processing task.
   /// Finalization of a post-processing task. User receives a Trigger which caused the finalization and a service
   /// registry with singleton interfaces.
@@ -29,6 +29,11 @@
 #include "QualityControl/DatabaseInterface.h"
 #include "WorkflowType.h"
 
+namespace o2::monitoring
+{
+class Monitoring;
+}
+
 namespace o2::framework
 {
 class DataAllocator;
@@ -95,8 +100,10 @@ class PostProcessingRunner
  private:
   void updateValidity(const Trigger& trigger);
   void doInitialize(const Trigger& trigger);
-  void doUpdate(const Trigger& trigger);
+  void doUpdate(const Trigger& trigger, std::unique_ptr<PreparedUpdate> prepared = nullptr);
+  void runBackfill(const std::vector<Trigger>& triggers);
   void doFinalize(const Trigger& trigger);
+  void sendMonitoring();
 
   enum class TaskState {
     INVALID,
@@ -121,6 +128,7 @@ class PostProcessingRunner
   PostProcessingRunnerConfig mRunnerConfig;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mSourceDatabase;
   std::shared_ptr<o2::quality_control::repository::DatabaseInterface> mDestinationDatabase;
+  std::shared_ptr<o2::monitoring::Monitoring> mCollector;
   std::unique_ptr<repository::DatabaseInterface> configureDatabase(std::unordered_map<std::string, std::string>& dbConfig, const std::string& name);
 };
 
@@ -37,6 +37,8 @@ struct PostProcessingRunnerConfig {
   double periodSeconds = 10.0;
   std::string configKeyValues; // These are for ConfigurableParams, not for override-values!
   boost::property_tree::ptree configTree{};
+  std::string monitoringUrl{}; // if empty, no metrics are sent
+  size_t backfillThreads = 0;  // if > 0, updates are prepared concurrently in runOverTimestamps
 };
 
 } // namespace o2::quality_control::postprocessing
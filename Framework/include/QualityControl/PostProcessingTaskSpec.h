@@ -46,6 +46,7 @@ struct PostProcessingTaskSpec {
   boost::property_tree::ptree tree = {};
   core::CustomParameters customParameters;
   std::unordered_map<std::string, std::string> sourceDatabase;
+  size_t backfillThreads = 0;
 };
 
 } // namespace o2::quality_control::core
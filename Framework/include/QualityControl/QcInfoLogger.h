@@ -19,6 +19,8 @@
 
 #include <InfoLogger/InfoLogger.hxx>
 #include <boost/property_tree/ptree_fwd.hpp>
+#include <climits>
+#include <string>
 #include "QualityControl/LogDiscardParameters.h"
 
 typedef AliceO2::InfoLogger::InfoLogger infologger; // not to have to type the full stuff each time
@@ -39,6 +41,9 @@ namespace o2::quality_control::core
 ///                     << "fatal message with extra fields" << ENDM; // complex version
 ///           ILOG(Info, Ops) << "Test message with severity Info and level Ops, see InfoLoggerMacros.hxx" << ENDM;
 ///
+/// ILOG is a statement, it cannot be an operand of another expression.
+/// The messages discarded by the filters cost one comparison, while the ILOG_INST versions are always formatted.
+///
 /// \author Barthelemy von Haller
 class QcInfoLogger
 {
@@ -73,6 +78,45 @@ class QcInfoLogger
                    const std::string& partitionName = "");
   static void disable();
 
+  // Setters of the InfoLogger discard filters. They should be used instead of calling the InfoLogger directly,
+  // so that ILOG knows which messages are discarded and does not even format them.
+  static void filterDiscardDebug(bool discard);
+  static void filterDiscardLevel(int fromLevel);
+  static void filterDiscardSetFile(const std::string& file, unsigned long rotateMaxBytes, unsigned int rotateMaxFiles, bool debugInDiscardFile);
+
+  /// \brief Tells if a message is removed at compile time, see the CMake option QC_STRIP_DEBUG_LOGS.
+  /// Errors are never removed, whatever their level.
+  static constexpr bool isStripped([[maybe_unused]] AliceO2::InfoLogger::InfoLogger::Severity severity, [[maybe_unused]] int level)
+  {
+#ifdef QC_STRIP_DEBUG_LOGS
+    using Severity = AliceO2::InfoLogger::InfoLogger::Severity;
+    return severity == Severity::Debug || (level >= AliceO2::InfoLogger::InfoLogger::Level::Trace && severity != Severity::Error && severity != Severity::Fatal);
+#else
+    return false;
+#endif
+  }
+
+  /// \brief Tells if a message would reach the InfoLogger output or the discard file.
+  /// The severity is known at compile time in ILOG, so a discarded message costs one comparison.
+  static bool isLogged(AliceO2::InfoLogger::InfoLogger::Severity severity, int level)
+  {
+    if (isStripped(severity, level)) {
+      return false;
+    }
+    if (severity == AliceO2::InfoLogger::InfoLogger::Severity::Error || severity == AliceO2::InfoLogger::InfoLogger::Severity::Fatal) {
+      return true;
+    }
+    return level < (severity == AliceO2::InfoLogger::InfoLogger::Severity::Debug ? sDebugDiscardedFromLevel : sDiscardedFromLevel);
+  }
+
+  /// \brief Turns a stream expression into void, so that ILOG can be the last operand of a conditional operator.
+  struct Voidify {
+    template <typename T>
+    void operator&(T&&)
+    {
+    }
+  };
+
   // build a default infologger
   static class _init
   {
@@ -93,6 +137,15 @@ class QcInfoLogger
   static AliceO2::InfoLogger::InfoLogger* instance;
   static AliceO2::InfoLogger::InfoLoggerContext* mContext;
   static bool disabled; // disabled basically means that we enforce discarding debug and level 1+
+
+  // the discard filters as set in the InfoLogger, and the resulting levels from which ILOG skips the messages
+  static void updateDiscardedLevels();
+  static bool sFilterDiscardDebug;
+  static int sFilterDiscardLevel;
+  static bool sDiscardToFile;
+  static bool sDebugInDiscardFile;
+  static int sDiscardedFromLevel;
+  static int sDebugDiscardedFromLevel;
 };
 
 } // namespace o2::quality_control::core
@@ -116,11 +169,17 @@ class QcInfoLogger
 #define ILOG(...) VA_MACRO(ILOG, void, void, __VA_ARGS__)
 // TODO understand why the zero argument does not work.
 // the code is derived from https://stackoverflow.com/questions/16683146/can-macros-be-overloaded-by-number-of-arguments
+// The messages which are discarded by the InfoLogger filters are not formatted, their operands are not even evaluated.
+#define ILOG_IF_LOGGED_(severity, level)                                \
+  !o2::quality_control::core::QcInfoLogger::isLogged(severity, level) \
+    ? (void)0                                                         \
+    : o2::quality_control::core::QcInfoLogger::Voidify() &            \
+        ILOG_INST << AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption { severity, level, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
 #define ILOG0(s, t) \
-  ILOG_INST << AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption { AliceO2::InfoLogger::InfoLogger::Severity::Info, AliceO2::InfoLogger::InfoLogger::Level::Support, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
+  ILOG_IF_LOGGED_(AliceO2::InfoLogger::InfoLogger::Severity::Info, AliceO2::InfoLogger::InfoLogger::Level::Support)
 #define ILOG1(s, t, severity) \
-  ILOG_INST << AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption { AliceO2::InfoLogger::InfoLogger::Severity::severity, AliceO2::InfoLogger::InfoLogger::Level::Support, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
+  ILOG_IF_LOGGED_(AliceO2::InfoLogger::InfoLogger::Severity::severity, AliceO2::InfoLogger::InfoLogger::Level::Support)
 #define ILOG2(s, t, severity, level) \
-  ILOG_INST << AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption { AliceO2::InfoLogger::InfoLogger::Severity::severity, AliceO2::InfoLogger::InfoLogger::Level::level, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
+  ILOG_IF_LOGGED_(AliceO2::InfoLogger::InfoLogger::Severity::severity, AliceO2::InfoLogger::InfoLogger::Level::level)
 
 #endif // QC_CORE_QCINFOLOGGER_H
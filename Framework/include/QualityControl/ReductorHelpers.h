@@ -18,6 +18,7 @@
 #define QUALITYCONTROL_REDUCTORHELPERS_H
 
 #include <string>
+#include <vector>
 
 namespace o2::quality_control
 {
@@ -46,6 +47,17 @@ namespace implementation
 bool updateReductorImpl(Reductor* r, const Trigger& t, const std::string& path, const std::string& name, const std::string& type,
                         repository::DatabaseInterface& qcdb, core::ConditionAccess& ccdbAccess);
 
+struct DataSourceDescription {
+  Reductor* reductor;
+  std::string path;
+  std::string name;
+  std::string type;
+};
+
+/// \brief implementation details of updateReductors, hiding some header inclusions
+std::vector<bool> updateReductorsImpl(const std::vector<DataSourceDescription>& sources, const Trigger& t,
+                                      repository::DatabaseInterface& qcdb, core::ConditionAccess& ccdbAccess);
+
 } // namespace implementation
 
 /// \brief Updates the provided Reductor with implementation-specific procedures
@@ -67,5 +79,27 @@ bool updateReductor(Reductor* r, const Trigger& t, const DataSourceT& ds, reposi
   return implementation::updateReductorImpl(r, t, path, name, type, qcdb, ccdbAccess);
 }
 
+/// \brief Updates the Reductors of several data sources, retrieving all their objects at once
+///
+/// \tparam DataSourceT data source structure type to be accessed. path, name and type string members are required.
+/// \tparam ReductorMapT map-like container of Reductor pointers, accessed with the data source names
+/// \param reductors reductors which are going to be type-checked, one per data source name
+/// \param t trigger
+/// \param dataSources data sources
+/// \param qcdb QCDB interface
+/// \param ccdbAccess a class which has access to conditions
+/// \return bool values indicating the success or failure in reducing an object, in the order of the data sources
+template <typename DataSourceT, typename ReductorMapT>
+std::vector<bool> updateReductors(ReductorMapT& reductors, const Trigger& t, const std::vector<DataSourceT>& dataSources,
+                                  repository::DatabaseInterface& qcdb, core::ConditionAccess& ccdbAccess)
+{
+  std::vector<implementation::DataSourceDescription> sources;
+  sources.reserve(dataSources.size());
+  for (const auto& ds : dataSources) {
+    sources.push_back({ reductors[ds.name].get(), ds.path, ds.name, ds.type });
+  }
+  return implementation::updateReductorsImpl(sources, t, qcdb, ccdbAccess);
+}
+
 } // namespace o2::quality_control::postprocessing::reductor_helpers
 #endif // QUALITYCONTROL_REDUCTORHELPERS_H
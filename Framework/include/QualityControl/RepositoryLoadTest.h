@@ -0,0 +1,111 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RepositoryLoadTest.h
+///
+
+#ifndef QC_REPOSITORY_REPOSITORYLOADTEST_H
+#define QC_REPOSITORY_REPOSITORYLOADTEST_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TObject;
+
+namespace o2::quality_control::repository
+{
+
+enum class LoadTestOperation {
+  Store,
+  Retrieve,
+  LatestValidity,
+  Listing
+};
+constexpr size_t nLoadTestOperations = 4;
+
+std::string toString(LoadTestOperation operation);
+
+struct RepositoryLoadTestConfig {
+  std::string databaseUrl; ///< if empty, a CcdbStandIn is started and used
+  size_t threads = 4;
+  std::chrono::milliseconds duration{ 10000 };
+  uint64_t maxRequestsPerThread = 0; ///< 0 means no limit
+  /// relative weights of the operations, in the order of LoadTestOperation
+  std::array<double, nLoadTestOperations> mix{ 1, 8, 2, 1 };
+  /// ROOT file with objects produced by a QC task, their number and sizes are used as they are
+  std::string objectsFile;
+  /// if no objects file is provided, histograms of these sizes are generated, in kB
+  std::vector<size_t> objectSizesKB{ 1, 10, 100 };
+  size_t numberOfObjects = 12;
+  std::string detector = "TST";
+  std::string taskName = "RepositoryLoadTest";
+  bool truncate = true; ///< removes the stored objects at the end
+
+  /// \brief Parses a mix of operations such as "store=1,retrieve=8,validity=2,listing=1". Missing operations get 0.
+  static std::array<double, nLoadTestOperations> parseMix(const std::string& mix);
+};
+
+struct LatencySummary {
+  uint64_t count = 0;
+  uint64_t errors = 0;
+  double throughput = 0; ///< requests per second
+  double meanMs = 0;
+  double p50Ms = 0;
+  double p99Ms = 0;
+  double p999Ms = 0;
+  double maxMs = 0;
+
+  /// \brief Summarizes the latencies, which are sorted in place.
+  static LatencySummary fromLatencies(std::vector<double>& latenciesMs, uint64_t errors, double durationS);
+};
+
+struct RepositoryLoadTestResults {
+  std::string databaseUrl;
+  size_t threads = 0;
+  size_t objects = 0;
+  uint64_t payloadBytes = 0; ///< the total size of the serialized objects
+  double durationS = 0;
+  std::array<LatencySummary, nLoadTestOperations> operations;
+  LatencySummary total;
+
+  std::string toJson() const;
+};
+
+/// \brief Drives a configurable mix of QCDB requests from many threads and measures their latencies.
+///
+/// Each thread uses its own CcdbDatabase, as the uploaders of a QC task would. Before the measurement,
+/// all the objects are stored once, so that the retrievals and listings do not return empty results.
+class RepositoryLoadTest
+{
+ public:
+  explicit RepositoryLoadTest(RepositoryLoadTestConfig config);
+  ~RepositoryLoadTest();
+
+  RepositoryLoadTestResults run();
+
+  /// \brief Reads the objects from a file, including those in MonitorObjectCollections and TDirectories.
+  static std::vector<std::unique_ptr<TObject>> readObjects(const std::string& filePath);
+  /// \brief Creates a histogram which takes roughly the requested amount of memory.
+  static std::unique_ptr<TObject> createHistogram(size_t sizeKB, const std::string& name);
+
+ private:
+  RepositoryLoadTestConfig mConfig;
+  std::vector<std::unique_ptr<TObject>> mObjects;
+};
+
+} // namespace o2::quality_control::repository
+
+#endif // QC_REPOSITORY_REPOSITORYLOADTEST_H
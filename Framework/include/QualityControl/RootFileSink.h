@@ -20,19 +20,39 @@
 #include <Framework/Task.h>
 #include <Framework/CompletionPolicy.h>
 #include <Framework/DataProcessorLabel.h>
+#include <Framework/ConfigParamSpec.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
 
 namespace o2::quality_control::core
 {
 
+class MonitorObjectCollection;
+
 /// \brief A Data Processor which stores MonitorObjectCollections in a specified file
+///
+/// By default, each received MonitorObjectCollection is merged with the stored one immediately.
+/// If a non-negative flush period is configured, the integrated collections are kept and merged in memory instead,
+/// and they are written to the file once per period (if 0, only at the end of the processing). New moving windows
+/// are appended to the file without reading it again.
 class RootFileSink : public framework::Task
 {
  public:
-  explicit RootFileSink(std::string filePath);
+  /// \param flushPeriod see the option "flush-period", which overrides it in init()
+  explicit RootFileSink(std::string filePath, std::chrono::seconds flushPeriod = std::chrono::seconds{ -1 });
   ~RootFileSink() override = default;
 
   void init(framework::InitContext& ictx) override;
   void run(framework::ProcessingContext& pctx) override;
+  void endOfStream(framework::EndOfStreamContext& eosContext) override;
+  void stop() override;
+
+  /// \brief Stores or accumulates a received MonitorObjectCollection and its moving windows, as run() does with each input.
+  void receive(std::unique_ptr<MonitorObjectCollection> moc);
 
   static framework::DataProcessorLabel getLabel()
   {
@@ -40,9 +60,26 @@ class RootFileSink : public framework::Task
   }
 
   static void customizeInfrastructure(std::vector<framework::CompletionPolicy>& policies);
+  static std::vector<framework::ConfigParamSpec> getOptions();
 
  private:
+  void store(MonitorObjectCollection* moc, MonitorObjectCollection* mwMOC);
+  void accumulate(std::unique_ptr<MonitorObjectCollection> moc, std::unique_ptr<MonitorObjectCollection> mwMOC);
+  void flush();
+  static void releaseMemory();
+  bool isAccumulating() const { return mFlushPeriod.count() >= 0; }
+
   std::string mFilePath;
+  std::chrono::seconds mFlushPeriod{ -1 };
+  std::chrono::steady_clock::time_point mLastFlush;
+  // integrated MOCs of each task, they include what was stored in the file before the first flush
+  std::map<std::string, std::unique_ptr<MonitorObjectCollection>> mIntegralMOCs;
+  std::set<std::string> mUpdatedIntegralMOCs;
+  // moving windows received since the last flush, by storage path
+  std::map<std::string, std::unique_ptr<MonitorObjectCollection>> mMovingWindowMOCs;
+  // paths of the MOCs known to be in the file, filled at the first flush
+  std::set<std::string> mStoredPaths;
+  bool mStoredPathsRead = false;
 };
 
 } // namespace o2::quality_control::core
@@ -51,14 +51,24 @@ class RootFileStorage
     Update
   };
 
+  enum class WriteMode {
+    Merge,    // the MOC is merged with the one already stored under the same path, if any
+    Overwrite // the MOC replaces the one stored under the same path without reading it
+  };
+
   explicit RootFileStorage(const std::string& filePath, ReadMode);
   ~RootFileStorage();
 
   DirectoryNode readStructure(bool loadObjects = false) const;
   MonitorObjectCollection* readMonitorObjectCollection(const std::string& path) const;
 
-  void storeIntegralMOC(MonitorObjectCollection* const moc);
-  void storeMovingWindowMOC(MonitorObjectCollection* const moc);
+  void storeIntegralMOC(MonitorObjectCollection* const moc, WriteMode writeMode = WriteMode::Merge);
+  void storeMovingWindowMOC(MonitorObjectCollection* const moc, WriteMode writeMode = WriteMode::Merge);
+
+  /// \brief Path under which storeIntegralMOC stores the provided MOC
+  static std::string integralMocPath(const MonitorObjectCollection* moc);
+  /// \brief Path under which storeMovingWindowMOC stores the provided MOC
+  static std::string movingWindowMocPath(const MonitorObjectCollection* moc);
 
  private:
   DirectoryNode readStructureImpl(TDirectory* currentDir, bool loadObjects) const;
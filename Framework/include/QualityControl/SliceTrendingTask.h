@@ -33,6 +33,8 @@
 class TCanvas;
 class TObject;
 class TLegend;
+class TGraphErrors;
+class TMultiGraph;
 
 namespace o2::quality_control::repository
 {
@@ -62,12 +64,23 @@ class SliceTrendingTask : public PostProcessingInterface
   void configure(const boost::property_tree::ptree& config) final;
   void initialize(Trigger, framework::ServiceRegistryRef) final;
   void update(Trigger, framework::ServiceRegistryRef) final;
+  /// Retrieves the objects of the data sources and reduces them with separate SliceReductors.
+  std::unique_ptr<PreparedUpdate> prepareUpdate(Trigger, framework::ServiceRegistryRef) final;
+  void finishUpdate(Trigger, framework::ServiceRegistryRef, std::unique_ptr<PreparedUpdate>) final;
   void finalize(Trigger, framework::ServiceRegistryRef) final;
 
  private:
+  struct PreparedValues;
+
   struct MetaData {
     Int_t runNumber = 0;
   };
+  /// \brief The graphs of a plot trended vs time or run, kept to append only the new entries of the trend.
+  struct CachedPlot {
+    std::vector<TGraphErrors*> graphs; // one per slice
+    TMultiGraph* multigraph = nullptr;
+    Long64_t entries = 0; // number of entries of the trend which are already in the graphs
+  };
   struct TitleSettings {
     std::string observableX;
     std::string observableY;
@@ -79,9 +92,16 @@ class SliceTrendingTask : public PostProcessingInterface
 
   /// \brief Methods specific to the trending itself.
   void trendValues(const Trigger& t, o2::quality_control::repository::DatabaseInterface&);
+  void setTime(const Trigger& t);
   void generatePlots();
   void drawCanvasMO(TCanvas* thisCanvas, const std::string& var,
-                    const std::string& name, const std::string& opt, const std::string& err, const std::vector<std::vector<float>>& axis, const std::vector<std::vector<std::string>>& sliceLabels, const TitleSettings& titlesettings);
+                    const std::string& name, const std::string& opt, const std::string& err, const std::vector<std::vector<float>>& axis, const std::vector<std::vector<std::string>>& sliceLabels, const TitleSettings& titlesettings, CachedPlot& cachedPlot);
+  /// \brief Appends the new entries of the trend to the plot drawn before, returns false if it has to be redrawn.
+  bool updateCanvasMO(TCanvas* thisCanvas, const SliceTrendingTaskConfig::Plot& plot, const std::string& varName);
+  /// \brief Appends the entries of the trend starting from firstEntry to the graphs of each slice, vs time or run.
+  /// \return the titles of the slices in the last entry
+  std::vector<std::string> appendTrendPoints(const std::vector<TGraphErrors*>& graphs, const std::string& varName, const std::string& typeName,
+                                             const std::string& errXName, const std::string& errYName, bool vsTime, Long64_t firstEntry);
   void getUserAxisRange(const std::string& graphAxisRange, float& limitLow, float& limitUp);
   void setUserAxisLabel(TAxis* xAxis, TAxis* yAxis, const std::string& graphAxisLabel);
   void getTrendVariables(const std::string& inputvar, std::string& sourceName, std::string& variableName, std::string& trend);
@@ -90,6 +110,8 @@ class SliceTrendingTask : public PostProcessingInterface
 
   template <typename T>
   void beautifyGraph(T& graph, const SliceTrendingTaskConfig::Plot& plotconfig, TCanvas* canv); // beautify function for TGraphs and TMultiGraphs
+  template <typename T>
+  void beautifyAxes(T& graph, const SliceTrendingTaskConfig::Plot& plotconfig, TCanvas* canv);
   void beautifyLegend(TLegend* geg, const SliceTrendingTaskConfig::Plot& plotconfig, TCanvas* canv);
   std::string beautifyTitle(const std::string_view rawtitle, const TitleSettings& titleSettings);
 
@@ -98,6 +120,7 @@ class SliceTrendingTask : public PostProcessingInterface
   UInt_t mTime;
   std::unique_ptr<TTree> mTrend;
   std::map<std::string, TObject*> mPlots;
+  std::map<std::string, CachedPlot> mCachedPlots;
   std::unordered_map<std::string, std::unique_ptr<SliceReductor>> mReductors;
   std::unordered_map<std::string, std::vector<SliceInfo>*> mSources;
   std::unordered_map<std::string, int> mNumberPads;
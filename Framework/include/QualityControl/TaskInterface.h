@@ -88,6 +88,11 @@ class TaskInterface : public UserCodeInterface
 
   virtual void finaliseCCDB(framework::ConcreteDataMatcher& matcher, void* obj);
 
+  /// \brief Creates the copy of a published object which is sent while the original is already filled in the next cycle.
+  /// It is used only if "doubleBufferedCycles" is enabled. By default, the object is cloned.
+  /// Override it if the objects can be copied more efficiently or if only a part of their state should be published.
+  virtual TObject* copyForPublication(const TObject& object);
+
   /// \brief Called each time mCustomParameters is updated.
   virtual void configure() override;
 
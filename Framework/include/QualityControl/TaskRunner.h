@@ -28,6 +28,9 @@
 #include <Framework/ServiceRegistryRef.h>
 // QC
 #include "QualityControl/TaskRunnerConfig.h"
+#include "QualityControl/MonitorObjectSerializer.h"
+
+#include <future>
 
 namespace o2::configuration
 {
@@ -53,6 +56,7 @@ namespace o2::quality_control::core
 class Timekeeper;
 class TaskInterface;
 class ObjectsManager;
+class ThreadPool;
 
 /// \brief A class driving the execution of a QC task inside DPL.
 ///
@@ -135,6 +139,9 @@ class TaskRunner : public framework::Task
   void startCycle();
   void finishCycle(framework::DataAllocator& outputs);
   int publish(framework::DataAllocator& outputs);
+  void sendParts(framework::DataAllocator& outputs, const std::vector<MonitorObjectSerializer::Part>& parts);
+  /// \brief Sends the objects of the previous cycle if they are serialized, waits for them if requested
+  void sendPendingPublication(framework::DataAllocator& outputs, bool wait);
   void publishCycleStats();
   void saveToFile();
 
@@ -144,6 +151,9 @@ class TaskRunner : public framework::Task
   std::shared_ptr<TaskInterface> mTask;
   std::shared_ptr<ObjectsManager> mObjectsManager;
   std::shared_ptr<Timekeeper> mTimekeeper;
+  std::unique_ptr<MonitorObjectSerializer> mSerializer; // only if objects should be serialized in parallel
+  std::unique_ptr<ThreadPool> mPublicationThread;       // only with double-buffered cycles
+  std::future<std::vector<MonitorObjectSerializer::Part>> mPendingPublication;
   Activity mActivity;
 
   void updateMonitoringStats(framework::ProcessingContext& pCtx);
@@ -159,6 +169,12 @@ class TaskRunner : public framework::Task
   int mNumberObjectsPublishedInCycle = 0;
   int mTotalNumberObjectsPublished = 0; // over a run
   double mLastPublicationDuration = 0;
+  struct {
+    size_t objects = 0;
+    double totalMs = 0;
+    double maxMs = 0;
+    std::string slowestObject;
+  } mLastSerializationStats; // only with parallel serialization
   uint64_t mDataReceivedInCycle = 0;
   AliceO2::Common::Timer mTimerTotalDurationActivity;
   AliceO2::Common::Timer mTimerDurationCycle;
@@ -60,6 +60,9 @@ struct TaskRunnerConfig : public UserCodeConfig {
   std::shared_ptr<o2::globaltracking::DataRequest> globalTrackingDataRequest;
   std::vector<std::string> movingWindows;
   bool disableLastCycle = false;
+  bool publishOnlyModifiedObjects = false;
+  size_t publicationThreads = 0;
+  bool doubleBufferedCycles = false;
 };
 
 } // namespace o2::quality_control::core
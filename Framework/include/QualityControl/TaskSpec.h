@@ -77,6 +77,9 @@ struct TaskSpec {
   GlobalTrackingDataRequestSpec globalTrackingDataRequest;
   std::vector<std::string> movingWindows;
   bool disableLastCycle = false;
+  bool publishOnlyModifiedObjects = false;
+  size_t publicationThreads = 0;
+  bool doubleBufferedCycles = false;
 };
 
 } // namespace o2::quality_control::core
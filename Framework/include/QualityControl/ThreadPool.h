@@ -0,0 +1,71 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ThreadPool.h
+///
+
+#ifndef QC_CORE_THREADPOOL_H
+#define QC_CORE_THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace o2::quality_control::core
+{
+
+/// \brief A fixed-size pool of threads executing submitted tasks in FIFO order.
+///
+/// The results (or exceptions) of the tasks are obtained with the returned futures.
+/// The destructor waits until all the tasks which were already submitted are executed.
+class ThreadPool
+{
+ public:
+  explicit ThreadPool(size_t nThreads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  template <typename F>
+  auto submit(F&& function) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+  {
+    using ResultType = std::invoke_result_t<std::decay_t<F>>;
+    // std::function needs a copyable callable, thus the shared_ptr
+    auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(function));
+    auto future = task->get_future();
+    push([task]() { (*task)(); });
+    return future;
+  }
+
+  size_t size() const { return mThreads.size(); }
+
+ private:
+  void push(std::function<void()>&& task);
+  void workerLoop();
+
+  std::vector<std::thread> mThreads;
+  std::queue<std::function<void()>> mTasks;
+  std::mutex mMutex;
+  std::condition_variable mCondition;
+  bool mStopping = false;
+};
+
+} // namespace o2::quality_control::core
+
+#endif // QC_CORE_THREADPOOL_H
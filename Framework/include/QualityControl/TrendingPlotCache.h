@@ -0,0 +1,95 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TrendingPlotCache.h
+///
+
+#ifndef QUALITYCONTROL_TRENDINGPLOTCACHE_H
+#define QUALITYCONTROL_TRENDINGPLOTCACHE_H
+
+#include "QualityControl/TrendingTaskConfig.h"
+
+#include <Rtypes.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TGraph;
+class TGraphErrors;
+class TH1;
+class TObject;
+class TTree;
+class TTreeFormula;
+
+namespace o2::quality_control::postprocessing
+{
+
+/// \brief Keeps what is needed to update a trending plot with the new entries of the trend.
+///
+/// A plot is first drawn in full with TTree::Draw, then the graphs and histograms which were produced are registered
+/// in the cache together with the compiled formulas of their varexp, selection and errors. Afterwards, update()
+/// evaluates these formulas only for the entries added to the TTree in the meantime and appends them to the existing
+/// graphs and histograms, instead of drawing the whole history again.
+/// Graphs which TTree::Draw does not represent as a TGraph or a 1D histogram, as well as formulas with several values
+/// per entry, are not supported - such plots have to be redrawn in full.
+class TrendingPlotCache
+{
+ public:
+  TrendingPlotCache();
+  ~TrendingPlotCache();
+
+  TrendingPlotCache(const TrendingPlotCache&) = delete;
+  TrendingPlotCache& operator=(const TrendingPlotCache&) = delete;
+
+  /// \brief Clears the cache and marks all the current entries of the tree as drawn.
+  void start(TTree* tree);
+  /// \brief Registers a graph which was just drawn with TTree::Draw.
+  /// \param drawn the TGraph or the 1D histogram produced by TTree::Draw, nullptr if there is none
+  /// \param graphErrors the error bars drawn on top of the graph, nullptr if there are none
+  /// \return false if the graph cannot be updated incrementally, the cache becomes invalid then.
+  bool addGraph(const TrendingTaskConfig::Graph& graphConfig, TObject* drawn, TGraphErrors* graphErrors);
+  /// \brief Sets the histogram which draws the axes. Its ranges follow the first graph of the plot.
+  void setBackground(TH1* background);
+  TH1* getBackground() const { return mBackground; }
+
+  /// \brief Appends the entries of the tree which were not drawn yet.
+  /// \return false if the plot should be redrawn in full instead, e.g. the tree was reset or replaced.
+  bool update(TTree* tree);
+  bool isValid() const { return mValid; }
+  void reset();
+
+  /// \brief Splits a TTree::Draw varexp into its dimensions, ignoring the scope resolution operator '::'.
+  static std::vector<std::string> splitVarexp(const std::string& varexp);
+
+ private:
+  struct CachedGraph {
+    std::vector<std::unique_ptr<TTreeFormula>> formulas; // varexp, followed by errors if any
+    std::unique_ptr<TTreeFormula> selection;
+    TGraph* graph = nullptr;
+    TH1* histogram = nullptr;
+    TGraphErrors* graphErrors = nullptr;
+  };
+
+  std::unique_ptr<TTreeFormula> compile(const std::string& name, const std::string& expression);
+  static void appendEntry(CachedGraph& cachedGraph);
+
+  TTree* mTree = nullptr;
+  Long64_t mEntries = 0;
+  bool mValid = false;
+  std::vector<CachedGraph> mGraphs;
+  TH1* mBackground = nullptr;
+  TGraph* mBackgroundGraph = nullptr;
+};
+
+} // namespace o2::quality_control::postprocessing
+
+#endif // QUALITYCONTROL_TRENDINGPLOTCACHE_H
@@ -20,7 +20,9 @@
 #include "QualityControl/PostProcessingInterface.h"
 #include "QualityControl/Reductor.h"
 #include "QualityControl/TrendingTaskConfig.h"
+#include "QualityControl/TrendingPlotCache.h"
 
+#include <map>
 #include <memory>
 #include <unordered_map>
 #include <TTree.h>
@@ -53,9 +55,14 @@ class TrendingTask : public PostProcessingInterface
   void configure(const boost::property_tree::ptree& config) override;
   void initialize(Trigger, framework::ServiceRegistryRef) override;
   void update(Trigger, framework::ServiceRegistryRef) override;
+  /// Retrieves the objects of the data sources and reduces them with separate Reductors, conditions are left to finishUpdate.
+  std::unique_ptr<PreparedUpdate> prepareUpdate(Trigger, framework::ServiceRegistryRef) override;
+  void finishUpdate(Trigger, framework::ServiceRegistryRef, std::unique_ptr<PreparedUpdate>) override;
   void finalize(Trigger, framework::ServiceRegistryRef) override;
 
  private:
+  struct PreparedValues;
+
   struct {
     Long64_t runNumber = 0;
     static const char* getBranchLeafList()
@@ -69,11 +76,14 @@ class TrendingTask : public PostProcessingInterface
   static void formatTimeXAxis(TH1* background);
   static void formatRunNumberXAxis(TH1* background);
   static std::string deduceGraphLegendOptions(const TrendingTaskConfig::Graph& graphConfig);
+  static void setColorPalette(int colorPalette);
 
   /// returns true only if all datasources were available to update reductor
-  bool trendValues(const Trigger& t, repository::DatabaseInterface&);
+  /// if prepared is not nullptr, the reduced values of the prepared sources are taken from there
+  bool trendValues(const Trigger& t, repository::DatabaseInterface&, PreparedValues* prepared = nullptr);
   void generatePlots();
-  TCanvas* drawPlot(const TrendingTaskConfig::Plot& plotConfig);
+  TCanvas* drawPlot(const TrendingTaskConfig::Plot& plotConfig, TrendingPlotCache& plotCache);
+  void updatePlot(const TrendingTaskConfig::Plot& plotConfig, const TrendingPlotCache& plotCache, TCanvas* canvas);
   void initializeTrend(repository::DatabaseInterface& qcdb);
   bool canContinueTrend(TTree* tree);
 
@@ -81,6 +91,7 @@ class TrendingTask : public PostProcessingInterface
   UInt_t mTime;
   std::unique_ptr<TTree> mTrend;
   std::map<std::string, std::unique_ptr<TObject>> mPlots;
+  std::map<std::string, TrendingPlotCache> mPlotCaches; // declared after the tree and the plots they refer to
   std::unordered_map<std::string, std::unique_ptr<Reductor>> mReductors;
 };
 
@@ -18,9 +18,8 @@
 #define QC_CHECKER_POLICYMANAGER_H
 
 #include <string>
-#include <map>
+#include <unordered_map>
 #include <vector>
-#include <functional>
 #include <iosfwd>
 #include <cstdint>
 
@@ -29,21 +28,25 @@
 namespace o2::quality_control::checker
 {
 
-using IsReadyFunctionType = std::function<bool()>;
 typedef uint32_t RevisionType;
+typedef uint32_t ObjectIdType;
 
 /**
  * Represents a policy and all its associated elements.
  */
 struct UpdatePolicy {
   std::string actorName;
-  IsReadyFunctionType isReady;
+  UpdatePolicyType type;
   std::vector<std::string> inputObjects;
   bool allInputObjects;
-  // TODO this line makes me think that lambdas are not enough because we actually need to store a state...
   bool policyHelperFlag; // the purpose might change depending on policy,
   RevisionType revision = 0;
 
+  // Bookkeeping which allows to tell whether the actor is ready without looking at its input objects.
+  std::vector<ObjectIdType> inputIds; // ids of the distinct input objects
+  size_t updatedInputs = 0;           // number of inputs whose revision is higher than the actor's revision
+  size_t receivedInputs = 0;          // number of inputs received at least once
+
   friend std::ostream& operator<<(std::ostream& out, const UpdatePolicy& updatePolicy); // output
 };
 
@@ -68,6 +71,10 @@ struct UpdatePolicy {
  *   - onEachSeparately: synonym of 'onAny'.
  * If "all" is specified as list of object, or the list is empty, we always trigger.
  *
+ * Object names are interned to integer ids and each policy keeps track of how many of its inputs were updated
+ * since the actor was last triggered. This counter is maintained when object and actor revisions change,
+ * so that isReady() does not have to look at the input objects.
+ *
  * A typical caller code looks like this:
  * \code{.cpp}
  *  // when initializing
@@ -137,9 +144,22 @@ class UpdatePolicyManager
   bool isReady(const std::string& actorName);
 
  private:
-  std::map<std::string /* Actor name */, UpdatePolicy> mPoliciesByActor;
+  struct ObjectState {
+    RevisionType revision = 0;
+    bool received = false;
+    std::vector<size_t> policies; // indices of the policies having this object as input
+  };
+
+  ObjectIdType internObject(const std::string& objectName);
+  UpdatePolicy& getPolicy(const std::string& actorName, const char* operation);
+  void setActorRevision(UpdatePolicy& policy, RevisionType revision);
+
+  std::vector<UpdatePolicy> mPolicies;
+  std::unordered_map<std::string /* Actor name */, size_t> mPolicyIndices;
+  std::vector<ObjectState> mObjects;
+  std::unordered_map<std::string /* Object name */, ObjectIdType> mObjectIds;
   RevisionType mGlobalRevision = 1;
-  std::map<std::string /* Object name */, RevisionType> mObjectsRevision;
+  RevisionType mMaxObjectRevision = 0;
 };
 
 } // namespace o2::quality_control::checker
@@ -32,6 +32,7 @@
 
 // QC
 #include "QualityControl/DatabaseFactory.h"
+#include "QualityControl/DatabaseUploader.h"
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/ServiceDiscovery.h"
 #include "QualityControl/Aggregator.h"
@@ -73,6 +74,7 @@ AggregatorRunner::AggregatorRunner(AggregatorRunnerConfig arc, const std::vector
 AggregatorRunner::~AggregatorRunner()
 {
   ILOG(Debug, Trace) << "AggregatorRunner destructor (" << this << ")" << ENDM;
+  mUploader.reset(); // uploads the remaining objects before we go
   if (mServiceDiscovery != nullptr) {
     mServiceDiscovery->deregister();
   }
@@ -173,27 +175,38 @@ AggregatorRunner::QualityObjectsWithAggregatorNameVector AggregatorRunner::aggre
 {
   ILOG(Debug, Trace) << "Aggregate called in AggregatorRunner, QOs in cache: " << mQualityObjects.size() << ENDM;
 
+  auto allQOs = runAggregators(mAggregators, mUpdatePolicyManager, mQualityObjects, *mActivity);
+  for (const auto& [aggregatorName, newQOs] : allQOs) {
+    mTotalNumberObjectsProduced += newQOs.size();
+    mTotalNumberAggregatorExecuted++;
+  }
+  return allQOs;
+}
+
+AggregatorRunner::QualityObjectsWithAggregatorNameVector AggregatorRunner::runAggregators(const std::vector<std::shared_ptr<Aggregator>>& aggregators,
+                                                                                          UpdatePolicyManager& updatePolicyManager,
+                                                                                          QualityObjectsMapType& qualityObjects,
+                                                                                          const Activity& activity)
+{
   QualityObjectsWithAggregatorNameVector allQOs;
-  for (auto const& aggregator : mAggregators) {
+  for (auto const& aggregator : aggregators) {
     string aggregatorName = aggregator->getName();
     ILOG(Info, Devel) << "Processing aggregator: " << aggregatorName << ENDM;
 
-    if (mUpdatePolicyManager.isReady(aggregatorName)) {
+    if (updatePolicyManager.isReady(aggregatorName)) {
       ILOG(Info, Devel) << "   Quality Objects for the aggregator '" << aggregatorName << "' are  ready, aggregating" << ENDM;
-      auto newQOs = aggregator->aggregate(mQualityObjects, *mActivity); // we give the whole list
-      mTotalNumberObjectsProduced += newQOs.size();
-      mTotalNumberAggregatorExecuted++;
+      auto newQOs = aggregator->aggregate(qualityObjects, activity); // we give the whole list
       // we consider the output of the aggregators the same way we do the output of a check
       for (const auto& qo : newQOs) {
-        mQualityObjects[qo->getName()] = qo;
-        mUpdatePolicyManager.updateObjectRevision(qo->getName());
+        qualityObjects[qo->getName()] = qo;
+        updatePolicyManager.updateObjectRevision(qo->getName());
       }
 
       allQOs.emplace_back(aggregatorName, newQOs);
 
       newQOs.clear();
 
-      mUpdatePolicyManager.updateActorRevision(aggregatorName); // Was aggregated, update latest revision
+      updatePolicyManager.updateActorRevision(aggregatorName); // Was aggregated, update latest revision
     } else {
       ILOG(Info, Devel) << "   Quality Objects for the aggregator '" << aggregatorName << "' are not ready, ignoring" << ENDM;
     }
@@ -213,7 +226,11 @@ void AggregatorRunner::store(QualityObjectsWithAggregatorNameVector& qualityObje
   try {
     for (const auto& [_, qualityObjects] : qualityObjectsWithAggregatorNames) {
       for (const auto& qo : qualityObjects) {
-        mDatabase->storeQO(qo);
+        if (mUploader) {
+          mUploader->enqueue(qo);
+        } else {
+          mDatabase->storeQO(qo);
+        }
       }
     }
 
@@ -242,6 +259,11 @@ void AggregatorRunner::initDatabase()
   mDatabase = DatabaseFactory::create(mRunnerConfig.database.at("implementation"));
   mDatabase->connect(mRunnerConfig.database);
   ILOG(Info, Devel) << "Database that is going to be used > Implementation : " << mRunnerConfig.database.at("implementation") << " / Host : " << mRunnerConfig.database.at("host") << ENDM;
+
+  auto uploaderConfig = DatabaseUploaderConfig::fromDatabaseConfig(mRunnerConfig.database);
+  if (uploaderConfig.enabled) {
+    mUploader = std::make_unique<DatabaseUploader>(DatabaseUploader::backendFactoryFor(mRunnerConfig.database), uploaderConfig);
+  }
 }
 
 void AggregatorRunner::initMonitoring()
@@ -380,6 +402,17 @@ void AggregatorRunner::sendPeriodicMonitoring()
     mCollector->send({ mTotalNumberAggregatorExecuted, "qc_aggregator_executed" });
     mCollector->send({ mTotalNumberObjectsProduced, "qc_aggregator_objects_produced" });
     mCollector->send({ mTimerTotalDurationActivity.getTime(), "qc_aggregator_duration" });
+    if (mUploader) {
+      auto stats = mUploader->collectStats();
+      mCollector->send(Metric{ "qc_aggregator_upload" }
+                         .addValue(stats.queueDepth, "queue_depth")
+                         .addValue(stats.stored, "stored")
+                         .addValue(stats.coalesced, "coalesced")
+                         .addValue(stats.dropped, "dropped")
+                         .addValue(stats.failed, "failed")
+                         .addValue(stats.meanLatencyMs, "mean_latency_ms")
+                         .addValue(stats.maxLatencyMs, "max_latency_ms"));
+    }
   }
 }
 
@@ -408,6 +441,9 @@ void AggregatorRunner::start(ServiceRegistryRef services)
 void AggregatorRunner::stop()
 {
   ILOG(Info, Support) << "Stopping run " << mActivity->mId << ENDM;
+  if (mUploader) {
+    mUploader->flush();
+  }
   for (auto& aggregator : mAggregators) {
     aggregator->endOfActivity(*mActivity);
   }
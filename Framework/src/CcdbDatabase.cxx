@@ -21,6 +21,8 @@
 #include "QualityControl/RepoPathUtils.h"
 #include "QualityControl/ActivityHelpers.h"
 #include "QualityControl/ObjectMetadataKeys.h"
+#include "QualityControl/DatabaseCache.h"
+#include "QualityControl/ThreadPool.h"
 
 // O2
 #include <Common/Exceptions.h>
@@ -35,6 +37,7 @@
 #include <TKey.h>
 // std
 #include <chrono>
+#include <future>
 #include <sstream>
 #include <filesystem>
 // boost
@@ -77,12 +80,42 @@ void CcdbDatabase::connect(const std::unordered_map<std::string, std::string>& c
   if (config.count("maxObjectSize")) {
     mMaxObjectSize = std::stoi(config.at("maxObjectSize"));
   }
+  if (config.count("retrievalThreads")) {
+    mRetrievalThreads = std::stoul(config.at("retrievalThreads"));
+  }
+  auto cacheConfig = DatabaseCacheConfig::fromDatabaseConfig(config);
+  if (cacheConfig.enabled) {
+    mCache = std::make_unique<DatabaseCache>(cacheConfig);
+    ILOG(Info, Devel) << "Objects retrieved from the database will be cached in memory (max " << cacheConfig.maxBytes / (1024 * 1024) << " MB)" << ENDM;
+  }
+}
+
+const DatabaseCache* CcdbDatabase::getCache() const
+{
+  return mCache.get();
 }
 
 void CcdbDatabase::init()
 {
-  ccdbApi->init(mUrl);
-  ccdbApi->setCurlRetriesParameters(5);
+  initApi(*ccdbApi);
+}
+
+void CcdbDatabase::initApi(o2::ccdb::CcdbApi& api) const
+{
+  api.init(mUrl);
+  api.setCurlRetriesParameters(5);
+}
+
+namespace
+{
+// CcdbApi is not meant to be used by several threads at once, thus each retrieval thread has its own
+thread_local std::unique_ptr<o2::ccdb::CcdbApi> tRetrievalApi;
+} // namespace
+
+o2::ccdb::CcdbApi& CcdbDatabase::getApi()
+{
+  // the retrieval threads belong to one CcdbDatabase, so their CcdbApi always points to the right server
+  return tRetrievalApi != nullptr ? *tRetrievalApi : *ccdbApi;
 }
 
 void CcdbDatabase::handleStorageError(const string& path, int result)
@@ -273,14 +306,21 @@ void CcdbDatabase::storeQO(std::shared_ptr<const o2::quality_control::core::Qual
 TObject* CcdbDatabase::retrieveTObject(std::string path, std::map<std::string, std::string> const& metadata, long timestamp, std::map<std::string, std::string>* headers)
 {
   if (timestamp == Timestamp::Latest) {
-    auto latestValidity = getLatestObjectValidity(path, metadata);
-    if (latestValidity.isInvalid()) {
+    auto latestVersion = getLatestObjectVersion(path, metadata);
+    if (latestVersion.validity.isInvalid()) {
       return nullptr;
     }
-    timestamp = latestValidity.getMin();
+    timestamp = latestVersion.validity.getMin();
+    if (mCache) {
+      // the listing already told us which object is the latest, we do not have to ask again if we have it
+      return retrieveCachedTObject(path, metadata, timestamp, headers, latestVersion);
+    }
+  } else if (mCache) {
+    // another object might have been stored for this timestamp meanwhile, thus we have to revalidate
+    return retrieveCachedTObject(path, metadata, timestamp, headers, std::nullopt);
   }
   // we try first to load a TFile
-  auto* object = ccdbApi->retrieveFromTFileAny<TObject>(path, metadata, timestamp, headers);
+  auto* object = getApi().retrieveFromTFileAny<TObject>(path, metadata, timestamp, headers);
   if (object == nullptr) {
     ILOG(Warning, Support) << "We could NOT retrieve the object " << path << " with timestamp " << timestamp << "." << ENDM;
     return nullptr;
@@ -289,6 +329,90 @@ TObject* CcdbDatabase::retrieveTObject(std::string path, std::map<std::string, s
   return object;
 }
 
+TObject* CcdbDatabase::retrieveCachedTObject(const std::string& path, const std::map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers, std::optional<DatabaseCache::Version> latestVersion)
+{
+  auto key = DatabaseCache::makeKey(path, metadata);
+  // the versions are cached by their validity, so any timestamp within it finds the same version,
+  // while the latest version has to match the ID given by the listing, in case it was stored again with the same validity
+  auto entry = latestVersion.has_value() ? mCache->find(key, latestVersion.value()) : mCache->findValidAt(key, timestamp);
+  std::map<std::string, std::string> responseHeaders;
+  TObject* object = nullptr;
+  if (entry != nullptr && latestVersion.has_value()) {
+    mCache->markHit();
+  } else if (entry != nullptr) {
+    auto etag = entry->headers.count("ETag") ? entry->headers.at("ETag") : "";
+    // with a matching etag the server answers with "304 Not Modified" and no object is returned
+    object = getApi().retrieveFromTFileAny<TObject>(path, metadata, timestamp, &responseHeaders, etag);
+    if (object == nullptr && !etag.empty() && responseHeaders.count("ETag") > 0 && responseHeaders.at("ETag") == etag) {
+      mCache->markRevalidated();
+    } else {
+      entry = nullptr;
+    }
+  } else {
+    object = getApi().retrieveFromTFileAny<TObject>(path, metadata, timestamp, &responseHeaders);
+  }
+
+  if (entry == nullptr) {
+    mCache->markMissed();
+    if (object == nullptr) {
+      ILOG(Warning, Support) << "We could NOT retrieve the object " << path << " with timestamp " << timestamp << "." << ENDM;
+      if (headers != nullptr) {
+        *headers = std::move(responseHeaders);
+      }
+      return nullptr;
+    }
+    auto validity = getValidity(responseHeaders);
+    if (!validity.has_value() && latestVersion.has_value()) {
+      validity = latestVersion->validity;
+    }
+    if (!validity.has_value()) {
+      // we cannot know which timestamps the object is valid for, so we do not cache it
+      ILOG(Debug, Support) << "Retrieved object " << path << " with timestamp " << timestamp << " without its validity, it is not cached" << ENDM;
+      if (headers != nullptr) {
+        *headers = std::move(responseHeaders);
+      }
+      return object;
+    }
+    // the entry is found later with the ID of the listing, which is the one in the ETag for the CCDB
+    auto id = latestVersion.has_value() ? latestVersion->id : getVersionId(responseHeaders);
+    entry = mCache->insert(key, { validity.value(), std::move(id) }, object, std::move(responseHeaders));
+  }
+  ILOG(Debug, Support) << "Retrieved object " << path << " with timestamp " << timestamp << ENDM;
+  if (headers != nullptr) {
+    *headers = entry->headers;
+  }
+  // the callers own what they receive, so they get a copy
+  return DatabaseCache::copy(*entry->object);
+}
+
+std::optional<core::ValidityInterval> CcdbDatabase::getValidity(const std::map<std::string, std::string>& headers)
+{
+  auto validFrom = headers.find(metadata_keys::validFrom);
+  auto validUntil = headers.find(metadata_keys::validUntil);
+  if (validFrom == headers.end() || validUntil == headers.end()) {
+    return std::nullopt;
+  }
+  try {
+    return core::ValidityInterval{ std::stoull(validFrom->second), std::stoull(validUntil->second) };
+  } catch (...) {
+    return std::nullopt;
+  }
+}
+
+std::string CcdbDatabase::getVersionId(const std::map<std::string, std::string>& headers)
+{
+  auto etag = headers.find("ETag");
+  if (etag == headers.end()) {
+    return {};
+  }
+  // the ETag is the quoted object ID
+  std::string id = etag->second;
+  if (id.size() >= 2 && id.front() == '"' && id.back() == '"') {
+    id = id.substr(1, id.size() - 2);
+  }
+  return id;
+}
+
 void* CcdbDatabase::retrieveAny(const type_info& tinfo, const string& path, const map<std::string, std::string>& metadata, long timestamp, std::map<std::string, std::string>* headers, const string& createdNotAfter, const string& createdNotBefore)
 {
   if (timestamp == Timestamp::Latest) {
@@ -298,7 +422,7 @@ void* CcdbDatabase::retrieveAny(const type_info& tinfo, const string& path, cons
     }
     timestamp = latestValidity.getMin();
   }
-  auto* object = ccdbApi->retrieveFromTFile(tinfo, path, metadata, timestamp, headers, "", createdNotAfter, createdNotBefore);
+  auto* object = getApi().retrieveFromTFile(tinfo, path, metadata, timestamp, headers, "", createdNotAfter, createdNotBefore);
   if (object == nullptr) {
     ILOG(Warning, Support) << "We could NOT retrieve the object " << path << " with timestamp " << timestamp << "." << ENDM;
     return nullptr;
@@ -307,6 +431,45 @@ void* CcdbDatabase::retrieveAny(const type_info& tinfo, const string& path, cons
   return object;
 }
 
+std::vector<DatabaseInterface::RetrievalResult> CcdbDatabase::retrieveMany(const std::vector<RetrievalRequest>& requests)
+{
+  if (mRetrievalThreads <= 1 || requests.size() <= 1) {
+    return DatabaseInterface::retrieveMany(requests);
+  }
+  if (mRetrievalPool == nullptr) {
+    // the objects are deserialized in the retrieval threads
+    ROOT::EnableThreadSafety();
+    mRetrievalPool = std::make_unique<ThreadPool>(mRetrievalThreads);
+  }
+
+  std::vector<std::future<RetrievalResult>> futures;
+  futures.reserve(requests.size());
+  for (const auto& request : requests) {
+    futures.push_back(mRetrievalPool->submit([this, &request]() {
+      if (tRetrievalApi == nullptr) {
+        tRetrievalApi = std::make_unique<o2::ccdb::CcdbApi>();
+        initApi(*tRetrievalApi);
+      }
+      return retrieve(request);
+    }));
+  }
+  // we wait for all the requests, even if one of them fails, because they refer to the argument
+  std::exception_ptr error;
+  std::vector<RetrievalResult> results;
+  results.reserve(futures.size());
+  for (auto& future : futures) {
+    try {
+      results.push_back(future.get());
+    } catch (...) {
+      error = error ? error : std::current_exception();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return results;
+}
+
 std::shared_ptr<o2::quality_control::core::MonitorObject> CcdbDatabase::retrieveMO(std::string objectPath, std::string objectName, long timestamp, const core::Activity& activity)
 {
   string fullPath = activity.mProvenance + "/" + objectPath + "/" + objectName;
@@ -433,9 +596,9 @@ void CcdbDatabase::prepareTaskDataContainer(std::string /*taskName*/)
   // NOOP for CCDB
 }
 
-std::string CcdbDatabase::getListingAsString(const std::string& subpath, const std::string& accept, bool latestOnly)
+std::string CcdbDatabase::getListingAsString(const std::string& subpath, const std::string& accept, bool latestOnly, long createdNotBefore)
 {
-  return ccdbApi->list(subpath, latestOnly, accept);
+  return getApi().list(subpath, latestOnly, accept, -1, createdNotBefore);
 }
 
 /// trim from start (in place)
@@ -473,7 +636,7 @@ std::vector<std::string> CcdbDatabase::getListing(const std::string& subpath)
   return result;
 }
 
-boost::property_tree::ptree CcdbDatabase::getListingAsPtree(const std::string& path, const std::map<std::string, std::string>& metadata, bool latestOnly)
+std::string CcdbDatabase::getListingAsJson(const std::string& path, const std::map<std::string, std::string>& metadata, bool latestOnly, long createdNotBefore)
 {
   // CCDB accepts metadata filters as slash-separated key=value pairs at the end of the object path
   std::stringstream pathWithMetadata;
@@ -481,8 +644,12 @@ boost::property_tree::ptree CcdbDatabase::getListingAsPtree(const std::string& p
   for (const auto& [key, value] : metadata) {
     pathWithMetadata << '/' << key << '=' << value;
   }
+  return getListingAsString(pathWithMetadata.str(), "application/json", latestOnly, createdNotBefore);
+}
 
-  std::stringstream listingAsStringStream{ getListingAsString(pathWithMetadata.str(), "application/json", latestOnly) };
+boost::property_tree::ptree CcdbDatabase::getListingAsPtree(const std::string& path, const std::map<std::string, std::string>& metadata, bool latestOnly)
+{
+  std::stringstream listingAsStringStream{ getListingAsJson(path, metadata, latestOnly) };
 
   boost::property_tree::ptree listingAsTree;
   try {
@@ -495,21 +662,41 @@ boost::property_tree::ptree CcdbDatabase::getListingAsPtree(const std::string& p
 }
 
 core::ValidityInterval CcdbDatabase::getLatestObjectValidity(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  return getLatestObjectVersion(path, metadata).validity;
+}
+
+DatabaseCache::Version CcdbDatabase::getLatestObjectVersion(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  if (mCache) {
+    auto key = DatabaseCache::makeKey(path, metadata, "listing");
+    if (auto version = mCache->findListing(key); version.has_value()) {
+      return version.value();
+    }
+    auto version = getLatestObjectVersionFromListing(path, metadata);
+    mCache->insertListing(key, version);
+    return version;
+  }
+  return getLatestObjectVersionFromListing(path, metadata);
+}
+
+DatabaseCache::Version CcdbDatabase::getLatestObjectVersionFromListing(const std::string& path, const std::map<std::string, std::string>& metadata)
 {
   auto listing = getListingAsPtree(path, metadata, true);
   if (listing.count("objects") == 0) {
     ILOG(Warning, Support) << "Could not get a valid listing from db '" << mUrl << "' for latestObjectMetadata '" << path << "'" << ENDM;
-    return gInvalidValidityInterval;
+    return { gInvalidValidityInterval, "" };
   }
   const auto& objects = listing.get_child("objects");
   if (objects.empty()) {
-    return gInvalidValidityInterval;
+    return { gInvalidValidityInterval, "" };
   } else if (objects.size() > 1) {
     ILOG(Warning, Support) << "Expected just one metadata entry for object '" << path << "'. Trying to continue by using the first." << ENDM;
   }
   const auto& latestObjectMetadata = objects.front().second;
 
-  return { latestObjectMetadata.get<uint64_t>(metadata_keys::validFrom), latestObjectMetadata.get<uint64_t>(metadata_keys::validUntil) };
+  return { { latestObjectMetadata.get<uint64_t>(metadata_keys::validFrom), latestObjectMetadata.get<uint64_t>(metadata_keys::validUntil) },
+           latestObjectMetadata.get<std::string>("id", "") };
 }
 
 std::vector<uint64_t> CcdbDatabase::getTimestampsForObject(const std::string& path)
@@ -0,0 +1,659 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   CcdbStandIn.cxx
+///
+
+#include "QualityControl/CcdbStandIn.h"
+#include "QualityControl/ObjectMetadataKeys.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <optional>
+#include <regex>
+#include <sstream>
+
+namespace asio = boost::asio;
+using asio::ip::tcp;
+
+namespace o2::quality_control::repository
+{
+
+struct CcdbStandIn::Version {
+  std::string id;
+  std::string path;
+  uint64_t validFrom = 0;
+  uint64_t validUntil = 0;
+  uint64_t created = 0;
+  std::map<std::string, std::string> metadata;
+  std::string fileName;
+  std::string contentType;
+  std::string data;
+};
+
+struct CcdbStandIn::Connection {
+  explicit Connection(asio::io_context& context) : socket(context) {}
+  tcp::socket socket;
+  std::atomic<bool> finished = false;
+};
+
+struct CcdbStandIn::Impl {
+  asio::io_context context;
+  tcp::acceptor acceptor{ context };
+};
+
+namespace
+{
+
+uint64_t msSinceEpoch()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/// Parses the whole text as an unsigned number, without throwing, since the requests come from the outside.
+std::optional<uint64_t> toUnsigned(std::string_view text, int base = 10)
+{
+  uint64_t value = 0;
+  auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value, base);
+  if (text.empty() || error != std::errc{} || end != text.data() + text.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::string decode(const std::string& encoded)
+{
+  std::string decoded;
+  decoded.reserve(encoded.size());
+  for (size_t i = 0; i < encoded.size(); i++) {
+    std::optional<uint64_t> code;
+    if (encoded[i] == '%' && i + 2 < encoded.size()) {
+      code = toUnsigned(std::string_view(encoded).substr(i + 1, 2), 16);
+    }
+    if (code.has_value()) {
+      decoded += static_cast<char>(code.value());
+      i += 2;
+    } else if (encoded[i] == '+') {
+      decoded += ' ';
+    } else {
+      decoded += encoded[i];
+    }
+  }
+  return decoded;
+}
+
+bool isNumber(const std::string& segment)
+{
+  return toUnsigned(segment).has_value();
+}
+
+/// The CCDB paths are made of the object path, followed by the numbers (e.g. timestamps) and the metadata filters.
+struct ParsedPath {
+  std::string path;
+  std::vector<uint64_t> numbers;
+  std::map<std::string, std::string> metadata;
+};
+
+ParsedPath parsePath(const std::string& target, size_t maxNumbers)
+{
+  std::vector<std::string> segments;
+  boost::split(segments, target, boost::is_any_of("/"));
+  std::erase_if(segments, [](const std::string& segment) { return segment.empty(); });
+
+  ParsedPath parsed;
+  while (!segments.empty() && segments.back().find('=') != std::string::npos) {
+    auto separator = segments.back().find('=');
+    parsed.metadata[decode(segments.back().substr(0, separator))] = decode(segments.back().substr(separator + 1));
+    segments.pop_back();
+  }
+  auto firstNumber = segments.size();
+  while (firstNumber > 1 && segments.size() - firstNumber < maxNumbers && isNumber(segments[firstNumber - 1])) {
+    firstNumber--;
+  }
+  for (size_t i = firstNumber; i < segments.size(); i++) {
+    parsed.numbers.push_back(toUnsigned(segments[i]).value());
+  }
+  segments.resize(firstNumber);
+  for (auto& segment : segments) {
+    parsed.path += (parsed.path.empty() ? "" : "/") + decode(segment);
+  }
+  return parsed;
+}
+
+/// Matches the object paths in the same way as the CCDB listings: the requested path might be a regular expression
+/// and it matches also the objects in the subfolders.
+class PathMatcher
+{
+ public:
+  explicit PathMatcher(const std::string& pattern) : mPattern(pattern)
+  {
+    try {
+      mRegex = std::regex(pattern);
+    } catch (const std::regex_error&) {
+    }
+  }
+
+  bool matches(const std::string& path) const
+  {
+    if (mPattern.empty() || path == mPattern || path.starts_with(mPattern + "/")) {
+      return true;
+    }
+    return mRegex.has_value() && std::regex_match(path, *mRegex);
+  }
+
+ private:
+  std::string mPattern;
+  std::optional<std::regex> mRegex;
+};
+
+const char* reasonPhrase(int status)
+{
+  switch (status) {
+    case 100:
+      return "Continue";
+    case 200:
+      return "OK";
+    case 201:
+      return "Created";
+    case 304:
+      return "Not Modified";
+    case 400:
+      return "Bad Request";
+    case 404:
+      return "Not Found";
+    case 405:
+      return "Method Not Allowed";
+    default:
+      return "Unknown";
+  }
+}
+
+/// Returns the content of the first file in a multipart/form-data body, or the whole body if it is not multipart.
+std::string extractFile(const std::string& contentType, const std::string& body, std::string& fileName, std::string& fileType)
+{
+  auto boundaryPos = contentType.find("boundary=");
+  if (contentType.find("multipart/form-data") == std::string::npos || boundaryPos == std::string::npos) {
+    return body;
+  }
+  auto boundary = "--" + boost::trim_copy_if(contentType.substr(boundaryPos + 9), boost::is_any_of("\" "));
+  auto partStart = body.find(boundary);
+  while (partStart != std::string::npos) {
+    auto headersEnd = body.find("\r\n\r\n", partStart);
+    auto partEnd = headersEnd == std::string::npos ? std::string::npos : body.find("\r\n" + boundary, headersEnd);
+    if (partEnd == std::string::npos) {
+      break;
+    }
+    std::string headers = body.substr(partStart, headersEnd - partStart);
+    if (auto fileNamePos = headers.find("filename=\""); fileNamePos != std::string::npos) {
+      fileName = headers.substr(fileNamePos + 10, headers.find('"', fileNamePos + 10) - fileNamePos - 10);
+      std::string lowerHeaders = boost::to_lower_copy(headers);
+      if (auto typePos = lowerHeaders.find("content-type:"); typePos != std::string::npos) {
+        fileType = boost::trim_copy(headers.substr(typePos + 13, headers.find("\r\n", typePos) - typePos - 13));
+      }
+      return body.substr(headersEnd + 4, partEnd - headersEnd - 4);
+    }
+    partStart = body.find(boundary, partEnd + 2);
+  }
+  return body;
+}
+
+} // namespace
+
+CcdbStandIn::CcdbStandIn(uint16_t port) : mImpl(std::make_unique<Impl>())
+{
+  tcp::endpoint endpoint(asio::ip::make_address("127.0.0.1"), port);
+  mImpl->acceptor.open(endpoint.protocol());
+  mImpl->acceptor.set_option(tcp::acceptor::reuse_address(true));
+  mImpl->acceptor.bind(endpoint);
+  mImpl->acceptor.listen();
+  mPort = mImpl->acceptor.local_endpoint().port();
+  mAcceptThread = std::thread([this]() { accept(); });
+  ILOG(Debug, Devel) << "CCDB stand-in listening at " << getUrl() << ENDM;
+}
+
+CcdbStandIn::~CcdbStandIn()
+{
+  stop();
+}
+
+std::string CcdbStandIn::getUrl() const
+{
+  return "http://127.0.0.1:" + std::to_string(getPort());
+}
+
+uint16_t CcdbStandIn::getPort() const
+{
+  return mPort;
+}
+
+size_t CcdbStandIn::getNumberOfObjects() const
+{
+  std::shared_lock lock(mStorageMutex);
+  return mObjectsById.size();
+}
+
+uint64_t CcdbStandIn::getNumberOfRequests() const
+{
+  return mRequests;
+}
+
+void CcdbStandIn::stop()
+{
+  if (!mRunning.exchange(false)) {
+    return;
+  }
+  // a connection wakes up the blocking accept, so that it can notice we are stopping
+  try {
+    tcp::socket wakeUp(mImpl->context);
+    wakeUp.connect(tcp::endpoint(asio::ip::make_address("127.0.0.1"), mPort));
+  } catch (...) {
+  }
+  mAcceptThread.join();
+  boost::system::error_code ec;
+  mImpl->acceptor.close(ec);
+
+  std::lock_guard<std::mutex> lock(mConnectionsMutex);
+  for (auto& [connection, thread] : mConnections) {
+    connection->socket.shutdown(tcp::socket::shutdown_both, ec);
+    thread.join();
+  }
+  mConnections.clear();
+}
+
+void CcdbStandIn::accept()
+{
+  while (mRunning) {
+    auto connection = std::make_shared<Connection>(mImpl->context);
+    boost::system::error_code ec;
+    mImpl->acceptor.accept(connection->socket, ec);
+    if (!mRunning || ec) {
+      break;
+    }
+    connection->socket.set_option(tcp::no_delay(true), ec);
+
+    std::lock_guard<std::mutex> lock(mConnectionsMutex);
+    std::erase_if(mConnections, [](auto& entry) {
+      if (entry.first->finished) {
+        entry.second.join();
+        return true;
+      }
+      return false;
+    });
+    mConnections.emplace_back(connection, std::thread([this, connection]() { serve(connection); }));
+  }
+}
+
+void CcdbStandIn::serve(std::shared_ptr<Connection> connection)
+{
+  auto& socket = connection->socket;
+  asio::streambuf buffer;
+  boost::system::error_code ec;
+
+  auto readExactly = [&](size_t size) -> std::string {
+    if (buffer.size() < size) {
+      asio::read(socket, buffer, asio::transfer_exactly(size - buffer.size()), ec);
+    }
+    if (ec) {
+      return {};
+    }
+    std::string data(asio::buffers_begin(buffer.data()), asio::buffers_begin(buffer.data()) + size);
+    buffer.consume(size);
+    return data;
+  };
+  auto readLine = [&]() -> std::string {
+    auto length = asio::read_until(socket, buffer, "\r\n", ec);
+    return ec ? std::string{} : readExactly(length).substr(0, length - 2);
+  };
+
+  while (mRunning) {
+    auto headLength = asio::read_until(socket, buffer, "\r\n\r\n", ec);
+    if (ec) {
+      break;
+    }
+    std::istringstream head(readExactly(headLength));
+    Request request;
+    std::string line, version;
+    std::getline(head, line);
+    std::istringstream(line) >> request.method >> request.target >> version;
+    while (std::getline(head, line) && line != "\r") {
+      auto separator = line.find(':');
+      if (separator != std::string::npos) {
+        request.headers[boost::to_lower_copy(line.substr(0, separator))] = boost::trim_copy(line.substr(separator + 1));
+      }
+    }
+
+    if (auto expect = request.headers.find("expect"); expect != request.headers.end() && boost::iequals(expect->second, "100-continue")) {
+      asio::write(socket, asio::buffer(std::string("HTTP/1.1 100 Continue\r\n\r\n")), ec);
+    }
+    // we cannot know where the next request starts after a malformed body, thus the connection is closed after answering
+    bool malformed = false;
+    if (auto length = request.headers.find("content-length"); length != request.headers.end()) {
+      auto size = toUnsigned(length->second);
+      malformed = !size.has_value();
+      request.body = malformed ? std::string{} : readExactly(size.value());
+    } else if (auto encoding = request.headers.find("transfer-encoding"); encoding != request.headers.end() && boost::iequals(encoding->second, "chunked")) {
+      while (!ec) {
+        auto line = readLine();
+        // the chunk size might be followed by extensions
+        auto chunkSize = toUnsigned(boost::trim_copy(line.substr(0, line.find(';'))), 16);
+        if (!chunkSize.has_value()) {
+          malformed = true;
+          break;
+        }
+        if (chunkSize.value() == 0) {
+          readLine();
+          break;
+        }
+        request.body += readExactly(chunkSize.value());
+        readLine();
+      }
+    }
+    if (ec) {
+      break;
+    }
+
+    Response response;
+    if (malformed) {
+      response.status = 400;
+      response.body = "Invalid Content-Length or chunk size";
+    } else {
+      response = handle(request);
+    }
+    std::ostringstream out;
+    out << "HTTP/1.1 " << response.status << " " << reasonPhrase(response.status) << "\r\n";
+    for (const auto& [name, value] : response.headers) {
+      out << name << ": " << value << "\r\n";
+    }
+    if (response.status != 304) {
+      out << "Content-Length: " << response.body.size() << "\r\n";
+    }
+    out << "\r\n";
+    auto responseHead = out.str();
+    std::vector<asio::const_buffer> buffers{ asio::buffer(responseHead) };
+    if (response.withBody && response.status != 304) {
+      buffers.push_back(asio::buffer(response.body));
+    }
+    asio::write(socket, buffers, ec);
+
+    auto connectionHeader = request.headers.find("connection");
+    if (ec || malformed || (connectionHeader != request.headers.end() && boost::iequals(connectionHeader->second, "close"))) {
+      break;
+    }
+  }
+  socket.close(ec);
+  connection->finished = true;
+}
+
+CcdbStandIn::Response CcdbStandIn::handle(const Request& request)
+{
+  mRequests++;
+  if (mRequestObserver) {
+    mRequestObserver(request);
+  }
+  auto queryStart = request.target.find('?');
+  std::string path = request.target.substr(0, queryStart);
+  std::map<std::string, std::string> query;
+  if (queryStart != std::string::npos) {
+    std::vector<std::string> parameters;
+    boost::split(parameters, request.target.substr(queryStart + 1), boost::is_any_of("&"));
+    for (const auto& parameter : parameters) {
+      auto separator = parameter.find('=');
+      query[decode(parameter.substr(0, separator))] = separator == std::string::npos ? "" : decode(parameter.substr(separator + 1));
+    }
+  }
+
+  Response response;
+  if (request.method == "POST" || request.method == "PUT") {
+    response = store(path, query, request);
+  } else if (request.method == "GET" || request.method == "HEAD") {
+    if (path.empty() || path == "/") {
+      response.body = "CCDB stand-in\n";
+    } else if (path.starts_with("/latest/") || path == "/latest") {
+      response = list(path.substr(7), true, request);
+    } else if (path.starts_with("/browse/") || path == "/browse") {
+      response = list(path.substr(7), false, request);
+    } else {
+      response = retrieve(path, request);
+    }
+    response.withBody = request.method == "GET";
+  } else if (request.method == "DELETE") {
+    response = truncate(path.starts_with("/truncate/") ? path.substr(9) : path);
+  } else {
+    response.status = 405;
+  }
+  return response;
+}
+
+CcdbStandIn::Response CcdbStandIn::store(const std::string& path, const std::map<std::string, std::string>& query, const Request& request)
+{
+  auto parsed = parsePath(path, 2);
+  Response response;
+  if (parsed.numbers.empty() || parsed.path.empty()) {
+    response.status = 400;
+    response.body = "Expected a path followed by the start and end of validity";
+    return response;
+  }
+
+  auto version = std::make_shared<Version>();
+  version->path = parsed.path;
+  version->validFrom = parsed.numbers[0];
+  version->validUntil = parsed.numbers.size() > 1 ? parsed.numbers[1] : version->validFrom + 24ull * 60 * 60 * 1000;
+  version->metadata = std::move(parsed.metadata);
+  for (const auto& [key, value] : query) {
+    version->metadata.emplace(key, value);
+  }
+  auto contentType = request.headers.count("content-type") ? request.headers.at("content-type") : "";
+  version->contentType = "application/octet-stream";
+  version->data = extractFile(contentType, request.body, version->fileName, version->contentType);
+
+  std::unique_lock lock(mStorageMutex);
+  version->created = std::max(msSinceEpoch(), mLastCreated + 1);
+  mLastCreated = version->created;
+  char id[40];
+  std::snprintf(id, sizeof(id), "00000000-0000-0000-0000-%012llx", static_cast<unsigned long long>(mNextId++));
+  version->id = id;
+  if (version->fileName.empty()) {
+    version->fileName = version->id + ".root";
+  }
+  mObjects[version->path].push_back(version);
+  mObjectsById[version->id] = version;
+
+  response.status = 201;
+  response.headers.emplace_back("Location", "/" + version->path + "/" + std::to_string(version->validFrom) + "/" + version->id);
+  return response;
+}
+
+CcdbStandIn::Response CcdbStandIn::retrieve(const std::string& path, const Request& request)
+{
+  std::shared_ptr<const Version> found;
+  {
+    std::shared_lock lock(mStorageMutex);
+    if (path.starts_with("/download/")) {
+      if (auto it = mObjectsById.find(path.substr(10)); it != mObjectsById.end()) {
+        found = it->second;
+      }
+    } else {
+      auto parsed = parsePath(path, 1);
+      uint64_t timestamp = parsed.numbers.empty() ? msSinceEpoch() : parsed.numbers[0];
+      if (auto versions = mObjects.find(parsed.path); versions != mObjects.end()) {
+        for (auto it = versions->second.rbegin(); it != versions->second.rend() && found == nullptr; ++it) {
+          const auto& version = **it;
+          bool matches = version.validFrom <= timestamp && timestamp < version.validUntil;
+          for (const auto& [key, value] : parsed.metadata) {
+            auto actual = version.metadata.find(key);
+            matches = matches && actual != version.metadata.end() && actual->second == value;
+          }
+          if (matches) {
+            found = *it;
+          }
+        }
+      }
+    }
+  }
+
+  Response response;
+  if (found == nullptr) {
+    response.status = 404;
+    return response;
+  }
+  auto etag = "\"" + found->id + "\"";
+  response.headers = {
+    { "ETag", etag },
+    { metadata_keys::validFrom, std::to_string(found->validFrom) },
+    { metadata_keys::validUntil, std::to_string(found->validUntil) },
+    { metadata_keys::created, std::to_string(found->created) },
+    { "Content-Type", found->contentType },
+    { "Content-Disposition", "inline;filename=\"" + found->fileName + "\"" },
+  };
+  for (const auto& [key, value] : found->metadata) {
+    response.headers.emplace_back(key, value);
+  }
+  if (auto ifNoneMatch = request.headers.find("if-none-match"); ifNoneMatch != request.headers.end() && ifNoneMatch->second == etag) {
+    response.status = 304;
+    return response;
+  }
+  response.body = found->data;
+  return response;
+}
+
+CcdbStandIn::Response CcdbStandIn::list(const std::string& path, bool latestOnly, const Request& request)
+{
+  auto parsed = parsePath(path, 0);
+  PathMatcher matcher(parsed.path);
+  uint64_t createdNotBefore = 0;
+  uint64_t createdNotAfter = UINT64_MAX;
+  for (auto [header, value] : { std::pair{ "if-not-before", &createdNotBefore }, std::pair{ "if-not-after", &createdNotAfter } }) {
+    if (auto it = request.headers.find(header); it != request.headers.end()) {
+      auto number = toUnsigned(it->second);
+      if (!number.has_value()) {
+        Response response;
+        response.status = 400;
+        response.body = std::string("Invalid ") + header + " header";
+        return response;
+      }
+      *value = number.value();
+    }
+  }
+
+  std::vector<std::shared_ptr<const Version>> listed;
+  {
+    std::shared_lock lock(mStorageMutex);
+    for (const auto& [objectPath, versions] : mObjects) {
+      if (!matcher.matches(objectPath)) {
+        continue;
+      }
+      for (auto it = versions.rbegin(); it != versions.rend(); ++it) {
+        const auto& version = **it;
+        bool matches = version.created >= createdNotBefore && version.created <= createdNotAfter;
+        for (const auto& [key, value] : parsed.metadata) {
+          auto actual = version.metadata.find(key);
+          matches = matches && actual != version.metadata.end() && actual->second == value;
+        }
+        if (matches) {
+          listed.push_back(*it);
+          if (latestOnly) {
+            break;
+          }
+        }
+      }
+    }
+  }
+  // the newest objects come first, as in CCDB
+  std::sort(listed.begin(), listed.end(), [](const auto& a, const auto& b) { return a->created > b->created; });
+
+  Response response;
+  auto accept = request.headers.count("accept") ? boost::to_lower_copy(request.headers.at("accept")) : "";
+  if (accept.find("json") == std::string::npos) {
+    response.headers.emplace_back("Content-Type", "text/plain");
+    for (const auto& version : listed) {
+      response.body += version->path + "\n";
+    }
+    return response;
+  }
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("objects");
+  writer.StartArray();
+  for (const auto& version : listed) {
+    writer.StartObject();
+    writer.Key("path");
+    writer.String(version->path.c_str());
+    writer.Key("id");
+    writer.String(version->id.c_str());
+    writer.Key("createTime");
+    writer.Uint64(version->created);
+    writer.Key("lastModified");
+    writer.Uint64(version->created);
+    writer.Key(metadata_keys::created);
+    writer.Uint64(version->created);
+    writer.Key("validFrom");
+    writer.Uint64(version->validFrom);
+    writer.Key("validUntil");
+    writer.Uint64(version->validUntil);
+    writer.Key(metadata_keys::validFrom);
+    writer.Uint64(version->validFrom);
+    writer.Key(metadata_keys::validUntil);
+    writer.Uint64(version->validUntil);
+    writer.Key("fileName");
+    writer.String(version->fileName.c_str());
+    writer.Key("contentType");
+    writer.String(version->contentType.c_str());
+    writer.Key("size");
+    writer.Uint64(version->data.size());
+    for (const auto& [key, value] : version->metadata) {
+      writer.Key(key.c_str());
+      writer.String(value.c_str());
+    }
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.Key("subfolders");
+  writer.StartArray();
+  writer.EndArray();
+  writer.EndObject();
+
+  response.headers.emplace_back("Content-Type", "application/json");
+  response.body = buffer.GetString();
+  return response;
+}
+
+CcdbStandIn::Response CcdbStandIn::truncate(const std::string& path)
+{
+  auto parsed = parsePath(path, 2);
+  PathMatcher matcher(parsed.path);
+  Response response;
+  std::unique_lock lock(mStorageMutex);
+  for (auto it = mObjects.begin(); it != mObjects.end();) {
+    if (!parsed.path.empty() && matcher.matches(it->first)) {
+      for (const auto& version : it->second) {
+        mObjectsById.erase(version->id);
+      }
+      it = mObjects.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return response;
+}
+
+} // namespace o2::quality_control::repository
@@ -100,7 +100,7 @@ void Check::reset()
   mCheckInterface->reset();
 }
 
-QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap)
+QualityObjectsType Check::check(const std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, bool deferBeautify)
 {
   if (mCheckInterface == nullptr) {
     BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Attempting to check, but no CheckInterface is loaded"));
@@ -124,7 +124,7 @@ QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObj
      */
     std::ranges::copy(mCheckConfig.objectNames |
                         std::views::filter([&](const auto& key) { return moMap.count(key) > 0; }) |
-                        std::views::transform([&](const auto& key) { return std::pair{ key, moMap[key] }; }),
+                        std::views::transform([&](const auto& key) { return std::pair{ key, moMap.at(key) }; }),
                       std::inserter(shadowMap, shadowMap.end()));
   }
 
@@ -173,12 +173,24 @@ QualityObjectsType Check::check(std::map<std::string, std::shared_ptr<MonitorObj
       stringifyInput(mCheckConfig.inputSpecs),
       monitorObjectsNames));
     qualityObjects.back()->setActivity(commonActivity);
-    beautify(moMapToCheck, quality);
+    if (deferBeautify) {
+      mDeferredBeautifications.emplace_back(std::move(moMapToCheck), quality);
+    } else {
+      beautify(moMapToCheck, quality);
+    }
   }
 
   return qualityObjects;
 }
 
+void Check::beautifyDeferred()
+{
+  for (auto& [moMap, quality] : mDeferredBeautifications) {
+    beautify(moMap, quality);
+  }
+  mDeferredBeautifications.clear();
+}
+
 void Check::beautify(std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, const Quality& quality)
 {
   if (!mCheckConfig.allowBeautify) {
@@ -21,14 +21,17 @@
 // O2
 #include <Common/Exceptions.h>
 #include <Framework/DataSpecUtils.h>
+#include <Framework/InputRecordWalker.h>
 #include <Framework/ConfigParamRegistry.h>
 #include <Monitoring/MonitoringFactory.h>
 #include <Monitoring/Monitoring.h>
 #include <CommonUtils/ConfigurableParam.h>
 
+#include <exception>
 #include <utility>
 // QC
 #include "QualityControl/DatabaseFactory.h"
+#include "QualityControl/DatabaseUploader.h"
 #include "QualityControl/ServiceDiscovery.h"
 #include "QualityControl/runnerUtils.h"
 #include "QualityControl/InfrastructureSpecReader.h"
@@ -37,8 +40,10 @@
 #include "QualityControl/ConfigParamGlo.h"
 #include "QualityControl/Bookkeeping.h"
 #include "QualityControl/WorkflowType.h"
+#include "QualityControl/ThreadPool.h"
 
 #include <TSystem.h>
+#include <TROOT.h>
 
 using namespace std::chrono;
 using namespace AliceO2::Common;
@@ -164,6 +169,7 @@ CheckRunner::CheckRunner(CheckRunnerConfig checkRunnerConfig, InputSpec input)
 CheckRunner::~CheckRunner()
 {
   ILOG(Debug, Trace) << "CheckRunner destructor (" << this << ")" << ENDM;
+  mUploader.reset(); // uploads the remaining objects before we go
   if (mServiceDiscovery != nullptr) {
     mServiceDiscovery->deregister();
   }
@@ -187,6 +193,12 @@ void CheckRunner::init(framework::InitContext& iCtx)
     iCtx.services().get<CallbackService>().set<CallbackService::Id::Reset>([this]() { reset(); });
     iCtx.services().get<CallbackService>().set<CallbackService::Id::Stop>([this]() { stop(); });
 
+    if (mConfig.checkParallelism > 1 && mChecks.size() > 1) {
+      ROOT::EnableThreadSafety();
+      mCheckPool = std::make_unique<ThreadPool>(std::min(mConfig.checkParallelism, mChecks.size()));
+      ILOG(Info, Devel) << "Checks will be executed with " << mCheckPool->size() << " threads" << ENDM;
+    }
+
     updatePolicyManager.reset();
     for (auto& [checkName, check] : mChecks) {
       check.init();
@@ -232,54 +244,29 @@ void CheckRunner::prepareCacheData(framework::InputRecord& inputRecord)
   mMonitorObjectStoreVector.clear();
 
   for (const auto& input : mInputs) {
-    auto dataRef = inputRecord.get(input.binding.c_str());
-    if (dataRef.header != nullptr && dataRef.payload != nullptr) {
+    // a task may publish its objects in several parts, see "publicationThreads"
+    for (const auto& dataRef : InputRecordWalker(inputRecord, { input })) {
+      if (dataRef.header == nullptr || dataRef.payload == nullptr) {
+        continue;
+      }
 
-      // We don't know what we receive, so we test for an array and then try a tobject.
-      // If we received a tobject, it gets encapsulated in the tobjarray.
-      shared_ptr<TObjArray> array = nullptr;
-      auto tobj = DataRefUtils::as<TObject>(dataRef);
+      // We don't know what we receive, it can be a TObjArray of MonitorObjects or TObjects, or a TObject.
+      // The cache adopts the deserialized object without copying it and encapsulates what is not a MonitorObject.
       // if the object has not been found, it will raise an exception that we just let go.
-      if (tobj->InheritsFrom("TObjArray")) {
-        array.reset(dynamic_cast<TObjArray*>(tobj.release()));
-        array->SetOwner(false);
-        ILOG(Debug, Devel) << "CheckRunner " << mDeviceName
-                           << " received an array with " << array->GetEntries()
-                           << " entries from " << input.binding << ENDM;
-      } else {
-        // it is just a TObject not embedded in a TObjArray. We build a TObjArray for it.
-        auto* newArray = new TObjArray();    // we cannot use `array` to add an object as it is const
-        TObject* newTObject = tobj->Clone(); // we need a copy to avoid that it gets deleted behind our back.
-        newArray->Add(newTObject);
-        array.reset(newArray); // now that the array is ready we can adopt it.
-        ILOG(Debug, Devel) << "CheckRunner " << mDeviceName
-                           << " received a tobject named " << tobj->GetName()
-                           << " from " << input.binding << ENDM;
-      }
+      auto tobj = DataRefUtils::as<TObject>(dataRef);
+      ILOG(Debug, Devel) << "CheckRunner " << mDeviceName << " received a " << tobj->ClassName()
+                         << " named " << tobj->GetName() << " from " << input.binding << ENDM;
+      header::DataOrigin origin = DataSpecUtils::asConcreteOrigin(input);
+      auto monitorObjects = mMonitorObjectCache.ingest(std::move(tobj), input.binding, origin.str, *mActivity);
 
-      // for each item of the array, check whether it is a MonitorObject. If not, create one and encapsulate.
-      // Then, store the MonitorObject in the various maps and vectors we will use later.
+      // Store the MonitorObjects in the various vectors we will use later.
       bool store = mInputStoreSet.count(DataSpecUtils::label(input)) > 0; // Check if this CheckRunner stores this input
-      for (const auto tObject : *array) {
-        std::shared_ptr<MonitorObject> mo{ dynamic_cast<MonitorObject*>(tObject) };
-
-        if (mo == nullptr) {
-          ILOG(Debug, Devel) << "The MO is null, probably a TObject could not be casted into an MO." << ENDM;
-          ILOG(Debug, Devel) << "    Creating an ad hoc MO." << ENDM;
-          header::DataOrigin origin = DataSpecUtils::asConcreteOrigin(input);
-          mo = std::make_shared<MonitorObject>(tObject, input.binding, "CheckRunner", origin.str);
-          mo->setActivity(*mActivity);
-        }
+      for (const auto& mo : monitorObjects) {
+        updatePolicyManager.updateObjectRevision(mo->getFullName());
+        mTotalNumberObjectsReceived++;
 
-        if (mo) {
-          mo->setIsOwner(true);
-          mMonitorObjects[mo->getFullName()] = mo;
-          updatePolicyManager.updateObjectRevision(mo->getFullName());
-          mTotalNumberObjectsReceived++;
-
-          if (store) { // Monitor Object will be stored later, after possible beautification
-            mMonitorObjectStoreVector.push_back(mo);
-          }
+        if (store) { // Monitor Object will be stored later, after possible beautification
+          mMonitorObjectStoreVector.push_back(mo);
         }
       }
     }
@@ -303,6 +290,17 @@ void CheckRunner::sendPeriodicMonitoring()
                        .addValue(rateQOs, "qos_per_second"));
     mCollector->send({ mTotalQOSent, "qc_checkrunner_qo_sent" });
     mCollector->send({ mTimerTotalDurationActivity.getTime(), "qc_checkrunner_duration" });
+    if (mUploader) {
+      auto stats = mUploader->collectStats();
+      mCollector->send(Metric{ "qc_checkrunner_upload" }
+                         .addValue(stats.queueDepth, "queue_depth")
+                         .addValue(stats.stored, "stored")
+                         .addValue(stats.coalesced, "coalesced")
+                         .addValue(stats.dropped, "dropped")
+                         .addValue(stats.failed, "failed")
+                         .addValue(stats.meanLatencyMs, "mean_latency_ms")
+                         .addValue(stats.maxLatencyMs, "max_latency_ms"));
+    }
     mNumberQOStored = 0;
     mNumberMOStored = 0;
   }
@@ -310,34 +308,85 @@ void CheckRunner::sendPeriodicMonitoring()
 
 QualityObjectsType CheckRunner::check()
 {
-  ILOG(Debug, Devel) << "Trying " << mChecks.size() << " checks for " << mMonitorObjects.size() << " monitor objects"
+  ILOG(Debug, Devel) << "Trying " << mChecks.size() << " checks for " << mMonitorObjectCache.getMonitorObjects().size() << " monitor objects"
                      << ENDM;
 
-  QualityObjectsType allQOs;
+  // The readiness of a check does not depend on the other checks being executed,
+  // thus we can evaluate it for all of them before running any.
+  std::vector<Check*> readyChecks;
   for (auto& [checkName, check] : mChecks) {
     if (updatePolicyManager.isReady(check.getName())) {
       ILOG(Debug, Support) << "Monitor Objects for the check '" << checkName << "' are ready --> check()" << ENDM;
-      auto newQOs = check.check(mMonitorObjects);
-      mTotalNumberCheckExecuted += newQOs.size();
-
-      allQOs.insert(allQOs.end(), std::make_move_iterator(newQOs.begin()), std::make_move_iterator(newQOs.end()));
-      newQOs.clear();
-
-      // Was checked, update latest revision
-      updatePolicyManager.updateActorRevision(checkName);
+      readyChecks.push_back(&check);
     } else {
       ILOG(Debug, Support) << "Monitor Objects for the check '" << checkName << "' are not ready, ignoring" << ENDM;
     }
   }
+
+  auto qosPerCheck = runChecks(readyChecks, mMonitorObjectCache.getMonitorObjects(), mCheckPool.get());
+
+  // QOs are returned in the order of mChecks, whatever the execution order was
+  QualityObjectsType allQOs;
+  for (size_t i = 0; i < readyChecks.size(); i++) {
+    auto& newQOs = qosPerCheck[i];
+    mTotalNumberCheckExecuted += newQOs.size();
+    allQOs.insert(allQOs.end(), std::make_move_iterator(newQOs.begin()), std::make_move_iterator(newQOs.end()));
+
+    // Was checked, update latest revision
+    updatePolicyManager.updateActorRevision(readyChecks[i]->getName());
+  }
   return allQOs;
 }
 
+std::vector<QualityObjectsType> CheckRunner::runChecks(const std::vector<Check*>& checks, const std::map<std::string, std::shared_ptr<MonitorObject>>& moMap, ThreadPool* pool)
+{
+  std::vector<QualityObjectsType> qosPerCheck;
+  qosPerCheck.reserve(checks.size());
+  if (pool != nullptr && checks.size() > 1) {
+    std::vector<std::future<QualityObjectsType>> futures;
+    futures.reserve(checks.size());
+    for (auto* check : checks) {
+      futures.push_back(pool->submit([check, &moMap]() { return check->check(moMap, true); }));
+    }
+    // we wait for all the checks before touching any MO again, even if one of them failed
+    std::exception_ptr exception;
+    for (auto& future : futures) {
+      try {
+        qosPerCheck.push_back(future.get());
+      } catch (...) {
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+    }
+    if (exception) {
+      for (auto* check : checks) {
+        check->clearDeferred();
+      }
+      std::rethrow_exception(exception);
+    }
+    // the MOs might be shared among the checks, thus they are beautified one check after another
+    for (auto* check : checks) {
+      check->beautifyDeferred();
+    }
+  } else {
+    for (auto* check : checks) {
+      qosPerCheck.push_back(check->check(moMap));
+    }
+  }
+  return qosPerCheck;
+}
+
 void CheckRunner::store(QualityObjectsType& qualityObjects, long validFrom)
 {
   ILOG(Debug, Devel) << "Storing " << qualityObjects.size() << " QualityObjects" << ENDM;
   try {
     for (auto& qo : qualityObjects) {
-      mDatabase->storeQO(qo);
+      if (mUploader) {
+        mUploader->enqueue(qo);
+      } else {
+        mDatabase->storeQO(qo);
+      }
       mTotalNumberQOStored++;
       mNumberQOStored++;
     }
@@ -355,7 +404,12 @@ void CheckRunner::store(std::vector<std::shared_ptr<MonitorObject>>& monitorObje
   ILOG(Debug, Devel) << "Storing " << monitorObjects.size() << " MonitorObjects" << ENDM;
   try {
     for (auto& mo : monitorObjects) {
-      mDatabase->storeMO(mo);
+      if (mUploader) {
+        // the cache keeps the MO and might beautify it in the next cycle while it is being uploaded, thus the uploader gets a copy
+        mUploader->enqueue(std::make_shared<MonitorObject>(*mo));
+      } else {
+        mDatabase->storeMO(mo);
+      }
 
       mTotalNumberMOStored++;
       mNumberMOStored++;
@@ -421,6 +475,11 @@ void CheckRunner::initDatabase()
   mDatabase = DatabaseFactory::create(mConfig.database.at("implementation"));
   mDatabase->connect(mConfig.database);
   ILOG(Info, Devel) << "Database that is going to be used > Implementation : " << mConfig.database.at("implementation") << " / Host : " << mConfig.database.at("host") << ENDM;
+
+  auto uploaderConfig = DatabaseUploaderConfig::fromDatabaseConfig(mConfig.database);
+  if (uploaderConfig.enabled) {
+    mUploader = std::make_unique<DatabaseUploader>(DatabaseUploader::backendFactoryFor(mConfig.database), uploaderConfig);
+  }
 }
 
 void CheckRunner::initMonitoring()
@@ -457,6 +516,9 @@ void CheckRunner::initLibraries()
 void CheckRunner::endOfStream(framework::EndOfStreamContext& eosContext)
 {
   mReceivedEOS = true;
+  if (mUploader) {
+    mUploader->flush(); // the last objects of the run should be in the QCDB before we acknowledge the EoS
+  }
 }
 
 void CheckRunner::start(ServiceRegistryRef services)
@@ -489,6 +551,9 @@ void CheckRunner::stop()
   if (!mReceivedEOS) {
     ILOG(Warning, Devel) << "The STOP transition happened before an EndOfStream was received. The very last QC objects in this run might not have been stored." << ENDM;
   }
+  if (mUploader) {
+    mUploader->flush();
+  }
   for (auto& [checkName, check] : mChecks) {
     check.endOfActivity(*mActivity);
   }
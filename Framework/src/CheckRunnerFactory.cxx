@@ -97,7 +97,8 @@ CheckRunnerConfig CheckRunnerFactory::extractConfig(const CommonSpec& commonSpec
     commonSpec.bookkeepingUrl,
     commonSpec.infologgerDiscardParameters,
     fallbackActivity,
-    options
+    options,
+    commonSpec.checkParallelism
   };
 }
 
@@ -0,0 +1,223 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DatabaseCache.cxx
+///
+
+#include "QualityControl/DatabaseCache.h"
+
+#include <TH1.h>
+#include <THnSparse.h>
+
+#include <algorithm>
+#include <iterator>
+
+namespace o2::quality_control::repository
+{
+
+DatabaseCacheConfig DatabaseCacheConfig::fromDatabaseConfig(const std::unordered_map<std::string, std::string>& databaseConfig)
+{
+  DatabaseCacheConfig config;
+  if (auto it = databaseConfig.find("cache"); it != databaseConfig.end()) {
+    config.enabled = it->second == "true" || it->second == "1";
+  }
+  if (auto it = databaseConfig.find("cacheSizeMB"); it != databaseConfig.end()) {
+    config.maxBytes = std::stoul(it->second) * 1024 * 1024;
+  }
+  if (auto it = databaseConfig.find("cacheListingTtlMs"); it != databaseConfig.end()) {
+    config.listingTtl = std::chrono::milliseconds(std::stol(it->second));
+  }
+  return config;
+}
+
+DatabaseCache::DatabaseCache(DatabaseCacheConfig config) : mConfig(config)
+{
+}
+
+std::string DatabaseCache::makeKey(const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  std::string key = path;
+  for (const auto& [name, value] : metadata) {
+    key += '/' + name + '=' + value;
+  }
+  return key;
+}
+
+std::string DatabaseCache::makeKey(const std::string& path, const std::map<std::string, std::string>& metadata, const std::string& suffix)
+{
+  return makeKey(path, metadata) + '@' + suffix;
+}
+
+std::shared_ptr<const DatabaseCache::Entry> DatabaseCache::find(const std::string& key, const Version& version)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto object = mIndex.find(key);
+  if (object == mIndex.end()) {
+    return nullptr;
+  }
+  auto cached = object->second.find(version.validity.getMin());
+  if (cached == object->second.end()) {
+    return nullptr;
+  }
+  // an object stored again with the same validity has another ID
+  const auto& cachedVersion = cached->second->second->version;
+  if (cachedVersion.validity.getMax() != version.validity.getMax() || cachedVersion.id != version.id) {
+    return nullptr;
+  }
+  return use(cached->second);
+}
+
+std::shared_ptr<const DatabaseCache::Entry> DatabaseCache::findValidAt(const std::string& key, core::validity_time_t timestamp)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto object = mIndex.find(key);
+  if (object == mIndex.end()) {
+    return nullptr;
+  }
+  // the version which starts last before the timestamp, if it is still valid at the timestamp
+  auto version = object->second.upper_bound(timestamp);
+  if (version == object->second.begin()) {
+    return nullptr;
+  }
+  version--;
+  if (version->second->second->version.validity.getMax() <= timestamp) {
+    return nullptr;
+  }
+  return use(version->second);
+}
+
+std::shared_ptr<const DatabaseCache::Entry> DatabaseCache::insert(const std::string& key, Version version, TObject* object, std::map<std::string, std::string> headers)
+{
+  auto entry = std::make_shared<Entry>();
+  entry->bytes = estimateSize(*object, headers);
+  entry->object.reset(object);
+  entry->headers = std::move(headers);
+  entry->version = std::move(version);
+  const auto validFrom = entry->version.validity.getMin();
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto& versions = mIndex[key];
+  if (auto cached = versions.find(validFrom); cached != versions.end()) {
+    erase(cached->second);
+  }
+  mLru.emplace_front(key, entry);
+  mIndex[key][validFrom] = mLru.begin();
+  mStats.bytes += entry->bytes;
+  evict();
+  return entry;
+}
+
+std::shared_ptr<const DatabaseCache::Entry> DatabaseCache::use(LruList::iterator it)
+{
+  mLru.splice(mLru.begin(), mLru, it);
+  return it->second;
+}
+
+void DatabaseCache::erase(LruList::iterator it)
+{
+  auto& [key, entry] = *it;
+  mStats.bytes -= entry->bytes;
+  auto object = mIndex.find(key);
+  object->second.erase(entry->version.validity.getMin());
+  if (object->second.empty()) {
+    mIndex.erase(object);
+  }
+  mLru.erase(it);
+}
+
+void DatabaseCache::evict()
+{
+  // the most recent entry is kept even if it is larger than the limit, the caller is still going to use it
+  while (mStats.bytes > mConfig.maxBytes && mLru.size() > 1) {
+    erase(std::prev(mLru.end()));
+    mStats.evictions++;
+  }
+}
+
+void DatabaseCache::markHit()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mStats.hits++;
+}
+
+void DatabaseCache::markRevalidated()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mStats.revalidated++;
+}
+
+void DatabaseCache::markMissed()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mStats.misses++;
+}
+
+std::optional<DatabaseCache::Version> DatabaseCache::findListing(const std::string& key)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto it = mListings.find(key);
+  if (it == mListings.end() || it->second.expiry < std::chrono::steady_clock::now()) {
+    mStats.listingMisses++;
+    return std::nullopt;
+  }
+  mStats.listingHits++;
+  return it->second.version;
+}
+
+void DatabaseCache::insertListing(const std::string& key, Version version)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto now = std::chrono::steady_clock::now();
+  if (mListings.size() > 10000) {
+    std::erase_if(mListings, [now](const auto& listing) { return listing.second.expiry < now; });
+  }
+  mListings[key] = { std::move(version), now + mConfig.listingTtl };
+}
+
+DatabaseCache::Stats DatabaseCache::getStats() const
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto stats = mStats;
+  stats.entries = mLru.size();
+  auto requests = stats.hits + stats.revalidated + stats.misses;
+  stats.hitRate = requests > 0 ? static_cast<double>(stats.hits + stats.revalidated) / requests : 0;
+  return stats;
+}
+
+TObject* DatabaseCache::copy(const TObject& object)
+{
+  auto* copy = object.Clone();
+  if (auto* histogram = dynamic_cast<TH1*>(copy)) {
+    histogram->SetDirectory(nullptr);
+  }
+  return copy;
+}
+
+size_t DatabaseCache::estimateSize(const TObject& object, const std::map<std::string, std::string>& headers)
+{
+  if (auto* histogram = dynamic_cast<const TH1*>(&object)) {
+    return sizeof(TH1) + histogram->GetNcells() * sizeof(double) * (histogram->GetSumw2N() > 0 ? 2 : 1);
+  }
+  if (auto* sparse = dynamic_cast<const THnSparse*>(&object)) {
+    return sizeof(THnSparse) + sparse->GetNbins() * (sizeof(double) + sparse->GetNdimensions() * sizeof(int));
+  }
+  // otherwise we rely on the size of the stored file, which is typically compressed, so it is a lower bound
+  if (auto it = headers.find("Content-Length"); it != headers.end()) {
+    try {
+      return std::stoul(it->second);
+    } catch (...) {
+    }
+  }
+  return 1024;
+}
+
+} // namespace o2::quality_control::repository
@@ -0,0 +1,202 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DatabaseUploader.cxx
+///
+
+#include "QualityControl/DatabaseUploader.h"
+#include "QualityControl/DatabaseInterface.h"
+#include "QualityControl/DatabaseFactory.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/QualityObject.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <TROOT.h>
+#include <boost/exception/diagnostic_information.hpp>
+#include <algorithm>
+
+using namespace std::chrono;
+
+namespace o2::quality_control::repository
+{
+
+DatabaseUploaderConfig DatabaseUploaderConfig::fromDatabaseConfig(const std::unordered_map<std::string, std::string>& databaseConfig)
+{
+  DatabaseUploaderConfig config;
+  if (auto it = databaseConfig.find("asyncUpload"); it != databaseConfig.end()) {
+    config.enabled = it->second == "true" || it->second == "1";
+  }
+  if (auto it = databaseConfig.find("uploadThreads"); it != databaseConfig.end()) {
+    config.threads = std::max<size_t>(1, std::stoul(it->second));
+  }
+  if (auto it = databaseConfig.find("uploadQueueSize"); it != databaseConfig.end()) {
+    config.queueSize = std::max<size_t>(1, std::stoul(it->second));
+  }
+  return config;
+}
+
+DatabaseUploader::DatabaseUploader(const BackendFactory& backendFactory, DatabaseUploaderConfig config)
+  : mConfig(config)
+{
+  mConfig.threads = std::max<size_t>(1, mConfig.threads);
+  mConfig.queueSize = std::max<size_t>(1, mConfig.queueSize);
+
+  // the objects are serialized in the worker threads
+  ROOT::EnableThreadSafety();
+
+  for (size_t i = 0; i < mConfig.threads; i++) {
+    mWorkers.emplace_back(&DatabaseUploader::workerLoop, this, backendFactory());
+  }
+  ILOG(Info, Devel) << "Asynchronous QCDB upload enabled with " << mConfig.threads << " thread(s), queue size "
+                    << mConfig.queueSize << ENDM;
+}
+
+DatabaseUploader::~DatabaseUploader()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mWorkAvailable.notify_all();
+  for (auto& worker : mWorkers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void DatabaseUploader::enqueue(std::shared_ptr<const core::MonitorObject> mo)
+{
+  push({ mo->getPath(), std::move(mo), nullptr, steady_clock::now() });
+}
+
+void DatabaseUploader::enqueue(std::shared_ptr<const core::QualityObject> qo)
+{
+  push({ qo->getPath(), nullptr, std::move(qo), steady_clock::now() });
+}
+
+void DatabaseUploader::push(Entry&& entry)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStats.enqueued++;
+
+    if (auto pending = mQueueIndex.find(entry.path); pending != mQueueIndex.end()) {
+      // a previous version is still waiting, it would be superseded anyway.
+      // the new one goes to the end of the queue, so that it is not the first to be dropped if the queue is full.
+      // the latency is still counted from the first version which was not uploaded.
+      auto enqueuedAt = pending->second->enqueuedAt;
+      *pending->second = std::move(entry);
+      pending->second->enqueuedAt = enqueuedAt;
+      mQueue.splice(mQueue.end(), mQueue, pending->second);
+      mStats.coalesced++;
+    } else {
+      if (mQueue.size() >= mConfig.queueSize) {
+        mQueueIndex.erase(mQueue.front().path);
+        mQueue.pop_front();
+        mStats.dropped++;
+      }
+      auto path = entry.path;
+      mQueue.push_back(std::move(entry));
+      mQueueIndex.emplace(std::move(path), std::prev(mQueue.end()));
+    }
+  }
+  mWorkAvailable.notify_one();
+}
+
+bool DatabaseUploader::hasUploadableEntry() const
+{
+  // an entry has to wait if an older version of the same path is being uploaded
+  return std::any_of(mQueue.begin(), mQueue.end(), [this](const Entry& entry) { return mPathsInFlight.count(entry.path) == 0; });
+}
+
+DatabaseUploader::Entry DatabaseUploader::takeUploadableEntry()
+{
+  auto it = std::find_if(mQueue.begin(), mQueue.end(), [this](const Entry& entry) { return mPathsInFlight.count(entry.path) == 0; });
+  Entry entry = std::move(*it);
+  mQueueIndex.erase(entry.path);
+  mQueue.erase(it);
+  mPathsInFlight.insert(entry.path);
+  return entry;
+}
+
+void DatabaseUploader::workerLoop(std::shared_ptr<DatabaseInterface> backend)
+{
+  while (true) {
+    Entry entry;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mWorkAvailable.wait(lock, [this] { return hasUploadableEntry() || (mStopping && mQueue.empty()); });
+      if (mQueue.empty()) {
+        return;
+      }
+      entry = takeUploadableEntry();
+    }
+
+    bool success = true;
+    try {
+      if (entry.mo) {
+        backend->storeMO(entry.mo);
+      } else {
+        backend->storeQO(entry.qo);
+      }
+    } catch (boost::exception& e) {
+      success = false;
+      ILOG(Info, Support) << "Unable to store object " << entry.path << ": " << diagnostic_information(e) << ENDM;
+    } catch (std::exception& e) {
+      success = false;
+      ILOG(Info, Support) << "Unable to store object " << entry.path << ": " << e.what() << ENDM;
+    }
+    double latencyMs = duration<double, std::milli>(steady_clock::now() - entry.enqueuedAt).count();
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mPathsInFlight.erase(entry.path);
+      success ? mStats.stored++ : mStats.failed++;
+      mLatencySumMs += latencyMs;
+      mLatencyCount++;
+      mStats.maxLatencyMs = std::max(mStats.maxLatencyMs, latencyMs);
+    }
+    // a newer version of the path we have just uploaded might be waiting
+    mWorkAvailable.notify_all();
+    mWorkDone.notify_all();
+  }
+}
+
+DatabaseUploader::BackendFactory DatabaseUploader::backendFactoryFor(const std::unordered_map<std::string, std::string>& databaseConfig)
+{
+  return [databaseConfig]() -> std::shared_ptr<DatabaseInterface> {
+    std::shared_ptr<DatabaseInterface> backend = DatabaseFactory::create(databaseConfig.at("implementation"));
+    backend->connect(databaseConfig);
+    return backend;
+  };
+}
+
+void DatabaseUploader::flush()
+{
+  std::unique_lock<std::mutex> lock(mMutex);
+  mWorkDone.wait(lock, [this] { return mQueue.empty() && mPathsInFlight.empty(); });
+}
+
+DatabaseUploader::Stats DatabaseUploader::collectStats()
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  Stats stats = mStats;
+  stats.queueDepth = mQueue.size();
+  stats.meanLatencyMs = mLatencyCount > 0 ? mLatencySumMs / mLatencyCount : 0;
+  mStats.maxLatencyMs = 0;
+  mLatencySumMs = 0;
+  mLatencyCount = 0;
+  return stats;
+}
+
+} // namespace o2::quality_control::repository
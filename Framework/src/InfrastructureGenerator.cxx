@@ -344,7 +344,7 @@ framework::WorkflowSpec InfrastructureGenerator::generateLocalBatchInfrastructur
                          std::move(fileSinkInputs),
                          Outputs{},
                          adaptFromTask<RootFileSink>(sinkFilePath),
-                         Options{},
+                         RootFileSink::getOptions(),
                          CommonServices::defaultServices(),
                          { RootFileSink::getLabel() } });
   }
@@ -81,6 +81,7 @@ CommonSpec InfrastructureSpecReader::readSpecEntry<CommonSpec>(const std::string
   };
   spec.postprocessingPeriod = commonTree.get<double>("postprocessing.periodSeconds", spec.postprocessingPeriod);
   spec.bookkeepingUrl = commonTree.get<std::string>("bookkeeping.url", spec.bookkeepingUrl);
+  spec.checkParallelism = commonTree.get<size_t>("checkParallelism", spec.checkParallelism);
 
   return spec;
 }
@@ -100,6 +101,9 @@ TaskSpec InfrastructureSpecReader::readSpecEntry<TaskSpec>(const std::string& ta
   ts.moduleName = taskTree.get<std::string>("moduleName");
   ts.detectorName = taskTree.get<std::string>("detectorName");
   ts.disableLastCycle = taskTree.get<bool>("disableLastCycle", false);
+  ts.publishOnlyModifiedObjects = taskTree.get<bool>("publishOnlyModifiedObjects", ts.publishOnlyModifiedObjects);
+  ts.publicationThreads = taskTree.get<size_t>("publicationThreads", ts.publicationThreads);
+  ts.doubleBufferedCycles = taskTree.get<bool>("doubleBufferedCycles", ts.doubleBufferedCycles);
   ts.cycleDurationSeconds = taskTree.get<int>("cycleDurationSeconds", -1);
   if (taskTree.count("cycleDurations") > 0) {
     for (const auto& cycleConfig : taskTree.get_child("cycleDurations")) {
@@ -381,6 +385,7 @@ PostProcessingTaskSpec
   ppts.active = ppTaskTree.get<bool>("active", ppts.active);
   ppts.critical = ppTaskTree.get<bool>("critical", ppts.critical);
   ppts.detectorName = ppTaskTree.get<std::string>("detectorName", ppts.detectorName);
+  ppts.backfillThreads = ppTaskTree.get<size_t>("backfillThreads", ppts.backfillThreads);
   if (ppTaskTree.count("sourceRepo") > 0) {
     for (const auto& [key, value] : ppTaskTree.get_child("sourceRepo")) {
       ppts.sourceDatabase.emplace(key, value.get_value<std::string>());
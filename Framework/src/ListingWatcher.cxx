@@ -0,0 +1,274 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ListingWatcher.cxx
+///
+
+#include "QualityControl/ListingWatcher.h"
+#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/ObjectMetadataKeys.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include "rapidjson/memorystream.h"
+#include "rapidjson/reader.h"
+
+#include <cctype>
+#include <set>
+
+using namespace std::chrono;
+
+namespace o2::quality_control::repository
+{
+
+namespace
+{
+
+/// SAX handler which collects the scalar values of the entries in the top-level "objects" array.
+struct ListingHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, ListingHandler> {
+  std::vector<ListingEntry> entries;
+  bool foundObjects = false;
+  int depth = 0;
+  int objectsDepth = -1; // the depth of the "objects" array while we are inside it
+  std::string key;
+
+  bool inEntry() const { return objectsDepth >= 0 && depth == objectsDepth + 1; }
+
+  bool StartObject()
+  {
+    depth++;
+    if (inEntry()) {
+      entries.emplace_back();
+    }
+    return true;
+  }
+  bool EndObject(rapidjson::SizeType)
+  {
+    depth--;
+    return true;
+  }
+  bool StartArray()
+  {
+    depth++;
+    if (depth == 2 && key == "objects") {
+      objectsDepth = depth;
+      foundObjects = true;
+    }
+    return true;
+  }
+  bool EndArray(rapidjson::SizeType)
+  {
+    if (depth == objectsDepth) {
+      objectsDepth = -1;
+    }
+    depth--;
+    return true;
+  }
+  bool Key(const char* str, rapidjson::SizeType length, bool)
+  {
+    key.assign(str, length);
+    return true;
+  }
+  // numbers are received as strings as well, thanks to kParseNumbersAsStringsFlag
+  bool String(const char* str, rapidjson::SizeType length, bool)
+  {
+    if (inEntry()) {
+      entries.back()[key] = std::string(str, length);
+    }
+    return true;
+  }
+  bool Bool(bool value)
+  {
+    if (inEntry()) {
+      entries.back()[key] = value ? "true" : "false";
+    }
+    return true;
+  }
+};
+
+uint64_t getUnsigned(const ListingEntry& entry, const std::string& key)
+{
+  auto it = entry.find(key);
+  return it == entry.end() ? 0 : std::strtoull(it->second.c_str(), nullptr, 10);
+}
+
+/// Returns a listing path which matches only the given objects of the folder, i.e. "folder/(name1|name2)".
+/// A regular expression like "folder/.*" would also match all the objects in the subfolders.
+/// The special characters are escaped in the regular expression and percent-encoded in the URL,
+/// since the slash separates the path segments and some characters are not accepted in URLs.
+std::string makeListingPath(const std::string& folder, const std::set<std::string>& paths)
+{
+  constexpr char hex[] = "0123456789ABCDEF";
+  auto encode = [&](char c) {
+    return std::string{ '%', hex[static_cast<unsigned char>(c) >> 4], hex[static_cast<unsigned char>(c) & 0xF] };
+  };
+  std::string result = folder + "/" + encode('(');
+  for (auto it = paths.begin(); it != paths.end(); ++it) {
+    if (it != paths.begin()) {
+      result += encode('|');
+    }
+    for (char c : it->substr(folder.size() + 1)) {
+      if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+        result += c;
+      } else {
+        result += encode('\\') + encode(c);
+      }
+    }
+  }
+  return result + encode(')');
+}
+
+} // namespace
+
+std::optional<std::vector<ListingEntry>> parseListing(std::string_view json)
+{
+  ListingHandler handler;
+  rapidjson::Reader reader;
+  rapidjson::MemoryStream stream(json.data(), json.size());
+  if (reader.Parse<rapidjson::kParseNumbersAsStringsFlag>(stream, handler).IsError() || !handler.foundObjects) {
+    return std::nullopt;
+  }
+  return std::move(handler.entries);
+}
+
+struct ListingWatcher::Group {
+  std::mutex mutex;
+  std::string databaseUrl;
+  std::string folder;
+  std::map<std::string, std::string> metadata;
+  milliseconds pollPeriod;
+  CcdbDatabase db;
+  std::multiset<std::string> paths;
+  std::map<std::string, ListingEntry> latest;
+  bool needsFullListing = true;
+  uint64_t lastCreated = 0;
+  steady_clock::time_point lastPoll{};
+  steady_clock::time_point lastFullListing{};
+
+  void poll();
+  void merge(std::vector<ListingEntry>& entries);
+};
+
+void ListingWatcher::Group::poll()
+{
+  constexpr auto fullListingPeriod = minutes(1);
+  auto now = steady_clock::now();
+  if (!needsFullListing && now - lastPoll < pollPeriod) {
+    return;
+  }
+  // objects might also be modified without creating a new version, thus we do not rely only on the incremental listings
+  bool full = needsFullListing || lastCreated == 0 || now - lastFullListing > fullListingPeriod;
+  // a single object is listed directly, otherwise we ask for the latest version of each watched object in the folder
+  std::set<std::string> uniquePaths(paths.begin(), paths.end());
+  auto query = uniquePaths.size() == 1 ? *uniquePaths.begin() : makeListingPath(folder, uniquePaths);
+  auto json = db.getListingAsJson(query, metadata, true, full ? -1 : static_cast<long>(lastCreated + 1));
+  lastPoll = now;
+
+  auto entries = parseListing(json);
+  if (!entries.has_value()) {
+    ILOG(Warning, Support) << "Could not get a valid listing from db '" << databaseUrl << "' for '" << query << "'" << ENDM;
+    return;
+  }
+  if (full) {
+    needsFullListing = false;
+    lastFullListing = now;
+  }
+  merge(*entries);
+}
+
+void ListingWatcher::Group::merge(std::vector<ListingEntry>& entries)
+{
+  for (auto& entry : entries) {
+    lastCreated = std::max(lastCreated, getUnsigned(entry, metadata_keys::created));
+    auto path = entry.find("path");
+    if (path == entry.end() || paths.count(path->second) == 0) {
+      continue;
+    }
+    auto current = latest.find(path->second);
+    if (current == latest.end()) {
+      latest.emplace(path->second, std::move(entry));
+    } else if (getUnsigned(entry, metadata_keys::lastModified) >= getUnsigned(current->second, metadata_keys::lastModified)) {
+      current->second = std::move(entry);
+    }
+  }
+}
+
+ListingWatcher::Watch::Watch(std::shared_ptr<Group> group, std::string path) : mGroup(std::move(group)), mPath(std::move(path))
+{
+  std::lock_guard<std::mutex> lock(mGroup->mutex);
+  if (mGroup->paths.count(mPath) == 0) {
+    mGroup->needsFullListing = true;
+  }
+  mGroup->paths.insert(mPath);
+}
+
+ListingWatcher::Watch::~Watch()
+{
+  std::lock_guard<std::mutex> lock(mGroup->mutex);
+  mGroup->paths.erase(mGroup->paths.find(mPath));
+  if (mGroup->paths.count(mPath) == 0) {
+    mGroup->latest.erase(mPath);
+  }
+}
+
+std::optional<ListingEntry> ListingWatcher::Watch::getLatest()
+{
+  std::lock_guard<std::mutex> lock(mGroup->mutex);
+  mGroup->poll();
+  if (auto it = mGroup->latest.find(mPath); it != mGroup->latest.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+ListingWatcher& ListingWatcher::getInstance()
+{
+  static ListingWatcher instance;
+  return instance;
+}
+
+void ListingWatcher::setPollPeriod(std::chrono::milliseconds pollPeriod)
+{
+  std::lock_guard<std::mutex> lock(mMutex);
+  mPollPeriod = pollPeriod;
+  // the groups which already exist follow the new period as well
+  for (const auto& [key, weakGroup] : mGroups) {
+    if (auto group = weakGroup.lock(); group != nullptr) {
+      std::lock_guard<std::mutex> groupLock(group->mutex);
+      group->pollPeriod = pollPeriod;
+    }
+  }
+}
+
+std::unique_ptr<ListingWatcher::Watch> ListingWatcher::watch(const std::string& databaseUrl, const std::string& path, const std::map<std::string, std::string>& metadata)
+{
+  auto folder = path.substr(0, path.find_last_of('/'));
+  std::string groupKey = databaseUrl + '|' + folder;
+  for (const auto& [key, value] : metadata) {
+    groupKey += '/' + key + '=' + value;
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  auto group = mGroups[groupKey].lock();
+  if (group == nullptr) {
+    group = std::make_shared<Group>();
+    group->databaseUrl = databaseUrl;
+    group->folder = folder;
+    group->metadata = metadata;
+    group->pollPeriod = mPollPeriod;
+    group->db.connect(databaseUrl, "", "", "");
+    mGroups[groupKey] = group;
+  }
+  std::erase_if(mGroups, [](const auto& entry) { return entry.second.expired(); });
+  return std::make_unique<Watch>(group, path);
+}
+
+} // namespace o2::quality_control::repository
@@ -0,0 +1,117 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MonitorObjectCache.cxx
+///
+
+#include "QualityControl/MonitorObjectCache.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/LazyObjectInterface.h"
+#include "QualityControl/Activity.h"
+
+#include <TObjArray.h>
+
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::checker
+{
+
+std::vector<std::shared_ptr<MonitorObject>> MonitorObjectCache::ingest(std::unique_ptr<TObject> received, const std::string& taskName,
+                                                                        const std::string& detectorName, const Activity& activity)
+{
+  std::vector<std::shared_ptr<MonitorObject>> updated;
+  if (received == nullptr) {
+    return updated;
+  }
+
+  if (received->InheritsFrom(TObjArray::Class())) {
+    std::unique_ptr<TObjArray> array{ static_cast<TObjArray*>(received.release()) };
+    array->SetOwner(false); // we adopt the elements one by one
+    updated.reserve(array->GetEntriesFast());
+    for (auto* element : *array) {
+      if (element == nullptr) {
+        continue;
+      }
+      if (auto* mo = dynamic_cast<MonitorObject*>(element)) {
+        mo->setIsOwner(true);
+        updated.emplace_back(mo);
+      } else {
+        updated.push_back(encapsulate(element, taskName, detectorName, activity));
+      }
+    }
+    if (auto* collection = dynamic_cast<MonitorObjectCollection*>(array.get())) {
+      for (const auto& name : collection->getUnchangedObjects()) {
+        if (auto mo = refresh(collection->getTaskName() + "/" + name, collection->getUnchangedObjectsValidity())) {
+          updated.push_back(std::move(mo));
+        }
+      }
+    }
+  } else if (auto* mo = dynamic_cast<MonitorObject*>(received.get())) {
+    received.release();
+    mo->setIsOwner(true);
+    updated.emplace_back(mo);
+  } else {
+    updated.push_back(encapsulate(received.release(), taskName, detectorName, activity));
+  }
+
+  for (const auto& mo : updated) {
+    // objects which travel without their derived content get it here, once for all the checks and the storage
+    if (auto* lazyObject = dynamic_cast<LazyObjectInterface*>(mo->getObject())) {
+      lazyObject->computeLazyContent();
+    }
+    mMonitorObjects[mo->getFullName()] = mo;
+  }
+  return updated;
+}
+
+std::shared_ptr<MonitorObject> MonitorObjectCache::encapsulate(TObject* object, const std::string& taskName,
+                                                               const std::string& detectorName, const Activity& activity)
+{
+  auto cached = mMonitorObjects.find(taskName + "/" + object->GetName());
+  // we can reuse the previous shell only if nobody else (e.g. a pending upload) holds it
+  if (cached != mMonitorObjects.end() && cached->second.use_count() == 1 && cached->second->isIsOwner()) {
+    auto& mo = cached->second;
+    // the move-assignment deletes the previous payload and drops any state left by the previous cycle (e.g. metadata)
+    *mo = MonitorObject(object, taskName, "CheckRunner", detectorName);
+    mo->setActivity(activity);
+    mNumberReusedShells++;
+    return mo;
+  }
+
+  auto mo = std::make_shared<MonitorObject>(object, taskName, "CheckRunner", detectorName);
+  mo->setActivity(activity);
+  mo->setIsOwner(true);
+  return mo;
+}
+
+std::shared_ptr<MonitorObject> MonitorObjectCache::refresh(const std::string& fullName, ValidityInterval validity)
+{
+  auto cached = mMonitorObjects.find(fullName);
+  if (cached == mMonitorObjects.end()) {
+    // we cannot do anything without the content of the object, it will come once it is modified
+    return nullptr;
+  }
+  if (cached->second.use_count() > 1) {
+    // somebody else (e.g. a pending upload) still reads the previous version, so we do not modify it
+    cached->second = std::make_shared<MonitorObject>(*cached->second);
+  }
+  cached->second->setValidity(validity);
+  return cached->second;
+}
+
+void MonitorObjectCache::clear()
+{
+  mMonitorObjects.clear();
+}
+
+} // namespace o2::quality_control::checker
@@ -21,6 +21,8 @@
 #include <Mergers/MergerAlgorithm.h>
 #include <TNamed.h>
 
+#include <algorithm>
+
 using namespace o2::mergers;
 
 namespace o2::quality_control::core
@@ -86,9 +88,48 @@ void MonitorObjectCollection::merge(mergers::MergeInterface* const other)
       // A corresponding object in the target collection could not be found.
       // We prefer to clone instead of passing the pointer in order to simplify deleting the `other`.
       this->Add(otherObject->Clone());
+      // it is not unchanged anymore, since we have its content now
+      std::erase(mUnchangedObjects, otherObjectName);
     }
   }
   delete otherIterator;
+
+  for (const auto& unchangedName : otherCollection->mUnchangedObjects) {
+    if (auto targetMO = dynamic_cast<MonitorObject*>(this->FindObject(unchangedName.c_str()))) {
+      // same as merging an empty object
+      if (targetMO->getValidity().isInvalid()) {
+        targetMO->setValidity(otherCollection->mUnchangedObjectsValidity);
+      } else if (otherCollection->mUnchangedObjectsValidity.isValid()) {
+        targetMO->updateValidity(otherCollection->mUnchangedObjectsValidity.getMin());
+        targetMO->updateValidity(otherCollection->mUnchangedObjectsValidity.getMax());
+      }
+    } else {
+      addUnchangedObject(unchangedName, otherCollection->mUnchangedObjectsValidity);
+    }
+  }
+}
+
+void MonitorObjectCollection::addUnchangedObject(const std::string& name, ValidityInterval validity)
+{
+  if (std::find(mUnchangedObjects.begin(), mUnchangedObjects.end(), name) == mUnchangedObjects.end()) {
+    mUnchangedObjects.push_back(name);
+  }
+  if (mUnchangedObjectsValidity.isInvalid()) {
+    mUnchangedObjectsValidity = validity;
+  } else if (validity.isValid()) {
+    mUnchangedObjectsValidity.update(validity.getMin());
+    mUnchangedObjectsValidity.update(validity.getMax());
+  }
+}
+
+const std::vector<std::string>& MonitorObjectCollection::getUnchangedObjects() const
+{
+  return mUnchangedObjects;
+}
+
+ValidityInterval MonitorObjectCollection::getUnchangedObjectsValidity() const
+{
+  return mUnchangedObjectsValidity;
 }
 
 void MonitorObjectCollection::postDeserialization()
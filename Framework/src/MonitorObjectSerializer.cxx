@@ -0,0 +1,112 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   MonitorObjectSerializer.cxx
+///
+
+#include "QualityControl/MonitorObjectSerializer.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/ThreadPool.h"
+
+#include <Common/Timer.h>
+#include <TMessage.h>
+#include <TROOT.h>
+
+#include <future>
+
+namespace o2::quality_control::core
+{
+
+MonitorObjectSerializer::MonitorObjectSerializer(size_t nThreads)
+{
+  // the objects are serialized in the worker threads
+  ROOT::EnableThreadSafety();
+  mPool = std::make_unique<ThreadPool>(nThreads);
+}
+
+MonitorObjectSerializer::~MonitorObjectSerializer() = default;
+
+size_t MonitorObjectSerializer::getNThreads() const
+{
+  return mPool->size();
+}
+
+std::unique_ptr<TMessage> MonitorObjectSerializer::serializeCollection(const MonitorObjectCollection& collection)
+{
+  // the same layout as the one produced by the DPL for ROOT-serialized objects
+  auto message = std::make_unique<TMessage>(kMESS_OBJECT);
+  message->WriteObjectAny(&collection, MonitorObjectCollection::Class());
+  message->SetLength();
+  return message;
+}
+
+std::vector<MonitorObjectSerializer::Part> MonitorObjectSerializer::serialize(const MonitorObjectCollection& collection)
+{
+  std::vector<MonitorObject*> objects;
+  for (auto* tobj : collection) {
+    if (auto* mo = dynamic_cast<MonitorObject*>(tobj)) {
+      objects.push_back(mo);
+    }
+  }
+
+  auto serializePart = [&collection](MonitorObject* mo, bool withUnchangedObjects) {
+    AliceO2::Common::Timer timer;
+    MonitorObjectCollection partCollection;
+    partCollection.SetOwner(false);
+    partCollection.SetName(collection.GetName());
+    partCollection.setDetector(collection.getDetector());
+    partCollection.setTaskName(collection.getTaskName());
+    if (mo != nullptr) {
+      partCollection.Add(mo);
+    }
+    if (withUnchangedObjects) {
+      for (const auto& name : collection.getUnchangedObjects()) {
+        partCollection.addUnchangedObject(name, collection.getUnchangedObjectsValidity());
+      }
+    }
+
+    Part part;
+    part.objectName = mo != nullptr ? mo->getName() : "";
+    part.message = serializeCollection(partCollection);
+    part.durationMs = timer.getTime() * 1000;
+    return part;
+  };
+
+  std::vector<Part> parts;
+  if (objects.empty()) {
+    parts.push_back(serializePart(nullptr, true));
+    return parts;
+  }
+
+  std::vector<std::future<Part>> futures;
+  futures.reserve(objects.size());
+  for (size_t i = 0; i < objects.size(); i++) {
+    futures.push_back(mPool->submit([&serializePart, mo = objects[i], first = i == 0]() { return serializePart(mo, first); }));
+  }
+  // we wait for all the parts, even if one of them fails, because they refer to local variables
+  std::exception_ptr error;
+  parts.reserve(futures.size());
+  for (auto& future : futures) {
+    try {
+      parts.push_back(future.get());
+    } catch (...) {
+      error = error ? error : std::current_exception();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return parts;
+}
+
+} // namespace o2::quality_control::core
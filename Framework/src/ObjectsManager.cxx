@@ -21,6 +21,7 @@
 #include "QualityControl/MonitorObjectCollection.h"
 #include <Common/Exceptions.h>
 #include <TObjArray.h>
+#include <TH1.h>
 
 #include <utility>
 #include <algorithm>
@@ -67,7 +68,7 @@ void ObjectsManager::startPublishingImpl(TObject* object, PublicationPolicy publ
     return;
   }
 
-  if (mMonitorObjects->FindObject(object->GetName()) != nullptr) {
+  if (findMonitorObject(object->GetName()) != nullptr) {
     ILOG(Warning, Support) << "Object is already being published (" << object->GetName() << "), will remove it and add the new one" << ENDM;
     stopPublishing(object->GetName());
   }
@@ -81,6 +82,9 @@ void ObjectsManager::startPublishingImpl(TObject* object, PublicationPolicy publ
   newObject->setActivity(mActivity);
   newObject->setCreateMovingWindow(std::find(mMovingWindowsList.begin(), mMovingWindowsList.end(), object->GetName()) != mMovingWindowsList.end());
   mMonitorObjects->Add(newObject);
+  mObjectsByName[object->GetName()] = newObject;
+  mObjectsByPayload[object] = newObject;
+  mRegistrations[newObject] = { object->GetName(), mMonitorObjects->GetLast() };
   mUpdateServiceDiscovery = true;
   mPublicationPoliciesForMOs[newObject] = publicationPolicy;
 }
@@ -120,29 +124,48 @@ void ObjectsManager::stopPublishing(TObject* object)
     ILOG(Warning, Support) << "A nullptr provided to ObjectManager::stopPublishing" << ENDM;
     return;
   }
-  // We look for the MonitorObject which observes the provided object by comparing its address
+  // We look for the MonitorObject which observes the provided object by its address
   // This way, we avoid invoking any methods of the provided object, thus we can stop publishing it even after it is deleted
-  MonitorObject* moToRemove = nullptr;
-  for (auto moAsTObject : *mMonitorObjects) {
-    auto mo = dynamic_cast<MonitorObject*>(moAsTObject);
-    if (mo && mo->getObject() == object) {
-      moToRemove = mo;
-      continue;
-    }
-  }
-  if (moToRemove) {
-    mPublicationPoliciesForMOs.erase(moToRemove);
-    mMonitorObjects->Remove(moToRemove);
-    mMonitorObjects->Compress();
+  auto moToRemove = mObjectsByPayload.find(object);
+  if (moToRemove != mObjectsByPayload.end()) {
+    removeMonitorObject(moToRemove->second);
   }
 }
 
 void ObjectsManager::stopPublishing(const string& objectName)
 {
-  auto* mo = dynamic_cast<MonitorObject*>(getMonitorObject(objectName));
+  removeMonitorObject(getMonitorObject(objectName));
+}
+
+void ObjectsManager::removeMonitorObject(MonitorObject* mo)
+{
+  auto registration = mRegistrations.find(mo);
+  if (registration == mRegistrations.end()) {
+    return;
+  }
   mPublicationPoliciesForMOs.erase(mo);
-  mMonitorObjects->Remove(mo);
+  mModificationStates.erase(mo);
+  mObjectsByName.erase(registration->second.name);
+  mObjectsByPayload.erase(mo->getObject());
+  // the slot is left empty, so the order of the other objects is kept without moving them
+  mMonitorObjects->RemoveAt(registration->second.slot);
+  mRegistrations.erase(registration);
+  mEmptySlots++;
+  if (mEmptySlots > mRegistrations.size()) {
+    compact();
+  }
+}
+
+void ObjectsManager::compact()
+{
+  if (mEmptySlots == 0) {
+    return;
+  }
   mMonitorObjects->Compress();
+  for (int slot = 0; slot <= mMonitorObjects->GetLast(); slot++) {
+    mRegistrations[dynamic_cast<MonitorObject*>(mMonitorObjects->UncheckedAt(slot))].slot = slot;
+  }
+  mEmptySlots = 0;
 }
 
 void ObjectsManager::stopPublishing(PublicationPolicy policy)
@@ -164,25 +187,37 @@ void ObjectsManager::stopPublishingAll()
   removeAllFromServiceDiscovery();
   mMonitorObjects->Clear();
   mPublicationPoliciesForMOs.clear();
+  mModificationStates.clear();
+  mObjectsByName.clear();
+  mObjectsByPayload.clear();
+  mRegistrations.clear();
+  mEmptySlots = 0;
 }
 
 bool ObjectsManager::isBeingPublished(const string& name)
 {
-  return (mMonitorObjects->FindObject(name.c_str()) != nullptr);
+  return findMonitorObject(name) != nullptr;
+}
+
+MonitorObject* ObjectsManager::findMonitorObject(const std::string& objectName) const
+{
+  auto mo = mObjectsByName.find(objectName);
+  return mo != mObjectsByName.end() ? mo->second : nullptr;
 }
 
 MonitorObject* ObjectsManager::getMonitorObject(const std::string& objectName)
 {
-  TObject* object = mMonitorObjects->FindObject(objectName.c_str());
+  MonitorObject* object = findMonitorObject(objectName);
   if (object == nullptr) {
     ILOG(Error, Support) << "ObjectsManager: Unable to find object \"" << objectName << "\"" << ENDM;
     BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(objectName));
   }
-  return dynamic_cast<MonitorObject*>(object);
+  return object;
 }
 
 MonitorObject* ObjectsManager::getMonitorObject(size_t index)
 {
+  compact();
   TObject* object = mMonitorObjects->At(index);
   if (object == nullptr) {
     ILOG(Error, Support) << "ObjectsManager: Unable to find object at index \"" << index << "\"" << ENDM;
@@ -192,11 +227,88 @@ MonitorObject* ObjectsManager::getMonitorObject(size_t index)
   return dynamic_cast<MonitorObject*>(object);
 }
 
-MonitorObjectCollection* ObjectsManager::getNonOwningArray() const
+MonitorObjectCollection* ObjectsManager::getNonOwningArray()
 {
+  compact();
   return new MonitorObjectCollection(*mMonitorObjects);
 }
 
+MonitorObjectCollection* ObjectsManager::getNonOwningArrayOfModified()
+{
+  auto* array = new MonitorObjectCollection();
+  array->SetOwner(false);
+  array->SetName(mMonitorObjects->GetName());
+  array->setDetector(mMonitorObjects->getDetector());
+  array->setTaskName(mMonitorObjects->getTaskName());
+
+  for (auto* tobj : *mMonitorObjects) {
+    auto* mo = dynamic_cast<MonitorObject*>(tobj);
+    if (mo == nullptr) {
+      continue;
+    }
+    if (isModified(mo)) {
+      array->Add(mo);
+    } else {
+      array->addUnchangedObject(mo->getName(), mo->getValidity());
+    }
+    auto* histogram = dynamic_cast<TH1*>(mo->getObject());
+    mModificationStates[mo] = { histogram ? histogram->GetEntries() : -1, false, false };
+  }
+  return array;
+}
+
+MonitorObjectCollection* ObjectsManager::copyArray(const MonitorObjectCollection& array, const std::function<TObject*(const TObject&)>& copier)
+{
+  auto* copy = new MonitorObjectCollection();
+  copy->SetOwner(true);
+  copy->SetName(array.GetName());
+  copy->setDetector(array.getDetector());
+  copy->setTaskName(array.getTaskName());
+  for (const auto& name : array.getUnchangedObjects()) {
+    copy->addUnchangedObject(name, array.getUnchangedObjectsValidity());
+  }
+
+  for (auto* tobj : array) {
+    auto* mo = dynamic_cast<MonitorObject*>(tobj);
+    if (mo == nullptr || mo->getObject() == nullptr) {
+      continue;
+    }
+    // the copy constructor does not clone the object of a MonitorObject which does not own it, we do it ourselves
+    auto* moCopy = new MonitorObject(*mo);
+    moCopy->setObject(copier(*mo->getObject()));
+    moCopy->setIsOwner(true);
+    copy->Add(moCopy);
+  }
+  return copy;
+}
+
+bool ObjectsManager::isModified(const MonitorObject* mo) const
+{
+  auto state = mModificationStates.find(mo);
+  auto* histogram = dynamic_cast<TH1*>(mo->getObject());
+  if (state == mModificationStates.end() || state->second.modified || histogram == nullptr || state->second.publishedEntries < 0) {
+    return true;
+  }
+  auto entries = histogram->GetEntries();
+  if (state->second.reset) {
+    // the consumers have the content of the previous publication, which is the same only if it was also empty
+    return entries != 0 || state->second.publishedEntries != 0;
+  }
+  return entries != state->second.publishedEntries;
+}
+
+void ObjectsManager::setModified(const std::string& objectName)
+{
+  mModificationStates[getMonitorObject(objectName)].modified = true;
+}
+
+void ObjectsManager::setAllReset()
+{
+  for (auto& [mo, state] : mModificationStates) {
+    state.reset = true;
+  }
+}
+
 void ObjectsManager::addMetadata(const std::string& objectName, const std::string& key, const std::string& value)
 {
   MonitorObject* mo = getMonitorObject(objectName);
@@ -213,7 +325,7 @@ void ObjectsManager::addOrUpdateMetadata(const std::string& objectName, const st
 
 size_t ObjectsManager::getNumberPublishedObjects()
 {
-  return mMonitorObjects->GetLast() + 1; // GetLast returns the index
+  return mRegistrations.size();
 }
 
 void ObjectsManager::setDefaultDrawOptions(const std::string& objectName, const std::string& options)
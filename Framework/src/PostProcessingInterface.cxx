@@ -37,6 +37,16 @@ void PostProcessingInterface::configure()
 {
 }
 
+std::unique_ptr<PreparedUpdate> PostProcessingInterface::prepareUpdate(Trigger, framework::ServiceRegistryRef)
+{
+  return nullptr;
+}
+
+void PostProcessingInterface::finishUpdate(Trigger trigger, framework::ServiceRegistryRef services, std::unique_ptr<PreparedUpdate>)
+{
+  update(std::move(trigger), services);
+}
+
 void PostProcessingInterface::setObjectsManager(std::shared_ptr<core::ObjectsManager> objectsManager)
 {
   mObjectsManager = std::move(objectsManager);
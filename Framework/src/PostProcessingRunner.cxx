@@ -27,14 +27,23 @@
 #include "QualityControl/MonitorObjectCollection.h"
 #include "QualityControl/Bookkeeping.h"
 #include "QualityControl/ActivityHelpers.h"
+#include "QualityControl/DatabaseCache.h"
+#include "QualityControl/ThreadPool.h"
 
+#include <boost/exception/diagnostic_information.hpp>
+#include <deque>
+#include <future>
+#include <mutex>
 #include <utility>
 #include <Framework/DataAllocator.h>
 #include <CommonUtils/ConfigurableParam.h>
+#include <Monitoring/MonitoringFactory.h>
+#include <TROOT.h>
 #include <TSystem.h>
 
 using namespace o2::quality_control::core;
 using namespace o2::quality_control::repository;
+using namespace o2::monitoring;
 
 namespace o2::quality_control::postprocessing
 {
@@ -101,6 +110,11 @@ void PostProcessingRunner::init(const PostProcessingRunnerConfig& runnerConfig,
     mPublicationCallback = publishToRepository(*mDestinationDatabase);
   }
   Bookkeeping::getInstance().init(runnerConfig.bookkeepingUrl);
+  if (!mRunnerConfig.monitoringUrl.empty()) {
+    mCollector = MonitoringFactory::Get(mRunnerConfig.monitoringUrl);
+    mCollector->addGlobalTag(tags::Key::Subsystem, tags::Value::QC);
+    mCollector->addGlobalTag("TaskName", mTaskConfig.taskName);
+  }
 
   // setup user's task
   ILOG(Debug, Devel) << "Creating a user task '" << mTaskConfig.taskName << "'" << ENDM;
@@ -167,12 +181,84 @@ void PostProcessingRunner::runOverTimestamps(const std::vector<uint64_t>& timest
   ILOG(Info, Support) << "Running the task '" << mTask->getName() << "' (det " << mRunnerConfig.detectorName << ") over " << timestamps.size() << " timestamps." << ENDM;
 
   doInitialize({ TriggerType::UserOrControl, false, mTaskConfig.activity, timestamps.front() });
-  for (size_t i = 1; i < timestamps.size() - 1; i++) {
-    doUpdate({ TriggerType::UserOrControl, i == timestamps.size() - 2, mTaskConfig.activity, timestamps[i] });
+  if (mRunnerConfig.backfillThreads > 0) {
+    std::vector<Trigger> triggers;
+    for (size_t i = 1; i < timestamps.size() - 1; i++) {
+      triggers.push_back({ TriggerType::UserOrControl, i == timestamps.size() - 2, mTaskConfig.activity, timestamps[i] });
+    }
+    runBackfill(triggers);
+  } else {
+    for (size_t i = 1; i < timestamps.size() - 1; i++) {
+      doUpdate({ TriggerType::UserOrControl, i == timestamps.size() - 2, mTaskConfig.activity, timestamps[i] });
+    }
   }
   doFinalize({ TriggerType::UserOrControl, false, mTaskConfig.activity, timestamps.back() });
 }
 
+void PostProcessingRunner::runBackfill(const std::vector<Trigger>& triggers)
+{
+  const size_t nThreads = mRunnerConfig.backfillThreads;
+  ILOG(Info, Support) << "Preparing the updates with " << nThreads << " thread(s)" << ENDM;
+
+  // the preparations run concurrently, thus each of them gets a separate database connection
+  struct Worker {
+    std::unique_ptr<DatabaseInterface> database;
+    framework::ServiceRegistry services;
+  };
+  std::vector<std::unique_ptr<Worker>> workers;
+  for (size_t i = 0; i < nThreads; i++) {
+    auto worker = std::make_unique<Worker>();
+    worker->database = configureDatabase(mRunnerConfig.sourceDatabase, "Backfill source");
+    worker->services.registerService<DatabaseInterface>(worker->database.get());
+    workers.push_back(std::move(worker));
+  }
+  std::mutex workersMutex;
+
+  ROOT::EnableThreadSafety();
+  auto prepare = [&](const Trigger& trigger) {
+    std::unique_ptr<Worker> worker;
+    {
+      std::lock_guard<std::mutex> lock(workersMutex);
+      worker = std::move(workers.back());
+      workers.pop_back();
+    }
+    std::unique_ptr<PreparedUpdate> prepared;
+    try {
+      prepared = mTask->prepareUpdate(trigger, worker->services);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(workersMutex);
+      workers.push_back(std::move(worker));
+      throw;
+    }
+    std::lock_guard<std::mutex> lock(workersMutex);
+    workers.push_back(std::move(worker));
+    return prepared;
+  };
+
+  // we prepare a limited number of updates ahead, so the memory usage does not depend on the number of timestamps
+  const size_t window = 2 * nThreads;
+  std::deque<std::future<std::unique_ptr<PreparedUpdate>>> pending;
+  // the pool is declared last, so that its destructor, which executes the preparations still in the queue
+  // (e.g. when an update throws), runs while everything they use is alive
+  ThreadPool pool(nThreads);
+  size_t nextToPrepare = 0;
+  for (const auto& trigger : triggers) {
+    while (nextToPrepare < triggers.size() && pending.size() < window) {
+      pending.push_back(pool.submit([&prepare, &trigger = triggers[nextToPrepare]]() { return prepare(trigger); }));
+      nextToPrepare++;
+    }
+    std::unique_ptr<PreparedUpdate> prepared;
+    try {
+      prepared = pending.front().get();
+    } catch (...) {
+      ILOG(Warning, Support) << "Could not prepare the update for trigger '" << trigger << "', it will be done without preparation: "
+                             << boost::current_exception_diagnostic_information(true) << ENDM;
+    }
+    pending.pop_front();
+    doUpdate(trigger, std::move(prepared));
+  }
+}
+
 void PostProcessingRunner::start(framework::ServiceRegistryRef dplServices)
 {
   Activity activityFromDriver = mTaskConfig.activity;
@@ -293,10 +379,14 @@ void PostProcessingRunner::doInitialize(const Trigger& trigger)
   mStopTriggers = trigger_helpers::createTriggers(mTaskConfig.stopTriggers, taskConfigWithCorrectActivity);
 }
 
-void PostProcessingRunner::doUpdate(const Trigger& trigger)
+void PostProcessingRunner::doUpdate(const Trigger& trigger, std::unique_ptr<PreparedUpdate> prepared)
 {
   ILOG(Info, Support) << "Updating the user task due to trigger '" << trigger << "'" << ENDM;
-  mTask->update(trigger, mServices);
+  if (prepared != nullptr) {
+    mTask->finishUpdate(trigger, mServices, std::move(prepared));
+  } else {
+    mTask->update(trigger, mServices);
+  }
   updateValidity(trigger);
 
   if (mActivity.mValidity.isValid()) {
@@ -305,6 +395,27 @@ void PostProcessingRunner::doUpdate(const Trigger& trigger)
   } else {
     ILOG(Warning, Support) << "Objects will not be published because their validity is invalid. This should not happen." << ENDM;
   }
+  sendMonitoring();
+}
+
+void PostProcessingRunner::sendMonitoring()
+{
+  if (mCollector == nullptr) {
+    return;
+  }
+  if (const auto* cache = mSourceDatabase->getCache()) {
+    auto stats = cache->getStats();
+    mCollector->send(Metric{ "qc_postprocessing_db_cache" }
+                       .addValue(stats.hits, "hits")
+                       .addValue(stats.revalidated, "revalidated")
+                       .addValue(stats.misses, "misses")
+                       .addValue(stats.hitRate, "hit_rate")
+                       .addValue(stats.listingHits, "listing_hits")
+                       .addValue(stats.listingMisses, "listing_misses")
+                       .addValue(stats.evictions, "evictions")
+                       .addValue(stats.entries, "entries")
+                       .addValue(stats.bytes, "bytes"));
+  }
 }
 
 void PostProcessingRunner::doFinalize(const Trigger& trigger)
@@ -348,7 +459,9 @@ PostProcessingRunnerConfig PostProcessingRunner::extractConfig(const CommonSpec&
     commonSpec.infologgerDiscardParameters,
     commonSpec.postprocessingPeriod,
     "",
-    ppTaskSpec.tree
+    ppTaskSpec.tree,
+    commonSpec.monitoringUrl,
+    ppTaskSpec.backfillThreads
   };
 }
 
@@ -16,6 +16,7 @@
 
 #include "QualityControl/QcInfoLogger.h"
 #include <boost/property_tree/ptree.hpp>
+#include <climits>
 
 namespace o2::quality_control::core
 {
@@ -24,6 +25,12 @@ AliceO2::InfoLogger::InfoLogger* QcInfoLogger::instance;
 AliceO2::InfoLogger::InfoLoggerContext* QcInfoLogger::mContext;
 QcInfoLogger::_init QcInfoLogger::_initializer;
 bool QcInfoLogger::disabled = false;
+bool QcInfoLogger::sFilterDiscardDebug = false;
+int QcInfoLogger::sFilterDiscardLevel = INT_MAX;
+bool QcInfoLogger::sDiscardToFile = false;
+bool QcInfoLogger::sDebugInDiscardFile = false;
+int QcInfoLogger::sDiscardedFromLevel = INT_MAX;
+int QcInfoLogger::sDebugDiscardedFromLevel = INT_MAX;
 
 void QcInfoLogger::setFacility(const std::string& facility)
 {
@@ -63,8 +70,43 @@ void QcInfoLogger::setPartition(const std::string& partitionName)
 void QcInfoLogger::disable()
 {
   QcInfoLogger::disabled = true;
-  ILOG_INST.filterDiscardDebug(true);
-  ILOG_INST.filterDiscardLevel(1);
+  filterDiscardDebug(true);
+  filterDiscardLevel(1);
+}
+
+void QcInfoLogger::filterDiscardDebug(bool discard)
+{
+  ILOG_INST.filterDiscardDebug(discard);
+  sFilterDiscardDebug = discard;
+  updateDiscardedLevels();
+}
+
+void QcInfoLogger::filterDiscardLevel(int fromLevel)
+{
+  ILOG_INST.filterDiscardLevel(fromLevel);
+  sFilterDiscardLevel = fromLevel;
+  updateDiscardedLevels();
+}
+
+void QcInfoLogger::filterDiscardSetFile(const std::string& file, unsigned long rotateMaxBytes, unsigned int rotateMaxFiles, bool debugInDiscardFile)
+{
+  ILOG_INST.filterDiscardSetFile(file.c_str(), rotateMaxBytes, rotateMaxFiles, 0, !debugInDiscardFile /*Do not store Debug messages in file*/);
+  sDiscardToFile = !file.empty();
+  sDebugInDiscardFile = debugInDiscardFile;
+  updateDiscardedLevels();
+}
+
+void QcInfoLogger::updateDiscardedLevels()
+{
+  // we skip only what the InfoLogger would drop, the messages which go to the discard file have to be formatted.
+  // levels below 1 are not used by the messages, so we let the InfoLogger deal with such filters.
+  const int discardLevel = sFilterDiscardLevel >= 1 ? sFilterDiscardLevel : INT_MAX;
+  sDiscardedFromLevel = sDiscardToFile ? INT_MAX : discardLevel;
+  if (sDiscardToFile && sDebugInDiscardFile) {
+    sDebugDiscardedFromLevel = INT_MAX;
+  } else {
+    sDebugDiscardedFromLevel = sFilterDiscardDebug ? INT_MIN : discardLevel;
+  }
 }
 
 using namespace std;
@@ -83,14 +125,14 @@ void QcInfoLogger::init(const std::string& facility,
   }
 
   // Set the proper discard filters
-  ILOG_INST.filterDiscardDebug(discardParameters.debug);
-  ILOG_INST.filterDiscardLevel(discardParameters.fromLevel);
+  filterDiscardDebug(discardParameters.debug);
+  filterDiscardLevel(discardParameters.fromLevel);
   if (disabled) {
-    ILOG_INST.filterDiscardDebug(true);
-    ILOG_INST.filterDiscardLevel(1);
+    filterDiscardDebug(true);
+    filterDiscardLevel(1);
   }
   if (!discardParameters.file.empty()) {
-    ILOG_INST.filterDiscardSetFile(discardParameters.file.c_str(), discardParameters.rotateMaxBytes, discardParameters.rotateMaxFiles, 0, !discardParameters.debugInDiscardFile /*Do not store Debug messages in file*/);
+    filterDiscardSetFile(discardParameters.file, discardParameters.rotateMaxBytes, discardParameters.rotateMaxFiles, discardParameters.debugInDiscardFile);
   }
   ILOG(Debug, Support) << "QC infologger initialized : " << discardParameters.debug << " ; " << discardParameters.fromLevel << ENDM;
   ILOG(Debug, Devel) << "   Discard debug ? " << discardParameters.debug << " / Discard from level ? " << discardParameters.fromLevel << " / Discard to file ? " << (!discardParameters.file.empty() ? discardParameters.file : "No") << " / Discard max bytes and files ? " << discardParameters.rotateMaxBytes << " = " << discardParameters.rotateMaxFiles << " / Put discarded debug messages in file ? " << discardParameters.debugInDiscardFile << ENDM;
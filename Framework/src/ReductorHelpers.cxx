@@ -59,4 +59,45 @@ bool updateReductorImpl(Reductor* r, const Trigger& t, const std::string& path,
   return false;
 }
 
+std::vector<bool> updateReductorsImpl(const std::vector<DataSourceDescription>& sources, const Trigger& t,
+                                      repository::DatabaseInterface& qcdb, core::ConditionAccess& ccdbAccess)
+{
+  using Request = repository::DatabaseInterface::RetrievalRequest;
+
+  // we retrieve all the repository objects at once, the conditions are left to ConditionAccess
+  std::vector<Request> requests;
+  std::vector<size_t> requestIndices(sources.size(), sources.size());
+  for (size_t i = 0; i < sources.size(); i++) {
+    const auto& source = sources[i];
+    if (source.reductor == nullptr) {
+      continue;
+    }
+    if (source.type == "repository") {
+      requestIndices[i] = requests.size();
+      requests.push_back({ Request::Type::MonitorObject, source.path, source.name, static_cast<long>(t.timestamp), t.activity });
+    } else if (source.type == "repository-quality") {
+      requestIndices[i] = requests.size();
+      requests.push_back({ Request::Type::QualityObject, source.path, source.name, static_cast<long>(t.timestamp), t.activity });
+    }
+  }
+  auto results = qcdb.retrieveMany(requests);
+
+  std::vector<bool> updated(sources.size(), false);
+  for (size_t i = 0; i < sources.size(); i++) {
+    const auto& source = sources[i];
+    if (requestIndices[i] == sources.size()) {
+      updated[i] = updateReductorImpl(source.reductor, t, source.path, source.name, source.type, qcdb, ccdbAccess);
+      continue;
+    }
+    const auto& result = results[requestIndices[i]];
+    auto reductorTObject = dynamic_cast<ReductorTObject*>(source.reductor);
+    TObject* obj = result.monitorObject ? result.monitorObject->getObject() : result.qualityObject.get();
+    if (obj && reductorTObject) {
+      reductorTObject->update(obj);
+      updated[i] = true;
+    }
+  }
+  return updated;
+}
+
 } // namespace o2::quality_control::postprocessing::reductor_helpers::implementation
\ No newline at end of file
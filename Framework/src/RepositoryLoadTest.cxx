@@ -0,0 +1,392 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RepositoryLoadTest.cxx
+///
+
+#include "QualityControl/RepositoryLoadTest.h"
+#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/CcdbStandIn.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/RepoPathUtils.h"
+
+#include "rapidjson/prettywriter.h"
+#include "rapidjson/stringbuffer.h"
+
+#include <Common/Exceptions.h>
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <TFile.h>
+#include <TH1F.h>
+#include <TKey.h>
+#include <TROOT.h>
+
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <numeric>
+#include <random>
+#include <thread>
+
+using namespace std::chrono;
+using namespace AliceO2::Common;
+using namespace o2::quality_control::core;
+
+namespace o2::quality_control::repository
+{
+
+std::string toString(LoadTestOperation operation)
+{
+  switch (operation) {
+    case LoadTestOperation::Store:
+      return "store";
+    case LoadTestOperation::Retrieve:
+      return "retrieve";
+    case LoadTestOperation::LatestValidity:
+      return "validity";
+    case LoadTestOperation::Listing:
+      return "listing";
+  }
+  return "unknown";
+}
+
+std::array<double, nLoadTestOperations> RepositoryLoadTestConfig::parseMix(const std::string& mix)
+{
+  std::array<double, nLoadTestOperations> weights{};
+  std::vector<std::string> entries;
+  boost::split(entries, mix, boost::is_any_of(","));
+  for (const auto& entry : entries) {
+    auto separator = entry.find('=');
+    auto name = boost::trim_copy(entry.substr(0, separator));
+    if (name.empty()) {
+      continue;
+    }
+    size_t i = 0;
+    while (i < nLoadTestOperations && toString(static_cast<LoadTestOperation>(i)) != name) {
+      i++;
+    }
+    if (i == nLoadTestOperations || separator == std::string::npos) {
+      BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Invalid entry '" + entry + "' in the mix of operations, expected e.g. 'store=1,retrieve=8,validity=2,listing=1'"));
+    }
+    weights[i] = std::stod(entry.substr(separator + 1));
+  }
+  if (std::accumulate(weights.begin(), weights.end(), 0.0) <= 0) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("The mix of operations '" + mix + "' does not contain any operation"));
+  }
+  return weights;
+}
+
+LatencySummary LatencySummary::fromLatencies(std::vector<double>& latenciesMs, uint64_t errors, double durationS)
+{
+  LatencySummary summary;
+  summary.count = latenciesMs.size();
+  summary.errors = errors;
+  if (latenciesMs.empty()) {
+    return summary;
+  }
+  std::sort(latenciesMs.begin(), latenciesMs.end());
+  // the nearest-rank method
+  auto percentile = [&latenciesMs](double p) {
+    auto rank = static_cast<size_t>(std::ceil(p * latenciesMs.size()));
+    return latenciesMs[std::clamp<size_t>(rank, 1, latenciesMs.size()) - 1];
+  };
+  summary.throughput = durationS > 0 ? summary.count / durationS : 0;
+  summary.meanMs = std::accumulate(latenciesMs.begin(), latenciesMs.end(), 0.0) / latenciesMs.size();
+  summary.p50Ms = percentile(0.5);
+  summary.p99Ms = percentile(0.99);
+  summary.p999Ms = percentile(0.999);
+  summary.maxMs = latenciesMs.back();
+  return summary;
+}
+
+std::string RepositoryLoadTestResults::toJson() const
+{
+  rapidjson::StringBuffer buffer;
+  rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+  auto writeSummary = [&writer](const LatencySummary& summary) {
+    writer.StartObject();
+    writer.Key("count");
+    writer.Uint64(summary.count);
+    writer.Key("errors");
+    writer.Uint64(summary.errors);
+    writer.Key("throughput");
+    writer.Double(summary.throughput);
+    writer.Key("meanMs");
+    writer.Double(summary.meanMs);
+    writer.Key("p50Ms");
+    writer.Double(summary.p50Ms);
+    writer.Key("p99Ms");
+    writer.Double(summary.p99Ms);
+    writer.Key("p999Ms");
+    writer.Double(summary.p999Ms);
+    writer.Key("maxMs");
+    writer.Double(summary.maxMs);
+    writer.EndObject();
+  };
+
+  writer.StartObject();
+  writer.Key("databaseUrl");
+  writer.String(databaseUrl.c_str());
+  writer.Key("threads");
+  writer.Uint64(threads);
+  writer.Key("objects");
+  writer.Uint64(objects);
+  writer.Key("payloadBytes");
+  writer.Uint64(payloadBytes);
+  writer.Key("durationS");
+  writer.Double(durationS);
+  writer.Key("operations");
+  writer.StartObject();
+  for (size_t i = 0; i < nLoadTestOperations; i++) {
+    writer.Key(toString(static_cast<LoadTestOperation>(i)).c_str());
+    writeSummary(operations[i]);
+  }
+  writer.EndObject();
+  writer.Key("total");
+  writeSummary(total);
+  writer.EndObject();
+  return buffer.GetString();
+}
+
+RepositoryLoadTest::RepositoryLoadTest(RepositoryLoadTestConfig config) : mConfig(std::move(config))
+{
+  if (mConfig.threads == 0) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("The load test needs at least one thread"));
+  }
+  if (!mConfig.objectsFile.empty()) {
+    mObjects = readObjects(mConfig.objectsFile);
+  } else {
+    for (size_t i = 0; i < mConfig.numberOfObjects && !mConfig.objectSizesKB.empty(); i++) {
+      auto size = mConfig.objectSizesKB[i % mConfig.objectSizesKB.size()];
+      mObjects.push_back(createHistogram(size, "histo" + std::to_string(size) + "kB_" + std::to_string(i)));
+    }
+  }
+  if (mObjects.empty()) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("The load test has no objects to store"));
+  }
+}
+
+RepositoryLoadTest::~RepositoryLoadTest() = default;
+
+std::vector<std::unique_ptr<TObject>> RepositoryLoadTest::readObjects(const std::string& filePath)
+{
+  std::unique_ptr<TFile> file(TFile::Open(filePath.c_str(), "READ"));
+  if (file == nullptr || file->IsZombie()) {
+    BOOST_THROW_EXCEPTION(FatalException() << errinfo_details("Could not open the file '" + filePath + "'"));
+  }
+
+  std::vector<std::unique_ptr<TObject>> objects;
+  auto addObject = [&objects](TObject* object) {
+    std::string name = object->GetName();
+    // the names end up in the object paths
+    std::replace_if(name.begin(), name.end(), [](char c) { return std::isspace(static_cast<unsigned char>(c)); }, '_');
+    auto* copy = object->Clone(name.c_str());
+    if (auto* histogram = dynamic_cast<TH1*>(copy)) {
+      histogram->SetDirectory(nullptr);
+    }
+    objects.emplace_back(copy);
+  };
+  std::function<void(TDirectory*)> readDirectory = [&](TDirectory* directory) {
+    for (auto* keyObject : *directory->GetListOfKeys()) {
+      auto* key = dynamic_cast<TKey*>(keyObject);
+      if (auto* keyClass = TClass::GetClass(key->GetClassName()); keyClass != nullptr && keyClass->InheritsFrom(TDirectory::Class())) {
+        // the directories are owned by the file
+        readDirectory(directory->GetDirectory(key->GetName()));
+        continue;
+      }
+      std::unique_ptr<TObject> object(key->ReadObj());
+      if (auto* collection = dynamic_cast<MonitorObjectCollection*>(object.get())) {
+        collection->SetOwner(true);
+        for (auto* element : *collection) {
+          if (auto* mo = dynamic_cast<MonitorObject*>(element); mo != nullptr && mo->getObject() != nullptr) {
+            addObject(mo->getObject());
+          }
+        }
+      } else if (auto* mo = dynamic_cast<MonitorObject*>(object.get())) {
+        if (mo->getObject() != nullptr) {
+          addObject(mo->getObject());
+        }
+      } else if (object != nullptr) {
+        addObject(object.get());
+      }
+    }
+  };
+  readDirectory(file.get());
+  ILOG(Info, Support) << "Read " << objects.size() << " objects from the file '" << filePath << "'" << ENDM;
+  return objects;
+}
+
+std::unique_ptr<TObject> RepositoryLoadTest::createHistogram(size_t sizeKB, const std::string& name)
+{
+  // 4 bytes per bin, filled with random values, so that the compression does not make it tiny
+  auto bins = std::max<int>(1, static_cast<int>(sizeKB * 1024 / sizeof(float)));
+  auto histogram = std::make_unique<TH1F>(name.c_str(), name.c_str(), bins, 0, bins);
+  histogram->SetDirectory(nullptr);
+  std::mt19937 generator(bins);
+  std::uniform_real_distribution<double> distribution(0, bins);
+  for (int i = 0; i < 4 * bins; i++) {
+    histogram->Fill(distribution(generator));
+  }
+  return histogram;
+}
+
+RepositoryLoadTestResults RepositoryLoadTest::run()
+{
+  std::unique_ptr<CcdbStandIn> standIn;
+  auto databaseUrl = mConfig.databaseUrl;
+  if (databaseUrl.empty()) {
+    standIn = std::make_unique<CcdbStandIn>();
+    databaseUrl = standIn->getUrl();
+    ILOG(Info, Support) << "Started a local CCDB stand-in at " << databaseUrl << ENDM;
+  }
+
+  RepositoryLoadTestResults results;
+  results.databaseUrl = databaseUrl;
+  results.threads = mConfig.threads;
+  results.objects = mObjects.size();
+  for (const auto& object : mObjects) {
+    TBufferFile buffer(TBuffer::kWrite);
+    buffer.WriteObject(object.get());
+    results.payloadBytes += buffer.Length();
+  }
+
+  auto createMonitorObjects = [this]() {
+    std::vector<std::shared_ptr<MonitorObject>> monitorObjects;
+    for (const auto& object : mObjects) {
+      auto mo = std::make_shared<MonitorObject>(object->Clone(), mConfig.taskName, "RepositoryLoadTest", mConfig.detector);
+      mo->setIsOwner(true);
+      monitorObjects.push_back(mo);
+    }
+    return monitorObjects;
+  };
+  const auto taskPath = RepoPathUtils::getMoPath(mConfig.detector, mConfig.taskName, "", "qc", false);
+  const auto fullTaskPath = RepoPathUtils::getMoPath(mConfig.detector, mConfig.taskName, "");
+
+  // all the objects should exist before we start to retrieve them
+  {
+    CcdbDatabase database;
+    database.connect(databaseUrl, "", "", "");
+    for (const auto& mo : createMonitorObjects()) {
+      database.storeMO(mo);
+    }
+  }
+
+  ROOT::EnableThreadSafety();
+  struct ThreadResults {
+    std::array<std::vector<double>, nLoadTestOperations> latenciesMs;
+    std::array<uint64_t, nLoadTestOperations> errors{};
+  };
+  std::vector<ThreadResults> threadResults(mConfig.threads);
+  std::vector<std::exception_ptr> setupErrors(mConfig.threads);
+  std::latch ready(mConfig.threads + 1);
+
+  auto work = [&](size_t threadIndex) {
+    auto& myResults = threadResults[threadIndex];
+    std::unique_ptr<CcdbDatabase> database;
+    std::vector<std::shared_ptr<MonitorObject>> monitorObjects;
+    try {
+      database = std::make_unique<CcdbDatabase>();
+      database->connect(databaseUrl, "", "", "");
+      monitorObjects = createMonitorObjects();
+    } catch (...) {
+      setupErrors[threadIndex] = std::current_exception();
+    }
+    // a thread which failed to set up arrives as well, otherwise all the others would wait forever
+    ready.arrive_and_wait();
+    if (setupErrors[threadIndex]) {
+      return;
+    }
+    std::mt19937 generator(threadIndex);
+    std::discrete_distribution<size_t> operations(mConfig.mix.begin(), mConfig.mix.end());
+    std::uniform_int_distribution<size_t> objects(0, monitorObjects.size() - 1);
+
+    const auto deadline = steady_clock::now() + mConfig.duration;
+    for (uint64_t request = 0; (mConfig.maxRequestsPerThread == 0 || request < mConfig.maxRequestsPerThread) && steady_clock::now() < deadline; request++) {
+      auto operation = operations(generator);
+      const auto& mo = monitorObjects[objects(generator)];
+      auto start = steady_clock::now();
+      bool success = true;
+      try {
+        switch (static_cast<LoadTestOperation>(operation)) {
+          case LoadTestOperation::Store:
+            database->storeMO(mo);
+            break;
+          case LoadTestOperation::Retrieve:
+            success = database->retrieveMO(taskPath, mo->getName(), DatabaseInterface::Timestamp::Latest) != nullptr;
+            break;
+          case LoadTestOperation::LatestValidity:
+            success = database->getLatestObjectValidity(mo->getPath(), {}).isValid();
+            break;
+          case LoadTestOperation::Listing:
+            success = !database->getListingAsJson(fullTaskPath + "/.*", {}, true).empty();
+            break;
+        }
+      } catch (...) {
+        success = false;
+      }
+      auto latencyMs = duration<double, std::milli>(steady_clock::now() - start).count();
+      if (success) {
+        myResults.latenciesMs[operation].push_back(latencyMs);
+      } else {
+        myResults.errors[operation]++;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < mConfig.threads; i++) {
+    threads.emplace_back(work, i);
+  }
+  ready.arrive_and_wait();
+  auto start = steady_clock::now();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& error : setupErrors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  results.durationS = duration<double>(steady_clock::now() - start).count();
+
+  std::vector<double> allLatencies;
+  uint64_t allErrors = 0;
+  for (size_t operation = 0; operation < nLoadTestOperations; operation++) {
+    std::vector<double> latencies;
+    uint64_t errors = 0;
+    for (auto& threadResult : threadResults) {
+      latencies.insert(latencies.end(), threadResult.latenciesMs[operation].begin(), threadResult.latenciesMs[operation].end());
+      errors += threadResult.errors[operation];
+    }
+    allLatencies.insert(allLatencies.end(), latencies.begin(), latencies.end());
+    allErrors += errors;
+    results.operations[operation] = LatencySummary::fromLatencies(latencies, errors, results.durationS);
+  }
+  results.total = LatencySummary::fromLatencies(allLatencies, allErrors, results.durationS);
+
+  if (mConfig.truncate) {
+    CcdbDatabase database;
+    database.connect(databaseUrl, "", "", "");
+    for (const auto& object : mObjects) {
+      database.truncate(fullTaskPath, object->GetName());
+    }
+  }
+  return results;
+}
+
+} // namespace o2::quality_control::repository
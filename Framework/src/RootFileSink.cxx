@@ -23,6 +23,7 @@
 #include <Framework/CompletionPolicyHelpers.h>
 #include <Framework/CompletionPolicy.h>
 #include <Framework/InputRecordWalker.h>
+#include <Framework/ConfigParamRegistry.h>
 
 #if defined(__linux__) && __has_include(<malloc.h>)
 #include <malloc.h>
@@ -33,8 +34,8 @@ using namespace o2::framework;
 namespace o2::quality_control::core
 {
 
-RootFileSink::RootFileSink(std::string filePath)
-  : mFilePath(std::move(filePath))
+RootFileSink::RootFileSink(std::string filePath, std::chrono::seconds flushPeriod)
+  : mFilePath(std::move(filePath)), mFlushPeriod(flushPeriod), mLastFlush(std::chrono::steady_clock::now())
 {
 }
 
@@ -47,14 +48,25 @@ void RootFileSink::customizeInfrastructure(std::vector<framework::CompletionPoli
   policies.emplace_back(CompletionPolicyHelpers::consumeWhenAny("qcRootFileSinkCompletionPolicy", matcher));
 }
 
+std::vector<framework::ConfigParamSpec> RootFileSink::getOptions()
+{
+  return { { "flush-period", framework::VariantType::Int, -1, { "If >= 0, the objects are integrated in memory and written to the file every that many seconds and at the end of processing (0 - only at the end). If < 0, each received object is merged into the file immediately." } } };
+}
+
 void RootFileSink::init(framework::InitContext& ictx)
 {
+  if (ictx.options().isSet("flush-period")) {
+    mFlushPeriod = std::chrono::seconds(ictx.options().get<int>("flush-period"));
+  }
+  mLastFlush = std::chrono::steady_clock::now();
+  if (isAccumulating()) {
+    ILOG(Info, Support) << "The objects will be integrated in memory and written to the file '" << mFilePath << "' every " << mFlushPeriod.count() << " seconds (0 - only at the end)" << ENDM;
+  }
 }
 
 void RootFileSink::run(framework::ProcessingContext& pctx)
 {
   try {
-    RootFileStorage mStorage{ mFilePath, RootFileStorage::ReadMode::Update };
     for (const auto& input : InputRecordWalker(pctx.inputs())) {
       auto moc = DataRefUtils::as<MonitorObjectCollection>(input);
       if (moc == nullptr) {
@@ -62,23 +74,132 @@ void RootFileSink::run(framework::ProcessingContext& pctx)
         continue;
       }
       ILOG(Info, Support) << "Received MonitorObjectCollection '" << moc->GetName() << "'" << ENDM;
-      moc->postDeserialization();
-      auto mwMOC = dynamic_cast<MonitorObjectCollection*>(moc->cloneMovingWindow());
+      receive(std::move(moc));
+    }
+  } catch (const std::bad_alloc& ex) {
+    ILOG(Error, Ops) << "Caught a bad_alloc exception, there is probably a huge file or object present, but I will try to survive" << ENDM;
+    ILOG(Error, Support) << "Details: " << ex.what() << ENDM;
+  } catch (...) {
+    throw;
+  }
 
-      if (moc->GetEntries() > 0) {
-        mStorage.storeIntegralMOC(moc.get());
+  if (!isAccumulating()) {
+    releaseMemory();
+  } else if (mFlushPeriod.count() > 0 && std::chrono::steady_clock::now() - mLastFlush >= mFlushPeriod) {
+    flush();
+  }
+}
+
+void RootFileSink::receive(std::unique_ptr<MonitorObjectCollection> moc)
+{
+  moc->postDeserialization();
+  auto mwMOC = std::unique_ptr<MonitorObjectCollection>(dynamic_cast<MonitorObjectCollection*>(moc->cloneMovingWindow()));
+
+  if (isAccumulating()) {
+    accumulate(std::move(moc), std::move(mwMOC));
+  } else {
+    store(moc.get(), mwMOC.get());
+  }
+}
+
+void RootFileSink::endOfStream(framework::EndOfStreamContext&)
+{
+  flush();
+}
+
+void RootFileSink::stop()
+{
+  flush();
+}
+
+void RootFileSink::store(MonitorObjectCollection* moc, MonitorObjectCollection* mwMOC)
+{
+  RootFileStorage mStorage{ mFilePath, RootFileStorage::ReadMode::Update };
+  if (moc->GetEntries() > 0) {
+    mStorage.storeIntegralMOC(moc);
+  }
+  if (mwMOC->GetEntries() > 0) {
+    mStorage.storeMovingWindowMOC(mwMOC);
+  }
+}
+
+void RootFileSink::accumulate(std::unique_ptr<MonitorObjectCollection> moc, std::unique_ptr<MonitorObjectCollection> mwMOC)
+{
+  if (moc->GetEntries() > 0) {
+    auto path = RootFileStorage::integralMocPath(moc.get());
+    if (auto integral = mIntegralMOCs.find(path); integral != mIntegralMOCs.end()) {
+      integral->second->merge(moc.get());
+    } else {
+      mIntegralMOCs.emplace(path, std::move(moc));
+    }
+    mUpdatedIntegralMOCs.insert(path);
+  }
+  if (mwMOC->GetEntries() > 0) {
+    auto path = RootFileStorage::movingWindowMocPath(mwMOC.get());
+    if (auto window = mMovingWindowMOCs.find(path); window != mMovingWindowMOCs.end()) {
+      window->second->merge(mwMOC.get());
+    } else {
+      mMovingWindowMOCs.emplace(path, std::move(mwMOC));
+    }
+  }
+}
+
+void RootFileSink::flush()
+{
+  mLastFlush = std::chrono::steady_clock::now();
+  if (!isAccumulating() || (mUpdatedIntegralMOCs.empty() && mMovingWindowMOCs.empty())) {
+    return;
+  }
+
+  try {
+    RootFileStorage storage{ mFilePath, RootFileStorage::ReadMode::Update };
+
+    if (!mStoredPathsRead) {
+      // only the keys are read, the file might contain the results of other workflows which we have to merge with
+      auto structure = storage.readStructure(false);
+      for (IntegralMocWalker walker(structure); walker.hasNextPath();) {
+        mStoredPaths.insert(walker.nextPath());
       }
-      if (mwMOC->GetEntries() > 0) {
-        mStorage.storeMovingWindowMOC(mwMOC);
+      for (MovingWindowMocWalker walker(structure); walker.hasNextPath();) {
+        mStoredPaths.insert(walker.nextPath());
       }
+      mStoredPathsRead = true;
     }
+
+    for (const auto& path : mUpdatedIntegralMOCs) {
+      auto& integralMOC = mIntegralMOCs.at(path);
+      if (mStoredPaths.count(path) > 0) {
+        // this happens only once per task, then the integral in memory includes the stored one and overwrites it
+        auto storedMOC = std::unique_ptr<MonitorObjectCollection>(storage.readMonitorObjectCollection(path));
+        if (storedMOC != nullptr) {
+          ILOG(Info, Support) << "Merging objects for task '" << path << "' with the existing ones in the file." << ENDM;
+          storedMOC->postDeserialization();
+          storedMOC->merge(integralMOC.get());
+          integralMOC = std::move(storedMOC);
+        }
+        mStoredPaths.erase(path);
+      }
+      storage.storeIntegralMOC(integralMOC.get(), RootFileStorage::WriteMode::Overwrite);
+    }
+    mUpdatedIntegralMOCs.clear();
+
+    for (auto& [path, mwMOC] : mMovingWindowMOCs) {
+      // windows which are not in the file yet are simply appended
+      auto writeMode = mStoredPaths.count(path) > 0 ? RootFileStorage::WriteMode::Merge : RootFileStorage::WriteMode::Overwrite;
+      storage.storeMovingWindowMOC(mwMOC.get(), writeMode);
+      mStoredPaths.insert(path);
+    }
+    mMovingWindowMOCs.clear();
   } catch (const std::bad_alloc& ex) {
     ILOG(Error, Ops) << "Caught a bad_alloc exception, there is probably a huge file or object present, but I will try to survive" << ENDM;
     ILOG(Error, Support) << "Details: " << ex.what() << ENDM;
-  } catch (...) {
-    throw;
   }
 
+  releaseMemory();
+}
+
+void RootFileSink::releaseMemory()
+{
 #if defined(__linux__) && __has_include(<malloc.h>)
   // Once we write object to TFile, the OS does not actually release the array memory from the heap,
   // despite deleting the pointers. This function encourages the system to release it.
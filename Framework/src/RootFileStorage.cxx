@@ -18,6 +18,7 @@
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/MonitorObjectCollection.h"
 #include "QualityControl/MonitorObject.h"
+#include "QualityControl/LazyObjectInterface.h"
 #include "QualityControl/ValidityInterval.h"
 
 #include <TFile.h>
@@ -169,8 +170,30 @@ bool validObjectValidities(const MonitorObjectCollection* moc)
   return true;
 }
 
+// the objects which were merged without their derived content get it before being written, as in the CheckRunner
+static void computeLazyContent(MonitorObjectCollection* moc)
+{
+  for (const auto& obj : *moc) {
+    if (auto mo = dynamic_cast<MonitorObject*>(obj)) {
+      if (auto lazyObject = dynamic_cast<LazyObjectInterface*>(mo->getObject())) {
+        lazyObject->computeLazyContent();
+      }
+    }
+  }
+}
+
+std::string RootFileStorage::integralMocPath(const MonitorObjectCollection* moc)
+{
+  return std::string(integralsDirectoryName) + "/" + moc->getDetector() + "/" + moc->getTaskName();
+}
+
+std::string RootFileStorage::movingWindowMocPath(const MonitorObjectCollection* moc)
+{
+  return std::string(movingWindowsDirectoryName) + "/" + moc->getDetector() + "/" + moc->getTaskName() + "/" + std::to_string(earliestValidFrom(moc));
+}
+
 // fixme we should not have to change the name!
-void RootFileStorage::storeIntegralMOC(MonitorObjectCollection* const moc)
+void RootFileStorage::storeIntegralMOC(MonitorObjectCollection* const moc, WriteMode writeMode)
 {
   const auto& mocStorageName = moc->getTaskName();
   if (mocStorageName.empty()) {
@@ -194,22 +217,27 @@ void RootFileStorage::storeIntegralMOC(MonitorObjectCollection* const moc)
   }
 
   // directory level: int/DET/TASK
-  ILOG(Debug, Support) << "Checking for existing objects in the file." << ENDM;
   int nbytes = 0;
-  auto storedMOC = std::unique_ptr<MonitorObjectCollection>(detDir->Get<MonitorObjectCollection>(mocStorageName.c_str()));
+  std::unique_ptr<MonitorObjectCollection> storedMOC;
+  if (writeMode == WriteMode::Merge) {
+    ILOG(Debug, Support) << "Checking for existing objects in the file." << ENDM;
+    storedMOC.reset(detDir->Get<MonitorObjectCollection>(mocStorageName.c_str()));
+  }
   if (storedMOC != nullptr) {
     storedMOC->postDeserialization();
     ILOG(Info, Support) << "Merging objects for task '" << detector << "/" << moc->getTaskName() << "' with the existing ones in the file." << ENDM;
     storedMOC->merge(moc);
+    computeLazyContent(storedMOC.get());
     nbytes = detDir->WriteObject(storedMOC.get(), storedMOC->GetName(), "Overwrite");
   } else {
     ILOG(Info, Support) << "Storing objects for task '" << detector << "/" << moc->getTaskName() << "' in the file." << ENDM;
+    computeLazyContent(moc);
     nbytes = detDir->WriteObject(moc, moc->GetName(), "Overwrite");
   }
   ILOG(Info, Support) << "Integrated objects '" << moc->GetName() << "' have been stored in the file (" << nbytes << " bytes)." << ENDM;
 }
 
-void RootFileStorage::storeMovingWindowMOC(MonitorObjectCollection* const moc)
+void RootFileStorage::storeMovingWindowMOC(MonitorObjectCollection* const moc, WriteMode writeMode)
 {
   if (moc->GetEntries() == 0) {
     ILOG(Warning, Support) << "The provided MonitorObjectCollection '" << moc->GetName() << "' is empty, will not store." << ENDM;
@@ -245,16 +273,21 @@ void RootFileStorage::storeMovingWindowMOC(MonitorObjectCollection* const moc)
   // directory level: mw/DET/TASK/<mw_start_time>
   auto mocStorageName = std::to_string(earliestValidFrom(moc));
   moc->SetName(mocStorageName.c_str());
-  ILOG(Info, Support) << "Checking for existing moving windows '" << mocStorageName << "' for task '" << detector << "/" << moc->getTaskName() << "' in the file." << ENDM;
   int nbytes = 0;
-  auto storedMOC = std::unique_ptr<MonitorObjectCollection>(taskDir->Get<MonitorObjectCollection>(mocStorageName.c_str()));
+  std::unique_ptr<MonitorObjectCollection> storedMOC;
+  if (writeMode == WriteMode::Merge) {
+    ILOG(Info, Support) << "Checking for existing moving windows '" << mocStorageName << "' for task '" << detector << "/" << moc->getTaskName() << "' in the file." << ENDM;
+    storedMOC.reset(taskDir->Get<MonitorObjectCollection>(mocStorageName.c_str()));
+  }
   if (storedMOC != nullptr) {
     storedMOC->postDeserialization();
     ILOG(Info, Support) << "Merging moving windows '" << moc->GetName() << "' for task '" << moc->getDetector() << "/" << moc->getTaskName() << "' with the existing one in the file." << ENDM;
     storedMOC->merge(moc);
+    computeLazyContent(storedMOC.get());
     nbytes = taskDir->WriteObject(storedMOC.get(), storedMOC->GetName(), "Overwrite");
   } else {
     ILOG(Info, Support) << "Storing moving windows '" << moc->GetName() << "' for task '" << moc->getDetector() << "/" << moc->getTaskName() << "' in the file." << ENDM;
+    computeLazyContent(moc);
     nbytes = taskDir->WriteObject(moc, moc->GetName(), "Overwrite");
   }
   ILOG(Info, Support) << "Moving windows '" << moc->GetName() << "' for task '" << detector << "/" << moc->getTaskName() << "' has been stored in the file (" << nbytes << " bytes)." << ENDM;
@@ -35,11 +35,22 @@
 #include <TMultiGraph.h>
 #include <TLegend.h>
 #include <TCanvas.h>
+#include <algorithm>
+#include <limits>
 
 using namespace o2::quality_control;
 using namespace o2::quality_control::core;
 using namespace o2::quality_control::postprocessing;
 
+struct SliceTrendingTask::PreparedValues : public PreparedUpdate {
+  struct Source {
+    std::vector<SliceInfo> slices;
+    int numberPads = 0;
+  };
+  std::vector<Source> sources; // one per data source, only the repository sources are filled
+  bool complete = true;        // false if any object could not be retrieved
+};
+
 void SliceTrendingTask::configure(const boost::property_tree::ptree& config)
 {
   mConfig = SliceTrendingTaskConfig(getID(), config);
@@ -55,6 +66,7 @@ void SliceTrendingTask::initialize(Trigger, framework::ServiceRegistryRef servic
   }
 
   mPlots.clear();
+  mCachedPlots.clear();
   mReductors.clear();
   mSources.clear();
 
@@ -119,6 +131,76 @@ void SliceTrendingTask::update(Trigger t, framework::ServiceRegistryRef services
   }
 }
 
+std::unique_ptr<PreparedUpdate> SliceTrendingTask::prepareUpdate(Trigger t, framework::ServiceRegistryRef services)
+{
+  auto& qcdb = services.get<repository::DatabaseInterface>();
+  using Request = repository::DatabaseInterface::RetrievalRequest;
+
+  std::vector<Request> requests;
+  for (const auto& dataSource : mConfig.dataSources) {
+    if (dataSource.type == "repository") {
+      requests.push_back({ Request::Type::MonitorObject, dataSource.path, dataSource.name, static_cast<long>(t.timestamp), t.activity });
+    }
+  }
+  auto results = qcdb.retrieveMany(requests);
+
+  // the SliceReductors of the task are used by update(), so we use separate ones to reduce the values ahead
+  auto prepared = std::make_unique<PreparedValues>();
+  prepared->sources.resize(mConfig.dataSources.size());
+  size_t resultIndex = 0;
+  for (size_t i = 0; i < mConfig.dataSources.size(); i++) {
+    const auto& dataSource = mConfig.dataSources[i];
+    if (dataSource.type != "repository") {
+      continue;
+    }
+    const auto& mo = results[resultIndex++].monitorObject;
+    TObject* obj = mo ? mo->getObject() : nullptr;
+    if (obj == nullptr) {
+      prepared->complete = false;
+      break;
+    }
+    std::unique_ptr<SliceReductor> reductor(root_class_factory::create<SliceReductor>(dataSource.moduleName, dataSource.reductorName));
+    auto axisDivision = dataSource.axisDivision;
+    reductor->update(obj, prepared->sources[i].slices, axisDivision, prepared->sources[i].numberPads);
+  }
+  return prepared;
+}
+
+void SliceTrendingTask::finishUpdate(Trigger t, framework::ServiceRegistryRef services, std::unique_ptr<PreparedUpdate> prepared)
+{
+  auto* values = dynamic_cast<PreparedValues*>(prepared.get());
+  if (values == nullptr) {
+    update(t, services);
+    return;
+  }
+
+  setTime(t);
+  for (size_t i = 0; i < mConfig.dataSources.size(); i++) {
+    const auto& dataSource = mConfig.dataSources[i];
+    mNumberPads[dataSource.name] = 0;
+    mSources[dataSource.name]->clear();
+    if (dataSource.type == "repository") {
+      mAxisDivision[dataSource.name] = dataSource.axisDivision;
+      mSliceLabel[dataSource.name] = dataSource.sliceLabels;
+      if (values->complete) {
+        *mSources[dataSource.name] = std::move(values->sources[i].slices);
+        mNumberPads[dataSource.name] = values->sources[i].numberPads;
+      }
+    } else {
+      ILOG(Error, Support) << "Data source '" << dataSource.type << "' is not of type repository." << ENDM;
+    }
+  }
+  if (values->complete) {
+    mTrend->Fill();
+  } else {
+    ILOG(Error, Support) << "Some objects could not be retrieved, will skip this trending cycle" << ENDM;
+  }
+
+  if (mConfig.producePlotsOnUpdate) {
+    generatePlots();
+  }
+}
+
 void SliceTrendingTask::finalize(Trigger t, framework::ServiceRegistryRef)
 {
   if (!mConfig.producePlotsOnUpdate) {
@@ -133,8 +215,7 @@ void SliceTrendingTask::finalize(Trigger t, framework::ServiceRegistryRef)
   }
 }
 
-void SliceTrendingTask::trendValues(const Trigger& t,
-                                    repository::DatabaseInterface& qcdb)
+void SliceTrendingTask::setTime(const Trigger& t)
 {
   if (mConfig.trendingTimestamp == "trigger") {
     // ROOT expects seconds since epoch.
@@ -145,6 +226,12 @@ void SliceTrendingTask::trendValues(const Trigger& t,
     mTime = t.activity.mValidity.getMax() / 1000;
   }
   mMetaData.runNumber = t.activity.mId;
+}
+
+void SliceTrendingTask::trendValues(const Trigger& t,
+                                    repository::DatabaseInterface& qcdb)
+{
+  setTime(t);
   for (auto& dataSource : mConfig.dataSources) {
     mNumberPads[dataSource.name] = 0;
     mSources[dataSource.name]->clear();
@@ -185,15 +272,22 @@ void SliceTrendingTask::generatePlots()
 
   ILOG(Info, Support) << "Generating " << mConfig.plots.size() << " plots." << ENDM;
   for (const auto& plot : mConfig.plots) {
+    const std::size_t posEndVar = plot.varexp.find('.'); // Find the end of the dataSource.
+    const std::string varName(plot.varexp.substr(0, posEndVar));
+
+    // Plots trended vs time or run get only the new entries of the trend appended.
+    if (mPlots.count(plot.name) && updateCanvasMO(dynamic_cast<TCanvas*>(mPlots[plot.name]), plot, varName)) {
+      getObjectsManager()->startPublishing(mPlots[plot.name], PublicationPolicy::Once);
+      continue;
+    }
+
     // Delete the existing plots before regenerating them.
     if (mPlots.count(plot.name)) {
       delete mPlots[plot.name];
       mPlots[plot.name] = nullptr;
     }
-
-    // Postprocess each pad (titles, axes, flushing buffers).
-    const std::size_t posEndVar = plot.varexp.find('.'); // Find the end of the dataSource.
-    const std::string varName(plot.varexp.substr(0, posEndVar));
+    auto& cachedPlot = mCachedPlots[plot.name];
+    cachedPlot = CachedPlot{};
 
     // Draw the trending on a new canvas.
     auto* c = new TCanvas();
@@ -201,8 +295,9 @@ void SliceTrendingTask::generatePlots()
     c->SetTitle(plot.title.c_str());
 
     TitleSettings titlesettings{ plot.legendObservableX, plot.legendObservableY, plot.legendUnitX, plot.legendUnitY, plot.legendCentmodeX, plot.legendCentmodeY };
-    drawCanvasMO(c, plot.varexp, plot.name, plot.option, plot.graphErrors, mAxisDivision[varName], mSliceLabel[varName], titlesettings);
+    drawCanvasMO(c, plot.varexp, plot.name, plot.option, plot.graphErrors, mAxisDivision[varName], mSliceLabel[varName], titlesettings, cachedPlot);
 
+    // Postprocess each pad (titles, axes, flushing buffers).
     int NumberPlots = 1;
     if (plot.varexp.find(":time") != std::string::npos || plot.varexp.find(":run") != std::string::npos) { // we plot vs time, multiple plots on canvas possible
       NumberPlots = mNumberPads[varName];
@@ -263,7 +358,7 @@ void SliceTrendingTask::generatePlots()
 } // void SliceTrendingTask::generatePlots()
 
 void SliceTrendingTask::drawCanvasMO(TCanvas* thisCanvas, const std::string& var,
-                                     const std::string& name, const std::string& opt, const std::string& err, const std::vector<std::vector<float>>& axis, const std::vector<std::vector<std::string>>& sliceLabels, const TitleSettings& titlesettings)
+                                     const std::string& name, const std::string& opt, const std::string& err, const std::vector<std::vector<float>>& axis, const std::vector<std::vector<std::string>>& sliceLabels, const TitleSettings& titlesettings, CachedPlot& cachedPlot)
 {
   // Determine the order of the plot (1 - histo, 2 - graph, ...)
   const size_t plotOrder = std::count(var.begin(), var.end(), ':') + 1;
@@ -315,37 +410,22 @@ void SliceTrendingTask::drawCanvasMO(TCanvas* thisCanvas, const std::string& var
     const int nEffectiveEntries = (trendType == "time") ? std::min(nEntriesTime, nEntriesData) : std::min(nEntriesRuns, nEntriesData);
     const int startPoint = (trendType == "time") ? nEntriesTime - nEffectiveEntries : nEntriesRuns - nEffectiveEntries;
 
+    std::vector<TGraphErrors*> graphs;
     for (int p = 0; p < nuPa; p++) {
-      thisCanvas->cd(p + 1);
-      int iEntry = 0;
-      graphErrors = new TGraphErrors(nEffectiveEntries);
-      myReader.SetEntry(startPoint - 1); // startPoint-1 as myReader.Next() increments by one so that we then start at startPoint
-
-      while (myReader.Next()) {
-        const double timeStamp = (trendType == "time") ? (double)(*retrieveTime) : (double)(*retrieveRun);
-        const double dataPoint = (dataRetrieveVector->at(p)).retrieveValue(typeName);
-        double errorX = 0.;
-        double errorY = 0.;
-
-        if (!err.empty()) {
-          errorX = (dataRetrieveVector->at(p)).retrieveValue(errXName);
-          errorY = (dataRetrieveVector->at(p)).retrieveValue(errYName);
-        }
-
-        graphErrors->SetPoint(iEntry, timeStamp, dataPoint);
-        graphErrors->SetPointError(iEntry, errorX, errorY); // Add Error to the last added point
+      graphs.push_back(new TGraphErrors());
+    }
+    const auto titles = appendTrendPoints(graphs, varName, typeName, errXName, errYName, trendType == "time", startPoint);
 
-        iEntry++;
-      }
+    for (int p = 0; p < nuPa; p++) {
+      thisCanvas->cd(p + 1);
+      graphErrors = graphs[p];
 
       if (!useSliceLabels) {
-        graphErrors->SetTitle((dataRetrieveVector->at(p)).title.data());
+        graphErrors->SetTitle(titles[p].data());
       } else {
         graphErrors->SetTitle(sliceLabels[0][p].data());
       }
 
-      myReader.Restart();
-
       if (!err.empty()) {
         if (plotOrder != 2) {
           ILOG(Info, Support) << "Non empty graphErrors seen for the plot '" << name
@@ -355,6 +435,11 @@ void SliceTrendingTask::drawCanvasMO(TCanvas* thisCanvas, const std::string& var
         }
       }
     }
+
+    if (!err.empty() && plotOrder == 2) {
+      cachedPlot.graphs = graphs;
+      cachedPlot.entries = nEntries;
+    }
   } // Trending vs time
   else if (trendType == "multigraphtime" || trendType == "multigraphrun") {
 
@@ -364,29 +449,15 @@ void SliceTrendingTask::drawCanvasMO(TCanvas* thisCanvas, const std::string& var
     const int nEffectiveEntries = (trendType == "multigraphtime") ? std::min(nEntriesTime, nEntriesData) : std::min(nEntriesRuns, nEntriesData);
     const int startPoint = (trendType == "multigraphtime") ? nEntriesTime - nEffectiveEntries : nEntriesRuns - nEffectiveEntries;
 
+    std::vector<TGraphErrors*> graphs;
     for (int p = 0; p < nuPa; p++) {
-      int iEntry = 0;
-      auto gr = new TGraphErrors(nEffectiveEntries);
-      myReader.SetEntry(startPoint - 1); // startPoint-1 as myReader.Next() increments by one so that we then start at startPoint
-
-      while (myReader.Next()) {
-        const double timeStamp = (trendType == "multigraphtime") ? (double)(*retrieveTime) : (double)(*retrieveRun);
-        const double dataPoint = (dataRetrieveVector->at(p)).retrieveValue(typeName);
-        double errorX = 0.;
-        double errorY = 0.;
-
-        if (!err.empty()) {
-          errorX = (dataRetrieveVector->at(p)).retrieveValue(errXName);
-          errorY = (dataRetrieveVector->at(p)).retrieveValue(errYName);
-        }
-
-        gr->SetPoint(iEntry, timeStamp, dataPoint);
-        gr->SetPointError(iEntry, errorX, errorY); // Add Error to the last added point
-        iEntry++;
-      }
+      graphs.push_back(new TGraphErrors());
+    }
+    const auto titles = appendTrendPoints(graphs, varName, typeName, errXName, errYName, trendType == "multigraphtime", startPoint);
 
-      const std::string_view title = useSliceLabels ? sliceLabels[0][p] : (dataRetrieveVector->at(p)).title;
-      // const std::string_view title = (dataRetrieveVector->at(p)).title;
+    for (int p = 0; p < nuPa; p++) {
+      auto gr = graphs[p];
+      const std::string_view title = useSliceLabels ? sliceLabels[0][p] : titles[p];
       const auto posDivider = title.find("RangeX");
       if (posDivider != std::string_view::npos) {
         auto rawtitle = title.substr(posDivider, -1);
@@ -395,10 +466,13 @@ void SliceTrendingTask::drawCanvasMO(TCanvas* thisCanvas, const std::string& var
         gr->SetName(title.data());
       }
 
-      myReader.Restart();
       multigraph->Add(gr);
     } // for (int p = 0; p < nuPa; p++)
 
+    cachedPlot.graphs = graphs;
+    cachedPlot.multigraph = multigraph;
+    cachedPlot.entries = nEntries;
+
     thisCanvas->cd(1);
     multigraph->Draw("A pmc plc");
 
@@ -499,6 +573,106 @@ void SliceTrendingTask::drawCanvasMO(TCanvas* thisCanvas, const std::string& var
   } // Trending vs Slices2D
 }
 
+std::vector<std::string> SliceTrendingTask::appendTrendPoints(const std::vector<TGraphErrors*>& graphs, const std::string& varName, const std::string& typeName,
+                                                             const std::string& errXName, const std::string& errYName, bool vsTime, Long64_t firstEntry)
+{
+  std::vector<std::string> titles(graphs.size());
+  const bool withErrors = !errXName.empty() || !errYName.empty();
+
+  TTreeReader myReader(mTrend.get());
+  TTreeReaderValue<UInt_t> retrieveTime(myReader, "time");
+  TTreeReaderValue<Int_t> retrieveRun(myReader, "meta.runNumber");
+  TTreeReaderValue<std::vector<SliceInfo>> dataRetrieveVector(myReader, varName.data());
+
+  myReader.SetEntry(firstEntry - 1); // firstEntry-1 as myReader.Next() increments by one so that we then start at firstEntry
+  while (myReader.Next()) {
+    const double timeStamp = vsTime ? (double)(*retrieveTime) : (double)(*retrieveRun);
+    for (size_t p = 0; p < graphs.size(); p++) {
+      const auto& slice = dataRetrieveVector->at(p);
+      const int iPoint = graphs[p]->GetN();
+      graphs[p]->SetPoint(iPoint, timeStamp, slice.retrieveValue(typeName));
+      if (withErrors) {
+        graphs[p]->SetPointError(iPoint, slice.retrieveValue(errXName), slice.retrieveValue(errYName)); // Add Error to the last added point
+      }
+      titles[p] = slice.title;
+    }
+  }
+  return titles;
+}
+
+bool SliceTrendingTask::updateCanvasMO(TCanvas* thisCanvas, const SliceTrendingTaskConfig::Plot& plot, const std::string& varName)
+{
+  auto cached = mCachedPlots.find(plot.name);
+  if (thisCanvas == nullptr || cached == mCachedPlots.end() || cached->second.graphs.empty()) {
+    return false;
+  }
+  auto& cachedPlot = cached->second;
+  const Long64_t nEntries = mTrend->GetEntries();
+  if (static_cast<int>(cachedPlot.graphs.size()) != mNumberPads[varName] || nEntries < cachedPlot.entries) {
+    // the slicing changed or the trend was reset
+    return false;
+  }
+
+  std::string sourceName, typeName, trendType;
+  getTrendVariables(plot.varexp, sourceName, typeName, trendType);
+  std::string errXName, errYName;
+  getTrendErrors(plot.graphErrors, errXName, errYName);
+
+  const bool vsTime = trendType == "time" || trendType == "multigraphtime";
+  appendTrendPoints(cachedPlot.graphs, sourceName, typeName, errXName, errYName, vsTime, cachedPlot.entries);
+  cachedPlot.entries = nEntries;
+
+  // The axes were computed when the graphs were painted for the first time, they have to include the new points.
+  auto axesRange = [](const std::vector<TGraphErrors*>& graphs, double& xMin, double& xMax, double& yMin, double& yMax) {
+    xMin = yMin = std::numeric_limits<double>::max();
+    xMax = yMax = std::numeric_limits<double>::lowest();
+    for (auto* graph : graphs) {
+      if (graph->GetN() == 0) {
+        continue;
+      }
+      double gxMin, gyMin, gxMax, gyMax;
+      graph->ComputeRange(gxMin, gyMin, gxMax, gyMax);
+      xMin = std::min(xMin, gxMin);
+      yMin = std::min(yMin, gyMin);
+      xMax = std::max(xMax, gxMax);
+      yMax = std::max(yMax, gyMax);
+    }
+    // the same margins as TGraph
+    const double dx = 0.1 * (xMax - xMin);
+    const double dy = 0.1 * (yMax - yMin);
+    xMin -= dx;
+    xMax += dx;
+    yMin -= dy;
+    yMax += dy;
+    return xMin < xMax;
+  };
+
+  double xMin, xMax, yMin, yMax;
+  if (cachedPlot.multigraph) {
+    thisCanvas->cd(1);
+    if (axesRange(cachedPlot.graphs, xMin, xMax, yMin, yMax)) {
+      cachedPlot.multigraph->GetXaxis()->SetLimits(xMin, xMax);
+      cachedPlot.multigraph->SetMinimum(yMin);
+      cachedPlot.multigraph->SetMaximum(yMax);
+    }
+    beautifyAxes(cachedPlot.multigraph, plot, thisCanvas);
+  } else {
+    for (size_t p = 0; p < cachedPlot.graphs.size(); p++) {
+      auto* graph = cachedPlot.graphs[p];
+      thisCanvas->cd(p + 1);
+      if (axesRange({ graph }, xMin, xMax, yMin, yMax)) {
+        graph->GetXaxis()->SetLimits(xMin, xMax);
+        graph->SetMinimum(yMin);
+        graph->SetMaximum(yMax);
+      }
+      beautifyAxes(graph, plot, thisCanvas);
+    }
+  }
+  thisCanvas->Modified();
+  thisCanvas->Update();
+  return true;
+}
+
 void SliceTrendingTask::getUserAxisRange(const std::string& graphAxisRange, float& limitLow, float& limitUp)
 {
   const std::size_t posDivider = graphAxisRange.find(':');
@@ -548,6 +722,12 @@ void SliceTrendingTask::beautifyGraph(T& graph, const SliceTrendingTaskConfig::P
   }
   graph->SetTitle(thisTitle.data());
 
+  beautifyAxes(graph, plotconfig, canv);
+}
+
+template <typename T>
+void SliceTrendingTask::beautifyAxes(T& graph, const SliceTrendingTaskConfig::Plot& plotconfig, TCanvas* canv)
+{
   // Set the user-defined range on the y axis if needed.
   if (!plotconfig.graphYRange.empty()) {
     float yMin, yMax;
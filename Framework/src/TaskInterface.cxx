@@ -17,6 +17,8 @@
 
 #include "QualityControl/TaskInterface.h"
 
+#include <TH1.h>
+
 namespace o2::quality_control::core
 {
 
@@ -50,6 +52,16 @@ void TaskInterface::finaliseCCDB(framework::ConcreteDataMatcher& matcher, void*
 {
 }
 
+TObject* TaskInterface::copyForPublication(const TObject& object)
+{
+  auto* copy = object.Clone();
+  // the copy is deleted in another thread, it should not be registered in any directory
+  if (auto* histogram = dynamic_cast<TH1*>(copy)) {
+    histogram->SetDirectory(nullptr);
+  }
+  return copy;
+}
+
 void TaskInterface::configure()
 {
   // noop, override it if you want.
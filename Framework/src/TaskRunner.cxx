@@ -44,6 +44,8 @@
 #include "QualityControl/TaskRunnerFactory.h"
 #include "QualityControl/ConfigParamGlo.h"
 #include "QualityControl/ObjectsManager.h"
+#include "QualityControl/MonitorObjectSerializer.h"
+#include "QualityControl/ThreadPool.h"
 #include "QualityControl/Bookkeeping.h"
 #include "QualityControl/TimekeeperFactory.h"
 #include "QualityControl/ActivityHelpers.h"
@@ -53,6 +55,8 @@
 
 #include <string>
 #include <TFile.h>
+#include <TMessage.h>
+#include <TROOT.h>
 #include <boost/property_tree/ptree.hpp>
 #include <TSystem.h>
 
@@ -108,6 +112,16 @@ void TaskRunner::init(InitContext& iCtx)
   // setup publisher
   mObjectsManager = std::make_shared<ObjectsManager>(mTaskConfig.taskName, mTaskConfig.className, mTaskConfig.detectorName, mTaskConfig.consulUrl, mTaskConfig.parallelTaskID);
   mObjectsManager->setMovingWindowsList(mTaskConfig.movingWindows);
+  if (mTaskConfig.publicationThreads > 1) {
+    mSerializer = std::make_unique<MonitorObjectSerializer>(mTaskConfig.publicationThreads);
+    ILOG(Info, Devel) << "MonitorObjects will be serialized with " << mSerializer->getNThreads() << " threads and published as separate message parts" << ENDM;
+  }
+  if (mTaskConfig.doubleBufferedCycles) {
+    // the copies of the objects are serialized in the background thread
+    ROOT::EnableThreadSafety();
+    mPublicationThread = std::make_unique<ThreadPool>(1);
+    ILOG(Info, Devel) << "Double-buffered cycles enabled, MonitorObjects will be copied at the end of cycles and serialized in the background" << ENDM;
+  }
 
   // setup timekeeping
   mDeploymentMode = DefaultsHelpers::deploymentMode();
@@ -143,6 +157,11 @@ void TaskRunner::init(InitContext& iCtx)
 
 void TaskRunner::run(ProcessingContext& pCtx)
 {
+  if (mPublicationThread) {
+    // the objects of the previous cycle are sent as soon as they are serialized
+    sendPendingPublication(pCtx.outputs(), false);
+  }
+
   if (mNoMoreCycles) {
     ILOG(Info, Support) << "The maximum number of cycles (" << mTaskConfig.maxNumberCycles << ") has been reached"
                         << " or the device has received an EndOfStream signal. Won't start a new cycle." << ENDM;
@@ -162,6 +181,7 @@ void TaskRunner::run(ProcessingContext& pCtx)
     finishCycle(pCtx.outputs());
     if (mTaskConfig.resetAfterCycles > 0 && (mCycleNumber % mTaskConfig.resetAfterCycles == 0)) {
       mTask->reset();
+      mObjectsManager->setAllReset();
       mTimekeeper->reset();
     }
     if (mTaskConfig.maxNumberCycles < 0 || mCycleNumber < mTaskConfig.maxNumberCycles) {
@@ -294,6 +314,9 @@ void TaskRunner::endOfStream(framework::EndOfStreamContext& eosContext)
       finishCycle(eosContext.outputs());
     }
   }
+  if (mPublicationThread) {
+    sendPendingPublication(eosContext.outputs(), true);
+  }
   mNoMoreCycles = true;
 }
 
@@ -326,6 +349,12 @@ void TaskRunner::stop(ServiceRegistryRef services)
 {
   try {
     mActivity = o2::quality_control::core::computeActivity(services, mActivity);
+    if (mPendingPublication.valid()) {
+      // there are no outputs at STOP, normally it was already sent upon EndOfStream
+      mPendingPublication.wait();
+      mPendingPublication = {};
+      ILOG(Warning, Support) << "The objects of the previous cycle could not be sent before the end of the run" << ENDM;
+    }
     if (mCycleOn) {
       mTask->endOfCycle();
       mCycleNumber++;
@@ -333,6 +362,7 @@ void TaskRunner::stop(ServiceRegistryRef services)
     }
     endOfActivity();
     mTask->reset();
+    mObjectsManager->setAllReset();
   } catch (...) {
     // we catch here because we don't know where it will go in DPL's CallbackService
     ILOG(Error, Support) << "Error caught in stop() : "
@@ -460,11 +490,16 @@ void TaskRunner::finishCycle(DataAllocator& outputs)
 {
   ILOG(Debug, Support) << "Finish cycle " << mCycleNumber << ENDM;
   // in the async context we print only info/ops logs, it's easier to temporarily elevate this log
-  ((mDeploymentMode == DeploymentMode::Grid) ? ILOG(Info, Ops) : ILOG(Info, Devel)) //
-    << "The objects validity is "
-    << "(" << mTimekeeper->getValidity().getMin() << ", " << mTimekeeper->getValidity().getMax() << "), "
-    << "(" << mTimekeeper->getSampleTimespan().getMin() << ", " << mTimekeeper->getSampleTimespan().getMax() << "), "
-    << "(" << mTimekeeper->getTimerangeIdRange().getMin() << ", " << mTimekeeper->getTimerangeIdRange().getMax() << ")" << ENDM;
+  // streamed into ILOG, so that the message is not formatted when it is discarded
+  if (mDeploymentMode == DeploymentMode::Grid) {
+    ILOG(Info, Ops) << "The objects validity is (" << mTimekeeper->getValidity().getMin() << ", " << mTimekeeper->getValidity().getMax() << "), ("
+                    << mTimekeeper->getSampleTimespan().getMin() << ", " << mTimekeeper->getSampleTimespan().getMax() << "), ("
+                    << mTimekeeper->getTimerangeIdRange().getMin() << ", " << mTimekeeper->getTimerangeIdRange().getMax() << ")" << ENDM;
+  } else {
+    ILOG(Info, Devel) << "The objects validity is (" << mTimekeeper->getValidity().getMin() << ", " << mTimekeeper->getValidity().getMax() << "), ("
+                      << mTimekeeper->getSampleTimespan().getMin() << ", " << mTimekeeper->getSampleTimespan().getMax() << "), ("
+                      << mTimekeeper->getTimerangeIdRange().getMin() << ", " << mTimekeeper->getTimerangeIdRange().getMax() << ")" << ENDM;
+  }
   mTask->endOfCycle();
 
   if (mCycleNumber == 0 && gSystem->Getenv("O2_QC_REGISTER_IN_BK")) {
@@ -525,6 +560,15 @@ void TaskRunner::publishCycleStats()
                      .addValue(mLastPublicationDuration, "publication")
                      .addValue(totalDurationActivity, "activity_whole_run"));
 
+  if (mLastSerializationStats.objects > 0) {
+    // aggregated, as a value per object would create as many metric series as there are objects
+    mCollector->send(Metric{ "qc_publication_serialization" }
+                       .addValue(mLastSerializationStats.objects, "objects")
+                       .addValue(mLastSerializationStats.totalMs, "total_ms")
+                       .addValue(mLastSerializationStats.maxMs, "max_ms"));
+    ILOG(Debug, Trace) << "The slowest object to serialize was '" << mLastSerializationStats.slowestObject << "' (" << mLastSerializationStats.maxMs << " ms)" << ENDM;
+  }
+
   mCollector->send(Metric{ "qc_objects_published" }
                      .addValue(mNumberObjectsPublishedInCycle, "in_cycle")
                      .addValue(rate, "per_second")
@@ -537,23 +581,69 @@ int TaskRunner::publish(DataAllocator& outputs)
   ILOG(Debug, Support) << "Publishing " << mObjectsManager->getNumberPublishedObjects() << " MonitorObjects" << ENDM;
   AliceO2::Common::Timer publicationDurationTimer;
 
-  auto concreteOutput = framework::DataSpecUtils::asConcreteDataMatcher(mTaskConfig.moSpec);
   // getNonOwningArray creates a TObjArray containing the monitoring objects, but not
   // owning them. The array is created by new and must be cleaned up by the caller
-  std::unique_ptr<MonitorObjectCollection> array(mObjectsManager->getNonOwningArray());
+  std::unique_ptr<MonitorObjectCollection> array(mTaskConfig.publishOnlyModifiedObjects ? mObjectsManager->getNonOwningArrayOfModified() : mObjectsManager->getNonOwningArray());
   int objectsPublished = array->GetEntries();
+  if (!array->getUnchangedObjects().empty()) {
+    ILOG(Debug, Support) << array->getUnchangedObjects().size() << " MonitorObjects did not change since the last cycle, they are not sent" << ENDM;
+  }
 
-  outputs.snapshot(
-    Output{ concreteOutput.origin,
-            concreteOutput.description,
-            concreteOutput.subSpec },
-    *array);
+  if (mPublicationThread) {
+    // the previous cycle has to be sent first, so the consumers receive the cycles in order
+    sendPendingPublication(outputs, true);
+    // the copies are serialized in the background, while the originals are already filled in the next cycle
+    std::unique_ptr<MonitorObjectCollection> copy(ObjectsManager::copyArray(*array, [this](const TObject& object) { return mTask->copyForPublication(object); }));
+    mPendingPublication = mPublicationThread->submit([this, copy = std::move(copy)]() {
+      if (mSerializer) {
+        return mSerializer->serialize(*copy);
+      }
+      std::vector<MonitorObjectSerializer::Part> parts(1);
+      parts[0].message = MonitorObjectSerializer::serializeCollection(*copy);
+      return parts;
+    });
+  } else if (mSerializer) {
+    sendParts(outputs, mSerializer->serialize(*array));
+  } else {
+    auto concreteOutput = framework::DataSpecUtils::asConcreteDataMatcher(mTaskConfig.moSpec);
+    outputs.snapshot(Output{ concreteOutput.origin, concreteOutput.description, concreteOutput.subSpec }, *array);
+  }
 
   mLastPublicationDuration = publicationDurationTimer.getTime();
   mObjectsManager->stopPublishing(PublicationPolicy::Once);
   return objectsPublished;
 }
 
+void TaskRunner::sendParts(DataAllocator& outputs, const std::vector<MonitorObjectSerializer::Part>& parts)
+{
+  // each part is sent separately, the consumers are expected to iterate over all of them
+  auto concreteOutput = framework::DataSpecUtils::asConcreteDataMatcher(mTaskConfig.moSpec);
+  Output output{ concreteOutput.origin, concreteOutput.description, concreteOutput.subSpec };
+  mLastSerializationStats = {};
+  for (const auto& part : parts) {
+    outputs.snapshot(output, part.message->Buffer(), part.message->Length(), gSerializationMethodROOT);
+    if (!part.objectName.empty()) {
+      mLastSerializationStats.objects++;
+      mLastSerializationStats.totalMs += part.durationMs;
+      if (part.durationMs >= mLastSerializationStats.maxMs) {
+        mLastSerializationStats.maxMs = part.durationMs;
+        mLastSerializationStats.slowestObject = part.objectName;
+      }
+    }
+  }
+}
+
+void TaskRunner::sendPendingPublication(DataAllocator& outputs, bool wait)
+{
+  if (!mPendingPublication.valid()) {
+    return;
+  }
+  if (!wait && mPendingPublication.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return;
+  }
+  sendParts(outputs, mPendingPublication.get());
+}
+
 void TaskRunner::saveToFile()
 {
   if (!mTaskConfig.saveToFile.empty()) {
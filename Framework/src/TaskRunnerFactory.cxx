@@ -167,6 +167,21 @@ TaskRunnerConfig TaskRunnerFactory::extractConfig(const CommonSpec& globalConfig
 
   o2::globaltracking::RecoContainer rd;
 
+  // Mergers in the "entire" mode replace the previous objects of a task with the new ones, thus they would lose the unchanged ones.
+  bool publishOnlyModifiedObjects = taskSpec.publishOnlyModifiedObjects;
+  if (publishOnlyModifiedObjects && taskSpec.location == TaskLocationSpec::Local && taskSpec.mergingMode == "entire") {
+    ILOG(Warning, Support) << "Task '" << taskSpec.taskName << "' uses Mergers in the \"entire\" mode, thus it will publish all the objects each cycle, "
+                           << "despite 'publishOnlyModifiedObjects' being enabled." << ENDM;
+    publishOnlyModifiedObjects = false;
+  }
+  // each object would be sent in its own message part, which would replace the previous ones in such Mergers
+  size_t publicationThreads = taskSpec.publicationThreads;
+  if (publicationThreads > 1 && taskSpec.location == TaskLocationSpec::Local && taskSpec.mergingMode == "entire") {
+    ILOG(Warning, Support) << "Task '" << taskSpec.taskName << "' uses Mergers in the \"entire\" mode, thus it will serialize all the objects in one message, "
+                           << "despite 'publicationThreads' being set to " << publicationThreads << "." << ENDM;
+    publicationThreads = 0;
+  }
+
   return {
     taskSpec.moduleName,
     taskSpec.className,
@@ -194,6 +209,9 @@ TaskRunnerConfig TaskRunnerFactory::extractConfig(const CommonSpec& globalConfig
     globalTrackingDataRequest,
     taskSpec.movingWindows,
     taskSpec.disableLastCycle,
+    publishOnlyModifiedObjects,
+    publicationThreads,
+    taskSpec.doubleBufferedCycles,
   };
 }
 
@@ -0,0 +1,72 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   ThreadPool.cxx
+///
+
+#include "QualityControl/ThreadPool.h"
+
+#include <algorithm>
+
+namespace o2::quality_control::core
+{
+
+ThreadPool::ThreadPool(size_t nThreads)
+{
+  nThreads = std::max<size_t>(1, nThreads);
+  mThreads.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; i++) {
+    mThreads.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStopping = true;
+  }
+  mCondition.notify_all();
+  for (auto& thread : mThreads) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+void ThreadPool::push(std::function<void()>&& task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTasks.push(std::move(task));
+  }
+  mCondition.notify_one();
+}
+
+void ThreadPool::workerLoop()
+{
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mCondition.wait(lock, [this] { return mStopping || !mTasks.empty(); });
+      if (mTasks.empty()) {
+        return; // we are stopping and there is nothing left to do
+      }
+      task = std::move(mTasks.front());
+      mTasks.pop();
+    }
+    task(); // packaged_task stores the exceptions in the future
+  }
+}
+
+} // namespace o2::quality_control::core
@@ -0,0 +1,205 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   TrendingPlotCache.cxx
+///
+
+#include "QualityControl/TrendingPlotCache.h"
+#include "QualityControl/QcInfoLogger.h"
+
+#include <TGraphErrors.h>
+#include <TH1.h>
+#include <THLimitsFinder.h>
+#include <TTree.h>
+#include <TTreeFormula.h>
+
+namespace o2::quality_control::postprocessing
+{
+
+TrendingPlotCache::TrendingPlotCache() = default;
+
+TrendingPlotCache::~TrendingPlotCache() = default;
+
+void TrendingPlotCache::reset()
+{
+  mGraphs.clear();
+  mTree = nullptr;
+  mEntries = 0;
+  mValid = false;
+  mBackground = nullptr;
+  mBackgroundGraph = nullptr;
+}
+
+void TrendingPlotCache::start(TTree* tree)
+{
+  reset();
+  mTree = tree;
+  mEntries = tree ? tree->GetEntries() : 0;
+  mValid = tree != nullptr;
+}
+
+std::vector<std::string> TrendingPlotCache::splitVarexp(const std::string& varexp)
+{
+  std::vector<std::string> dimensions;
+  size_t begin = 0;
+  for (size_t i = 0; i < varexp.size(); i++) {
+    if (varexp[i] != ':') {
+      continue;
+    }
+    if (i + 1 < varexp.size() && varexp[i + 1] == ':') {
+      i++; // scope resolution operator, not a separator
+      continue;
+    }
+    dimensions.push_back(varexp.substr(begin, i - begin));
+    begin = i + 1;
+  }
+  dimensions.push_back(varexp.substr(begin));
+  return dimensions;
+}
+
+std::unique_ptr<TTreeFormula> TrendingPlotCache::compile(const std::string& name, const std::string& expression)
+{
+  auto formula = std::make_unique<TTreeFormula>(name.c_str(), expression.c_str(), mTree);
+  if (formula->GetNdim() == 0) {
+    ILOG(Debug, Devel) << "Could not compile the formula '" << expression << "', the plot will be redrawn in full" << ENDM;
+    return nullptr;
+  }
+  if (formula->GetMultiplicity() != 0) {
+    ILOG(Debug, Devel) << "The formula '" << expression << "' has several values per entry, the plot will be redrawn in full" << ENDM;
+    return nullptr;
+  }
+  return formula;
+}
+
+bool TrendingPlotCache::addGraph(const TrendingTaskConfig::Graph& graphConfig, TObject* drawn, TGraphErrors* graphErrors)
+{
+  if (!mValid) {
+    return false;
+  }
+
+  CachedGraph cachedGraph;
+  auto varexp = splitVarexp(graphConfig.varexp);
+  if (auto* graph = dynamic_cast<TGraph*>(drawn); graph != nullptr && varexp.size() == 2) {
+    cachedGraph.graph = graph;
+  } else if (auto* histogram = dynamic_cast<TH1*>(drawn); histogram != nullptr && varexp.size() == 1 && histogram->GetDimension() == 1) {
+    cachedGraph.histogram = histogram;
+  } else {
+    mValid = false;
+    return false;
+  }
+  if (graphErrors != nullptr) {
+    auto errors = splitVarexp(graphConfig.errors);
+    if (errors.size() != 2) {
+      mValid = false;
+      return false;
+    }
+    varexp.insert(varexp.end(), errors.begin(), errors.end());
+    cachedGraph.graphErrors = graphErrors;
+  }
+
+  for (size_t i = 0; i < varexp.size(); i++) {
+    auto formula = compile(graphConfig.name + "_var" + std::to_string(i), varexp[i]);
+    if (formula == nullptr) {
+      mValid = false;
+      return false;
+    }
+    cachedGraph.formulas.push_back(std::move(formula));
+  }
+  if (!graphConfig.selection.empty()) {
+    cachedGraph.selection = compile(graphConfig.name + "_selection", graphConfig.selection);
+    if (cachedGraph.selection == nullptr) {
+      mValid = false;
+      return false;
+    }
+  }
+
+  if (mGraphs.empty() && cachedGraph.graph != nullptr) {
+    // TTree::Draw sets the axes ranges according to the first graph drawn on the canvas
+    mBackgroundGraph = cachedGraph.graph;
+  }
+  mGraphs.push_back(std::move(cachedGraph));
+  return true;
+}
+
+void TrendingPlotCache::setBackground(TH1* background)
+{
+  mBackground = background;
+}
+
+void TrendingPlotCache::appendEntry(CachedGraph& cachedGraph)
+{
+  // same semantics as TTree::Draw: the selection is used as a weight, entries with 0 are skipped
+  double weight = 1.0;
+  if (cachedGraph.selection) {
+    if (cachedGraph.selection->GetNdata() == 0) {
+      return;
+    }
+    weight = cachedGraph.selection->EvalInstance(0);
+    if (weight == 0) {
+      return;
+    }
+  }
+
+  double values[4] = { 0 };
+  for (size_t i = 0; i < cachedGraph.formulas.size(); i++) {
+    if (cachedGraph.formulas[i]->GetNdata() == 0) {
+      return;
+    }
+    values[i] = cachedGraph.formulas[i]->EvalInstance(0);
+  }
+
+  if (cachedGraph.histogram) {
+    cachedGraph.histogram->Fill(values[0], weight);
+    return;
+  }
+  // varexp is "y:x", errors are "ex:ey"
+  cachedGraph.graph->SetPoint(cachedGraph.graph->GetN(), values[1], values[0]);
+  if (cachedGraph.graphErrors) {
+    auto point = cachedGraph.graphErrors->GetN();
+    cachedGraph.graphErrors->SetPoint(point, values[1], values[0]);
+    cachedGraph.graphErrors->SetPointError(point, values[2], values[3]);
+  }
+}
+
+bool TrendingPlotCache::update(TTree* tree)
+{
+  if (!mValid || tree == nullptr || tree != mTree || tree->GetEntries() < mEntries) {
+    return false;
+  }
+
+  const auto entries = tree->GetEntries();
+  for (Long64_t entry = mEntries; entry < entries; entry++) {
+    if (tree->LoadTree(entry) < 0) {
+      mValid = false;
+      return false;
+    }
+    for (auto& cachedGraph : mGraphs) {
+      appendEntry(cachedGraph);
+    }
+  }
+  mEntries = entries;
+
+  for (auto& cachedGraph : mGraphs) {
+    if (cachedGraph.histogram) {
+      // QCG does not empty the buffers before drawing, we have to do it
+      cachedGraph.histogram->BufferEmpty();
+    }
+  }
+  if (mBackground && mBackgroundGraph && mBackgroundGraph->GetN() > 0) {
+    double xMin, yMin, xMax, yMax;
+    mBackgroundGraph->ComputeRange(xMin, yMin, xMax, yMax);
+    THLimitsFinder::GetLimitsFinder()->FindGoodLimits(mBackground, xMin, xMax, yMin, yMax);
+  }
+  return true;
+}
+
+} // namespace o2::quality_control::postprocessing
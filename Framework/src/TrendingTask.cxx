@@ -38,11 +38,17 @@ using namespace o2::quality_control;
 using namespace o2::quality_control::core;
 using namespace o2::quality_control::postprocessing;
 
+struct TrendingTask::PreparedValues : public PreparedUpdate {
+  std::vector<std::unique_ptr<Reductor>> reductors; // one per data source, nullptr if the source was not prepared
+  std::vector<bool> updated;                        // one per data source
+};
+
 void TrendingTask::configure(const boost::property_tree::ptree& config)
 {
   // we clear any existing objects, which would be there only in case of reconfiguration
   // at the time of writing, this not even supported by ECS
   mReductors.clear();
+  mPlotCaches.clear();
   mTrend.reset();
 
   // configuration
@@ -102,6 +108,7 @@ void TrendingTask::initializeTrend(o2::quality_control::repository::DatabaseInte
   }
 
   // tree is not reusable or does not exist => if we want to reuse the latest, we look for it in QCDB
+  mPlotCaches.clear();
   mTrend.reset();
   if (mConfig.resumeTrend) {
     ILOG(Info, Support) << "Trying to retrieve an existing TTree for this task to continue the trend." << ENDM;
@@ -145,6 +152,7 @@ void TrendingTask::initializeTrend(o2::quality_control::repository::DatabaseInte
 void TrendingTask::initialize(Trigger, framework::ServiceRegistryRef services)
 {
   // removing leftovers from any previous runs
+  mPlotCaches.clear();
   mPlots.clear();
 
   initializeTrend(services.get<repository::DatabaseInterface>());
@@ -165,6 +173,50 @@ void TrendingTask::update(Trigger t, framework::ServiceRegistryRef services)
   }
 }
 
+std::unique_ptr<PreparedUpdate> TrendingTask::prepareUpdate(Trigger t, framework::ServiceRegistryRef services)
+{
+  auto& qcdb = services.get<repository::DatabaseInterface>();
+
+  // the Reductors of the task are bound to the tree, so we use separate ones to reduce the values ahead
+  std::unordered_map<std::string, std::unique_ptr<Reductor>> reductors;
+  std::vector<TrendingTaskConfig::DataSource> sources;
+  for (const auto& source : mConfig.dataSources) {
+    // conditions are retrieved with a CCDB manager which cannot be shared across threads
+    if (source.type == "repository" || source.type == "repository-quality") {
+      auto&& [emplaced, _] = reductors.emplace(source.name, root_class_factory::create<Reductor>(source.moduleName, source.reductorName));
+      emplaced->second->setCustomConfig(source.reductorParameters);
+      sources.push_back(source);
+    }
+  }
+  auto updated = reductor_helpers::updateReductors(reductors, t, sources, qcdb, *this);
+
+  auto prepared = std::make_unique<PreparedValues>();
+  prepared->reductors.resize(mConfig.dataSources.size());
+  prepared->updated.resize(mConfig.dataSources.size(), false);
+  for (size_t i = 0, j = 0; i < mConfig.dataSources.size(); i++) {
+    if (auto it = reductors.find(mConfig.dataSources[i].name); it != reductors.end()) {
+      prepared->reductors[i] = std::move(it->second);
+      prepared->updated[i] = updated[j++];
+    }
+  }
+  return prepared;
+}
+
+void TrendingTask::finishUpdate(Trigger t, framework::ServiceRegistryRef services, std::unique_ptr<PreparedUpdate> prepared)
+{
+  auto* values = dynamic_cast<PreparedValues*>(prepared.get());
+  if (values == nullptr) {
+    update(t, services);
+    return;
+  }
+  auto& qcdb = services.get<repository::DatabaseInterface>();
+
+  const auto allSourcesInvoked = trendValues(t, qcdb, values);
+  if (mConfig.producePlotsOnUpdate && (!mConfig.trendIfAllInputs || allSourcesInvoked)) {
+    generatePlots();
+  }
+}
+
 void TrendingTask::finalize(Trigger, framework::ServiceRegistryRef)
 {
   if (!mConfig.producePlotsOnUpdate) {
@@ -173,7 +225,7 @@ void TrendingTask::finalize(Trigger, framework::ServiceRegistryRef)
   generatePlots();
 }
 
-bool TrendingTask::trendValues(const Trigger& t, repository::DatabaseInterface& qcdb)
+bool TrendingTask::trendValues(const Trigger& t, repository::DatabaseInterface& qcdb, PreparedValues* prepared)
 {
   if (mConfig.trendingTimestamp == "trigger") {
     // ROOT expects seconds since epoch.
@@ -186,8 +238,29 @@ bool TrendingTask::trendValues(const Trigger& t, repository::DatabaseInterface&
   mMetaData.runNumber = t.activity.mId;
   bool wereAllSourcesInvoked = true;
 
-  for (auto& dataSource : mConfig.dataSources) {
-    if (!reductor_helpers::updateReductor(mReductors[dataSource.name].get(), t, dataSource, qcdb, *this)) {
+  std::vector<bool> updated;
+  if (prepared != nullptr) {
+    // the Reductors which prepared new values replace the ones of the task and the tree is bound to them.
+    // the sources which could not be updated keep their previous values, as in the serial path.
+    updated = prepared->updated;
+    for (size_t i = 0; i < mConfig.dataSources.size(); i++) {
+      const auto& dataSource = mConfig.dataSources[i];
+      if (prepared->reductors[i] != nullptr) {
+        if (updated[i]) {
+          auto& reductor = mReductors[dataSource.name];
+          reductor = std::move(prepared->reductors[i]);
+          mTrend->SetBranchAddress(dataSource.name.c_str(), reductor->getBranchAddress());
+        }
+      } else {
+        updated[i] = reductor_helpers::updateReductor(mReductors[dataSource.name].get(), t, dataSource, qcdb, *this);
+      }
+    }
+  } else {
+    updated = reductor_helpers::updateReductors(mReductors, t, mConfig.dataSources, qcdb, *this);
+  }
+  for (size_t i = 0; i < mConfig.dataSources.size(); i++) {
+    const auto& dataSource = mConfig.dataSources[i];
+    if (!updated[i]) {
       wereAllSourcesInvoked = false;
       ILOG(Error, Support) << "Failed to update reductor for data sources with path '" << dataSource.path
                            << "', name '" << dataSource.name
@@ -261,16 +334,31 @@ void TrendingTask::generatePlots()
 
   ILOG(Info, Support) << "Generating " << mConfig.plots.size() << " plots." << ENDM;
   for (const auto& plotConfig : mConfig.plots) {
+    auto& plot = mPlots[plotConfig.name];
+    auto& plotCache = mPlotCaches[plotConfig.name];
 
-    // Before we generate any new plots, we have to delete existing under the same names.
-    // It seems that ROOT cannot handle an existence of two canvases with a common name in the same process.
-    if (mPlots.count(plotConfig.name)) {
-      mPlots[plotConfig.name].reset();
+    if (plot != nullptr && plotCache.update(mTrend.get())) {
+      // only the entries added since the last time were appended to the existing plot
+      updatePlot(plotConfig, plotCache, dynamic_cast<TCanvas*>(plot.get()));
+    } else {
+      // Before we generate any new plots, we have to delete existing under the same names.
+      // It seems that ROOT cannot handle an existence of two canvases with a common name in the same process.
+      plot.reset();
+      plot.reset(drawPlot(plotConfig, plotCache));
     }
-    auto c = drawPlot(plotConfig);
-    mPlots[plotConfig.name].reset(c);
-    getObjectsManager()->startPublishing(c, PublicationPolicy::Once);
+    getObjectsManager()->startPublishing(plot.get(), PublicationPolicy::Once);
+  }
+}
+
+void TrendingTask::updatePlot(const TrendingTaskConfig::Plot& plotConfig, const TrendingPlotCache& plotCache, TCanvas* canvas)
+{
+  // the colors of some drawing options are picked from the palette when the canvas is painted
+  setColorPalette(plotConfig.colorPalette);
+  if (auto background = plotCache.getBackground(); background != nullptr && !plotConfig.graphYRange.empty()) {
+    setUserYAxisRange(background, plotConfig.graphYRange);
   }
+  canvas->Modified();
+  canvas->Update();
 }
 
 std::string TrendingTask::deduceGraphLegendOptions(const TrendingTaskConfig::Graph& graphConfig)
@@ -306,23 +394,30 @@ std::string TrendingTask::deduceGraphLegendOptions(const TrendingTaskConfig::Gra
   return out;
 }
 
-TCanvas* TrendingTask::drawPlot(const TrendingTaskConfig::Plot& plotConfig)
+void TrendingTask::setColorPalette(int colorPalette)
 {
-  auto* c = new TCanvas();
-  auto* legend = new TLegend(0.3, 0.2);
-
-  if (plotConfig.colorPalette != 0) {
+  if (colorPalette != 0) {
     // this will work just once until we bump ROOT to a version which contains this commit:
     // https://github.com/root-project/root/commit/0acdbd5be80494cec98ff60ba9a73cfe70a9a57a
     // and enable the commented out line
     // perhaps JSROOT >7.7.1 will allow us to retain the palette as well.
-    gStyle->SetPalette(plotConfig.colorPalette);
+    gStyle->SetPalette(colorPalette);
     // This makes ROOT store the selected palette for each generated plot.
     // TColor::DefinedColors(1); // TODO enable when available
   } else {
     // we set the default palette
     gStyle->SetPalette();
   }
+}
+
+TCanvas* TrendingTask::drawPlot(const TrendingTaskConfig::Plot& plotConfig, TrendingPlotCache& plotCache)
+{
+  auto* c = new TCanvas();
+  auto* legend = new TLegend(0.3, 0.2);
+
+  setColorPalette(plotConfig.colorPalette);
+  // the plot is drawn in full, from now on we can append only the new entries of the trend
+  plotCache.start(mTrend.get());
 
   // regardless whether we draw a graph or a histogram, a histogram is always used by TTree::Draw to draw axes and title
   // we attempt to keep it to do some modifications later
@@ -356,13 +451,16 @@ TCanvas* TrendingTask::drawPlot(const TrendingTaskConfig::Plot& plotConfig)
       }
     }
 
+    TObject* drawn = nullptr;
     if (auto graph = dynamic_cast<TGraph*>(c->FindObject("Graph"))) {
+      drawn = graph;
       graph->SetName(graphConfig.name.c_str());
       graph->SetTitle(graphConfig.title.c_str());
       legend->AddEntry(graph, graphConfig.title.c_str(), deduceGraphLegendOptions(graphConfig).c_str());
     }
     if (auto htemp = dynamic_cast<TH1*>(c->FindObject("htemp"))) {
       if (plotOrder == 1) {
+        drawn = htemp;
         htemp->SetName(graphConfig.name.c_str());
         htemp->SetTitle(graphConfig.title.c_str());
         legend->AddEntry(htemp, graphConfig.title.c_str(), "lpf");
@@ -380,8 +478,10 @@ TCanvas* TrendingTask::drawPlot(const TrendingTaskConfig::Plot& plotConfig)
       }
     }
 
+    plotCache.addGraph(graphConfig, drawn, graphErrors);
     firstGraphInPlot = false;
   }
+  plotCache.setBackground(background);
 
   c->SetName(plotConfig.name.c_str());
   c->SetTitle(plotConfig.title.c_str());
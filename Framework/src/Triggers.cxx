@@ -20,14 +20,13 @@
 #include "QualityControl/CcdbDatabase.h"
 #include "QualityControl/ObjectMetadataKeys.h"
 #include "QualityControl/KafkaPoller.h"
+#include "QualityControl/ListingWatcher.h"
 
 #include <CCDB/CcdbApi.h>
 #include <Common/Timer.h>
 #include <chrono>
 #include <ostream>
 #include <tuple>
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/json_parser.hpp>
 
 using namespace std::chrono;
 using namespace o2::quality_control::core;
@@ -50,6 +49,34 @@ uint64_t Trigger::msSinceEpoch()
 namespace triggers
 {
 
+namespace
+{
+
+template <typename T>
+T getInteger(const ListingEntry& entry, const std::string& key)
+{
+  auto it = entry.find(key);
+  return it == entry.end() ? T{ 0 } : static_cast<T>(std::strtoll(it->second.c_str(), nullptr, 10));
+}
+
+const std::string& getString(const ListingEntry& entry, const std::string& key)
+{
+  static const std::string empty;
+  auto it = entry.find(key);
+  return it == entry.end() ? empty : it->second;
+}
+
+std::vector<ListingEntry> getListing(CcdbDatabase& db, const std::string& path)
+{
+  auto objects = parseListing(db.getListingAsJson(path));
+  if (!objects.has_value()) {
+    throw std::runtime_error("Could not get a valid listing from the database for the path '" + path + "'");
+  }
+  return std::move(objects.value());
+}
+
+} // namespace
+
 TriggerFcn NotImplemented(std::string triggerName)
 {
   ILOG(Warning, Support) << "TriggerType '" << triggerName << "' is not implemented yet. It will always return TriggerType::No" << ENDM;
@@ -191,40 +218,29 @@ TriggerFcn Periodic(double seconds, const Activity& activity, std::string config
 
 TriggerFcn NewObject(const std::string& databaseUrl, const std::string& databaseType, const std::string& objectPath, const Activity& activity, const std::string& config)
 {
-  // Key names in the header map.
-  constexpr auto timestampKey = metadata_keys::validFrom;
   auto fullObjectPath = (databaseType == "qcdb" ? activity.mProvenance + "/" : "") + objectPath;
   auto metadata = databaseType == "qcdb" ? activity_helpers::asDatabaseMetadata(activity, false) : std::map<std::string, std::string>();
   auto objectActivity = activity;
 
   ILOG(Debug, Support) << "Initializing newObject trigger for the object '" << fullObjectPath << "' and Activity '" << activity << "'" << ENDM;
-  // We support only CCDB here.
-  auto db = std::make_shared<repository::CcdbDatabase>();
-  db->connect(databaseUrl, "", "", "");
+  // We support only CCDB here. The listing requests are shared with other triggers watching objects in the same folder.
+  std::shared_ptr<ListingWatcher::Watch> watch = ListingWatcher::getInstance().watch(databaseUrl, fullObjectPath, metadata);
 
   // Returns "Valid-From" of an object if there is a new one, otherwise 0.
-  auto newObjectValidity = [db, fullObjectPath, metadata, databaseUrl, activity, lastModified = validity_time_t{ 0 }]() mutable -> ValidityInterval {
-    const auto listing = db->getListingAsPtree(fullObjectPath, metadata, true);
-    if (listing.count("objects") == 0) {
-      ILOG(Warning, Support) << "Could not get a valid listing from db '" << databaseUrl << "' for object '" << fullObjectPath << "'" << ENDM;
-      return gInvalidValidityInterval;
-    }
-    const auto& objects = listing.get_child("objects");
-    if (objects.empty()) {
+  auto newObjectValidity = [watch, fullObjectPath, databaseUrl, activity, lastModified = validity_time_t{ 0 }]() mutable -> ValidityInterval {
+    const auto object = watch->getLatest();
+    if (!object.has_value()) {
       // We don't make a fuss over it, because we might be just waiting for the first version of such object.
       // Apparently it happens always for a few iterations at SOR, so Warnings might be too annoying.
       ILOG(Debug, Devel) << "Could not find the file '" << fullObjectPath << "' in the db '"
                          << databaseUrl << "' for given Activity settings (" << activity << "). Zeroes and empty strings are treated as wildcards." << ENDM;
       return gInvalidValidityInterval;
-    } else if (objects.size() > 1) {
-      ILOG(Warning, Support) << "Expected just one metadata entry for object '" << fullObjectPath << "'. Trying to continue by using the first." << ENDM;
     }
 
-    const auto& object = objects.front().second;
-    validity_time_t newLastModified = object.get<uint64_t>(metadata_keys::lastModified, 0);
+    validity_time_t newLastModified = getInteger<validity_time_t>(*object, metadata_keys::lastModified);
     if (newLastModified > lastModified) {
       lastModified = newLastModified;
-      return { object.get<uint64_t>(metadata_keys::validFrom, 0), object.get<uint64_t>(metadata_keys::validUntil) };
+      return { getInteger<validity_time_t>(*object, metadata_keys::validFrom), getInteger<validity_time_t>(*object, metadata_keys::validUntil) };
     }
     return gInvalidValidityInterval;
   };
@@ -263,9 +279,9 @@ TriggerFcn ForEachObject(const std::string& databaseUrl, const std::string& data
   auto db = std::make_shared<repository::CcdbDatabase>();
   db->connect(databaseUrl, "", "", "");
 
-  auto objects = db->getListingAsPtree(fullObjectPath).get_child("objects");
+  auto objects = getListing(*db, fullObjectPath);
   ILOG(Info, Support) << "Got " << objects.size() << " objects for the path '" << fullObjectPath << "'" << ENDM;
-  auto filteredObjects = std::make_shared<std::vector<boost::property_tree::ptree>>();
+  auto filteredObjects = std::make_shared<std::vector<ListingEntry>>();
   const auto filter = databaseType == "qcdb" ? activity : Activity();
 
   ILOG(Debug, Devel) << "Filter activity: " << activity << ENDM;
@@ -273,10 +289,10 @@ TriggerFcn ForEachObject(const std::string& databaseUrl, const std::string& data
   // As for today, we receive objects in the order of the newest to the oldest.
   // We prefer the other order here.
   for (auto rit = objects.rbegin(); rit != objects.rend(); ++rit) {
-    auto objectActivity = activity_helpers::asActivity(rit->second, activity.mProvenance);
+    auto objectActivity = activity_helpers::asActivity(*rit, activity.mProvenance);
     ILOG(Debug, Trace) << "Matching the filter with object's activity: " << objectActivity << ENDM;
     if (filter.matches(objectActivity)) {
-      filteredObjects->emplace_back(rit->second);
+      filteredObjects->emplace_back(std::move(*rit));
       ILOG(Debug, Devel) << "Matched an object with activity: " << activity << ENDM;
     }
   }
@@ -284,15 +300,15 @@ TriggerFcn ForEachObject(const std::string& databaseUrl, const std::string& data
 
   // we make sure it is sorted. If it is already, it shouldn't cost much.
   std::sort(filteredObjects->begin(), filteredObjects->end(),
-            [](const boost::property_tree::ptree& a, const boost::property_tree::ptree& b) {
-              return a.get<int64_t>(timestampSortKey) < b.get<int64_t>(timestampSortKey);
+            [](const ListingEntry& a, const ListingEntry& b) {
+              return getInteger<int64_t>(a, timestampSortKey) < getInteger<int64_t>(b, timestampSortKey);
             });
 
   return [filteredObjects, activity, currentObject = filteredObjects->begin(), config]() mutable -> Trigger {
     if (currentObject != filteredObjects->end()) {
       auto currentActivity = activity_helpers::asActivity(*currentObject, activity.mProvenance);
       bool last = currentObject + 1 == filteredObjects->end();
-      Trigger trigger(TriggerType::ForEachObject, last, currentActivity, currentObject->get<int64_t>(timestampSortKey));
+      Trigger trigger(TriggerType::ForEachObject, last, currentActivity, getInteger<int64_t>(*currentObject, timestampSortKey));
       ++currentObject;
       return trigger;
     } else {
@@ -311,9 +327,9 @@ TriggerFcn ForEachLatest(const std::string& databaseUrl, const std::string& data
   auto db = std::make_shared<repository::CcdbDatabase>();
   db->connect(databaseUrl, "", "", "");
 
-  auto objects = db->getListingAsPtree(fullObjectPath).get_child("objects");
+  auto objects = getListing(*db, fullObjectPath);
   ILOG(Info, Support) << "Got " << objects.size() << " objects for the path '" << fullObjectPath << "'" << ENDM;
-  auto filteredObjects = std::make_shared<std::vector<std::pair<Activity, boost::property_tree::ptree>>>();
+  auto filteredObjects = std::make_shared<std::vector<std::pair<Activity, ListingEntry>>>();
   const auto filter = databaseType == "qcdb" ? activity : Activity();
 
   ILOG(Debug, Devel) << "Filter activity: " << activity << ENDM;
@@ -322,17 +338,17 @@ TriggerFcn ForEachLatest(const std::string& databaseUrl, const std::string& data
   // The inverse order is more likely to follow what we want (ascending by period/pass/run),
   // thus sorting may take less time.
   for (auto rit = objects.rbegin(); rit != objects.rend(); ++rit) {
-    auto objectActivity = activity_helpers::asActivity(rit->second, activity.mProvenance);
+    auto objectActivity = activity_helpers::asActivity(*rit, activity.mProvenance);
     ILOG(Debug, Trace) << "Matching the filter with object's activity: " << objectActivity << ENDM;
     if (filter.matches(objectActivity)) {
-      auto latestObject = std::find_if(filteredObjects->begin(), filteredObjects->end(), [&](const std::pair<Activity, boost::property_tree::ptree>& entry) {
+      auto latestObject = std::find_if(filteredObjects->begin(), filteredObjects->end(), [&](const std::pair<Activity, ListingEntry>& entry) {
         return entry.first.same(objectActivity);
       });
-      if (latestObject != filteredObjects->end() && latestObject->second.get<int64_t>(timestampSortKey) < rit->second.get<int64_t>(timestampSortKey)) {
-        *latestObject = { objectActivity, rit->second };
+      if (latestObject != filteredObjects->end() && getInteger<int64_t>(latestObject->second, timestampSortKey) < getInteger<int64_t>(*rit, timestampSortKey)) {
+        *latestObject = { objectActivity, std::move(*rit) };
         ILOG(Debug, Devel) << "Updated the object with activity: " << objectActivity << ENDM;
       } else {
-        filteredObjects->emplace_back(objectActivity, rit->second);
+        filteredObjects->emplace_back(objectActivity, std::move(*rit));
         ILOG(Debug, Devel) << "Matched an object with activity: " << objectActivity << ENDM;
       }
     }
@@ -342,21 +358,21 @@ TriggerFcn ForEachLatest(const std::string& databaseUrl, const std::string& data
   // Since we select concrete objects per each combination of run/pass/period,
   // we sort the entries in the ascending order by period, pass and run.
   std::sort(filteredObjects->begin(), filteredObjects->end(),
-            [](const std::pair<Activity, boost::property_tree::ptree>& a, const std::pair<Activity, boost::property_tree::ptree>& b) {
-              return std::forward_as_tuple(a.second.get<std::string>(metadata_keys::periodName, ""),
-                                           a.second.get<std::string>(metadata_keys::passName, ""),
-                                           a.second.get<int64_t>(metadata_keys::runNumber, 0)) <
-                     std::forward_as_tuple(b.second.get<std::string>(metadata_keys::periodName, ""),
-                                           b.second.get<std::string>(metadata_keys::passName, ""),
-                                           b.second.get<int64_t>(metadata_keys::runNumber, 0));
+            [](const std::pair<Activity, ListingEntry>& a, const std::pair<Activity, ListingEntry>& b) {
+              return std::make_tuple(getString(a.second, metadata_keys::periodName),
+                                     getString(a.second, metadata_keys::passName),
+                                     getInteger<int64_t>(a.second, metadata_keys::runNumber)) <
+                     std::make_tuple(getString(b.second, metadata_keys::periodName),
+                                     getString(b.second, metadata_keys::passName),
+                                     getInteger<int64_t>(b.second, metadata_keys::runNumber));
             });
 
   return [filteredObjects, activity, currentObject = filteredObjects->begin(), config]() mutable -> Trigger {
     if (currentObject != filteredObjects->end()) {
       const auto& currentActivity = currentObject->first;
-      const auto& currentPtree = currentObject->second;
+      const auto& currentEntry = currentObject->second;
       bool last = currentObject + 1 == filteredObjects->end();
-      Trigger trigger(TriggerType::ForEachLatest, last, currentActivity, currentPtree.get<int64_t>(metadata_keys::validFrom), config);
+      Trigger trigger(TriggerType::ForEachLatest, last, currentActivity, getInteger<int64_t>(currentEntry, metadata_keys::validFrom), config);
       ++currentObject;
       return trigger;
     } else {
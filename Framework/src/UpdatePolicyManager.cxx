@@ -14,6 +14,8 @@
 /// \author Barthelemy von Haller
 ///
 
+#include <algorithm>
+#include <string_view>
 #include <utility>
 
 #include "QualityControl/UpdatePolicyManager.h"
@@ -33,19 +35,40 @@ void UpdatePolicyManager::updateGlobalRevision()
     // mGlobalRevision cannot be 0
     // 0 means overflow, increment and update all check revisions to 0
     ++mGlobalRevision;
-    for (auto& actor : mPoliciesByActor) {
-      updateActorRevision(actor.second.actorName, 0);
+    for (auto& policy : mPolicies) {
+      setActorRevision(policy, 0);
     }
   }
 }
 
-void UpdatePolicyManager::updateActorRevision(const std::string& actorName, RevisionType revision)
+UpdatePolicy& UpdatePolicyManager::getPolicy(const std::string& actorName, const char* operation)
 {
-  if (mPoliciesByActor.count(actorName) == 0) {
-    ILOG(Error, Support) << "Cannot update revision for " << actorName << " : object not found" << ENDM;
+  auto it = mPolicyIndices.find(actorName);
+  if (it == mPolicyIndices.end()) {
+    ILOG(Error, Support) << "Cannot " << operation << " " << actorName << " : object not found" << ENDM;
     BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(actorName));
   }
-  mPoliciesByActor.at(actorName).revision = revision;
+  return mPolicies[it->second];
+}
+
+void UpdatePolicyManager::setActorRevision(UpdatePolicy& policy, RevisionType revision)
+{
+  policy.revision = revision;
+  if (revision >= mMaxObjectRevision) {
+    // typical case, the actor has just been triggered and no object can be newer
+    policy.updatedInputs = 0;
+    return;
+  }
+  policy.updatedInputs = 0;
+  for (auto id : policy.inputIds) {
+    const auto& object = mObjects[id];
+    policy.updatedInputs += object.received && object.revision > revision;
+  }
+}
+
+void UpdatePolicyManager::updateActorRevision(const std::string& actorName, RevisionType revision)
+{
+  setActorRevision(getPolicy(actorName, "update revision for"), revision);
 }
 
 void UpdatePolicyManager::updateActorRevision(const std::string& actorName)
@@ -53,9 +76,30 @@ void UpdatePolicyManager::updateActorRevision(const std::string& actorName)
   updateActorRevision(actorName, mGlobalRevision);
 }
 
+ObjectIdType UpdatePolicyManager::internObject(const std::string& objectName)
+{
+  if (auto it = mObjectIds.find(objectName); it != mObjectIds.end()) {
+    return it->second;
+  }
+  auto id = static_cast<ObjectIdType>(mObjects.size());
+  mObjects.emplace_back();
+  mObjectIds.emplace(objectName, id);
+  return id;
+}
+
 void UpdatePolicyManager::updateObjectRevision(const std::string& objectName, RevisionType revision)
 {
-  mObjectsRevision[objectName] = revision;
+  auto& object = mObjects[internObject(objectName)];
+  for (auto policyIndex : object.policies) {
+    auto& policy = mPolicies[policyIndex];
+    bool wasUpdated = object.received && object.revision > policy.revision;
+    bool isUpdated = revision > policy.revision;
+    policy.updatedInputs += static_cast<int>(isUpdated) - static_cast<int>(wasUpdated);
+    policy.receivedInputs += !object.received;
+  }
+  object.revision = revision;
+  object.received = true;
+  mMaxObjectRevision = std::max(mMaxObjectRevision, revision);
 }
 
 void UpdatePolicyManager::updateObjectRevision(const std::string& objectName)
@@ -65,128 +109,75 @@ void UpdatePolicyManager::updateObjectRevision(const std::string& objectName)
 
 void UpdatePolicyManager::addPolicy(const std::string& actorName, UpdatePolicyType policyType, std::vector<std::string> objectNames, bool allObjects, bool policyHelper)
 {
-  IsReadyFunctionType isReadyFunction;
-  switch (policyType) {
-    case UpdatePolicyType::OnAll: {
-      /**
-       * Run check if all MOs are updated
-       */
-      isReadyFunction = [&, actorName]() {
-        for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-          // QC-1033 - failure to use this policy with checks producing single QO
-          std::string objectNameLocal = objectName;
-          if (objectNameLocal.back() == '/') {
-            ILOG(Debug, Devel) << "OnAll - remove the final slash" << ENDM;
-            objectNameLocal.pop_back();
-          }
-          if (mObjectsRevision.count(objectNameLocal) == 0 || mObjectsRevision.at(objectNameLocal) <= mPoliciesByActor.at(actorName).revision) {
-            return false;
-          }
-        }
-        return true;
-      };
-      break;
+  size_t policyIndex = mPolicies.size();
+  if (auto existing = mPolicyIndices.find(actorName); existing != mPolicyIndices.end()) {
+    // the policy is replaced, its inputs do not refer to it anymore
+    policyIndex = existing->second;
+    for (auto id : mPolicies[policyIndex].inputIds) {
+      std::erase(mObjects[id].policies, policyIndex);
     }
-    case UpdatePolicyType::OnAnyNonZero: {
-      /**
-       * Return true if any declared MOs were updated
-       * Guarantee that all declared MOs are available
-       */
-      isReadyFunction = [&, actorName]() {
-        if (!mPoliciesByActor.at(actorName).policyHelperFlag) {
-          // Check if all monitor objects are available
-          for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-            // QC-1033 - failure to use this policy with checks producing single QO
-            std::string objectNameLocal = objectName;
-            if (objectNameLocal.back() == '/') {
-              ILOG(Debug, Devel) << "OnAnyNonZero - remove the final slash" << ENDM;
-              objectNameLocal.pop_back();
-            }
-
-            if (!mObjectsRevision.count(objectNameLocal)) {
-              return false;
-            }
-          }
-          // From now on all MOs are available
-          mPoliciesByActor.at(actorName).policyHelperFlag = true;
-        }
-
-        for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-          std::string objectNameLocal = objectName;
-          if (objectNameLocal.back() == '/') {
-            ILOG(Debug, Devel) << "OnAnyNonZero - remove the final slash" << ENDM;
-            objectNameLocal.pop_back();
-          }
-          if (mObjectsRevision[objectNameLocal] > mPoliciesByActor.at(actorName).revision) {
-            return true;
-          }
-        }
-        return false;
-      };
-      break;
-    }
-    case UpdatePolicyType::OnEachSeparately: {
-      /**
-        * Return true if any declared object were updated.
-        * This is the same behaviour as OnAny.
-        */
-      isReadyFunction = [&, actorName]() {
-        if (mPoliciesByActor.at(actorName).allInputObjects) {
-          return true;
-        }
+  } else {
+    mPolicies.emplace_back();
+    mPolicyIndices.emplace(actorName, policyIndex);
+  }
 
-        for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-          if (mObjectsRevision.count(objectName) && mObjectsRevision[objectName] > mPoliciesByActor.at(actorName).revision) {
-            return true;
-          }
-        }
-        return false;
-      };
-      break;
+  UpdatePolicy policy{ actorName, policyType, std::move(objectNames), allObjects, policyHelper };
+  for (const auto& objectName : policy.inputObjects) {
+    std::string_view name = objectName;
+    if ((policyType == UpdatePolicyType::OnAll || policyType == UpdatePolicyType::OnAnyNonZero) && !name.empty() && name.back() == '/') {
+      // QC-1033 - failure to use this policy with checks producing single QO
+      ILOG(Debug, Devel) << UpdatePolicyTypeUtils::ToString(policyType) << " - remove the final slash" << ENDM;
+      name.remove_suffix(1);
     }
-    case UpdatePolicyType::OnGlobalAny: {
-      /**
-       * Return true if any MOs were updated.
-       * Inner policy - used for `"MOs": "all"`
-       * Might return true even if MO is not used in actor.
-       */
-
-      isReadyFunction = []() {
-        // Expecting check of this policy only if any change
-        return true;
-      };
-      break;
-    }
-    case UpdatePolicyType::OnAny: {
-      /**
-       * Default behaviour
-       *
-       * Return true if any MOs are updated
-       */
-      isReadyFunction = [&, actorName]() {
-        for (const auto& objectName : mPoliciesByActor.at(actorName).inputObjects) {
-          if (mObjectsRevision.count(objectName) && mObjectsRevision[objectName] > mPoliciesByActor.at(actorName).revision) {
-            return true;
-          }
-        }
-        return false;
-      };
-      break;
+    auto id = internObject(std::string(name));
+    if (std::find(policy.inputIds.begin(), policy.inputIds.end(), id) != policy.inputIds.end()) {
+      continue;
     }
+    policy.inputIds.push_back(id);
+    mObjects[id].policies.push_back(policyIndex);
+    const auto& object = mObjects[id];
+    policy.receivedInputs += object.received;
+    policy.updatedInputs += object.received && object.revision > policy.revision;
   }
+  mPolicies[policyIndex] = std::move(policy);
 
-  mPoliciesByActor[actorName] = { actorName, isReadyFunction, std::move(objectNames), allObjects, policyHelper };
-
-  ILOG(Info, Devel) << "Added a policy : " << mPoliciesByActor[actorName] << ENDM;
+  ILOG(Info, Devel) << "Added a policy : " << mPolicies[policyIndex] << ENDM;
 }
 
 bool UpdatePolicyManager::isReady(const std::string& actorName)
 {
-  if (mPoliciesByActor.count(actorName) == 0) {
-    ILOG(Error, Support) << "Cannot check if " << actorName << " is ready : object not found" << ENDM;
-    BOOST_THROW_EXCEPTION(ObjectNotFoundError() << errinfo_object_name(actorName));
+  auto& policy = getPolicy(actorName, "check readiness of");
+  switch (policy.type) {
+    case UpdatePolicyType::OnAll:
+      // Run check if all MOs are updated
+      return policy.updatedInputs == policy.inputIds.size();
+    case UpdatePolicyType::OnAnyNonZero:
+      // Return true if any declared MOs were updated
+      // Guarantee that all declared MOs are available
+      if (!policy.policyHelperFlag) {
+        if (policy.receivedInputs < policy.inputIds.size()) {
+          return false;
+        }
+        // From now on all MOs are available
+        policy.policyHelperFlag = true;
+      }
+      return policy.updatedInputs > 0;
+    case UpdatePolicyType::OnEachSeparately:
+      // Return true if any declared object were updated.
+      // This is the same behaviour as OnAny.
+      return policy.allInputObjects || policy.updatedInputs > 0;
+    case UpdatePolicyType::OnGlobalAny:
+      // Return true if any MOs were updated.
+      // Inner policy - used for `"MOs": "all"`
+      // Might return true even if MO is not used in actor.
+      // Expecting check of this policy only if any change
+      return true;
+    case UpdatePolicyType::OnAny:
+      // Default behaviour
+      // Return true if any MOs are updated
+      return policy.updatedInputs > 0;
   }
-  return mPoliciesByActor.at(actorName).isReady();
+  return false;
 }
 
 std::ostream& operator<<(std::ostream& out, const UpdatePolicy& updatePolicy) // output
@@ -204,9 +195,12 @@ std::ostream& operator<<(std::ostream& out, const UpdatePolicy& updatePolicy) //
 
 void UpdatePolicyManager::reset()
 {
-  mPoliciesByActor.clear();
-  mObjectsRevision.clear();
+  mPolicies.clear();
+  mPolicyIndices.clear();
+  mObjects.clear();
+  mObjectIds.clear();
   mGlobalRevision = 1;
+  mMaxObjectRevision = 0;
 }
 
-} // namespace o2::quality_control::checker
\ No newline at end of file
+} // namespace o2::quality_control::checker
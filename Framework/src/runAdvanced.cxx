@@ -96,9 +96,9 @@ WorkflowSpec defineDataProcessing(ConfigContext const& config)
   auto infologgerFilterDiscardDebug = configTree.get<bool>("qc.config.infologger.filterDiscardDebug", true);
   auto infologgerDiscardLevel = configTree.get<int>("qc.config.infologger.filterDiscardLevel", 21);
   auto infologgerDiscardFile = configTree.get<std::string>("qc.config.infologger.filterDiscardFile", "");
-  ILOG_INST.filterDiscardDebug(infologgerFilterDiscardDebug);
-  ILOG_INST.filterDiscardLevel(infologgerDiscardLevel);
-  ILOG_INST.filterDiscardSetFile(infologgerDiscardFile.c_str(), 0, 0, 0, true /*Do not store Debug messages in file*/);
+  QcInfoLogger::filterDiscardDebug(infologgerFilterDiscardDebug);
+  QcInfoLogger::filterDiscardLevel(infologgerDiscardLevel);
+  QcInfoLogger::filterDiscardSetFile(infologgerDiscardFile, 0, 0, false /*Do not store Debug messages in file*/);
   QcInfoLogger::setFacility("runAdvanced");
 
   // Full processing topology.
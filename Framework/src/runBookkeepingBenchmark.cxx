@@ -53,8 +53,8 @@ int main(int argc, const char* argv[])
   const auto minDelay = vm["delay"].as<int>();
   cout << "minDelay : " << minDelay << endl;
 
-  ILOG_INST.filterDiscardDebug(true);
-  ILOG_INST.filterDiscardLevel(11);
+  QcInfoLogger::filterDiscardDebug(true);
+  QcInfoLogger::filterDiscardLevel(11);
 
   Bookkeeping::getInstance().init(url);
 
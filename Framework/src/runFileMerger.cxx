@@ -17,7 +17,12 @@
 
 #include "QualityControl/QcInfoLogger.h"
 #include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/ThreadPool.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <string>
 #include <unordered_map>
 #include <fstream>
@@ -27,6 +32,7 @@
 #include <TFile.h>
 #include <TKey.h>
 #include <TGrid.h>
+#include <TROOT.h>
 #include <variant>
 
 namespace bpo = boost::program_options;
@@ -48,6 +54,191 @@ struct Node {
   std::string getFullPath() const { return pathTo + std::filesystem::path::preferred_separator + name; }
 };
 
+using ErrorHandler = std::function<void(const std::string&)>;
+
+struct MergeTimings {
+  std::chrono::duration<double, std::milli> reading{ 0 };
+  std::chrono::duration<double, std::milli> merging{ 0 };
+};
+
+void mergeRecursively(TDirectory* fileNode, Node& memoryNode, const std::vector<std::string>& excludedDirectories, const ErrorHandler& handleError, MergeTimings& timings)
+{
+  if (fileNode == nullptr) {
+    ILOG(Error) << "Provided parentNode pointer is null, skipping." << ENDM;
+    return;
+  }
+  TIter next(fileNode->GetListOfKeys());
+  TKey* key;
+  while ((key = (TKey*)next())) {
+    // we look for exact matches here. we skip if there are no subdirectories
+    if (std::find(excludedDirectories.begin(), excludedDirectories.end(), key->GetName()) != excludedDirectories.end()) {
+      ILOG(Info, Support) << "Skipping '" << key->GetName() << "' as requested in the input arguments" << ENDM;
+      continue;
+    }
+    // we check if we have to skip any subdirectories wrt where we are
+    std::vector<std::string> excludedSubdirectories;
+    for (const auto& excludedDirectory : excludedDirectories) {
+      auto match = std::string(key->GetName()) + '/';
+      if (excludedDirectory.find(match) == 0) {
+        if (excludedDirectory.size() < match.size()) {
+          ILOG(Warning, Support) << "Invalid exclusion path '" << excludedDirectory << "'" << ENDM;
+          continue;
+        }
+        excludedSubdirectories.push_back(excludedDirectory.substr(match.size()));
+      }
+    }
+
+    // only one key is loaded at a time, it is merged and deleted before reading the next one
+    ILOG(Debug, Devel) << "Getting the value for key '" << key->GetName() << "'" << ENDM;
+    auto readStart = std::chrono::steady_clock::now();
+    auto* value = fileNode->Get(key->GetName());
+    timings.reading += std::chrono::steady_clock::now() - readStart;
+    if (value == nullptr) {
+      ILOG(Error) << "Could not get the value '" << key->GetName() << "', skipping." << ENDM;
+      continue;
+    }
+    if (auto inputMOC = dynamic_cast<MonitorObjectCollection*>(value)) {
+      inputMOC->postDeserialization();
+
+      if (memoryNode.children.count(inputMOC->GetName())) {
+        auto mergeStart = std::chrono::steady_clock::now();
+        try {
+          std::get<MonitorObjectCollection*>(memoryNode.children[inputMOC->GetName()])->merge(inputMOC);
+        } catch (...) {
+          handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
+        }
+        timings.merging += std::chrono::steady_clock::now() - mergeStart;
+        delete inputMOC;
+      } else {
+        memoryNode.children[inputMOC->GetName()] = inputMOC;
+      }
+    } else if (auto dir = dynamic_cast<TDirectory*>(value)) {
+      auto name = dir->GetName();
+      if (memoryNode.children.count(name) == 0) {
+        memoryNode.children[name] = Node{ memoryNode.getFullPath(), name };
+      }
+      mergeRecursively(dir, std::get<Node>(memoryNode.children[name]), excludedSubdirectories, handleError, timings);
+    } else {
+      handleError("Could not cast the node to MonitorObjectCollection nor TDirectory.");
+      delete value;
+      continue;
+    }
+  }
+}
+
+void deleteTree(Node& node)
+{
+  for (auto& [name, value] : node.children) {
+    std::visit(overloaded{ [](Node& child) { deleteTree(child); },
+                           [](MonitorObjectCollection* moc) { delete moc; } },
+               value);
+  }
+  node.children.clear();
+}
+
+/// merges the source tree into the target tree, the source tree is left empty
+void mergeTrees(Node& target, Node& source, const ErrorHandler& handleError)
+{
+  for (auto& [name, sourceValue] : source.children) {
+    auto targetIt = target.children.find(name);
+    if (targetIt == target.children.end()) {
+      target.children.emplace(name, std::move(sourceValue));
+      continue;
+    }
+    auto& targetValue = targetIt->second;
+    if (std::holds_alternative<Node>(targetValue) && std::holds_alternative<Node>(sourceValue)) {
+      mergeTrees(std::get<Node>(targetValue), std::get<Node>(sourceValue), handleError);
+    } else if (std::holds_alternative<MonitorObjectCollection*>(targetValue) && std::holds_alternative<MonitorObjectCollection*>(sourceValue)) {
+      auto sourceMOC = std::get<MonitorObjectCollection*>(sourceValue);
+      try {
+        std::get<MonitorObjectCollection*>(targetValue)->merge(sourceMOC);
+      } catch (...) {
+        handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
+      }
+      delete sourceMOC;
+    } else {
+      handleError("Could not merge '" + target.getFullPath() + std::filesystem::path::preferred_separator + name + "', it is a directory in one input and an object in another.");
+      if (auto sourceNode = std::get_if<Node>(&sourceValue)) {
+        deleteTree(*sourceNode);
+      } else {
+        delete std::get<MonitorObjectCollection*>(sourceValue);
+      }
+    }
+  }
+  source.children.clear();
+}
+
+/// objects which are already in the output file are the targets of the merge, as if they were read first
+void mergeWithOutputFile(TFile* outputFile, Node& memoryNode, const ErrorHandler& handleError)
+{
+  for (auto it = memoryNode.children.begin(); it != memoryNode.children.end();) {
+    auto& [name, value] = *it;
+    if (auto node = std::get_if<Node>(&value)) {
+      mergeWithOutputFile(outputFile, *node, handleError);
+      ++it;
+      continue;
+    }
+    auto inputMOC = std::get<MonitorObjectCollection*>(value);
+    std::string mocPath = memoryNode.getFullPath() + std::filesystem::path::preferred_separator + name;
+    auto mergedTObj = outputFile->Get(mocPath.c_str());
+    if (mergedTObj == nullptr) {
+      ++it;
+      continue;
+    }
+    auto mergedMOC = dynamic_cast<MonitorObjectCollection*>(mergedTObj);
+    if (mergedMOC == nullptr) {
+      handleError("Could not cast the merged object to MonitorObjectCollection, skipping.");
+      delete mergedTObj;
+      delete inputMOC;
+      it = memoryNode.children.erase(it);
+      continue;
+    }
+    mergedMOC->postDeserialization();
+    ILOG(Info) << "Read merged object '" << mergedMOC->GetName() << "'" << ENDM;
+    try {
+      mergedMOC->merge(inputMOC);
+    } catch (...) {
+      handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
+    }
+    delete inputMOC;
+    value = mergedMOC;
+    ++it;
+  }
+}
+
+/// merges the input files into the tree, returns the number of files which were read
+size_t mergeFiles(const std::vector<std::string>& inputFilePaths, std::atomic<size_t>& nextFile, Node& mergedTree, const std::vector<std::string>& excludedDirectories, const ErrorHandler& handleError)
+{
+  size_t filesRead = 0;
+  for (size_t i = nextFile++; i < inputFilePaths.size(); i = nextFile++) {
+    const auto& inputFilePath = inputFilePaths[i];
+    auto openStart = std::chrono::steady_clock::now();
+    auto* file = TFile::Open(inputFilePath.c_str(), "READ");
+    if (file == nullptr) {
+      handleError("File handler for '" + inputFilePath + "' is nullptr.");
+      continue;
+    }
+    if (file->IsZombie()) {
+      handleError("File '" + inputFilePath + "' is zombie.");
+      continue;
+    }
+    if (!file->IsOpen()) {
+      handleError("Failed to open the file: " + inputFilePath);
+      continue;
+    }
+    ILOG(Debug) << "Input file '" << inputFilePath << "' successfully open." << ENDM;
+
+    MergeTimings timings;
+    timings.reading = std::chrono::steady_clock::now() - openStart;
+    mergeRecursively(file, mergedTree, excludedDirectories, handleError, timings);
+    file->Close();
+    delete file;
+    filesRead++;
+    ILOG(Info, Support) << "Merged file '" << inputFilePath << "' (reading: " << timings.reading.count() << " ms, merging: " << timings.merging.count() << " ms)" << ENDM;
+  }
+  return filesRead;
+}
+
 int main(int argc, const char* argv[])
 {
   size_t filesRead = 0;
@@ -60,7 +251,8 @@ int main(int argc, const char* argv[])
       ("output-file", bpo::value<std::string>()->default_value("merged.root"), "File path to store the merged results, if the file exists, it will be merged with new files.") //
       ("input-files-list", bpo::value<std::string>()->default_value(""), "Path to a file containing a list of input files (row by row)")                                       //
       ("input-files", bpo::value<std::vector<std::string>>()->multitoken(), "Space-separated file paths which should be merged.")                                              //
-      ("exclude-directories", bpo::value<std::vector<std::string>>()->multitoken(), "Space-separated directories which should be excluded when merging files.");
+      ("exclude-directories", bpo::value<std::vector<std::string>>()->multitoken(), "Space-separated directories which should be excluded when merging files.")               //
+      ("workers", bpo::value<size_t>()->default_value(1), "Number of threads merging the input files in parallel.");
 
     bpo::variables_map vm;
     store(bpo::command_line_parser(argc, argv).options(desc).run(), vm);
@@ -113,9 +305,9 @@ int main(int argc, const char* argv[])
       ILOG(Info, Support) << ENDM;
     }
 
-    auto handleError = vm["exit-on-error"].as<bool>()
-                         ? [](const std::string& message) { throw std::runtime_error(message); }
-                         : [](const std::string& message) { ILOG(Error, Support) << message << ENDM; };
+    ErrorHandler handleError = vm["exit-on-error"].as<bool>()
+                                 ? ErrorHandler([](const std::string& message) { throw std::runtime_error(message); })
+                                 : ErrorHandler([](const std::string& message) { ILOG(Error, Support) << message << ENDM; });
 
     auto outputFilePath = vm["output-file"].as<std::string>();
     auto outputFile = new TFile(outputFilePath.c_str(), "UPDATE");
@@ -137,105 +329,47 @@ int main(int argc, const char* argv[])
     // We choose to keep the merged file structure in memory and merge everything we can before storing in a file.
     // If this becomes too memory-hungry, it could be rewritten to store anything merge immediately at the cost of
     // more I/O operations.
-    Node mergedTree;
-    for (const auto& inputFilePath : inputFilePaths) {
-      auto* file = TFile::Open(inputFilePath.c_str(), "READ");
-      if (file == nullptr) {
-        handleError("File handler for '" + inputFilePath + "' is nullptr.");
-        continue;
-      }
-      if (file->IsZombie()) {
-        handleError("File '" + inputFilePath + "' is zombie.");
-        continue;
+    // With several workers, each of them merges the files it takes from the common list into its own tree,
+    // then the trees are merged pairwise, so the memory usage grows with the number of workers, not files.
+    auto nWorkers = std::clamp<size_t>(vm["workers"].as<size_t>(), 1, std::max<size_t>(inputFilePaths.size(), 1));
+    std::vector<Node> mergedTrees(nWorkers);
+    std::atomic<size_t> nextFile = 0;
+    auto mergeStart = std::chrono::steady_clock::now();
+    if (nWorkers == 1) {
+      filesRead = mergeFiles(inputFilePaths, nextFile, mergedTrees[0], excludedDirectories, handleError);
+    } else {
+      ILOG(Info, Support) << "Merging " << inputFilePaths.size() << " files with " << nWorkers << " workers" << ENDM;
+      ROOT::EnableThreadSafety();
+      ThreadPool pool(nWorkers);
+      std::vector<std::future<size_t>> filesReadByWorkers;
+      for (auto& tree : mergedTrees) {
+        filesReadByWorkers.push_back(pool.submit([&]() {
+          try {
+            return mergeFiles(inputFilePaths, nextFile, tree, excludedDirectories, handleError);
+          } catch (...) {
+            // the other workers stop after their current file
+            nextFile = inputFilePaths.size();
+            throw;
+          }
+        }));
       }
-      if (!file->IsOpen()) {
-        handleError("Failed to open the file: " + inputFilePath);
-        continue;
+      for (auto& future : filesReadByWorkers) {
+        filesRead += future.get();
       }
-      ILOG(Debug) << "Input file '" << inputFilePath << "' successfully open." << ENDM;
 
-      std::function<void(TDirectory*, Node&, const std::vector<std::string>&)> mergeRecursively;
-      mergeRecursively = [&](TDirectory* fileNode, Node& memoryNode, const std::vector<std::string>& excludedDirectories = {}) {
-        if (fileNode == nullptr) {
-          ILOG(Error) << "Provided parentNode pointer is null, skipping." << ENDM;
-          return;
+      for (size_t stride = 1; stride < mergedTrees.size(); stride *= 2) {
+        std::vector<std::future<void>> pairMerges;
+        for (size_t i = 0; i + stride < mergedTrees.size(); i += 2 * stride) {
+          pairMerges.push_back(pool.submit([&, i, stride]() { mergeTrees(mergedTrees[i], mergedTrees[i + stride], handleError); }));
         }
-        TIter next(fileNode->GetListOfKeys());
-        TKey* key;
-        while ((key = (TKey*)next())) {
-          // we look for exact matches here. we skip if there are no subdirectories
-          if (std::find(excludedDirectories.begin(), excludedDirectories.end(), key->GetName()) != excludedDirectories.end()) {
-            ILOG(Info, Support) << "Skipping '" << key->GetName() << "' as requested in the input arguments" << ENDM;
-            continue;
-          }
-          // we check if we have to skip any subdirectories wrt where we are
-          std::vector<std::string> excludedSubdirectories;
-          for (const auto& excludedDirectory : excludedDirectories) {
-            auto match = std::string(key->GetName()) + '/';
-            if (excludedDirectory.find(match) == 0) {
-              if (excludedDirectory.size() < match.size()) {
-                ILOG(Warning, Support) << "Invalid exclusion path '" << excludedDirectory << "'" << ENDM;
-                continue;
-              }
-              excludedSubdirectories.push_back(excludedDirectory.substr(match.size()));
-            }
-          }
-
-          ILOG(Debug, Devel) << "Getting the value for key '" << key->GetName() << "'" << ENDM;
-          auto* value = fileNode->Get(key->GetName());
-          if (value == nullptr) {
-            ILOG(Error) << "Could not get the value '" << key->GetName() << "', skipping." << ENDM;
-            continue;
-          }
-          if (auto inputMOC = dynamic_cast<MonitorObjectCollection*>(value)) {
-            inputMOC->postDeserialization();
-
-            if (memoryNode.children.count(inputMOC->GetName()) == 0) {
-              std::string mocPath = memoryNode.getFullPath() + std::filesystem::path::preferred_separator + key->GetName();
-
-              auto mergedTObj = outputFile->Get(mocPath.c_str());
-              if (mergedTObj != nullptr) {
-                auto mergedMOC = dynamic_cast<MonitorObjectCollection*>(mergedTObj);
-                if (mergedMOC == nullptr) {
-                  handleError("Could not cast the merged object to MonitorObjectCollection, skipping.");
-                  delete mergedMOC;
-                  continue;
-                }
-                mergedMOC->postDeserialization();
-                memoryNode.children[mergedMOC->GetName()] = mergedMOC;
-                ILOG(Info) << "Read merged object '" << mergedMOC->GetName() << "'" << ENDM;
-              }
-            }
-
-            if (memoryNode.children.count(inputMOC->GetName())) {
-              try {
-                std::get<MonitorObjectCollection*>(memoryNode.children[inputMOC->GetName()])->merge(inputMOC);
-              } catch (...) {
-                handleError("Failed to merge the Monitor Object Collection. Exception caught: " + boost::current_exception_diagnostic_information(true));
-              }
-              delete inputMOC;
-            } else {
-              memoryNode.children[inputMOC->GetName()] = inputMOC;
-            }
-          } else if (auto dir = dynamic_cast<TDirectory*>(value)) {
-            auto name = dir->GetName();
-            if (memoryNode.children.count(name) == 0) {
-              memoryNode.children[name] = Node{ memoryNode.getFullPath(), name };
-            }
-            mergeRecursively(dir, std::get<Node>(memoryNode.children[name]), excludedSubdirectories);
-          } else {
-            handleError("Could not cast the node to MonitorObjectCollection nor TDirectory.");
-            delete value;
-            continue;
-          }
+        for (auto& future : pairMerges) {
+          future.get();
         }
-      };
-
-      mergeRecursively(file, mergedTree, excludedDirectories);
-      file->Close();
-      delete file;
-      filesRead++;
+      }
     }
+    Node& mergedTree = mergedTrees[0];
+    mergeWithOutputFile(outputFile, mergedTree, handleError);
+    ILOG(Info, Support) << "Merged " << filesRead << " files in " << std::chrono::duration<double>(std::chrono::steady_clock::now() - mergeStart).count() << " s" << ENDM;
 
     std::function<void(TDirectory*, const Node&)> storeRecursively;
     storeRecursively = [&](TDirectory* fout, const Node& memoryNode) {
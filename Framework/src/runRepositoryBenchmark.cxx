@@ -13,43 +13,86 @@
 /// \file   runRepositoryBenchmark.cxx
 /// \author Barthelemy von Haller
 ///
+/// This is an executable which drives a mix of store, retrieve, latest validity and listing requests to a QCDB
+/// from many threads and prints the latencies and throughput of each type of request as JSON.
+/// If no database URL is given, it runs against a local CCDB stand-in, which allows to compare client-side changes.
 
-#include "RepositoryBenchmark.h"
-#include <fairmq/runDevice.h>
+#include "QualityControl/QcInfoLogger.h"
+#include "QualityControl/RepositoryLoadTest.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/exception/diagnostic_information.hpp>
+#include <boost/program_options.hpp>
+#include <fstream>
+#include <iostream>
 
 namespace bpo = boost::program_options;
+using namespace o2::quality_control::repository;
 
-void addCustomOptions(bpo::options_description& options)
+int main(int argc, const char* argv[])
 {
-  options.add_options()("number-objects", bpo::value<uint64_t>()->default_value(1),
-                        "Number of objects to try to send to the CCDB every second (default : 1)")(
-    "size-objects", bpo::value<uint64_t>()->default_value(1),
-    "Size of the objects to send (in kB, 1, 10, 100, 1000, default : 1)")(
-    "max-iterations", bpo::value<uint64_t>()->default_value(3),
-    "Maximum number of iterations of Run/ConditionalRun/OnData (0 - infinite, default : 3)")(
-    "number-tasks", bpo::value<uint64_t>()->default_value(0),
-    "Informative only, the number of tasks being ran in parallel.")(
-    "database-url", bpo::value<std::string>()->default_value("ccdb-test.cern.ch:8080"),
-    "Database url (default : ccdb-test.cern.ch:8080")("database-username", bpo::value<std::string>()->default_value(""),
-                                                      "Database username (default : <empty>)")(
-    "database-password", bpo::value<std::string>()->default_value(""), "Database password (default : <empty>)")(
-    "database-name", bpo::value<std::string>()->default_value(""), "Database name (default : <empty>")(
-    "task-name", bpo::value<std::string>()->default_value("benchmarkTask"),
-    "Name of the task (default : benchmarkTask)")("object-name", bpo::value<std::string>()->default_value("benchmark"),
-                                                  "Name of the object (default : benchmark)")(
-    "delete", bpo::value<int>()->default_value(0),
-    "Deletion mode (deletes all the versions of the object, 1:true, 0:false)")(
-    "database-backend", bpo::value<std::string>()->default_value("CCDB"),
-    "Name of the database backend (\"CCDB\" (default) or \"MySql\"")(
-    "monitoring-threaded", bpo::value<int>()->default_value(1),
-    "Whether to send the objects rate from a dedicated thread (1, default) or directly from the main thread (0)")(
-    "monitoring-threaded-interval", bpo::value<int>()->default_value(1),
-    "In case we have a thread for the monitoring, interval in sec. between sending monitoring data")(
-    "monitoring-url", bpo::value<std::string>()->default_value("infologger://"),
-    "The URL to the monitoring system (default : \"infologger://\")");
-}
+  try {
+    bpo::options_description desc{ "Options" };
+    desc.add_options()                                                                                                                                    //
+      ("help,h", "Help screen")                                                                                                                           //
+      ("database-url", bpo::value<std::string>()->default_value(""), "URL to the QCDB. If empty, a local CCDB stand-in is used.")                         //
+      ("threads", bpo::value<size_t>()->default_value(4), "Number of concurrent clients, each with its own database connection.")                        //
+      ("duration", bpo::value<double>()->default_value(10), "Duration of the measurement in seconds.")                                                    //
+      ("max-requests", bpo::value<uint64_t>()->default_value(0), "Maximum number of requests per thread, 0 means no limit.")                             //
+      ("mix", bpo::value<std::string>()->default_value("store=1,retrieve=8,validity=2,listing=1"), "Relative weights of the types of requests.")          //
+      ("objects-file", bpo::value<std::string>()->default_value(""), "ROOT file with the output of a QC task, whose objects are stored and retrieved.") //
+      ("object-sizes", bpo::value<std::string>()->default_value("1,10,100"), "Sizes of the generated histograms in kB, if no objects file is given.")     //
+      ("number-objects", bpo::value<size_t>()->default_value(12), "Number of the generated histograms, if no objects file is given.")                     //
+      ("detector-code", bpo::value<std::string>()->default_value("TST"), "Detector code used in the object paths.")                                       //
+      ("task-name", bpo::value<std::string>()->default_value("RepositoryLoadTest"), "Task name used in the object paths.")                                //
+      ("no-truncate", bpo::bool_switch()->default_value(false), "Keep the stored objects in the database at the end.")                                    //
+      ("output", bpo::value<std::string>()->default_value(""), "File to write the results to, they are printed on the standard output if empty.");
 
-std::unique_ptr<fair::mq::Device> getDevice(fair::mq::ProgOptions& /*config*/)
-{
-  return std::make_unique<o2::quality_control::core::RepositoryBenchmark>();
+    bpo::variables_map vm;
+    store(parse_command_line(argc, argv, desc), vm);
+    notify(vm);
+
+    if (vm.count("help")) {
+      std::cout << desc << std::endl;
+      return 0;
+    }
+
+    RepositoryLoadTestConfig config;
+    config.databaseUrl = vm["database-url"].as<std::string>();
+    config.threads = vm["threads"].as<size_t>();
+    config.duration = std::chrono::milliseconds(static_cast<long>(vm["duration"].as<double>() * 1000));
+    config.maxRequestsPerThread = vm["max-requests"].as<uint64_t>();
+    config.mix = RepositoryLoadTestConfig::parseMix(vm["mix"].as<std::string>());
+    config.objectsFile = vm["objects-file"].as<std::string>();
+    config.objectSizesKB.clear();
+    std::vector<std::string> sizes;
+    boost::split(sizes, vm["object-sizes"].as<std::string>(), boost::is_any_of(","));
+    for (const auto& size : sizes) {
+      config.objectSizesKB.push_back(std::stoul(size));
+    }
+    config.numberOfObjects = vm["number-objects"].as<size_t>();
+    config.detector = vm["detector-code"].as<std::string>();
+    config.taskName = vm["task-name"].as<std::string>();
+    config.truncate = !vm["no-truncate"].as<bool>();
+
+    o2::quality_control::core::QcInfoLogger::filterDiscardDebug(true);
+    RepositoryLoadTest loadTest(config);
+    auto results = loadTest.run();
+
+    auto output = vm["output"].as<std::string>();
+    if (output.empty()) {
+      std::cout << results.toJson() << std::endl;
+    } else {
+      std::ofstream(output) << results.toJson() << std::endl;
+      ILOG(Info, Support) << "Results written to '" << output << "'" << ENDM;
+    }
+  } catch (const bpo::error& ex) {
+    ILOG(Error, Ops) << "Exception caught: " << ex.what() << ENDM;
+    return 1;
+  } catch (...) {
+    ILOG(Error, Ops) << boost::current_exception_diagnostic_information(true) << ENDM;
+    return 1;
+  }
+
+  return 0;
 }
@@ -0,0 +1,75 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   benchmarkInfoLogger.cxx
+///
+/// Measures the cost of a call to ILOG for a message discarded by the InfoLogger filters,
+/// comparing it to a message formatted and then discarded by the InfoLogger, which is what ILOG used to do.
+/// The debug messages and the levels from Devel up are discarded, as in production.
+///
+
+#include "QualityControl/QcInfoLogger.h"
+
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control::core;
+
+template <typename Function>
+double measureNsPerCall(size_t nCalls, Function function)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < nCalls; i++) {
+    function(i);
+  }
+  std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+  return duration.count() / nCalls;
+}
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()("help,h", "Help screen")("calls,c", bpo::value<size_t>()->default_value(1000000), "Number of calls to measure");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+  const auto nCalls = vm["calls"].as<size_t>();
+
+  QcInfoLogger::filterDiscardDebug(true);
+  QcInfoLogger::filterDiscardLevel(AliceO2::InfoLogger::InfoLogger::Level::Devel);
+
+  const std::string objectName = "qc/TST/MO/Task/histogram";
+  auto formatted = measureNsPerCall(nCalls, [&](size_t i) {
+    ILOG_INST << AliceO2::InfoLogger::InfoLogger::InfoLoggerMessageOption{ AliceO2::InfoLogger::InfoLogger::Severity::Debug, AliceO2::InfoLogger::InfoLogger::Level::Devel, AliceO2::InfoLogger::InfoLogger::undefinedMessageOption.errorCode, __FILE__, __LINE__ }
+              << "CheckRunner received the object " << objectName << " number " << i << ENDM;
+  });
+  auto debug = measureNsPerCall(nCalls, [&](size_t i) {
+    ILOG(Debug, Devel) << "CheckRunner received the object " << objectName << " number " << i << ENDM;
+  });
+  auto trace = measureNsPerCall(nCalls, [&](size_t i) {
+    ILOG(Info, Trace) << "CheckRunner received the object " << objectName << " number " << i << ENDM;
+  });
+
+  std::cout << "ns per discarded message (" << nCalls << " calls)" << (QcInfoLogger::isStripped(AliceO2::InfoLogger::InfoLogger::Severity::Debug, 0) ? ", Debug and Trace stripped at compile time" : "") << ":" << std::endl;
+  std::cout << "  formatted, then discarded by InfoLogger : " << formatted << std::endl;
+  std::cout << "  ILOG(Debug, Devel)                      : " << debug << std::endl;
+  std::cout << "  ILOG(Info, Trace)                       : " << trace << std::endl;
+  return 0;
+}
@@ -0,0 +1,142 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   benchmarkMonitorObjectIngestion.cxx
+///
+/// Measures the memory allocated by a CheckRunner to ingest the objects it receives in each cycle,
+/// comparing the former approach (clone of the received TObject, new MonitorObject) to MonitorObjectCache.
+/// The allocations made to create the received objects (i.e. the deserialization) are not counted.
+///
+
+#include "QualityControl/MonitorObjectCache.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/Activity.h"
+
+#include <TH2F.h>
+#include <TObjArray.h>
+#include <boost/program_options.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::checker;
+
+namespace
+{
+std::atomic<size_t> gAllocatedBytes{ 0 };
+}
+
+void* operator new(size_t size)
+{
+  gAllocatedBytes += size;
+  if (void* ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+std::vector<TObject*> receive(size_t nObjects, int nBins, bool asMonitorObjects)
+{
+  std::vector<TObject*> received;
+  for (size_t i = 0; i < nObjects; i++) {
+    auto name = "histo" + std::to_string(i);
+    auto* histo = new TH2F(name.c_str(), name.c_str(), nBins, 0, 1, nBins, 0, 1);
+    histo->Fill(0.5, 0.5);
+    if (asMonitorObjects) {
+      received.push_back(new MonitorObject(histo, "task", "TaskClass", "TST"));
+    } else {
+      received.push_back(histo);
+    }
+  }
+  return received;
+}
+
+// what CheckRunner::prepareCacheData used to do for each received object
+void ingestWithClone(std::map<std::string, std::shared_ptr<MonitorObject>>& cache, TObject* received, const Activity& activity)
+{
+  auto* array = new TObjArray();
+  array->Add(received->Clone());
+  delete received;
+  for (auto* element : *array) {
+    std::shared_ptr<MonitorObject> mo{ dynamic_cast<MonitorObject*>(element) };
+    if (mo == nullptr) {
+      mo = std::make_shared<MonitorObject>(element, "external", "CheckRunner", "TST");
+      mo->setActivity(activity);
+    }
+    mo->setIsOwner(true);
+    cache[mo->getFullName()] = mo;
+  }
+  delete array;
+}
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()("help,h", "Help screen")("objects,o", bpo::value<size_t>()->default_value(20), "Number of objects received in each cycle")("bins,b", bpo::value<int>()->default_value(500), "Number of bins of the TH2F along each axis")("cycles,c", bpo::value<size_t>()->default_value(10), "Number of cycles")("monitorObjects,m", bpo::value<bool>()->default_value(false), "Receive MonitorObjects instead of bare TObjects");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+  const auto nObjects = vm["objects"].as<size_t>();
+  const auto nBins = vm["bins"].as<int>();
+  const auto nCycles = vm["cycles"].as<size_t>();
+  const auto asMonitorObjects = vm["monitorObjects"].as<bool>();
+
+  TH1::AddDirectory(false);
+  Activity activity;
+
+  size_t cloneBytes = 0;
+  {
+    std::map<std::string, std::shared_ptr<MonitorObject>> cache;
+    for (size_t cycle = 0; cycle < nCycles; cycle++) {
+      auto received = receive(nObjects, nBins, asMonitorObjects);
+      auto before = gAllocatedBytes.load();
+      for (auto* object : received) {
+        ingestWithClone(cache, object, activity);
+      }
+      cloneBytes += gAllocatedBytes.load() - before;
+    }
+  }
+
+  size_t cacheBytes = 0;
+  {
+    MonitorObjectCache cache;
+    for (size_t cycle = 0; cycle < nCycles; cycle++) {
+      auto received = receive(nObjects, nBins, asMonitorObjects);
+      auto before = gAllocatedBytes.load();
+      for (auto* object : received) {
+        cache.ingest(std::unique_ptr<TObject>(object), "external", "TST", activity);
+      }
+      cacheBytes += gAllocatedBytes.load() - before;
+    }
+    std::cout << "MonitorObject shells reused: " << cache.getNumberReusedShells() << std::endl;
+  }
+
+  std::cout << "Bytes allocated per cycle to ingest " << nObjects << " " << (asMonitorObjects ? "MonitorObjects" : "TObjects")
+            << " (TH2F " << nBins << "x" << nBins << "):" << std::endl;
+  std::cout << "  clone + new MonitorObject : " << cloneBytes / nCycles << std::endl;
+  std::cout << "  MonitorObjectCache        : " << cacheBytes / nCycles << std::endl;
+  return 0;
+}
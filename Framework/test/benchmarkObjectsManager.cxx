@@ -0,0 +1,90 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   benchmarkObjectsManager.cxx
+///
+/// Measures the time spent by ObjectsManager to register, look up and unregister many objects,
+/// as tasks with one histogram per chip or detection element do in initialize() and at the end of a run.
+///
+
+#include "QualityControl/ObjectsManager.h"
+
+#include <TH1F.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control::core;
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()("help,h", "Help screen")("objects,o", bpo::value<size_t>()->default_value(10000), "Number of objects")("repetitions,r", bpo::value<size_t>()->default_value(5), "Number of repetitions");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+  const auto nObjects = vm["objects"].as<size_t>();
+  const auto nRepetitions = vm["repetitions"].as<size_t>();
+
+  TH1::AddDirectory(false);
+  std::vector<std::unique_ptr<TH1F>> histograms;
+  std::vector<std::string> names;
+  for (size_t i = 0; i < nObjects; i++) {
+    names.push_back("histo" + std::to_string(i));
+    histograms.push_back(std::make_unique<TH1F>(names.back().c_str(), names.back().c_str(), 10, 0, 10));
+  }
+  // the objects are unregistered in a random order, as it would be the worst case for a compacted array
+  std::vector<size_t> removalOrder(nObjects);
+  for (size_t i = 0; i < nObjects; i++) {
+    removalOrder[i] = i;
+  }
+  std::shuffle(removalOrder.begin(), removalOrder.end(), std::mt19937{ 42 });
+
+  std::chrono::duration<double, std::milli> startTime{ 0 }, lookupTime{ 0 }, stopTime{ 0 };
+  for (size_t repetition = 0; repetition < nRepetitions; repetition++) {
+    ObjectsManager objectsManager("benchmark", "BenchmarkClass", "TST", "", 0, true);
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto& histogram : histograms) {
+      objectsManager.startPublishing(histogram.get(), PublicationPolicy::Forever);
+    }
+    auto started = std::chrono::steady_clock::now();
+    for (const auto& name : names) {
+      objectsManager.setDefaultDrawOptions(name, "colz");
+    }
+    auto lookedUp = std::chrono::steady_clock::now();
+    for (auto i : removalOrder) {
+      objectsManager.stopPublishing(histograms[i].get());
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    startTime += started - start;
+    lookupTime += lookedUp - started;
+    stopTime += end - lookedUp;
+  }
+
+  std::cout << nObjects << " objects, average of " << nRepetitions << " repetitions:" << std::endl;
+  std::cout << "  startPublishing       : " << startTime.count() / nRepetitions << " ms" << std::endl;
+  std::cout << "  setDefaultDrawOptions : " << lookupTime.count() / nRepetitions << " ms" << std::endl;
+  std::cout << "  stopPublishing        : " << stopTime.count() / nRepetitions << " ms" << std::endl;
+  return 0;
+}
@@ -0,0 +1,377 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   benchmarkQcPipeline.cxx
+///
+/// Runs the hot paths of a QC pipeline in one process, stage by stage, with synthetic detector payloads:
+/// parallel tasks fill histograms with TFs and publish them at the end of each cycle, the Mergers algorithm merges
+/// their collections, the CheckRunner ingests the merged objects in its MonitorObjectCache, runs the ready Checks
+/// (QcCommon MeanIsAbove) and stores the results in a DummyDatabase, and the AggregatorRunner runs a QcCommon
+/// WorstOfAllAggregator on their qualities. The readiness of the checks and of the aggregator is evaluated by
+/// UpdatePolicyManagers, as in the runners. The DPL transport between the stages is replaced by the ROOT serialization
+/// it would perform. It reports the TF rate, the duration of each stage, the cycle latency (from the end of the cycle
+/// to the aggregated quality) and the resident memory allocated by each stage and left after it.
+///
+
+#include "QualityControl/Aggregator.h"
+#include "QualityControl/AggregatorRunner.h"
+#include "QualityControl/Check.h"
+#include "QualityControl/CheckRunner.h"
+#include "QualityControl/DummyDatabase.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/MonitorObjectCache.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/MonitorObjectSerializer.h"
+#include "QualityControl/ObjectsManager.h"
+#include "QualityControl/QualityObject.h"
+#include "QualityControl/ThreadPool.h"
+#include "QualityControl/UpdatePolicyManager.h"
+
+#include <Mergers/MergerAlgorithm.h>
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TH3F.h>
+#include <TMessage.h>
+#include <TROOT.h>
+#include <boost/program_options.hpp>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::checker;
+using namespace o2::quality_control::repository;
+using namespace std::chrono;
+
+namespace
+{
+
+// the same as what DPL does to read ROOT-serialized messages
+class InputMessage : public TMessage
+{
+ public:
+  InputMessage(void* buffer, Int_t length) : TMessage(buffer, length) { ResetBit(kIsOwner); }
+};
+
+std::unique_ptr<MonitorObjectCollection> deserialize(const TMessage& message)
+{
+  std::vector<char> buffer(message.Buffer(), message.Buffer() + message.Length());
+  InputMessage input(buffer.data(), buffer.size());
+  auto* collection = static_cast<MonitorObjectCollection*>(input.ReadObjectAny(MonitorObjectCollection::Class()));
+  collection->SetOwner(true);
+  return std::unique_ptr<MonitorObjectCollection>(collection);
+}
+
+// the current resident memory, the peak of getrusage() would be the one of the whole process
+long getRssKB()
+{
+  long size = 0, resident = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> size >> resident;
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/// A task which fills its histograms with the entries of each TF.
+class SyntheticTask
+{
+ public:
+  SyntheticTask(size_t index, size_t nObjects, size_t objectSizeKB, int dimensions, size_t tfEntries)
+    : mObjectsManager("pipeline", "SyntheticTask", "TST", "", static_cast<int>(index), true), mDimensions(dimensions)
+  {
+    // 4 bytes per bin
+    auto binsPerAxis = std::max(1, static_cast<int>(std::pow(objectSizeKB * 1024.0 / sizeof(float), 1.0 / dimensions)));
+    for (size_t i = 0; i < nObjects; i++) {
+      auto name = "histo" + std::to_string(i);
+      TH1* histogram = nullptr;
+      if (dimensions == 1) {
+        histogram = new TH1F(name.c_str(), name.c_str(), binsPerAxis, 0, 1);
+      } else if (dimensions == 2) {
+        histogram = new TH2F(name.c_str(), name.c_str(), binsPerAxis, 0, 1, binsPerAxis, 0, 1);
+      } else {
+        histogram = new TH3F(name.c_str(), name.c_str(), binsPerAxis, 0, 1, binsPerAxis, 0, 1, binsPerAxis, 0, 1);
+      }
+      mHistograms.emplace_back(histogram);
+      mObjectsManager.startPublishing(histogram, PublicationPolicy::Forever);
+    }
+    // the same TF is processed again and again, so that the generation of data is not measured
+    std::mt19937 generator(index);
+    std::uniform_real_distribution<double> distribution(0, 1);
+    mTf.resize(tfEntries * 3);
+    std::generate(mTf.begin(), mTf.end(), [&]() { return distribution(generator); });
+  }
+
+  void processTf()
+  {
+    for (auto& histogram : mHistograms) {
+      for (size_t i = 0; i + 2 < mTf.size(); i += 3) {
+        if (mDimensions == 1) {
+          histogram->Fill(mTf[i]);
+        } else if (mDimensions == 2) {
+          static_cast<TH2*>(histogram.get())->Fill(mTf[i], mTf[i + 1]);
+        } else {
+          static_cast<TH3*>(histogram.get())->Fill(mTf[i], mTf[i + 1], mTf[i + 2]);
+        }
+      }
+    }
+  }
+
+  std::unique_ptr<TMessage> publish(validity_time_t cycleEnd)
+  {
+    mObjectsManager.setValidity({ cycleEnd - 1000, cycleEnd });
+    auto message = MonitorObjectSerializer::serializeCollection(*mObjectsManager.getNonOwningArray());
+    for (auto& histogram : mHistograms) {
+      histogram->Reset();
+    }
+    return message;
+  }
+
+ private:
+  ObjectsManager mObjectsManager;
+  int mDimensions;
+  std::vector<std::unique_ptr<TH1>> mHistograms;
+  std::vector<double> mTf;
+};
+
+struct StageStats {
+  duration<double, std::milli> total{ 0 };
+  duration<double, std::milli> max{ 0 };
+  long totalRssDeltaKB = 0;
+  long maxRssDeltaKB = 0;
+  long rssKB = 0;
+
+  void add(duration<double, std::milli> elapsed, long rssBeforeKB)
+  {
+    total += elapsed;
+    max = std::max(max, elapsed);
+    rssKB = getRssKB();
+    totalRssDeltaKB += rssKB - rssBeforeKB;
+    maxRssDeltaKB = std::max(maxRssDeltaKB, rssKB - rssBeforeKB);
+  }
+};
+
+std::vector<std::unique_ptr<Check>> createChecks(size_t nChecks, UpdatePolicyManager& updatePolicyManager, const Activity& activity)
+{
+  std::vector<std::unique_ptr<Check>> checks;
+  for (size_t i = 0; i < nChecks; i++) {
+    CheckConfig config;
+    config.name = "check" + std::to_string(i);
+    config.moduleName = "QcCommon";
+    config.className = "o2::quality_control_modules::common::MeanIsAbove";
+    config.detectorName = "TST";
+    config.customParameters.set("meanThreshold", "0.5");
+    config.policyType = UpdatePolicyType::OnEachSeparately;
+    config.allObjects = true;
+    config.allowBeautify = true;
+    auto check = std::make_unique<Check>(config);
+    check->init();
+    check->startOfActivity(activity);
+    updatePolicyManager.addPolicy(check->getName(), check->getUpdatePolicyType(), check->getObjectsNames(), check->getAllObjectsOption(), false);
+    checks.push_back(std::move(check));
+  }
+  return checks;
+}
+
+std::shared_ptr<Aggregator> createAggregator(const std::vector<std::unique_ptr<Check>>& checks, UpdatePolicyManager& updatePolicyManager, const Activity& activity)
+{
+  AggregatorConfig config;
+  config.name = "worstOf";
+  config.moduleName = "QcCommon";
+  config.className = "o2::quality_control_modules::common::WorstOfAllAggregator";
+  config.detectorName = "TST";
+  config.policyType = UpdatePolicyType::OnAny;
+  config.allObjects = true;
+  for (const auto& check : checks) {
+    config.sources.emplace_back(DataSourceType::Check, check->getName());
+  }
+  auto aggregator = std::make_shared<Aggregator>(config);
+  aggregator->init();
+  aggregator->startOfActivity(activity);
+  updatePolicyManager.addPolicy(aggregator->getName(), aggregator->getUpdatePolicyType(), aggregator->getObjectsNames(), aggregator->getAllObjectsOption(), false);
+  return aggregator;
+}
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                                 //
+    ("help,h", "Help screen")                                                                                        //
+    ("tasks,t", bpo::value<size_t>()->default_value(4), "Number of parallel tasks, merged by the merger")            //
+    ("objects,o", bpo::value<size_t>()->default_value(20), "Number of objects published by each task")               //
+    ("size,s", bpo::value<size_t>()->default_value(100), "Size of each object in kB")                                //
+    ("dimensions,d", bpo::value<int>()->default_value(1), "Dimensionality of the histograms (1, 2 or 3)")            //
+    ("tf-entries,e", bpo::value<size_t>()->default_value(1000), "Number of entries filled in each object by one TF") //
+    ("checks,k", bpo::value<size_t>()->default_value(10), "Number of checks, each of them receives all the objects") //
+    ("check-parallelism,p", bpo::value<size_t>()->default_value(0), "Number of threads running the checks, 0 to run them in the main thread") //
+    ("cycle-duration,c", bpo::value<double>()->default_value(1), "Duration of a task cycle in seconds")              //
+    ("cycles,n", bpo::value<size_t>()->default_value(10), "Number of cycles");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+  const auto nTasks = vm["tasks"].as<size_t>();
+  const auto nObjects = vm["objects"].as<size_t>();
+  const auto objectSizeKB = vm["size"].as<size_t>();
+  const auto dimensions = std::clamp(vm["dimensions"].as<int>(), 1, 3);
+  const auto tfEntries = vm["tf-entries"].as<size_t>();
+  const auto nChecks = vm["checks"].as<size_t>();
+  const auto checkParallelism = vm["check-parallelism"].as<size_t>();
+  const auto cycleDuration = duration<double>(vm["cycle-duration"].as<double>());
+  const auto nCycles = vm["cycles"].as<size_t>();
+
+  TH1::AddDirectory(false);
+  ROOT::EnableThreadSafety();
+  Activity activity;
+  std::vector<std::unique_ptr<SyntheticTask>> tasks;
+  for (size_t i = 0; i < nTasks; i++) {
+    tasks.push_back(std::make_unique<SyntheticTask>(i, nObjects, objectSizeKB, dimensions, tfEntries));
+  }
+  UpdatePolicyManager checksPolicyManager;
+  auto checks = createChecks(nChecks, checksPolicyManager, activity);
+  std::unique_ptr<ThreadPool> checkPool = checkParallelism > 0 ? std::make_unique<ThreadPool>(checkParallelism) : nullptr;
+  UpdatePolicyManager aggregatorPolicyManager;
+  std::vector<std::shared_ptr<Aggregator>> aggregators{ createAggregator(checks, aggregatorPolicyManager, activity) };
+  QualityObjectsMapType qoMap;
+  MonitorObjectCache cache;
+  DummyDatabase database;
+  const long initialRssKB = getRssKB();
+
+  size_t totalTfs = 0;
+  duration<double> taskTime{ 0 };
+  StageStats tasksStats, publicationStats, mergerStats, checkRunnerStats, aggregatorStats, cycleStats;
+
+  for (size_t cycle = 0; cycle < nCycles; cycle++) {
+    // Tasks: each of them processes TFs in its own thread, as separate processes would
+    std::vector<size_t> tfs(nTasks, 0);
+    std::vector<std::thread> threads;
+    long rssKB = getRssKB();
+    auto cycleStart = steady_clock::now();
+    for (size_t i = 0; i < nTasks; i++) {
+      threads.emplace_back([&, i]() {
+        while (steady_clock::now() - cycleStart < cycleDuration) {
+          tasks[i]->processTf();
+          tfs[i]++;
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    auto cycleEnd = steady_clock::now();
+    tasksStats.add(cycleEnd - cycleStart, rssKB);
+    rssKB = tasksStats.rssKB;
+    taskTime += cycleEnd - cycleStart;
+    for (auto count : tfs) {
+      totalTfs += count;
+    }
+
+    // Publication at the end of the cycle
+    auto timestamp = static_cast<validity_time_t>(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count());
+    std::vector<std::unique_ptr<TMessage>> messages;
+    for (auto& task : tasks) {
+      messages.push_back(task->publish(timestamp));
+    }
+    auto published = steady_clock::now();
+    publicationStats.add(published - cycleEnd, rssKB);
+    rssKB = publicationStats.rssKB;
+
+    // Merger
+    auto merged = deserialize(*messages.front());
+    for (size_t i = 1; i < messages.size(); i++) {
+      auto collection = deserialize(*messages[i]);
+      o2::mergers::algorithm::merge(merged.get(), collection.get());
+    }
+    auto mergedMessage = MonitorObjectSerializer::serializeCollection(*merged);
+    merged.reset();
+    messages.clear();
+    auto afterMerger = steady_clock::now();
+    mergerStats.add(afterMerger - published, rssKB);
+    rssKB = mergerStats.rssKB;
+
+    // CheckRunner, as in its run(): the readiness of all the checks is evaluated before running any
+    auto updated = cache.ingest(deserialize(*mergedMessage), "pipeline", "TST", activity);
+    mergedMessage.reset();
+    for (const auto& mo : updated) {
+      checksPolicyManager.updateObjectRevision(mo->getFullName());
+    }
+    std::vector<Check*> readyChecks;
+    for (const auto& check : checks) {
+      if (checksPolicyManager.isReady(check->getName())) {
+        readyChecks.push_back(check.get());
+      }
+    }
+    auto qosPerCheck = CheckRunner::runChecks(readyChecks, cache.getMonitorObjects(), checkPool.get());
+    for (size_t i = 0; i < readyChecks.size(); i++) {
+      checksPolicyManager.updateActorRevision(readyChecks[i]->getName());
+      for (const auto& qo : qosPerCheck[i]) {
+        database.storeQO(qo);
+      }
+    }
+    for (const auto& mo : updated) {
+      database.storeMO(mo);
+    }
+    checksPolicyManager.updateGlobalRevision();
+    auto afterCheckRunner = steady_clock::now();
+    checkRunnerStats.add(afterCheckRunner - afterMerger, rssKB);
+    rssKB = checkRunnerStats.rssKB;
+
+    // AggregatorRunner, which receives the QOs of the CheckRunner
+    for (const auto& qos : qosPerCheck) {
+      for (const auto& qo : qos) {
+        qoMap[qo->getName()] = qo;
+        aggregatorPolicyManager.updateObjectRevision(qo->getName());
+      }
+    }
+    for (const auto& [aggregatorName, qos] : AggregatorRunner::runAggregators(aggregators, aggregatorPolicyManager, qoMap, activity)) {
+      for (const auto& qo : qos) {
+        database.storeQO(qo);
+      }
+    }
+    aggregatorPolicyManager.updateGlobalRevision();
+    auto afterAggregator = steady_clock::now();
+    aggregatorStats.add(afterAggregator - afterCheckRunner, rssKB);
+    cycleStats.add(afterAggregator - cycleEnd, tasksStats.rssKB);
+  }
+
+  std::cout << nTasks << " tasks x " << nObjects << " TH" << dimensions << "F of " << objectSizeKB << " kB, " << tfEntries << " entries per TF, "
+            << nChecks << " checks on " << std::max<size_t>(checkParallelism, 1) << " threads, " << nCycles << " cycles of " << cycleDuration.count() << " s" << std::endl;
+  std::cout << "  TF rate per task : " << totalTfs / taskTime.count() / nTasks << " TF/s" << std::endl;
+  std::cout << "  initial RSS      : " << initialRssKB / 1024 << " MB" << std::endl;
+  std::cout << "  stage              mean [ms]    max [ms]  mean dRSS [MB]  max dRSS [MB]  RSS after [MB]" << std::endl;
+  auto print = [nCycles](const std::string& stage, const StageStats& stats) {
+    std::cout << "  " << std::left << std::setw(16) << stage << std::right << std::fixed << std::setprecision(3)
+              << std::setw(12) << stats.total.count() / nCycles << std::setw(12) << stats.max.count()
+              << std::setw(16) << stats.totalRssDeltaKB / 1024.0 / nCycles << std::setw(15) << stats.maxRssDeltaKB / 1024.0
+              << std::setw(16) << stats.rssKB / 1024.0 << std::endl;
+  };
+  print("tasks", tasksStats);
+  print("publication", publicationStats);
+  print("merger", mergerStats);
+  print("checkrunner", checkRunnerStats);
+  print("aggregator", aggregatorStats);
+  print("cycle latency", cycleStats);
+  return 0;
+}
@@ -0,0 +1,92 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   benchmarkUpdatePolicyManager.cxx
+///
+/// Measures the time spent by UpdatePolicyManager in a CheckRunner cycle: updating the revisions of the received
+/// objects, asking each check whether it is ready and updating the revisions of the triggered checks.
+///
+
+#include "QualityControl/UpdatePolicyManager.h"
+
+#include <boost/program_options.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control::checker;
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()("help,h", "Help screen")("objects,o", bpo::value<size_t>()->default_value(10000), "Number of objects")("checks,c", bpo::value<size_t>()->default_value(500), "Number of checks")("inputs,i", bpo::value<size_t>()->default_value(20), "Number of inputs of each check")("updated,u", bpo::value<size_t>()->default_value(1000), "Number of objects updated in each cycle")("cycles,n", bpo::value<size_t>()->default_value(1000), "Number of cycles");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+  const auto nObjects = vm["objects"].as<size_t>();
+  const auto nChecks = vm["checks"].as<size_t>();
+  const auto nInputs = vm["inputs"].as<size_t>();
+  const auto nUpdated = vm["updated"].as<size_t>();
+  const auto nCycles = vm["cycles"].as<size_t>();
+
+  std::vector<std::string> objectNames;
+  for (size_t i = 0; i < nObjects; i++) {
+    objectNames.push_back("TST/MO/task/histo" + std::to_string(i));
+  }
+
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<size_t> objectDistribution(0, nObjects - 1);
+  const UpdatePolicyType policyTypes[] = { UpdatePolicyType::OnAny, UpdatePolicyType::OnAll, UpdatePolicyType::OnAnyNonZero, UpdatePolicyType::OnEachSeparately };
+
+  UpdatePolicyManager updatePolicyManager;
+  std::vector<std::string> checkNames;
+  for (size_t i = 0; i < nChecks; i++) {
+    std::vector<std::string> inputs;
+    for (size_t j = 0; j < nInputs; j++) {
+      inputs.push_back(objectNames[objectDistribution(generator)]);
+    }
+    checkNames.push_back("check" + std::to_string(i));
+    updatePolicyManager.addPolicy(checkNames.back(), policyTypes[i % 4], std::move(inputs), false, false);
+  }
+
+  size_t triggered = 0;
+  std::chrono::duration<double, std::micro> updateObjectsTime{ 0 }, isReadyTime{ 0 };
+  for (size_t cycle = 0; cycle < nCycles; cycle++) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nUpdated; i++) {
+      updatePolicyManager.updateObjectRevision(objectNames[objectDistribution(generator)]);
+    }
+    auto objectsUpdated = std::chrono::steady_clock::now();
+    for (const auto& checkName : checkNames) {
+      if (updatePolicyManager.isReady(checkName)) {
+        triggered++;
+        updatePolicyManager.updateActorRevision(checkName);
+      }
+    }
+    updatePolicyManager.updateGlobalRevision();
+    auto end = std::chrono::steady_clock::now();
+    updateObjectsTime += objectsUpdated - start;
+    isReadyTime += end - objectsUpdated;
+  }
+
+  std::cout << nObjects << " objects, " << nChecks << " checks with " << nInputs << " inputs, "
+            << nUpdated << " objects updated per cycle, " << triggered << " checks triggered in " << nCycles << " cycles" << std::endl;
+  std::cout << "  updateObjectRevision per cycle : " << updateObjectsTime.count() / nCycles << " us" << std::endl;
+  std::cout << "  isReady + updateActorRevision per cycle : " << isReadyTime.count() / nCycles << " us" << std::endl;
+  return 0;
+}
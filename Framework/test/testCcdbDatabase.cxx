@@ -223,6 +223,32 @@ BOOST_AUTO_TEST_CASE(ccdb_retrieve_qo, *utf::depends_on("ccdb_store"))
   BOOST_CHECK_EQUAL(qo->getActivity().mProvenance, "qc");
 }
 
+BOOST_AUTO_TEST_CASE(ccdb_retrieve_many, *utf::depends_on("ccdb_store"))
+{
+  test_fixture f;
+  using Request = DatabaseInterface::RetrievalRequest;
+  std::vector<Request> requests{
+    { Request::Type::MonitorObject, f.getMoFolder("quarantine"), "quarantine" },
+    { Request::Type::QualityObject, f.getQoPath("test-ccdb-check", "", false), "" },
+    { Request::Type::MonitorObject, "non/existing", "object" },
+    { Request::Type::MonitorObject, f.getMoFolder("short"), "short", 15000 },
+    { Request::Type::QualityObject, f.getQoFolder("short"), "short", 15000 }
+  };
+  auto results = f.backend->retrieveMany(requests);
+  BOOST_REQUIRE_EQUAL(results.size(), requests.size());
+
+  BOOST_REQUIRE_NE(results[0].monitorObject, nullptr);
+  BOOST_CHECK_EQUAL(results[0].monitorObject->getName(), "quarantine");
+  BOOST_CHECK_EQUAL(results[0].qualityObject, nullptr);
+  BOOST_REQUIRE_NE(results[1].qualityObject, nullptr);
+  BOOST_CHECK_EQUAL(results[1].qualityObject->getQuality().getLevel(), 3);
+  BOOST_CHECK_EQUAL(results[2].monitorObject, nullptr);
+  BOOST_REQUIRE_NE(results[3].monitorObject, nullptr);
+  BOOST_CHECK_EQUAL(results[3].monitorObject->getName(), "short");
+  BOOST_REQUIRE_NE(results[4].qualityObject, nullptr);
+  BOOST_CHECK_EQUAL(results[4].qualityObject->getName(), f.taskName + "/short");
+}
+
 BOOST_AUTO_TEST_CASE(ccdb_provenance, *utf::depends_on("ccdb_store"))
 {
   test_fixture f;
@@ -0,0 +1,189 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testCcdbStandIn.cxx
+///
+
+#include "QualityControl/CcdbStandIn.h"
+#include "QualityControl/CcdbDatabase.h"
+#include "QualityControl/ListingWatcher.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/RepositoryLoadTest.h"
+
+#include <TH1F.h>
+#include <boost/asio.hpp>
+#include <catch_amalgamated.hpp>
+#include <chrono>
+#include <thread>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+
+TEST_CASE("ccdb_stand_in_requests")
+{
+  CcdbStandIn standIn;
+  CcdbStandIn::Request store{ "POST", "/qc/TST/MO/task/obj/1000/2000/RunNumber=5", { { "content-type", "application/octet-stream" } }, "payload" };
+  REQUIRE(standIn.handle(store).status == 201);
+  store.target = "/qc/TST/MO/task/obj/1500/3000/RunNumber=6";
+  store.body = "payload2";
+  REQUIRE(standIn.handle(store).status == 201);
+  CHECK(standIn.getNumberOfObjects() == 2);
+
+  auto response = standIn.handle({ "GET", "/qc/TST/MO/task/obj/1700", {}, "" });
+  CHECK(response.status == 200);
+  CHECK(response.body == "payload2");
+  response = standIn.handle({ "GET", "/qc/TST/MO/task/obj/1700/RunNumber=5", {}, "" });
+  CHECK(response.status == 200);
+  CHECK(response.body == "payload");
+  CHECK(standIn.handle({ "GET", "/qc/TST/MO/task/obj/2500/RunNumber=5", {}, "" }).status == 404);
+
+  std::string etag;
+  for (const auto& [name, value] : response.headers) {
+    if (name == "ETag") {
+      etag = value;
+    }
+  }
+  REQUIRE(!etag.empty());
+  CHECK(standIn.handle({ "GET", "/qc/TST/MO/task/obj/1700/RunNumber=5", { { "if-none-match", etag } }, "" }).status == 304);
+
+  auto latest = parseListing(standIn.handle({ "GET", "/latest/qc/TST/MO/.*", { { "accept", "application/json" } }, "" }).body);
+  REQUIRE(latest.has_value());
+  REQUIRE(latest->size() == 1);
+  CHECK(latest->at(0).at("RunNumber") == "6");
+  auto all = parseListing(standIn.handle({ "GET", "/browse/qc/TST/MO/task/obj", { { "accept", "application/json" } }, "" }).body);
+  REQUIRE(all.has_value());
+  CHECK(all->size() == 2);
+  CHECK(standIn.handle({ "GET", "/latest/qc/TST/MO/.*", { { "if-not-before", "soon" } }, "" }).status == 400);
+  // an invalid escape is kept as it is
+  CHECK(standIn.handle({ "GET", "/qc/TST/MO/task/obj%zz/1700", {}, "" }).status == 404);
+
+  CHECK(standIn.handle({ "DELETE", "/truncate/qc/TST/MO/task/obj", {}, "" }).status == 200);
+  CHECK(standIn.getNumberOfObjects() == 0);
+}
+
+TEST_CASE("ccdb_stand_in_malformed_requests")
+{
+  CcdbStandIn standIn;
+  for (const std::string& request : { "POST /qc/TST/MO/task/obj/1000/2000 HTTP/1.1\r\nContent-Length: abc\r\n\r\n",
+                                      "POST /qc/TST/MO/task/obj/1000/2000 HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nxyz\r\n" }) {
+    boost::asio::io_context context;
+    boost::asio::ip::tcp::socket socket(context);
+    socket.connect({ boost::asio::ip::make_address("127.0.0.1"), standIn.getPort() });
+    boost::asio::write(socket, boost::asio::buffer(request));
+    // the request is rejected and the connection is closed
+    boost::system::error_code ec;
+    std::string response;
+    boost::asio::read(socket, boost::asio::dynamic_buffer(response), ec);
+    CHECK(ec == boost::asio::error::eof);
+    CHECK(response.starts_with("HTTP/1.1 400"));
+  }
+  CHECK(standIn.getNumberOfObjects() == 0);
+
+  // the stand-in still serves the next requests
+  CcdbDatabase database;
+  database.connect({ { "host", standIn.getUrl() } });
+  CHECK(database.getLatestObjectValidity("qc/TST/MO/task/obj", {}).isInvalid());
+}
+
+TEST_CASE("ccdb_stand_in_with_ccdb_database")
+{
+  CcdbStandIn standIn;
+  CcdbDatabase database;
+  database.connect(standIn.getUrl(), "", "", "");
+
+  auto* histogram = new TH1F("histogram", "histogram", 100, 0, 100);
+  histogram->Fill(5);
+  auto mo = std::make_shared<MonitorObject>(histogram, "task", "TestClass", "TST");
+  mo->setIsOwner(true);
+  database.storeMO(mo);
+  CHECK(standIn.getNumberOfObjects() == 1);
+
+  auto retrieved = database.retrieveMO("TST/MO/task", "histogram", DatabaseInterface::Timestamp::Latest);
+  REQUIRE(retrieved != nullptr);
+  auto* retrievedHistogram = dynamic_cast<TH1F*>(retrieved->getObject());
+  REQUIRE(retrievedHistogram != nullptr);
+  CHECK(retrievedHistogram->GetEntries() == 1);
+
+  CHECK(database.getLatestObjectValidity("qc/TST/MO/task/histogram", {}).isValid());
+}
+
+TEST_CASE("ccdb_stand_in_with_database_cache")
+{
+  CcdbStandIn standIn;
+  CcdbDatabase database;
+  database.connect({ { "host", standIn.getUrl() }, { "cache", "true" }, { "cacheListingTtlMs", "10" } });
+
+  auto* histogram = new TH1F("histogram", "histogram", 100, 0, 100);
+  auto mo = std::make_shared<MonitorObject>(histogram, "task", "TestClass", "TST");
+  mo->setIsOwner(true);
+  mo->setValidity({ 1000, 5000 });
+  database.storeMO(mo);
+
+  // the trigger timestamps differ, but they are within the validity of the same object
+  std::unique_ptr<TObject> object(database.retrieveTObject("qc/TST/MO/task/histogram", {}, 2000));
+  CHECK(object != nullptr);
+  object.reset(database.retrieveTObject("qc/TST/MO/task/histogram", {}, 3000));
+  CHECK(object != nullptr);
+  object.reset(database.retrieveTObject("qc/TST/MO/task/histogram", {}, DatabaseInterface::Timestamp::Latest));
+  CHECK(object != nullptr);
+  object.reset(database.retrieveTObject("qc/TST/MO/task/histogram", {}, 6000));
+  CHECK(object == nullptr);
+
+  REQUIRE(database.getCache() != nullptr);
+  auto stats = database.getCache()->getStats();
+  CHECK(stats.misses == 2);
+  CHECK(stats.revalidated == 1);
+  CHECK(stats.hits == 1);
+  CHECK(stats.entries == 1);
+
+  // an object stored again with the same validity is the new latest one, it is not served from the cache
+  histogram->Fill(5);
+  database.storeMO(mo);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  object.reset(database.retrieveTObject("qc/TST/MO/task/histogram", {}, DatabaseInterface::Timestamp::Latest));
+  REQUIRE(object != nullptr);
+  CHECK(dynamic_cast<TH1F*>(object.get())->GetEntries() == 1);
+  CHECK(database.getCache()->getStats().misses == 3);
+  CHECK(database.getCache()->getStats().entries == 1);
+}
+
+TEST_CASE("repository_load_test")
+{
+  CHECK(RepositoryLoadTestConfig::parseMix("store=1, retrieve=2") == std::array<double, nLoadTestOperations>{ 1, 2, 0, 0 });
+  CHECK_THROWS(RepositoryLoadTestConfig::parseMix("unknown=1"));
+  CHECK_THROWS(RepositoryLoadTestConfig::parseMix("store=0"));
+
+  std::vector<double> latencies(1000);
+  for (size_t i = 0; i < latencies.size(); i++) {
+    latencies[i] = static_cast<double>(latencies.size() - i);
+  }
+  auto summary = LatencySummary::fromLatencies(latencies, 3, 2.0);
+  CHECK(summary.count == 1000);
+  CHECK(summary.errors == 3);
+  CHECK(summary.throughput == Catch::Approx(500));
+  CHECK(summary.p50Ms == Catch::Approx(500));
+  CHECK(summary.p99Ms == Catch::Approx(990));
+  CHECK(summary.p999Ms == Catch::Approx(999));
+  CHECK(summary.maxMs == Catch::Approx(1000));
+
+  RepositoryLoadTestConfig config;
+  config.threads = 2;
+  config.maxRequestsPerThread = 20;
+  config.objectSizesKB = { 1, 10 };
+  config.numberOfObjects = 4;
+  RepositoryLoadTest loadTest(config);
+  auto results = loadTest.run();
+  CHECK(results.objects == 4);
+  CHECK(results.total.count + results.total.errors == 40);
+  CHECK(results.total.errors == 0);
+  CHECK(results.toJson().find("\"p999Ms\"") != std::string::npos);
+}
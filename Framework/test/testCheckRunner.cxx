@@ -17,12 +17,19 @@
 #include "QualityControl/CheckRunnerFactory.h"
 #include "QualityControl/CheckRunner.h"
 #include "QualityControl/CommonSpec.h"
+#include "QualityControl/InfrastructureSpecReader.h"
+#include "QualityControl/ThreadPool.h"
+#include "getTestDataDirectory.h"
+#include <Configuration/ConfigurationFactory.h>
+#include <Configuration/ConfigurationInterface.h>
+#include <TH1F.h>
 #include <catch_amalgamated.hpp>
 
 using namespace o2::quality_control::checker;
 using namespace std;
 using namespace o2::framework;
 using namespace o2::header;
+using namespace o2::configuration;
 
 TEST_CASE("test_check_runner_static")
 {
@@ -47,3 +54,71 @@ TEST_CASE("test_checkRunner_getDetector")
   checks.push_back(config);
   CHECK(CheckRunner::getDetectorName(checks) == "MANY");
 }
+
+namespace
+{
+
+std::shared_ptr<MonitorObject> dummyMO(const std::string& objName, const std::string& taskName)
+{
+  auto obj = std::make_shared<MonitorObject>(new TH1F(objName.c_str(), objName.c_str(), 100, 0, 10), taskName, "test", "TST");
+  obj->setIsOwner(true);
+  return obj;
+}
+
+std::vector<std::string> describe(const std::vector<QualityObjectsType>& qosPerCheck)
+{
+  std::vector<std::string> descriptions;
+  for (const auto& qos : qosPerCheck) {
+    for (const auto& qo : qos) {
+      std::string description = qo->getCheckName();
+      for (const auto& moName : qo->getMonitorObjectsNames()) {
+        description += " " + moName;
+      }
+      descriptions.push_back(description);
+    }
+  }
+  return descriptions;
+}
+
+} // namespace
+
+TEST_CASE("test_check_runner_parallel_checks")
+{
+  auto config = ConfigurationFactory::getConfiguration(std::string("json://") + getTestDataDirectory() + "testSharedConfig.json");
+  auto infrastructureSpec = InfrastructureSpecReader::readInfrastructureSpec(config->getRecursive(), WorkflowType::Standalone);
+
+  // the checks share the MOs, some of them produce one QO per MO
+  std::vector<std::string> checkNames{ "singleCheck", "checkAll", "checkOnEachSeparately", "checkAny", "dataSizeCheck", "checkAnyNonZero", "someNumbersCheck" };
+  std::vector<std::unique_ptr<Check>> checkStorage;
+  std::vector<Check*> checks;
+  for (const auto& checkName : checkNames) {
+    auto checkSpec = std::find_if(infrastructureSpec.checks.begin(), infrastructureSpec.checks.end(), [&checkName](const auto& checkSpec) {
+      return checkSpec.checkName == checkName;
+    });
+    REQUIRE(checkSpec != infrastructureSpec.checks.end());
+    auto& check = checkStorage.emplace_back(std::make_unique<Check>(Check::extractConfig(infrastructureSpec.common, *checkSpec)));
+    check->init();
+    check->startOfActivity(Activity());
+    checks.push_back(check.get());
+  }
+
+  std::map<std::string, std::shared_ptr<MonitorObject>> moMap{
+    { "skeletonTask/example", dummyMO("example", "skeletonTask") },
+    { "abcTask/test1", dummyMO("test1", "abcTask") },
+    { "abcTask/test2", dummyMO("test2", "abcTask") }
+  };
+
+  auto expected = describe(CheckRunner::runChecks(checks, moMap, nullptr));
+  REQUIRE(expected.size() == checks.size() + 1);
+
+  ThreadPool pool(4);
+  for (int iteration = 0; iteration < 20; iteration++) {
+    CHECK(describe(CheckRunner::runChecks(checks, moMap, &pool)) == expected);
+  }
+
+  // a check without a loaded CheckInterface throws, the other checks are still awaited
+  Check notInitialized(checkStorage[1]->getConfig());
+  std::vector<Check*> checksWithFailure{ checks[0], &notInitialized, checks[2] };
+  CHECK_THROWS(CheckRunner::runChecks(checksWithFailure, moMap, &pool));
+  CHECK(describe(CheckRunner::runChecks(checks, moMap, &pool)) == expected);
+}
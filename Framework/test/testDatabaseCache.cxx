@@ -0,0 +1,161 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testDatabaseCache.cxx
+///
+
+#include "QualityControl/DatabaseCache.h"
+
+#include <TH1F.h>
+#include <TObjString.h>
+#include <catch_amalgamated.hpp>
+#include <thread>
+
+using namespace o2::quality_control::repository;
+
+TEST_CASE("database_cache_config")
+{
+  auto config = DatabaseCacheConfig::fromDatabaseConfig({ { "host", "ccdb-test.cern.ch:8080" } });
+  CHECK_FALSE(config.enabled);
+
+  config = DatabaseCacheConfig::fromDatabaseConfig({ { "cache", "true" }, { "cacheSizeMB", "10" }, { "cacheListingTtlMs", "50" } });
+  CHECK(config.enabled);
+  CHECK(config.maxBytes == 10 * 1024 * 1024);
+  CHECK(config.listingTtl == std::chrono::milliseconds(50));
+}
+
+TEST_CASE("database_cache_key")
+{
+  CHECK(DatabaseCache::makeKey("qc/TST/MO/task/obj", {}) != DatabaseCache::makeKey("qc/TST/MO/task/obj", {}, "listing"));
+  CHECK(DatabaseCache::makeKey("qc/TST/MO/task/obj", {}, "1") != DatabaseCache::makeKey("qc/TST/MO/task/obj", {}, "2"));
+  CHECK(DatabaseCache::makeKey("qc/TST/MO/task/obj", { { "RunNumber", "1" } }, "1") != DatabaseCache::makeKey("qc/TST/MO/task/obj", { { "RunNumber", "2" } }, "1"));
+  CHECK(DatabaseCache::makeKey("qc/TST/MO/task/obj", { { "RunNumber", "1" } }, "1") == DatabaseCache::makeKey("qc/TST/MO/task/obj", { { "RunNumber", "1" } }, "1"));
+}
+
+TEST_CASE("database_cache_hits_and_copies")
+{
+  TH1::AddDirectory(false);
+  DatabaseCache cache({ true, 1024 * 1024, std::chrono::milliseconds(1000) });
+
+  CHECK(cache.find("histo", { { 1000, 2000 }, "abc" }) == nullptr);
+  cache.markMissed();
+  auto* histo = new TH1F("histo", "histo", 100, 0, 100);
+  histo->Fill(5);
+  cache.insert("histo", { { 1000, 2000 }, "abc" }, histo, { { "ETag", "\"abc\"" } });
+
+  auto entry = cache.find("histo", { { 1000, 2000 }, "abc" });
+  REQUIRE(entry != nullptr);
+  CHECK(entry->headers.at("ETag") == "\"abc\"");
+  CHECK(entry->object.get() == histo);
+  cache.markHit();
+
+  std::unique_ptr<TObject> copy(DatabaseCache::copy(*entry->object));
+  REQUIRE(copy != nullptr);
+  CHECK(copy.get() != histo);
+  CHECK(dynamic_cast<TH1F*>(copy.get())->GetEntries() == 1);
+
+  // looking up an entry is not counted by itself
+  cache.find("histo", { { 1000, 2000 }, "abc" });
+  cache.markRevalidated();
+
+  auto stats = cache.getStats();
+  CHECK(stats.hits == 1);
+  CHECK(stats.revalidated == 1);
+  CHECK(stats.misses == 1);
+  CHECK(stats.entries == 1);
+  CHECK(stats.bytes > 100 * sizeof(double));
+  CHECK(stats.hitRate == Catch::Approx(2.0 / 3.0));
+}
+
+TEST_CASE("database_cache_versions")
+{
+  DatabaseCache cache({ true, 1024 * 1024, std::chrono::milliseconds(1000) });
+  cache.insert("obj", { { 1000, 2000 }, "" }, new TObjString("v1"), {});
+  cache.insert("obj", { { 1500, 3000 }, "" }, new TObjString("v2"), {});
+  cache.insert("other", { { 0, 10000 }, "" }, new TObjString("other"), {});
+
+  // an exact validity is needed to find a version with find()
+  CHECK(cache.find("obj", { { 1000, 2500 }, "" }) == nullptr);
+  CHECK(std::string(cache.find("obj", { { 1500, 3000 }, "" })->object->GetName()) == "v2");
+
+  // any timestamp within the validity finds the version which starts last
+  CHECK(cache.findValidAt("obj", 999) == nullptr);
+  CHECK(std::string(cache.findValidAt("obj", 1000)->object->GetName()) == "v1");
+  CHECK(std::string(cache.findValidAt("obj", 1499)->object->GetName()) == "v1");
+  CHECK(std::string(cache.findValidAt("obj", 1500)->object->GetName()) == "v2");
+  CHECK(std::string(cache.findValidAt("obj", 2999)->object->GetName()) == "v2");
+  CHECK(cache.findValidAt("obj", 3000) == nullptr);
+  CHECK(cache.findValidAt("missing", 1500) == nullptr);
+
+  // an object stored again with the same validity is another version
+  cache.insert("obj", { { 1000, 2000 }, "id1" }, new TObjString("v1"), {});
+  CHECK(cache.find("obj", { { 1000, 2000 }, "id2" }) == nullptr);
+  CHECK(std::string(cache.find("obj", { { 1000, 2000 }, "id1" })->object->GetName()) == "v1");
+  cache.insert("obj", { { 1000, 2000 }, "id2" }, new TObjString("v1 again"), {});
+  CHECK(cache.find("obj", { { 1000, 2000 }, "id1" }) == nullptr);
+  CHECK(std::string(cache.find("obj", { { 1000, 2000 }, "id2" })->object->GetName()) == "v1 again");
+
+  // a version with the same start of validity replaces the previous one
+  cache.insert("obj", { { 1500, 4000 }, "" }, new TObjString("v3"), {});
+  CHECK(std::string(cache.findValidAt("obj", 3500)->object->GetName()) == "v3");
+  CHECK(cache.getStats().entries == 3);
+  CHECK(cache.getStats().hits == 0);
+}
+
+TEST_CASE("database_cache_lru_eviction")
+{
+  // each object is estimated to 1000 bytes, so only two of them fit
+  DatabaseCache cache({ true, 2500, std::chrono::milliseconds(1000) });
+  cache.insert("a", { { 1, 2 }, "" }, new TObjString("a"), { { "Content-Length", "1000" } });
+  cache.insert("b", { { 1, 2 }, "" }, new TObjString("b"), { { "Content-Length", "1000" } });
+  // "a" becomes the most recently used, thus "b" is evicted
+  REQUIRE(cache.find("a", { { 1, 2 }, "" }) != nullptr);
+  cache.insert("c", { { 1, 2 }, "" }, new TObjString("c"), { { "Content-Length", "1000" } });
+
+  CHECK(cache.find("a", { { 1, 2 }, "" }) != nullptr);
+  CHECK(cache.find("b", { { 1, 2 }, "" }) == nullptr);
+  CHECK(cache.findValidAt("b", 1) == nullptr);
+  CHECK(cache.find("c", { { 1, 2 }, "" }) != nullptr);
+  auto stats = cache.getStats();
+  CHECK(stats.evictions == 1);
+  CHECK(stats.entries == 2);
+  CHECK(stats.bytes == 2000);
+
+  // an entry is replaced if inserted again
+  cache.insert("c", { { 1, 2 }, "" }, new TObjString("c2"), { { "Content-Length", "1000" } });
+  CHECK(cache.getStats().bytes == 2000);
+  CHECK(std::string(cache.find("c", { { 1, 2 }, "" })->object->GetName()) == "c2");
+
+  // an object larger than the cache is still kept until the next one comes
+  cache.insert("d", { { 1, 2 }, "" }, new TObjString("d"), { { "Content-Length", "10000" } });
+  CHECK(cache.find("d", { { 1, 2 }, "" }) != nullptr);
+  CHECK(cache.getStats().entries == 1);
+}
+
+TEST_CASE("database_cache_listings")
+{
+  DatabaseCache cache({ true, 1024, std::chrono::milliseconds(100) });
+  CHECK_FALSE(cache.findListing("obj").has_value());
+  cache.insertListing("obj", { { 10, 20 }, "id" });
+  auto version = cache.findListing("obj");
+  REQUIRE(version.has_value());
+  CHECK(version->validity.getMin() == 10);
+  CHECK(version->validity.getMax() == 20);
+  CHECK(version->id == "id");
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  CHECK_FALSE(cache.findListing("obj").has_value());
+
+  auto stats = cache.getStats();
+  CHECK(stats.listingHits == 1);
+  CHECK(stats.listingMisses == 2);
+}
@@ -0,0 +1,188 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testDatabaseUploader.cxx
+///
+
+#include "QualityControl/DatabaseUploader.h"
+#include "QualityControl/DummyDatabase.h"
+#include "QualityControl/MonitorObject.h"
+#include "QualityControl/QualityObject.h"
+
+#include <TH1F.h>
+#include <catch_amalgamated.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace o2::quality_control::core;
+using namespace o2::quality_control::repository;
+
+namespace
+{
+
+/// Lets the test decide when the uploads end and records the order of the stored objects.
+struct UploadGate {
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool open = true;
+  size_t started = 0;
+  std::vector<std::string> stored;
+
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    open = false;
+  }
+  void release()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      open = true;
+    }
+    condition.notify_all();
+  }
+  void waitForStarted(size_t uploads)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [&] { return started >= uploads; });
+  }
+  void upload(const std::string& name)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    started++;
+    condition.notify_all();
+    condition.wait(lock, [&] { return open; });
+    stored.push_back(name);
+  }
+};
+
+struct BlockingDatabase : public DummyDatabase {
+  explicit BlockingDatabase(UploadGate& gate) : mGate(gate) {}
+
+  void storeMO(std::shared_ptr<const MonitorObject> mo) override
+  {
+    mGate.upload(mo->getName());
+  }
+  void storeQO(std::shared_ptr<const QualityObject> qo) override
+  {
+    mGate.upload(qo->getCheckName() + ":" + qo->getQuality().getName());
+  }
+
+  UploadGate& mGate;
+};
+
+std::shared_ptr<MonitorObject> makeMO(const std::string& name)
+{
+  auto mo = std::make_shared<MonitorObject>(new TH1F(name.c_str(), name.c_str(), 10, 0, 10), "task", "class", "TST");
+  mo->setIsOwner(true);
+  return mo;
+}
+
+} // namespace
+
+TEST_CASE("database_uploader_config")
+{
+  auto defaultConfig = DatabaseUploaderConfig::fromDatabaseConfig({ { "implementation", "Dummy" } });
+  CHECK(defaultConfig.enabled == false);
+
+  auto config = DatabaseUploaderConfig::fromDatabaseConfig({ { "asyncUpload", "true" },
+                                                             { "uploadThreads", "4" },
+                                                             { "uploadQueueSize", "0" } });
+  CHECK(config.enabled == true);
+  CHECK(config.threads == 4);
+  CHECK(config.queueSize == 1);
+}
+
+TEST_CASE("database_uploader_stores_everything")
+{
+  UploadGate gate;
+  DatabaseUploaderConfig config;
+  config.threads = 3;
+  DatabaseUploader uploader([&]() { return std::make_shared<BlockingDatabase>(gate); }, config);
+
+  for (int i = 0; i < 20; i++) {
+    uploader.enqueue(std::shared_ptr<const MonitorObject>(makeMO("histo" + std::to_string(i))));
+    uploader.enqueue(std::make_shared<const QualityObject>(Quality::Good, "check" + std::to_string(i)));
+  }
+  uploader.flush();
+
+  CHECK(gate.stored.size() == 40);
+  auto stats = uploader.collectStats();
+  CHECK(stats.enqueued == 40);
+  CHECK(stats.stored == 40);
+  CHECK(stats.queueDepth == 0);
+  CHECK(stats.dropped == 0);
+  CHECK(stats.coalesced == 0);
+}
+
+TEST_CASE("database_uploader_coalesces_and_drops")
+{
+  UploadGate gate;
+  DatabaseUploaderConfig config;
+  config.threads = 1;
+  config.queueSize = 3;
+  DatabaseUploader uploader([&]() { return std::make_shared<BlockingDatabase>(gate); }, config);
+
+  // the first one keeps the worker busy while we fill the queue
+  gate.close();
+  uploader.enqueue(std::make_shared<const QualityObject>(Quality::Good, "busy"));
+  gate.waitForStarted(1);
+
+  uploader.enqueue(std::make_shared<const QualityObject>(Quality::Bad, "same"));
+  uploader.enqueue(std::make_shared<const QualityObject>(Quality::Good, "other0"));
+  uploader.enqueue(std::make_shared<const QualityObject>(Quality::Good, "other1"));
+  // replaces the pending version and moves to the end of the queue
+  uploader.enqueue(std::make_shared<const QualityObject>(Quality::Medium, "same"));
+  CHECK(uploader.collectStats().queueDepth == 3);
+  // the queue is full, thus "other0" which has been waiting the longest is dropped
+  uploader.enqueue(std::make_shared<const QualityObject>(Quality::Good, "other2"));
+
+  gate.release();
+  uploader.flush();
+
+  CHECK(gate.stored == std::vector<std::string>{ "busy:Good", "other1:Good", "same:Medium", "other2:Good" });
+  auto stats = uploader.collectStats();
+  CHECK(stats.enqueued == 6);
+  CHECK(stats.coalesced == 1);
+  CHECK(stats.dropped == 1);
+  CHECK(stats.stored == 4);
+  CHECK(stats.maxLatencyMs > 0);
+}
+
+TEST_CASE("database_uploader_keeps_the_order_of_versions")
+{
+  UploadGate gate;
+  DatabaseUploaderConfig config;
+  config.threads = 2;
+  DatabaseUploader uploader([&]() { return std::make_shared<BlockingDatabase>(gate); }, config);
+
+  gate.close();
+  uploader.enqueue(std::make_shared<const QualityObject>(Quality::Bad, "same"));
+  gate.waitForStarted(1);
+  // the second worker has to skip the newer version of "same" while the older one is being uploaded
+  uploader.enqueue(std::make_shared<const QualityObject>(Quality::Good, "same"));
+  uploader.enqueue(std::make_shared<const QualityObject>(Quality::Good, "other"));
+  gate.waitForStarted(2);
+  CHECK(uploader.collectStats().queueDepth == 1);
+
+  gate.release();
+  uploader.flush();
+
+  REQUIRE(gate.stored.size() == 3);
+  auto first = std::find(gate.stored.begin(), gate.stored.end(), "same:Bad");
+  auto second = std::find(gate.stored.begin(), gate.stored.end(), "same:Good");
+  CHECK(first < second);
+  CHECK(second != gate.stored.end());
+}
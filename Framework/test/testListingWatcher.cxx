@@ -0,0 +1,222 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testListingWatcher.cxx
+///
+
+#include "QualityControl/ListingWatcher.h"
+#include "QualityControl/CcdbStandIn.h"
+
+#include <catch_amalgamated.hpp>
+#include <mutex>
+
+using namespace o2::quality_control::repository;
+using namespace std::chrono_literals;
+
+namespace
+{
+
+void storeObject(CcdbStandIn& standIn, const std::string& path, const std::string& runNumber)
+{
+  CcdbStandIn::Request store{ "POST", "/" + path + "/1000/2000/RunNumber=" + runNumber, { { "content-type", "application/octet-stream" } }, "payload" };
+  REQUIRE(standIn.handle(store).status == 201);
+}
+
+/// Keeps the listing requests received by a CcdbStandIn
+struct ListingRequests {
+  std::mutex mutex;
+  std::vector<CcdbStandIn::Request> requests;
+
+  explicit ListingRequests(CcdbStandIn& standIn)
+  {
+    standIn.setRequestObserver([this](const CcdbStandIn::Request& request) {
+      if (request.target.starts_with("/latest/") || request.target.starts_with("/browse/")) {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.push_back(request);
+      }
+    });
+  }
+
+  std::vector<CcdbStandIn::Request> take()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::exchange(requests, {});
+  }
+};
+
+} // namespace
+
+TEST_CASE("parse_listing")
+{
+  const std::string json = R"({
+    "objects": [
+      {
+        "path": "qc/TST/MO/task/obj",
+        "createTime": 1700000000100,
+        "lastModified": 1700000000200,
+        "Valid-From": 1700000000000,
+        "Valid-Until": 1700000100000,
+        "RunNumber": "523000",
+        "PassName": "apass1",
+        "partName": "/",
+        "replicas": [ "alien:///alice/data/obj" ],
+        "preservation": false
+      },
+      {
+        "path": "qc/TST/MO/task/obj2",
+        "lastModified": 1700000000300,
+        "metadata": { "nested": "ignored" },
+        "RunNumber": "523001"
+      }
+    ],
+    "subfolders": [ "qc/TST/MO/task/folder" ]
+  })";
+
+  auto entries = parseListing(json);
+  REQUIRE(entries.has_value());
+  REQUIRE(entries->size() == 2);
+
+  const auto& first = entries->at(0);
+  CHECK(first.at("path") == "qc/TST/MO/task/obj");
+  CHECK(first.at("lastModified") == "1700000000200");
+  CHECK(first.at("Valid-From") == "1700000000000");
+  CHECK(first.at("Valid-Until") == "1700000100000");
+  CHECK(first.at("RunNumber") == "523000");
+  CHECK(first.at("PassName") == "apass1");
+  CHECK(first.at("preservation") == "false");
+  CHECK(first.count("replicas") == 0);
+
+  const auto& second = entries->at(1);
+  CHECK(second.at("path") == "qc/TST/MO/task/obj2");
+  CHECK(second.at("RunNumber") == "523001");
+  CHECK(second.count("nested") == 0);
+  CHECK(second.count("metadata") == 0);
+}
+
+TEST_CASE("parse_listing_empty_and_invalid")
+{
+  auto entries = parseListing(R"({"objects":[],"subfolders":[]})");
+  REQUIRE(entries.has_value());
+  CHECK(entries->empty());
+
+  CHECK_FALSE(parseListing("").has_value());
+  CHECK_FALSE(parseListing(R"({"objects":[{"path":"a")").has_value());
+  CHECK_FALSE(parseListing(R"({"subfolders":[]})").has_value());
+  // "objects" has to be at the top level
+  CHECK_FALSE(parseListing(R"({"nested":{"objects":[{"path":"a"}]}})").has_value());
+}
+
+TEST_CASE("listing_watcher_groups_paths")
+{
+  CcdbStandIn standIn;
+  storeObject(standIn, "qc/TST/MO/task/obj1", "5");
+  storeObject(standIn, "qc/TST/MO/task/obj2", "5");
+  storeObject(standIn, "qc/TST/MO/task/sub/obj1", "5");
+  storeObject(standIn, "qc/TST/MO/other/obj1", "5");
+  ListingRequests listingRequests(standIn);
+  ListingWatcher::getInstance().setPollPeriod(1h);
+
+  auto watch1 = ListingWatcher::getInstance().watch(standIn.getUrl(), "qc/TST/MO/task/obj1");
+  auto watch2 = ListingWatcher::getInstance().watch(standIn.getUrl(), "qc/TST/MO/task/obj2");
+  auto latest1 = watch1->getLatest();
+  auto latest2 = watch2->getLatest();
+  REQUIRE(latest1.has_value());
+  REQUIRE(latest2.has_value());
+  CHECK(latest1->at("path") == "qc/TST/MO/task/obj1");
+  CHECK(latest2->at("path") == "qc/TST/MO/task/obj2");
+
+  // both objects are listed with one request, which does not include the objects in the subfolders
+  auto requests = listingRequests.take();
+  REQUIRE(requests.size() == 1);
+  CHECK(requests[0].target.starts_with("/latest/qc/TST/MO/task/"));
+  auto entries = parseListing(standIn.handle({ "GET", requests[0].target, { { "accept", "application/json" } }, "" }).body);
+  REQUIRE(entries.has_value());
+  CHECK(entries->size() == 2);
+
+  // the next calls within the poll period do not send any request
+  CHECK(watch1->getLatest().has_value());
+  CHECK(watch2->getLatest().has_value());
+  CHECK(listingRequests.take().empty());
+
+  // an object in another folder gets its own group
+  auto watch3 = ListingWatcher::getInstance().watch(standIn.getUrl(), "qc/TST/MO/other/obj1");
+  CHECK(watch3->getLatest().has_value());
+  CHECK(listingRequests.take().size() == 1);
+}
+
+TEST_CASE("listing_watcher_incremental_polls")
+{
+  CcdbStandIn standIn;
+  storeObject(standIn, "qc/TST/MO/task/obj1", "5");
+  storeObject(standIn, "qc/TST/MO/task/obj2", "5");
+  ListingRequests listingRequests(standIn);
+  ListingWatcher::getInstance().setPollPeriod(1h);
+
+  auto watch1 = ListingWatcher::getInstance().watch(standIn.getUrl(), "qc/TST/MO/task/obj1");
+  auto watch2 = ListingWatcher::getInstance().watch(standIn.getUrl(), "qc/TST/MO/task/obj2");
+  REQUIRE(watch1->getLatest().has_value());
+  auto requests = listingRequests.take();
+  REQUIRE(requests.size() == 1);
+  // the first listing is complete
+  CHECK(requests[0].headers.count("if-not-before") == 0);
+
+  // the new period applies to the group which exists already
+  ListingWatcher::getInstance().setPollPeriod(0ms);
+  storeObject(standIn, "qc/TST/MO/task/obj1", "6");
+  auto latest1 = watch1->getLatest();
+  REQUIRE(latest1.has_value());
+  CHECK(latest1->at("RunNumber") == "6");
+  requests = listingRequests.take();
+  REQUIRE(requests.size() == 1);
+  // the next ones ask only for the objects created since the previous one
+  REQUIRE(requests[0].headers.count("if-not-before") == 1);
+  auto createdNotBefore = std::stoull(requests[0].headers.at("if-not-before"));
+  auto entries = parseListing(standIn.handle({ "GET", requests[0].target, { { "accept", "application/json" }, { "if-not-before", std::to_string(createdNotBefore) } }, "" }).body);
+  REQUIRE(entries.has_value());
+  CHECK(entries->size() == 1);
+
+  // the objects which were not in the incremental listing are still known
+  auto latest2 = watch2->getLatest();
+  REQUIRE(latest2.has_value());
+  CHECK(latest2->at("RunNumber") == "5");
+  ListingWatcher::getInstance().setPollPeriod(1000ms);
+}
+
+TEST_CASE("listing_watcher_unsubscribe")
+{
+  CcdbStandIn standIn;
+  storeObject(standIn, "qc/TST/MO/task/obj1", "5");
+  storeObject(standIn, "qc/TST/MO/task/obj2", "5");
+  ListingRequests listingRequests(standIn);
+  ListingWatcher::getInstance().setPollPeriod(0ms);
+
+  auto watch1 = ListingWatcher::getInstance().watch(standIn.getUrl(), "qc/TST/MO/task/obj1");
+  auto watch2 = ListingWatcher::getInstance().watch(standIn.getUrl(), "qc/TST/MO/task/obj2");
+  REQUIRE(watch1->getLatest().has_value());
+  CHECK(listingRequests.take().at(0).target.find("obj2") != std::string::npos);
+
+  // once a watch is destroyed, its object is not listed anymore
+  watch2.reset();
+  REQUIRE(watch1->getLatest().has_value());
+  auto requests = listingRequests.take();
+  REQUIRE(requests.size() == 1);
+  CHECK(requests[0].target.find("obj2") == std::string::npos);
+
+  // once all the watches are destroyed, the group is gone and a new watch starts with a complete listing
+  watch1.reset();
+  auto watch3 = ListingWatcher::getInstance().watch(standIn.getUrl(), "qc/TST/MO/task/obj1");
+  REQUIRE(watch3->getLatest().has_value());
+  requests = listingRequests.take();
+  REQUIRE(requests.size() == 1);
+  CHECK(requests[0].headers.count("if-not-before") == 0);
+  ListingWatcher::getInstance().setPollPeriod(1000ms);
+}
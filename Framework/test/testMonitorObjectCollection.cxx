@@ -167,6 +167,44 @@ TEST_CASE("monitor_object_collection_merge_different_id")
   }
 }
 
+TEST_CASE("monitor_object_collection_merge_unchanged")
+{
+  MonitorObjectCollection target;
+  target.SetOwner(true);
+  TH1I* targetTH1I = new TH1I("histo 1d", "histo 1d", 10, 0, 10);
+  targetTH1I->Fill(5);
+  MonitorObject* targetMoTH1I = new MonitorObject(targetTH1I, "histo 1d", "class", "DET");
+  targetMoTH1I->setValidity({ 10, 20 });
+  targetMoTH1I->setIsOwner(true);
+  target.Add(targetMoTH1I);
+
+  MonitorObjectCollection other;
+  other.SetOwner(true);
+  other.addUnchangedObject("histo 1d", { 20, 30 });
+  other.addUnchangedObject("histo 2d", { 20, 30 });
+
+  CHECK_NOTHROW(algorithm::merge(&target, &other));
+  // the unchanged object only extends the validity of the existing one
+  REQUIRE(target.GetEntries() == 1);
+  CHECK(targetTH1I->GetEntries() == 1);
+  CHECK(targetMoTH1I->getValidity() == ValidityInterval{ 10, 30 });
+  // the unchanged object which is not in the target is passed further
+  REQUIRE(target.getUnchangedObjects().size() == 1);
+  CHECK(target.getUnchangedObjects()[0] == "histo 2d");
+  CHECK(target.getUnchangedObjectsValidity() == ValidityInterval{ 20, 30 });
+
+  // once we get the object, it is not listed as unchanged anymore
+  MonitorObjectCollection another;
+  another.SetOwner(true);
+  TH2I* anotherTH2I = new TH2I("histo 2d", "histo 2d", 10, 0, 10, 10, 0, 10);
+  MonitorObject* anotherMoTH2I = new MonitorObject(anotherTH2I, "histo 2d", "class", "DET");
+  anotherMoTH2I->setIsOwner(true);
+  another.Add(anotherMoTH2I);
+  CHECK_NOTHROW(algorithm::merge(&target, &another));
+  CHECK(target.GetEntries() == 2);
+  CHECK(target.getUnchangedObjects().empty());
+}
+
 TEST_CASE("monitor_object_collection_post_deserialization")
 {
   const size_t bins = 10;
@@ -0,0 +1,104 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testMonitorObjectSerializer.cxx
+///
+
+#include "QualityControl/MonitorObjectSerializer.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/MonitorObject.h"
+
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TMessage.h>
+#include <catch_amalgamated.hpp>
+#include <memory>
+#include <vector>
+
+using namespace o2::quality_control::core;
+
+namespace
+{
+// the same as what DPL does to read ROOT-serialized messages
+class InputMessage : public TMessage
+{
+ public:
+  InputMessage(void* buffer, Int_t length) : TMessage(buffer, length) { ResetBit(kIsOwner); }
+};
+
+std::unique_ptr<MonitorObjectCollection> deserialize(const TMessage& message)
+{
+  std::vector<char> buffer(message.Buffer(), message.Buffer() + message.Length());
+  InputMessage input(buffer.data(), buffer.size());
+  return std::unique_ptr<MonitorObjectCollection>(static_cast<MonitorObjectCollection*>(input.ReadObjectAny(MonitorObjectCollection::Class())));
+}
+} // namespace
+
+TEST_CASE("monitor_object_serializer")
+{
+  TH1::AddDirectory(false);
+  MonitorObjectCollection collection;
+  collection.SetOwner(true);
+  collection.SetName("task");
+  collection.setDetector("TST");
+  collection.setTaskName("task");
+  for (int i = 0; i < 10; i++) {
+    auto name = "histo" + std::to_string(i);
+    TH1* histo = i % 2 ? static_cast<TH1*>(new TH1F(name.c_str(), name.c_str(), 100, 0, 100)) : new TH2F(name.c_str(), name.c_str(), 100, 0, 100, 100, 0, 100);
+    histo->Fill(i, i);
+    auto* mo = new MonitorObject(histo, "task", "TaskClass", "TST");
+    mo->setIsOwner(true);
+    collection.Add(mo);
+  }
+  collection.addUnchangedObject("unchanged", { 1, 2 });
+
+  MonitorObjectSerializer serializer(4);
+  CHECK(serializer.getNThreads() == 4);
+  auto parts = serializer.serialize(collection);
+  REQUIRE(parts.size() == 10);
+
+  for (size_t i = 0; i < parts.size(); i++) {
+    CHECK(parts[i].objectName == "histo" + std::to_string(i));
+    CHECK(parts[i].durationMs >= 0);
+    auto received = deserialize(*parts[i].message);
+    REQUIRE(received != nullptr);
+    received->SetOwner(true);
+    CHECK(received->getDetector() == "TST");
+    CHECK(received->getTaskName() == "task");
+    REQUIRE(received->GetEntries() == 1);
+    auto* mo = dynamic_cast<MonitorObject*>(received->At(0));
+    REQUIRE(mo != nullptr);
+    mo->setIsOwner(true);
+    CHECK(mo->getName() == parts[i].objectName);
+    CHECK(dynamic_cast<TH1*>(mo->getObject())->GetEntries() == 1);
+    // only the first part carries the unchanged objects
+    CHECK(received->getUnchangedObjects().size() == (i == 0 ? 1 : 0));
+  }
+}
+
+TEST_CASE("monitor_object_serializer_empty")
+{
+  MonitorObjectCollection collection;
+  collection.setTaskName("task");
+  collection.addUnchangedObject("unchanged", { 1, 2 });
+
+  MonitorObjectSerializer serializer(2);
+  auto parts = serializer.serialize(collection);
+  REQUIRE(parts.size() == 1);
+  CHECK(parts[0].objectName.empty());
+  auto received = deserialize(*parts[0].message);
+  REQUIRE(received != nullptr);
+  CHECK(received->GetEntries() == 0);
+  CHECK(received->getTaskName() == "task");
+  REQUIRE(received->getUnchangedObjects().size() == 1);
+  CHECK(received->getUnchangedObjects()[0] == "unchanged");
+}
@@ -15,6 +15,7 @@
 ///
 
 #include "QualityControl/ObjectsManager.h"
+#include "QualityControl/MonitorObjectCollection.h"
 
 #define BOOST_TEST_MODULE ObjectManager test
 #define BOOST_TEST_MAIN
@@ -135,6 +136,45 @@ BOOST_AUTO_TEST_CASE(unpublish_test)
   delete s5;
 }
 
+BOOST_AUTO_TEST_CASE(unpublish_keeps_order_test)
+{
+  Config config;
+  config.consulUrl = "";
+  ObjectsManager objectsManager(config.taskName, config.taskClass, config.detectorName, config.consulUrl, 0, true);
+  std::vector<std::unique_ptr<TObjString>> objects;
+  for (int i = 0; i < 10; i++) {
+    objects.push_back(std::make_unique<TObjString>(("object" + std::to_string(i)).c_str()));
+    objectsManager.startPublishing<true>(objects.back().get(), PublicationPolicy::Forever);
+  }
+
+  // removing the objects by pointer and by name, so that some slots are left empty, then adding a new one
+  objectsManager.stopPublishing(objects[1].get());
+  objectsManager.stopPublishing("object4");
+  objectsManager.stopPublishing(objects[5].get());
+  TObjString added("added");
+  objectsManager.startPublishing<true>(&added, PublicationPolicy::Forever);
+  BOOST_CHECK(!objectsManager.isBeingPublished("object1"));
+  BOOST_CHECK(objectsManager.isBeingPublished("object2"));
+  BOOST_CHECK(objectsManager.isBeingPublished("added"));
+  BOOST_CHECK_EQUAL(objectsManager.getNumberPublishedObjects(), 8);
+
+  std::vector<std::string> expected{ "object0", "object2", "object3", "object6", "object7", "object8", "object9", "added" };
+  for (size_t i = 0; i < expected.size(); i++) {
+    BOOST_CHECK_EQUAL(objectsManager.getMonitorObject(i)->getName(), expected[i]);
+  }
+  std::unique_ptr<TObjArray> array(objectsManager.getNonOwningArray());
+  BOOST_REQUIRE_EQUAL(array->GetEntriesFast(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    BOOST_CHECK_EQUAL(array->At(i)->GetName(), expected[i]);
+  }
+
+  // objects can still be removed after compacting the collection
+  objectsManager.stopPublishing(objects[9].get());
+  BOOST_CHECK(!objectsManager.isBeingPublished("object9"));
+  BOOST_CHECK_EQUAL(objectsManager.getNumberPublishedObjects(), 7);
+  BOOST_CHECK_EQUAL(objectsManager.getMonitorObject(6)->getName(), "added");
+}
+
 BOOST_AUTO_TEST_CASE(getters_test)
 {
   Config config;
@@ -217,4 +257,75 @@ BOOST_AUTO_TEST_CASE(feed_with_nullptr)
   BOOST_CHECK_NO_THROW(objectsManager.stopPublishing(nullptr));
 }
 
+BOOST_AUTO_TEST_CASE(copy_array_test)
+{
+  Config config;
+  config.consulUrl = "";
+  ObjectsManager objectsManager(config.taskName, config.taskClass, config.detectorName, config.consulUrl, 0, true);
+  TH1F h("histo", "h", 10, 0, 10);
+  h.Fill(1);
+  objectsManager.startPublishing(&h, PublicationPolicy::Forever);
+  objectsManager.setValidity({ 10, 20 });
+
+  std::unique_ptr<MonitorObjectCollection> array(objectsManager.getNonOwningArray());
+  array->addUnchangedObject("unchanged", { 10, 20 });
+  std::unique_ptr<MonitorObjectCollection> copy(ObjectsManager::copyArray(*array, [](const TObject& object) { return object.Clone(); }));
+  BOOST_CHECK(copy->IsOwner());
+  BOOST_CHECK_EQUAL(copy->getTaskName(), array->getTaskName());
+  BOOST_CHECK_EQUAL(copy->getUnchangedObjects().size(), 1);
+  auto* mo = dynamic_cast<MonitorObject*>(copy->FindObject("histo"));
+  BOOST_REQUIRE(mo != nullptr);
+  BOOST_CHECK(mo->isIsOwner());
+  BOOST_CHECK(mo->getObject() != &h);
+  BOOST_CHECK(mo->getValidity() == ValidityInterval(10, 20));
+
+  // the copy is not affected by the next cycle
+  h.Fill(2);
+  BOOST_CHECK_EQUAL(dynamic_cast<TH1F*>(mo->getObject())->GetEntries(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(modified_objects_test)
+{
+  Config config;
+  config.consulUrl = "";
+  ObjectsManager objectsManager(config.taskName, config.taskClass, config.detectorName, config.consulUrl, 0, true);
+  TH1F h1("histo1", "h1", 10, 0, 10);
+  TH1F h2("histo2", "h2", 10, 0, 10);
+  TObjString s("content");
+  objectsManager.startPublishing(&h1, PublicationPolicy::Forever);
+  objectsManager.startPublishing(&h2, PublicationPolicy::Forever);
+  objectsManager.startPublishing<true>(&s, PublicationPolicy::Forever);
+
+  // everything is sent the first time
+  std::unique_ptr<MonitorObjectCollection> array(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 3);
+  BOOST_CHECK(array->getUnchangedObjects().empty());
+
+  // only the filled histogram and the object which is not a histogram are sent
+  h1.Fill(1);
+  array.reset(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK_EQUAL(array->GetEntries(), 2);
+  BOOST_CHECK(array->FindObject("histo1") != nullptr);
+  BOOST_CHECK(array->FindObject("content") != nullptr);
+  BOOST_REQUIRE_EQUAL(array->getUnchangedObjects().size(), 1);
+  BOOST_CHECK_EQUAL(array->getUnchangedObjects()[0], "histo2");
+
+  // explicitly marked as modified
+  objectsManager.setModified("histo2");
+  array.reset(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK(array->FindObject("histo1") == nullptr);
+  BOOST_CHECK(array->FindObject("histo2") != nullptr);
+
+  // a reset histogram is sent once, unless it was already empty
+  h1.Reset();
+  objectsManager.setAllReset();
+  array.reset(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK(array->FindObject("histo1") != nullptr);
+  BOOST_CHECK(array->FindObject("histo2") == nullptr);
+  objectsManager.setAllReset();
+  array.reset(objectsManager.getNonOwningArrayOfModified());
+  BOOST_CHECK(array->FindObject("histo1") == nullptr);
+  BOOST_CHECK_EQUAL(array->getUnchangedObjects().size(), 2);
+}
+
 } // namespace o2::quality_control::core
@@ -356,3 +356,46 @@ TEST_CASE("test_errors")
   CHECK(updatePolicyManager.isReady("actor2") == false);
   updatePolicyManager.updateGlobalRevision();
 }
+
+TEST_CASE("test_policy_inputs")
+{
+  UpdatePolicyManager updatePolicyManager;
+
+  // duplicated inputs are counted once, the final slash is ignored by OnAll and OnAnyNonZero
+  updatePolicyManager.addPolicy("actor1", UpdatePolicyType::OnAll, { "object1/", "object1", "object2" }, false, false);
+  updatePolicyManager.addPolicy("actor2", UpdatePolicyType::OnAnyNonZero, { "object1/", "object2" }, false, false);
+
+  updatePolicyManager.updateObjectRevision("object1");
+  CHECK(updatePolicyManager.isReady("actor1") == false);
+  CHECK(updatePolicyManager.isReady("actor2") == false);
+  updatePolicyManager.updateGlobalRevision();
+
+  updatePolicyManager.updateObjectRevision("object2");
+  CHECK(updatePolicyManager.isReady("actor1") == true);
+  CHECK(updatePolicyManager.isReady("actor2") == true);
+  updatePolicyManager.updateActorRevision("actor1");
+  updatePolicyManager.updateActorRevision("actor2");
+  CHECK(updatePolicyManager.isReady("actor1") == false);
+  CHECK(updatePolicyManager.isReady("actor2") == false);
+  updatePolicyManager.updateGlobalRevision();
+
+  // an object received before the policy is added is taken into account
+  updatePolicyManager.updateObjectRevision("object3");
+  updatePolicyManager.addPolicy("actor3", UpdatePolicyType::OnAny, { "object3" }, false, false);
+  CHECK(updatePolicyManager.isReady("actor3") == true);
+
+  // replacing a policy drops its former inputs
+  updatePolicyManager.addPolicy("actor3", UpdatePolicyType::OnAny, { "object4" }, false, false);
+  CHECK(updatePolicyManager.isReady("actor3") == false);
+  updatePolicyManager.updateObjectRevision("object3");
+  CHECK(updatePolicyManager.isReady("actor3") == false);
+  updatePolicyManager.updateObjectRevision("object4");
+  CHECK(updatePolicyManager.isReady("actor3") == true);
+
+  // going back in time makes the newer objects updated again
+  updatePolicyManager.updateActorRevision("actor1", 0);
+  CHECK(updatePolicyManager.isReady("actor1") == true);
+
+  updatePolicyManager.reset();
+  CHECK_THROWS_AS(updatePolicyManager.isReady("actor1"), ObjectNotFoundError);
+}
@@ -0,0 +1,120 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testRootFileSink.cxx
+///
+
+#include "QualityControl/RootFileSink.h"
+#include "QualityControl/RootFileStorage.h"
+#include "QualityControl/MonitorObjectCollection.h"
+#include "QualityControl/MonitorObject.h"
+
+#include <filesystem>
+#include <catch_amalgamated.hpp>
+#include <TH1I.h>
+#include <unistd.h>
+
+using namespace o2::quality_control::core;
+
+namespace
+{
+
+struct SinkFileFixture {
+  explicit SinkFileFixture(const std::string& testCase)
+    : filePath("/tmp/qc_test_root_file_sink_" + testCase + "_" + std::to_string(getpid()) + ".root")
+  {
+    std::filesystem::remove(filePath);
+  }
+
+  ~SinkFileFixture()
+  {
+    std::filesystem::remove(filePath);
+  }
+
+  std::string filePath;
+};
+
+// a collection as a task would publish it, with one entry in the histogram and a moving window
+std::unique_ptr<MonitorObjectCollection> createMOC()
+{
+  auto moc = std::make_unique<MonitorObjectCollection>();
+  moc->SetOwner(true);
+  auto histo = new TH1I("histo 1d", "histo 1d", 10, 0, 10);
+  histo->Fill(5);
+  auto mo = new MonitorObject(histo, "histo 1d", "class", "DET");
+  mo->setActivity({ 300000, "PHYSICS", "LHC32x", "apass2", "qc_async", { 100, 300 } });
+  mo->setCreateMovingWindow(true);
+  mo->setIsOwner(true);
+  moc->Add(mo);
+  return moc;
+}
+
+double readSum(const std::string& filePath, const std::string& mocPath)
+{
+  RootFileStorage storage(filePath, RootFileStorage::ReadMode::Read);
+  auto moc = std::unique_ptr<MonitorObjectCollection>(storage.readMonitorObjectCollection(mocPath));
+  REQUIRE(moc != nullptr);
+  REQUIRE(moc->GetEntries() == 1);
+  auto mo = dynamic_cast<MonitorObject*>(moc->At(0));
+  REQUIRE(mo != nullptr);
+  auto histo = dynamic_cast<TH1I*>(mo->getObject());
+  REQUIRE(histo != nullptr);
+  return histo->GetSum();
+}
+
+} // namespace
+
+TEST_CASE("sink_merge_immediately")
+{
+  SinkFileFixture fixture("merge_immediately");
+  RootFileSink sink(fixture.filePath);
+
+  sink.receive(createMOC());
+  sink.receive(createMOC());
+
+  // each collection is merged into the file as soon as it is received
+  CHECK(readSum(fixture.filePath, "int/TST/Test") == 2);
+  CHECK(readSum(fixture.filePath, "mw/TST/Test/100") == 2);
+}
+
+TEST_CASE("sink_flush_read")
+{
+  SinkFileFixture fixture("flush_read");
+
+  // the results of a previous workflow, which have to be merged with
+  {
+    RootFileStorage storage(fixture.filePath, RootFileStorage::ReadMode::Update);
+    auto moc = createMOC();
+    storage.storeIntegralMOC(moc.get());
+  }
+
+  // only written at the end
+  RootFileSink sink(fixture.filePath, std::chrono::seconds{ 0 });
+  sink.receive(createMOC());
+  sink.receive(createMOC());
+  CHECK(readSum(fixture.filePath, "int/TST/Test") == 1);
+
+  sink.stop();
+  CHECK(readSum(fixture.filePath, "int/TST/Test") == 3);
+  CHECK(readSum(fixture.filePath, "mw/TST/Test/100") == 2);
+
+  // the integral in memory already includes what is in the file, the moving window is merged with the stored one
+  sink.receive(createMOC());
+  sink.stop();
+  CHECK(readSum(fixture.filePath, "int/TST/Test") == 4);
+  CHECK(readSum(fixture.filePath, "mw/TST/Test/100") == 3);
+
+  // nothing new to write
+  sink.stop();
+  CHECK(readSum(fixture.filePath, "int/TST/Test") == 4);
+  CHECK(readSum(fixture.filePath, "mw/TST/Test/100") == 3);
+}
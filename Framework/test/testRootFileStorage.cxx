@@ -119,6 +119,39 @@ TEST_CASE("int_write_read")
   }
 }
 
+TEST_CASE("int_overwrite")
+{
+  TestFileFixture fixture("int_overwrite");
+
+  MonitorObjectCollection* mocBefore = new MonitorObjectCollection();
+  mocBefore->SetOwner(true);
+
+  TH1I* histoBefore = new TH1I("histo 1d", "histo 1d", bins, min, max);
+  histoBefore->Fill(5);
+  MonitorObject* moHistoBefore = new MonitorObject(histoBefore, "histo 1d", "class", "DET");
+  moHistoBefore->setIsOwner(true);
+  mocBefore->Add(moHistoBefore);
+
+  RootFileStorage storage(fixture.filePath, RootFileStorage::ReadMode::Update);
+  REQUIRE(RootFileStorage::integralMocPath(mocBefore) == "int/TST/Test");
+  REQUIRE_NOTHROW(storage.storeIntegralMOC(mocBefore));
+  // the stored object is replaced, not merged with
+  REQUIRE_NOTHROW(storage.storeIntegralMOC(mocBefore, RootFileStorage::WriteMode::Overwrite));
+
+  auto mocAfter = storage.readMonitorObjectCollection(RootFileStorage::integralMocPath(mocBefore));
+  REQUIRE(mocAfter != nullptr);
+  auto moHistoAfter = dynamic_cast<MonitorObject*>(mocAfter->At(0));
+  REQUIRE(moHistoAfter != nullptr);
+  auto histoAfter = dynamic_cast<TH1I*>(moHistoAfter->getObject());
+  REQUIRE(histoAfter != nullptr);
+  CHECK(histoAfter->GetSum() == 1);
+
+  IntegralMocWalker walker(storage.readStructure(false));
+  REQUIRE(walker.hasNextPath());
+  CHECK(walker.nextPath() == RootFileStorage::integralMocPath(mocBefore));
+  CHECK(!walker.hasNextPath());
+}
+
 TEST_CASE("mw_write_read")
 {
   // the fixture will do the cleanup when being destroyed only after any file readers are destroyed earlier
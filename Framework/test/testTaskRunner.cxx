@@ -135,3 +135,27 @@ BOOST_AUTO_TEST_CASE(test_task_good_detector_name)
 
   //  cout << "no error message" << endl;
 }
+
+BOOST_AUTO_TEST_CASE(test_task_entire_merging_publication)
+{
+  std::string configFilePath = std::string("json://") + getTestDataDirectory() + "testSharedConfig.json";
+  auto config = ConfigurationFactory::getConfiguration(configFilePath);
+  auto infrastructureSpec = InfrastructureSpecReader::readInfrastructureSpec(config->getRecursive(), WorkflowType::Standalone);
+  auto taskSpec = *std::find_if(infrastructureSpec.tasks.begin(), infrastructureSpec.tasks.end(), [](const auto& taskSpec) {
+    return taskSpec.taskName == "abcTask";
+  });
+  taskSpec.location = TaskLocationSpec::Local;
+  taskSpec.publishOnlyModifiedObjects = true;
+  taskSpec.publicationThreads = 4;
+
+  // Mergers in the "entire" mode need all the objects in one message
+  taskSpec.mergingMode = "entire";
+  auto entireConfig = TaskRunnerFactory::extractConfig(infrastructureSpec.common, taskSpec, 1);
+  BOOST_CHECK(!entireConfig.publishOnlyModifiedObjects);
+  BOOST_CHECK_EQUAL(entireConfig.publicationThreads, 0);
+
+  taskSpec.mergingMode = "delta";
+  auto deltaConfig = TaskRunnerFactory::extractConfig(infrastructureSpec.common, taskSpec, 1);
+  BOOST_CHECK(deltaConfig.publishOnlyModifiedObjects);
+  BOOST_CHECK_EQUAL(deltaConfig.publicationThreads, 4);
+}
@@ -0,0 +1,57 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testThreadPool.cxx
+///
+
+#include "QualityControl/ThreadPool.h"
+
+#include <catch_amalgamated.hpp>
+#include <atomic>
+#include <stdexcept>
+
+using namespace o2::quality_control::core;
+
+TEST_CASE("thread_pool_results")
+{
+  ThreadPool pool(4);
+  CHECK(pool.size() == 4);
+
+  std::vector<std::future<int>> futures;
+  for (int i = 0; i < 100; i++) {
+    futures.push_back(pool.submit([i]() { return i * i; }));
+  }
+  for (int i = 0; i < 100; i++) {
+    CHECK(futures[i].get() == i * i);
+  }
+}
+
+TEST_CASE("thread_pool_exceptions")
+{
+  ThreadPool pool(2);
+  auto future = pool.submit([]() -> int { throw std::runtime_error("oops"); });
+  CHECK_THROWS_AS(future.get(), std::runtime_error);
+  CHECK(pool.submit([]() { return 42; }).get() == 42);
+}
+
+TEST_CASE("thread_pool_drains_on_destruction")
+{
+  std::atomic<int> counter = 0;
+  {
+    ThreadPool pool(0); // at least one thread is created
+    CHECK(pool.size() == 1);
+    for (int i = 0; i < 50; i++) {
+      pool.submit([&counter]() { counter++; });
+    }
+  }
+  CHECK(counter == 50);
+}
@@ -0,0 +1,144 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testTrendingPlotCache.cxx
+///
+
+#include "QualityControl/TrendingPlotCache.h"
+
+#include <TCanvas.h>
+#include <TGraph.h>
+#include <TH1.h>
+#include <TTree.h>
+#include <catch_amalgamated.hpp>
+
+using namespace o2::quality_control::postprocessing;
+
+namespace
+{
+
+struct TestTrend {
+  TestTrend()
+  {
+    tree.Branch("time", &time);
+    tree.Branch("value", &value);
+    tree.Branch("array", array, "array[3]/D");
+  }
+
+  void fill(size_t entries)
+  {
+    for (size_t i = 0; i < entries; i++) {
+      time++;
+      value = time % 5;
+      array[0] = array[1] = array[2] = value;
+      tree.Fill();
+    }
+  }
+
+  TTree tree;
+  UInt_t time = 1000;
+  Double_t value = 0;
+  Double_t array[3] = { 0 };
+};
+
+} // namespace
+
+TEST_CASE("trending_plot_cache_split_varexp")
+{
+  CHECK(TrendingPlotCache::splitVarexp("value") == std::vector<std::string>{ "value" });
+  CHECK(TrendingPlotCache::splitVarexp("source.mean:time") == std::vector<std::string>{ "source.mean", "time" });
+  CHECK(TrendingPlotCache::splitVarexp("TMath::Abs(value):meta.runNumber") == std::vector<std::string>{ "TMath::Abs(value)", "meta.runNumber" });
+}
+
+TEST_CASE("trending_plot_cache_graph")
+{
+  TestTrend trend;
+  trend.fill(10);
+
+  TCanvas canvas;
+  trend.tree.Draw("value:time", "value > 1", "*L");
+  auto* graph = dynamic_cast<TGraph*>(canvas.FindObject("Graph"));
+  REQUIRE(graph != nullptr);
+  REQUIRE(graph->GetN() == 6);
+  auto* background = dynamic_cast<TH1*>(canvas.FindObject("htemp"));
+  REQUIRE(background != nullptr);
+
+  TrendingPlotCache cache;
+  cache.start(&trend.tree);
+  CHECK(cache.addGraph({ "graph", "graph", "value:time", "value > 1", "*L", "" }, graph, nullptr));
+  cache.setBackground(background);
+  CHECK(cache.isValid());
+
+  // nothing new
+  CHECK(cache.update(&trend.tree));
+  CHECK(graph->GetN() == 6);
+
+  trend.fill(10);
+  CHECK(cache.update(&trend.tree));
+  // the same as a full redraw
+  trend.tree.Draw("value:time", "value > 1", "goff");
+  REQUIRE(graph->GetN() == trend.tree.GetSelectedRows());
+  for (int i = 0; i < graph->GetN(); i++) {
+    CHECK(graph->GetPointY(i) == trend.tree.GetVal(0)[i]);
+    CHECK(graph->GetPointX(i) == trend.tree.GetVal(1)[i]);
+  }
+  // the axes follow the new points
+  CHECK(background->GetXaxis()->GetXmax() >= trend.time);
+
+  // the trend was reset, the plot has to be redrawn
+  trend.tree.Reset();
+  CHECK_FALSE(cache.update(&trend.tree));
+  TTree otherTree;
+  CHECK_FALSE(cache.update(&otherTree));
+}
+
+TEST_CASE("trending_plot_cache_histogram")
+{
+  TestTrend trend;
+  trend.fill(10);
+
+  TCanvas canvas;
+  trend.tree.Draw("value");
+  auto* histogram = dynamic_cast<TH1*>(canvas.FindObject("htemp"));
+  REQUIRE(histogram != nullptr);
+  histogram->BufferEmpty();
+
+  TrendingPlotCache cache;
+  cache.start(&trend.tree);
+  CHECK(cache.addGraph({ "histogram", "histogram", "value", "", "", "" }, histogram, nullptr));
+
+  trend.fill(5);
+  CHECK(cache.update(&trend.tree));
+  CHECK(histogram->GetEntries() == 15);
+}
+
+TEST_CASE("trending_plot_cache_unsupported")
+{
+  TestTrend trend;
+  trend.fill(10);
+
+  TCanvas canvas;
+  trend.tree.Draw("array:time", "", "*L");
+  auto* graph = dynamic_cast<TGraph*>(canvas.FindObject("Graph"));
+  REQUIRE(graph != nullptr);
+
+  TrendingPlotCache cache;
+  cache.start(&trend.tree);
+  // several values per entry
+  CHECK_FALSE(cache.addGraph({ "graph", "graph", "array:time", "", "*L", "" }, graph, nullptr));
+  CHECK_FALSE(cache.isValid());
+  CHECK_FALSE(cache.update(&trend.tree));
+
+  // not drawn as a graph nor a histogram
+  cache.start(&trend.tree);
+  CHECK_FALSE(cache.addGraph({ "graph", "graph", "value:time", "", "colz", "" }, nullptr, nullptr));
+}
@@ -292,3 +292,140 @@ TEST_CASE("test_trending_task")
   objectManager->stopPublishing(PublicationPolicy::Once);
   objectManager->stopPublishing(PublicationPolicy::ThroughStop);
 }
+
+TEST_CASE("test_trending_task_prepared_update_with_missing_source")
+{
+  const std::string pid = std::to_string(getpid());
+  const std::string trendingTaskName = "TestTrendingTaskPrepared";
+  const std::string trendingTaskID = "TSTTrendingTaskPrepared";
+  const std::string taskName = "TrendingTaskPreparedTest" + pid;
+
+  std::stringstream ss;
+  ss << R"json({
+  "qc": {
+    "config": {
+      "database": {
+        "implementation": "CCDB",
+        "host": "ccdb-test.cern.ch:8080"
+      },
+      "Activity": {},
+      "monitoring": {
+        "url": "infologger:///debug?qc"
+      }
+    },
+    "postprocessing": {
+      "TSTTrendingTaskPrepared": {
+        "active": "true",
+        "taskName": "TestTrendingTaskPrepared",
+        "className": "o2::quality_control::postprocessing::TrendingTask",
+        "trendIfAllInputs": false,
+        "moduleName": "QualityControl",
+        "detectorName": "TST",
+        "dataSources": [
+          {
+            "type": "repository",
+            "path": "TST/MO/)json" +
+          taskName + R"json(",
+            "name": "alwaysThere",
+            "reductorName": "o2::quality_control_modules::common::TH1Reductor",
+            "moduleName": "QcCommon"
+          },
+          {
+            "type": "repository",
+            "path": "TST/MO/)json" +
+          taskName + R"json(",
+            "name": "onlyFirst",
+            "reductorName": "o2::quality_control_modules::common::TH1Reductor",
+            "moduleName": "QcCommon"
+          }
+        ],
+        "plots": [],
+        "initTrigger": [],
+        "updateTrigger": [],
+        "stopTrigger": []
+      }
+    }
+  }
+})json";
+  boost::property_tree::ptree config;
+  boost::property_tree::read_json(ss, config);
+
+  std::shared_ptr<DatabaseInterface> repository = DatabaseFactory::create("CCDB");
+  repository->connect(CCDB_ENDPOINT, "", "", "");
+  repository->truncate("qc/TST/MO/" + taskName, "*");
+  CleanupAtDestruction cleanTestObjects([repository, taskName]() {
+    if (repository) {
+      repository->truncate("qc/TST/MO/" + taskName, "*");
+    }
+  });
+
+  // "onlyFirst" is missing for the second trigger, thus the trend should keep its previous values
+  {
+    TH1I* alwaysThere = new TH1I("alwaysThere", "alwaysThere", 10, 0, 10.0);
+    alwaysThere->Fill(4);
+    auto mo = std::make_shared<MonitorObject>(alwaysThere, taskName, "TestClass", "TST");
+    mo->setValidity({ 2, 100000 });
+    repository->storeMO(mo);
+    alwaysThere->Fill(8);
+    mo->setValidity({ 100001, 200000 });
+    repository->storeMO(mo);
+
+    TH1I* onlyFirst = new TH1I("onlyFirst", "onlyFirst", 10, 0, 10.0);
+    onlyFirst->Fill(2);
+    onlyFirst->Fill(3);
+    auto mo2 = std::make_shared<MonitorObject>(onlyFirst, taskName, "TestClass", "TST");
+    mo2->setValidity({ 2, 100000 });
+    repository->storeMO(mo2);
+  }
+
+  const std::vector<Trigger> triggers{
+    { TriggerType::NewObject, false, { 0, "NONE", "", "", "qc", { 2, 100000 } }, 100000 - 1 },
+    { TriggerType::NewObject, false, { 0, "NONE", "", "", "qc", { 100000, 200000 } }, 200000 - 1 }
+  };
+  auto runTask = [&](bool prepared) {
+    ServiceRegistry services;
+    services.registerService<DatabaseInterface>(repository.get());
+    auto objectManager = std::make_shared<ObjectsManager>(taskName, "o2::quality_control::postprocessing::TrendingTask", "TST", "");
+    TrendingTask task;
+    task.setName(trendingTaskName);
+    task.setID(trendingTaskID);
+    task.setObjectsManager(objectManager);
+    REQUIRE_NOTHROW(task.configure(config));
+    REQUIRE_NOTHROW(task.initialize({ TriggerType::UserOrControl, true, { 0, "NONE", "", "", "qc" }, 1 }, services));
+    for (const auto& trigger : triggers) {
+      if (prepared) {
+        auto preparedUpdate = task.prepareUpdate(trigger, services);
+        REQUIRE(preparedUpdate != nullptr);
+        task.finishUpdate(trigger, services, std::move(preparedUpdate));
+      } else {
+        task.update(trigger, services);
+      }
+    }
+    auto treeMO = objectManager->getMonitorObject(trendingTaskName);
+    REQUIRE(treeMO != nullptr);
+    auto* tree = dynamic_cast<TTree*>(treeMO->getObject());
+    REQUIRE(tree != nullptr);
+    REQUIRE(tree->GetEntries() == 2);
+    tree->Draw("alwaysThere.entries:onlyFirst.entries:onlyFirst.mean", "", "goff");
+    std::vector<double> values;
+    for (int variable = 0; variable < 3; variable++) {
+      values.insert(values.end(), tree->GetVal(variable), tree->GetVal(variable) + 2);
+    }
+    objectManager->stopPublishing(PublicationPolicy::Once);
+    objectManager->stopPublishing(PublicationPolicy::ThroughStop);
+    return values;
+  };
+
+  auto serial = runTask(false);
+  auto parallel = runTask(true);
+  CHECK_THAT(serial[0], Catch::Matchers::WithinAbs(1, 0.01));
+  CHECK_THAT(serial[1], Catch::Matchers::WithinAbs(2, 0.01));
+  CHECK_THAT(serial[2], Catch::Matchers::WithinAbs(2, 0.01));
+  CHECK_THAT(serial[3], Catch::Matchers::WithinAbs(2, 0.01));
+  CHECK_THAT(serial[4], Catch::Matchers::WithinAbs(2.5, 0.01));
+  CHECK_THAT(serial[5], Catch::Matchers::WithinAbs(2.5, 0.01));
+  REQUIRE(parallel.size() == serial.size());
+  for (size_t i = 0; i < serial.size(); i++) {
+    CHECK_THAT(parallel[i], Catch::Matchers::WithinAbs(serial[i], 0.0001));
+  }
+}
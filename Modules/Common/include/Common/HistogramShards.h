@@ -0,0 +1,90 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HistogramShards.h
+///
+
+#ifndef QUALITYCONTROL_HISTOGRAMSHARDS_H
+#define QUALITYCONTROL_HISTOGRAMSHARDS_H
+
+#include <TH1.h>
+
+#include <unordered_map>
+#include <vector>
+
+class TH2;
+
+namespace o2::quality_control_modules::common
+{
+
+/// \brief Per-thread bin buffers which allow to fill the same histograms from several threads without locking.
+///
+/// Each registered histogram gets one dense buffer of bin contents, sums of squared weights and statistics per shard
+/// (typically one per thread). Threads fill only their own shard with fill() and the caller adds all the shards to
+/// the histograms with merge() once the parallel section is over, e.g. once per TF. The result is the same as
+/// if the histograms were filled directly with TH1::Fill, up to the floating point summation order.
+/// Histograms with extendable axes and profiles are not supported, as their bins cannot be known in advance.
+///
+/// Registering histograms and merging is not thread-safe, while fill() can be called concurrently for different shards.
+class HistogramShards
+{
+ public:
+  explicit HistogramShards(size_t nShards);
+  ~HistogramShards() = default;
+
+  /// \brief Registers a histogram which will be filled through the shards.
+  /// \throw std::invalid_argument if the histogram is not supported
+  void add(TH1* histogram);
+  bool contains(const TH1* histogram) const { return mIndex.find(histogram) != mIndex.end(); }
+
+  /// \brief Fills a 1D histogram in the given shard, equivalent to TH1::Fill(x, w).
+  void fill(size_t shard, TH1* histogram, double x, double w = 1.0);
+  /// \brief Fills a 2D histogram in the given shard, equivalent to TH2::Fill(x, y, w).
+  void fill(size_t shard, TH2* histogram, double x, double y, double w = 1.0);
+
+  /// \brief Adds the contents of all the shards to the histograms and empties the shards.
+  void merge();
+  /// \brief Empties the shards without touching the histograms.
+  void clear();
+
+  size_t getNShards() const { return mNShards; }
+
+ private:
+  struct alignas(64) Shard {
+    std::vector<double> contents;
+    std::vector<double> sumw2;
+    double stats[TH1::kNstat] = { 0 };
+    double entries = 0;
+    int firstBin = -1;
+    int lastBin = -1;
+    bool weighted = false;
+
+    void touch(int bin, int nCells, double w);
+    void reset();
+  };
+
+  struct Entry {
+    TH1* histogram = nullptr;
+    std::vector<Shard> shards;
+  };
+
+  Shard& getShard(size_t shard, const TH1* histogram);
+  static void merge(Entry& entry);
+
+  size_t mNShards;
+  std::vector<Entry> mEntries;
+  std::unordered_map<const TH1*, size_t> mIndex;
+};
+
+} // namespace o2::quality_control_modules::common
+
+#endif // QUALITYCONTROL_HISTOGRAMSHARDS_H
@@ -83,8 +83,8 @@ class QualityTask : public quality_control::postprocessing::PostProcessingInterf
   void finalize(quality_control::postprocessing::Trigger, framework::ServiceRegistryRef) override;
 
  private:
-  std::pair<std::shared_ptr<quality_control::core::QualityObject>, bool> getLatestQO(
-    quality_control::repository::DatabaseInterface& qcdb, const o2::quality_control::core::Activity& activity, const std::string& fullPath, const std::string& group);
+  std::pair<std::shared_ptr<quality_control::core::QualityObject>, bool> filterLatestQO(
+    std::shared_ptr<quality_control::core::QualityObject> qo, const o2::quality_control::core::Activity& activity, const std::string& fullPath, const std::string& group);
 
  private:
   /// \brief configuration parameters
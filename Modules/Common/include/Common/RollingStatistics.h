@@ -0,0 +1,124 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RollingStatistics.h
+///
+
+#ifndef QUALITYCONTROL_ROLLINGSTATISTICS_H
+#define QUALITYCONTROL_ROLLINGSTATISTICS_H
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace o2::quality_control_modules::common
+{
+
+/// \brief Mean and standard deviation of the mean of a set of points, to which points can be added and removed in constant time.
+///
+/// Without errors, all the points have the same weight and the mean and the variance are updated with the Welford algorithm.
+/// With errors, each point has the weight 1/error^2 and the statistics are derived from the running sums of the weights,
+/// of the weighted values and of the weighted squared values. The formulas are the ones used so far by the trending checks:
+/// - without errors, the standard deviation of the mean is sqrt(sum((x - mean)^2) / (n * (n - 1))), 0 for one point,
+/// - with errors, it is sqrt((<x^2> - mean^2) * r / (1 - r)) with r = sum(w^2) / sum(w)^2, the error of the point for one point.
+/// The mean and the standard deviation of an empty set are NaN.
+class RollingStatistics
+{
+ public:
+  explicit RollingStatistics(bool useErrors = false) : mUseErrors(useErrors) {}
+  ~RollingStatistics() = default;
+
+  /// \brief Removes all the points and sets whether the errors of the next points are used as weights.
+  void reset(bool useErrors);
+  /// \brief Removes all the points.
+  void clear() { reset(mUseErrors); }
+
+  /// \brief Adds a point. The error is ignored if the errors are not used.
+  void add(double value, double error = 0.);
+  /// \brief Removes a point which was added before, with the same value and error.
+  void remove(double value, double error = 0.);
+  /// \brief Adds the points [firstPoint, lastPoint) of a series, e.g. the arrays of a TGraph, skipping the masked ones.
+  /// \param errors errors of the points, can be nullptr if the errors are not used
+  /// \param maskedPoints indices of the points to skip, counted from firstPoint
+  void add(const double* values, const double* errors, int firstPoint, int lastPoint, const std::vector<int>& maskedPoints = {});
+
+  bool usesErrors() const { return mUseErrors; }
+  size_t getN() const { return mN; }
+  double getMean() const;
+  double getStdDevOfMean() const;
+
+ private:
+  bool mUseErrors;
+  size_t mN = 0;
+  // Welford, without errors
+  double mMean = 0.;
+  double mSumSquaredDeviations = 0.;
+  // running sums, with errors
+  double mSumOfWeights = 0.;
+  double mSumOfSquaredWeights = 0.;
+  double mWeightedSum = 0.;
+  double mWeightedSumOfSquares = 0.;
+};
+
+/// \brief Statistics of the points of a series in a window which moves towards the end of the series, e.g. the last points of a trending graph.
+///
+/// Only the points which enter and leave the window are processed when it moves forward, so following a growing graph
+/// costs O(1) per new point, also from one check to the next one if the object is kept.
+/// The window keeps a copy of its points. Its first and last points are compared to the series given to setSeries(),
+/// with their x coordinates, which have to be strictly increasing (e.g. the timestamps of a trending graph).
+/// If they differ (e.g. the oldest points of the trend were dropped) or the window moves backwards, the statistics are
+/// computed again from scratch. Points modified in the middle of the window are thus not noticed.
+/// The running sums are also recomputed from the copy of the points once as many points left the window as it contains,
+/// which bounds the rounding errors accumulated by the removals without changing the cost per point.
+class SlidingWindowStatistics
+{
+ public:
+  SlidingWindowStatistics() = default;
+  ~SlidingWindowStatistics() = default;
+
+  /// \brief Sets the series of points that the window moves over. The arrays must stay valid until the next call.
+  /// \param xs strictly increasing x coordinates of the points, which identify them (e.g. TGraph::GetX())
+  /// \param errors errors of the points, can be nullptr if the errors are not used
+  /// \return true if the points of the window are still the same and they are kept, false if the window was emptied
+  bool setSeries(const double* xs, const double* values, const double* errors, int nPoints, bool useErrors);
+  /// \brief Moves the window to the points [firstPoint, lastPoint) of the series.
+  const RollingStatistics& moveTo(int firstPoint, int lastPoint);
+  /// \brief Empties the window.
+  void reset();
+
+  const RollingStatistics& getStatistics() const { return mStatistics; }
+
+ private:
+  struct Point {
+    double x;
+    double value;
+    double error;
+  };
+
+  double getError(int point) const { return mErrors ? mErrors[point] : 0.; }
+  void rebuild();
+
+  RollingStatistics mStatistics;
+  std::deque<Point> mPoints;
+  int mFirstPoint = 0;
+  int mLastPoint = 0;
+  size_t mRemovedSinceRebuild = 0;
+
+  const double* mXs = nullptr;
+  const double* mValues = nullptr;
+  const double* mErrors = nullptr;
+  int mNPoints = 0;
+};
+
+} // namespace o2::quality_control_modules::common
+
+#endif // QUALITYCONTROL_ROLLINGSTATISTICS_H
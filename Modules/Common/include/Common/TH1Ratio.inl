@@ -217,6 +217,33 @@ void TH1Ratio<T>::update()
     return;
   }
 
+  if (mLazyRatio) {
+    invalidateRatio();
+  } else {
+    computeRatio();
+  }
+}
+
+template<class T>
+void TH1Ratio<T>::computeLazyContent()
+{
+  if (!mRatioUpToDate && mHistoNum && mHistoDen) {
+    computeRatio();
+  }
+}
+
+template<class T>
+void TH1Ratio<T>::invalidateRatio()
+{
+  // the stale ratio is shrunk to a single bin on the range of the numerator, computeRatio() rebuilds the axis
+  T::Reset();
+  T::SetBins(1, mHistoNum->GetXaxis()->GetXmin(), mHistoNum->GetXaxis()->GetXmax());
+  mRatioUpToDate = false;
+}
+
+template<class T>
+void TH1Ratio<T>::computeRatio()
+{
   T::Reset();
   if (mHistoNum->GetXaxis()->IsVariableBinSize()) {
     T::GetXaxis()->Set(mHistoNum->GetXaxis()->GetNbins(), mHistoNum->GetXaxis()->GetXbins()->GetArray());
@@ -224,6 +251,10 @@ void TH1Ratio<T>::update()
     T::GetXaxis()->Set(mHistoNum->GetXaxis()->GetNbins(), mHistoNum->GetXaxis()->GetXmin(), mHistoNum->GetXaxis()->GetXmax());
   }
   T::SetBinsLength();
+  // the sum of squares of weights follows the number of bins, which changes when a stale ratio is rebuilt
+  if (T::GetSumw2N() > 0 && T::GetSumw2N() != T::GetNcells()) {
+    T::GetSumw2()->Set(T::GetNcells());
+  }
 
   // Copy bin labels between histograms.
   // If set, the bin labels of the ratio histograms are copied to the numerator.
@@ -247,6 +278,7 @@ void TH1Ratio<T>::update()
     th1ratio_internal::copyBinLabels<T>(mHistoNum, mHistoDen);
     T::Divide(mHistoNum, mHistoDen, 1.0, 1.0, mBinominalErrors ? "B" : "");
   }
+  mRatioUpToDate = true;
 }
 
 template<class T>
@@ -296,6 +328,7 @@ void TH1Ratio<T>::Copy(TObject& obj) const
   }
 
   dest->setHasUniformScaling(hasUniformScaling());
+  dest->setLazyRatio(hasLazyRatio());
 
   T::Copy(obj);
 
@@ -18,6 +18,7 @@
 #define QUALITYCONTROL_TH2RATIO_H
 
 #include "Mergers/MergeInterface.h"
+#include "QualityControl/LazyObjectInterface.h"
 #include <TH2F.h>
 #include <TH2D.h>
 #include <TDirectory.h>
@@ -26,7 +27,7 @@ namespace o2::quality_control_modules::common
 {
 
 template <class T>
-class TH2Ratio : public T, public o2::mergers::MergeInterface
+class TH2Ratio : public T, public o2::mergers::MergeInterface, public o2::quality_control::core::LazyObjectInterface
 {
  public:
   TH2Ratio();
@@ -68,7 +69,15 @@ class TH2Ratio : public T, public o2::mergers::MergeInterface
   void setHasBinominalErrors(bool flag = true) { mBinominalErrors = flag; }
   bool hasBinominalErrors() const { return mBinominalErrors; }
 
+  // In the lazy mode only the numerator and the denominator are kept up to date by update(), merge() and Add(),
+  // while the ratio is shrunk to a single empty bin and marked as stale.
+  // The ratio is computed by computeLazyContent(), which the CheckRunner and the RootFileSink call before using the object.
+  void setLazyRatio(bool flag = true) { mLazyRatio = flag; }
+  bool hasLazyRatio() const { return mLazyRatio; }
+  bool isRatioUpToDate() const { return mRatioUpToDate; }
+
   void update();
+  void computeLazyContent() override;
 
   // functions inherited from TH2x
   void Reset(Option_t* option = "") override;
@@ -87,8 +96,13 @@ class TH2Ratio : public T, public o2::mergers::MergeInterface
   bool mBinominalErrors{ false };
   Bool_t mSumw2Enabled{ kTRUE };
   std::string mTreatMeAs{ T::Class_Name() };
+  bool mLazyRatio{ false };
+  bool mRatioUpToDate{ true };
+
+  void computeRatio();
+  void invalidateRatio();
 
-  ClassDefOverride(TH2Ratio, 3);
+  ClassDefOverride(TH2Ratio, 4);
 };
 
 typedef TH2Ratio<TH2F> TH2FRatio;
@@ -276,6 +276,34 @@ void TH2Ratio<T>::update()
     return;
   }
 
+  if (mLazyRatio) {
+    invalidateRatio();
+  } else {
+    computeRatio();
+  }
+}
+
+template<class T>
+void TH2Ratio<T>::computeLazyContent()
+{
+  if (!mRatioUpToDate && mHistoNum && mHistoDen) {
+    computeRatio();
+  }
+}
+
+template<class T>
+void TH2Ratio<T>::invalidateRatio()
+{
+  // the stale ratio is shrunk to a single bin on the range of the numerator, computeRatio() rebuilds the axes
+  T::Reset();
+  T::SetBins(1, mHistoNum->GetXaxis()->GetXmin(), mHistoNum->GetXaxis()->GetXmax(),
+             1, mHistoNum->GetYaxis()->GetXmin(), mHistoNum->GetYaxis()->GetXmax());
+  mRatioUpToDate = false;
+}
+
+template<class T>
+void TH2Ratio<T>::computeRatio()
+{
   T::Reset();
   if (mHistoNum->GetXaxis()->IsVariableBinSize()) {
     T::GetXaxis()->Set(mHistoNum->GetXaxis()->GetNbins(), mHistoNum->GetXaxis()->GetXbins()->GetArray());
@@ -288,6 +316,10 @@ void TH2Ratio<T>::update()
     T::GetYaxis()->Set(mHistoNum->GetYaxis()->GetNbins(), mHistoNum->GetYaxis()->GetXmin(), mHistoNum->GetYaxis()->GetXmax());
   }
   T::SetBinsLength();
+  // the sum of squares of weights follows the number of bins, which changes when a stale ratio is rebuilt
+  if (T::GetSumw2N() > 0 && T::GetSumw2N() != T::GetNcells()) {
+    T::GetSumw2()->Set(T::GetNcells());
+  }
 
   // Copy bin labels between histograms.
   // If set, the bin labels of the ratio histograms are copied to the numerator.
@@ -311,6 +343,7 @@ void TH2Ratio<T>::update()
     th2ratio_internal::copyBinLabels<T>(mHistoNum, mHistoDen);
     T::Divide(mHistoNum, mHistoDen, 1.0, 1.0, mBinominalErrors ? "B" : "");
   }
+  mRatioUpToDate = true;
 }
 
 template<class T>
@@ -360,6 +393,7 @@ void TH2Ratio<T>::Copy(TObject& obj) const
   }
 
   dest->setHasUniformScaling(hasUniformScaling());
+  dest->setLazyRatio(hasLazyRatio());
 
   T::Copy(obj);
 
@@ -19,6 +19,7 @@
 #define QC_MODULE_COMMON_TRENDCHECK_H
 
 #include "QualityControl/CheckInterface.h"
+#include "Common/RollingStatistics.h"
 
 #include <optional>
 #include <array>
@@ -62,7 +63,7 @@ class TrendCheck : public o2::quality_control::checker::CheckInterface
     StdDeviation
   };
 
-  std::array<std::optional<std::pair<double, double>>, 2> getThresholds(std::string key, TGraph* graph);
+  std::array<std::optional<std::pair<double, double>>, 2> getThresholds(std::string key, TGraph* graph, SlidingWindowStatistics& window);
   void getGraphsFromObject(TObject* object, std::vector<TGraph*>& graphs);
   double getInteractionRate();
 
@@ -76,6 +77,8 @@ class TrendCheck : public o2::quality_control::checker::CheckInterface
   std::unordered_map<std::string, std::vector<std::pair<double, std::pair<double, double>>>> mThresholdsTrendBad;
   std::unordered_map<std::string, std::vector<std::pair<double, std::pair<double, double>>>> mThresholdsTrendMedium;
   std::unordered_map<std::string, Quality> mQualities;
+  /// windows of points used for the average of each graph, kept from one check to the next one
+  std::unordered_map<std::string, SlidingWindowStatistics> mAverageWindows; //!
 };
 
 } // namespace o2::quality_control_modules::common
@@ -0,0 +1,185 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   HistogramShards.cxx
+///
+
+#include "Common/HistogramShards.h"
+
+#include <TArrayD.h>
+#include <TH2.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace o2::quality_control_modules::common
+{
+
+HistogramShards::HistogramShards(size_t nShards) : mNShards(std::max<size_t>(nShards, 1))
+{
+}
+
+void HistogramShards::add(TH1* histogram)
+{
+  if (histogram == nullptr) {
+    throw std::invalid_argument("Cannot shard a null histogram");
+  }
+  if (contains(histogram)) {
+    return;
+  }
+  if (histogram->GetDimension() > 2 || histogram->InheritsFrom("TProfile") || histogram->InheritsFrom("TProfile2D")) {
+    throw std::invalid_argument(std::string("Histogram '") + histogram->GetName() + "' cannot be sharded, only 1D and 2D histograms are supported");
+  }
+  if (histogram->CanExtendAllAxes()) {
+    throw std::invalid_argument(std::string("Histogram '") + histogram->GetName() + "' cannot be sharded, its axes are extendable");
+  }
+  mIndex.emplace(histogram, mEntries.size());
+  mEntries.push_back({ histogram, std::vector<Shard>(mNShards) });
+}
+
+HistogramShards::Shard& HistogramShards::getShard(size_t shard, const TH1* histogram)
+{
+  return mEntries[mIndex.at(histogram)].shards.at(shard);
+}
+
+void HistogramShards::Shard::touch(int bin, int nCells, double w)
+{
+  // the buffers are allocated by the thread which fills them for the first time
+  if (contents.empty()) {
+    contents.assign(nCells, 0.0);
+    sumw2.assign(nCells, 0.0);
+  }
+  contents[bin] += w;
+  sumw2[bin] += w * w;
+  firstBin = firstBin < 0 ? bin : std::min(firstBin, bin);
+  lastBin = std::max(lastBin, bin);
+  weighted |= w != 1.0;
+  entries++;
+}
+
+void HistogramShards::Shard::reset()
+{
+  // only the touched range has to be zeroed, which keeps merging cheap for large, sparsely filled histograms
+  if (firstBin >= 0) {
+    std::fill(contents.begin() + firstBin, contents.begin() + lastBin + 1, 0.0);
+    std::fill(sumw2.begin() + firstBin, sumw2.begin() + lastBin + 1, 0.0);
+  }
+  std::fill(std::begin(stats), std::end(stats), 0.0);
+  entries = 0;
+  firstBin = -1;
+  lastBin = -1;
+  weighted = false;
+}
+
+void HistogramShards::fill(size_t shard, TH1* histogram, double x, double w)
+{
+  auto& s = getShard(shard, histogram);
+  const auto* xAxis = histogram->GetXaxis();
+  const int bin = xAxis->FindFixBin(x);
+  s.touch(bin, histogram->GetNcells(), w);
+
+  // same as TH1::Fill, under- and overflows do not contribute to the statistics by default
+  if ((bin == 0 || bin > xAxis->GetNbins()) && !histogram->GetStatOverflowsBehaviour()) {
+    return;
+  }
+  s.stats[0] += w;
+  s.stats[1] += w * w;
+  s.stats[2] += w * x;
+  s.stats[3] += w * x * x;
+}
+
+void HistogramShards::fill(size_t shard, TH2* histogram, double x, double y, double w)
+{
+  auto& s = getShard(shard, histogram);
+  const auto* xAxis = histogram->GetXaxis();
+  const auto* yAxis = histogram->GetYaxis();
+  const int binx = xAxis->FindFixBin(x);
+  const int biny = yAxis->FindFixBin(y);
+  s.touch(histogram->GetBin(binx, biny), histogram->GetNcells(), w);
+
+  // same as TH2::Fill, under- and overflows do not contribute to the statistics by default
+  if ((binx == 0 || binx > xAxis->GetNbins() || biny == 0 || biny > yAxis->GetNbins()) && !histogram->GetStatOverflowsBehaviour()) {
+    return;
+  }
+  s.stats[0] += w;
+  s.stats[1] += w * w;
+  s.stats[2] += w * x;
+  s.stats[3] += w * x * x;
+  s.stats[4] += w * y;
+  s.stats[5] += w * y * y;
+  s.stats[6] += w * x * y;
+}
+
+void HistogramShards::merge(Entry& entry)
+{
+  auto* histogram = entry.histogram;
+  bool filled = false;
+  bool weighted = false;
+  for (const auto& shard : entry.shards) {
+    filled |= shard.entries > 0;
+    weighted |= shard.weighted;
+  }
+  if (!filled) {
+    return;
+  }
+
+  // TH1::Fill starts storing the sums of squared weights as soon as a weight different from 1 is used
+  if (weighted && histogram->GetSumw2N() == 0 && !histogram->TestBit(TH1::kIsNotW)) {
+    histogram->Sumw2();
+  }
+
+  double stats[TH1::kNstat] = { 0 };
+  histogram->GetStats(stats);
+  double entries = histogram->GetEntries();
+  double* sumw2 = histogram->GetSumw2N() > 0 ? histogram->GetSumw2()->GetArray() : nullptr;
+
+  for (auto& shard : entry.shards) {
+    if (shard.entries == 0) {
+      continue;
+    }
+    for (int bin = shard.firstBin; bin <= shard.lastBin; bin++) {
+      if (shard.contents[bin] != 0) {
+        histogram->AddBinContent(bin, shard.contents[bin]);
+      }
+      if (sumw2 != nullptr) {
+        sumw2[bin] += shard.sumw2[bin];
+      }
+    }
+    for (int i = 0; i < TH1::kNstat; i++) {
+      stats[i] += shard.stats[i];
+    }
+    entries += shard.entries;
+    shard.reset();
+  }
+
+  histogram->PutStats(stats);
+  histogram->SetEntries(entries);
+}
+
+void HistogramShards::merge()
+{
+  for (auto& entry : mEntries) {
+    merge(entry);
+  }
+}
+
+void HistogramShards::clear()
+{
+  for (auto& entry : mEntries) {
+    for (auto& shard : entry.shards) {
+      shard.reset();
+    }
+  }
+}
+
+} // namespace o2::quality_control_modules::common
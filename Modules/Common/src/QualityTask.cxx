@@ -193,15 +193,13 @@ void QualityTask::initialize(quality_control::postprocessing::Trigger t, framewo
 }
 
 //_________________________________________________________________________________________
-// Helper function for retrieving a QualityObject from the QCDB, in the form of a std::pair<std::shared_ptr<QualityObject>, bool>
-// A non-null QO is returned in the first element of the pair if the QO is found in the QCDB
+// Helper function for checking a QualityObject retrieved from the QCDB, in the form of a std::pair<std::shared_ptr<QualityObject>, bool>
+// A non-null QO is returned in the first element of the pair if the QO was found in the QCDB and is not too old
 // The second element of the pair is set to true if the QO has a time stamp more recent than the last retrieved one
 
-std::pair<std::shared_ptr<QualityObject>, bool> QualityTask::getLatestQO(
-  repository::DatabaseInterface& qcdb, const Activity& activity, const std::string& fullPath, const std::string& group)
+std::pair<std::shared_ptr<QualityObject>, bool> QualityTask::filterLatestQO(
+  std::shared_ptr<QualityObject> qo, const Activity& activity, const std::string& fullPath, const std::string& group)
 {
-  // retrieve QO from CCDB
-  auto qo = qcdb.retrieveQO(fullPath, repository::DatabaseInterface::Timestamp::Latest, activity);
   if (!qo) {
     return { nullptr, false };
   }
@@ -248,6 +246,18 @@ void QualityTask::update(quality_control::postprocessing::Trigger t, framework::
   };
   std::vector<std::variant<Separator, TextAlign, Message>> lines;
 
+  // retrieve all the QOs from CCDB at once, in the order in which they are displayed
+  std::vector<repository::DatabaseInterface::RetrievalRequest> requests;
+  for (const auto& qualityGroupConfig : mConfig.qualityGroups) {
+    for (const auto& qualityConfig : qualityGroupConfig.inputObjects) {
+      requests.push_back({ repository::DatabaseInterface::RetrievalRequest::Type::QualityObject,
+                           fullQoPath(qualityGroupConfig.path, qualityConfig.name), "",
+                           repository::DatabaseInterface::Timestamp::Latest, t.activity });
+    }
+  }
+  auto results = qcdb.retrieveMany(requests);
+  size_t resultIndex = 0;
+
   for (const auto& qualityGroupConfig : mConfig.qualityGroups) {
     if (!qualityGroupConfig.title.empty()) {
       lines.emplace_back(Message{ qualityGroupConfig.title });
@@ -257,10 +267,10 @@ void QualityTask::update(quality_control::postprocessing::Trigger t, framework::
     for (const auto& qualityConfig : qualityGroupConfig.inputObjects) {
       auto fullPath = fullQoPath(qualityGroupConfig.path, qualityConfig.name);
       auto& qualityTitle = qualityConfig.title.empty() ? qualityConfig.name : qualityConfig.title;
-      // retrieve QO from CCDB, in the form of a std::pair<std::shared_ptr<QualityObject>, bool>
+      // check the retrieved QO, in the form of a std::pair<std::shared_ptr<QualityObject>, bool>
       // a valid object is returned in the first element of the pair if the QO is found in the QCDB
       // the second element of the pair is set to true if the QO has a time stamp more recent than the last retrieved one
-      auto [qo, wasUpdated] = getLatestQO(qcdb, t.activity, fullPath, qualityGroupConfig.name);
+      auto [qo, wasUpdated] = filterLatestQO(results[resultIndex++].qualityObject, t.activity, fullPath, qualityGroupConfig.name);
       if (!qo) {
         lines.emplace_back(Message{ fmt::format("#color[{}]{{{} : quality missing!}}", mColors["Missing"], qualityTitle) });
         lines.emplace_back(TextAlign{ 12 });
@@ -34,42 +34,27 @@ namespace o2::quality_control_modules::common
 {
 
 //_________________________________________________________________________________________
-// Helper function for retrieving a MonitorObject from the QCDB, in the form of a std::pair<std::shared_ptr<MonitorObject>, bool>
-// A non-null MO is returned in the first element of the pair if the MO is found in the QCDB
+// Helper function for checking a MonitorObject retrieved from the QCDB, in the form of a std::pair<std::shared_ptr<MonitorObject>, bool>
+// A non-null MO is returned in the first element of the pair if the MO was found in the QCDB
 // The second element of the pair is set to true if the MO has a time stamp more recent than a user-supplied threshold
 
-static std::pair<std::shared_ptr<MonitorObject>, bool> getMO(repository::DatabaseInterface& qcdb, const std::string& fullPath, Trigger trigger, long notOlderThan)
+static std::pair<std::shared_ptr<MonitorObject>, bool> checkMO(std::shared_ptr<MonitorObject> mo, const std::string& fullPath, Trigger trigger, long notOlderThan)
 {
-  // find the time-stamp of the most recent object matching the current activity
-  // if ignoreActivity is true the activity matching criteria are not applied
-  auto objectTimestamp = trigger.timestamp;
-  const auto filterMetadata = activity_helpers::asDatabaseMetadata(trigger.activity, false);
-  const auto objectValidity = qcdb.getLatestObjectValidity(trigger.activity.mProvenance + "/" + fullPath, filterMetadata);
-  if (objectValidity.isValid()) {
-    objectTimestamp = objectValidity.getMax() - 1;
-  } else {
+  if (!mo) {
     ILOG(Warning, Devel) << "Could not find the object '" << fullPath << "' for activity " << trigger.activity << ENDM;
     return { nullptr, false };
   }
 
-  auto [success, path, name] = o2::quality_control::core::RepoPathUtils::splitObjectPath(fullPath);
-  if (!success) {
-    return { nullptr, false };
-  }
-  // retrieve QO from CCDB - do not associate to trigger activity if ignoreActivity is true
-  auto qo = qcdb.retrieveMO(path, name, objectTimestamp, trigger.activity);
-  if (!qo) {
-    return { nullptr, false };
-  }
-
+  // the time-stamp of the most recent object matching the current activity
+  long objectTimestamp = mo->getValidity().getMax() - 1;
   long elapsed = static_cast<long>(trigger.timestamp) - objectTimestamp;
   // check if the object is not older than a given number of milliseconds
   if (elapsed > notOlderThan) {
     ILOG(Warning, Devel) << "Object '" << fullPath << "' for activity " << trigger.activity << " is too old: " << elapsed << " > " << notOlderThan << ENDM;
-    return { qo, false };
+    return { mo, false };
   }
 
-  return { qo, true };
+  return { mo, true };
 }
 
 //_________________________________________________________________________________________
@@ -169,34 +154,50 @@ void ReferenceComparatorTask::update(quality_control::postprocessing::Trigger tr
 {
   auto& qcdb = services.get<repository::DatabaseInterface>();
 
+  // retrieve the most recent objects matching the current activity, all at once
+  std::vector<repository::DatabaseInterface::RetrievalRequest> requests;
+  std::vector<const std::string*> requestedPlotNames;
   for (auto& [groupName, plotVec] : mPlotNames) {
     for (auto& plotName : plotVec) {
-      // get object for current timestamp - age limit is converted to milliseconds
-      auto object = getMO(qcdb, plotName, trigger, mNotOlderThan * 1000);
-
-      // skip objects that are not found or too old
-      if (!object.first || !object.second) {
+      auto [success, path, name] = o2::quality_control::core::RepoPathUtils::splitObjectPath(plotName);
+      if (!success) {
+        ILOG(Warning, Support) << "Could not split the path of the object '" << plotName << "', skipping it" << ENDM;
         continue;
       }
+      requests.push_back({ repository::DatabaseInterface::RetrievalRequest::Type::MonitorObject, path, name,
+                           repository::DatabaseInterface::Timestamp::Latest, trigger.activity });
+      requestedPlotNames.push_back(&plotName);
+    }
+  }
+  auto results = qcdb.retrieveMany(requests);
 
-      // only process objects inheriting from TH1
-      auto* histogram = dynamic_cast<TH1*>(object.first->getObject());
-      if (!histogram) {
-        continue;
-      }
+  for (size_t i = 0; i < requestedPlotNames.size(); i++) {
+    const auto& plotName = *requestedPlotNames[i];
+    // check the object for current timestamp - age limit is converted to milliseconds
+    auto object = checkMO(results[i].monitorObject, plotName, trigger, mNotOlderThan * 1000);
 
-      // check if a corresponding output plot was initialized
-      auto iter = mHistograms.find(plotName);
-      if (iter == mHistograms.end()) {
-        continue;
-      }
+    // skip objects that are not found or too old
+    if (!object.first || !object.second) {
+      continue;
+    }
 
-      // update the plot ratios and the histograms with superimposed reference
-      auto referenceMO = mReferencePlots[plotName];
-      TH1* referenceHistogram = dynamic_cast<TH1*>(referenceMO->getObject());
+    // only process objects inheriting from TH1
+    auto* histogram = dynamic_cast<TH1*>(object.first->getObject());
+    if (!histogram) {
+      continue;
+    }
 
-      iter->second->update(histogram, referenceHistogram);
+    // check if a corresponding output plot was initialized
+    auto iter = mHistograms.find(plotName);
+    if (iter == mHistograms.end()) {
+      continue;
     }
+
+    // update the plot ratios and the histograms with superimposed reference
+    auto referenceMO = mReferencePlots[plotName];
+    TH1* referenceHistogram = dynamic_cast<TH1*>(referenceMO->getObject());
+
+    iter->second->update(histogram, referenceHistogram);
   }
 }
 
@@ -0,0 +1,178 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   RollingStatistics.cxx
+///
+
+#include "Common/RollingStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace o2::quality_control_modules::common
+{
+
+void RollingStatistics::reset(bool useErrors)
+{
+  *this = RollingStatistics(useErrors);
+}
+
+void RollingStatistics::add(double value, double error)
+{
+  mN++;
+  if (!mUseErrors) {
+    double delta = value - mMean;
+    mMean += delta / mN;
+    mSumSquaredDeviations += delta * (value - mMean);
+  } else {
+    double weight = 1. / (error * error);
+    mSumOfWeights += weight;
+    mSumOfSquaredWeights += weight * weight;
+    mWeightedSum += weight * value;
+    mWeightedSumOfSquares += weight * value * value;
+  }
+}
+
+void RollingStatistics::remove(double value, double error)
+{
+  if (mN <= 1) {
+    // the sums of an empty set are exactly zero, no need to carry the rounding errors of the subtraction
+    clear();
+    return;
+  }
+  mN--;
+  if (!mUseErrors) {
+    double delta = value - mMean;
+    mMean -= delta / mN;
+    mSumSquaredDeviations = std::max(0., mSumSquaredDeviations - delta * (value - mMean));
+  } else {
+    double weight = 1. / (error * error);
+    mSumOfWeights -= weight;
+    mSumOfSquaredWeights -= weight * weight;
+    mWeightedSum -= weight * value;
+    mWeightedSumOfSquares -= weight * value * value;
+  }
+}
+
+void RollingStatistics::add(const double* values, const double* errors, int firstPoint, int lastPoint, const std::vector<int>& maskedPoints)
+{
+  if (lastPoint <= firstPoint) {
+    return;
+  }
+  std::vector<bool> masked;
+  if (!maskedPoints.empty()) {
+    masked.resize(lastPoint - firstPoint, false);
+    for (auto point : maskedPoints) {
+      if (point >= 0 && point < lastPoint - firstPoint) {
+        masked[point] = true;
+      }
+    }
+  }
+  for (int point = firstPoint; point < lastPoint; point++) {
+    if (!masked.empty() && masked[point - firstPoint]) {
+      continue;
+    }
+    add(values[point], errors ? errors[point] : 0.);
+  }
+}
+
+double RollingStatistics::getMean() const
+{
+  if (mN == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  return mUseErrors ? mWeightedSum / mSumOfWeights : mMean;
+}
+
+double RollingStatistics::getStdDevOfMean() const
+{
+  if (mN == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (mN == 1) { // we only have one point, we keep its uncertainty
+    return mUseErrors ? std::sqrt(1. / mSumOfWeights) : 0.;
+  }
+  if (!mUseErrors) {
+    return std::sqrt(mSumSquaredDeviations / (mN * (mN - 1.)));
+  }
+  double mean = mWeightedSum / mSumOfWeights;
+  double ratioSumWeight = mSumOfSquaredWeights / (mSumOfWeights * mSumOfWeights);
+  // the difference can end up slightly below zero for points with the same value
+  double variance = std::max(0., mWeightedSumOfSquares / mSumOfWeights - mean * mean);
+  return std::sqrt(variance * (1. / (1. - ratioSumWeight)) * ratioSumWeight);
+}
+
+bool SlidingWindowStatistics::setSeries(const double* xs, const double* values, const double* errors, int nPoints, bool useErrors)
+{
+  useErrors = useErrors && errors != nullptr;
+  mXs = xs;
+  mValues = values;
+  mErrors = useErrors ? errors : nullptr;
+  mNPoints = nPoints;
+
+  // checking all the points would cost as much as computing the statistics again,
+  // the first and the last ones are enough to notice that the series was shifted or replaced, since the x coordinates increase
+  auto isSame = [this](const Point& point, int index) { return point.x == mXs[index] && point.value == mValues[index] && point.error == getError(index); };
+  bool samePoints = useErrors == mStatistics.usesErrors() && mLastPoint <= nPoints &&
+                    (mPoints.empty() || (isSame(mPoints.front(), mFirstPoint) && isSame(mPoints.back(), mLastPoint - 1)));
+  if (!samePoints) {
+    mStatistics.reset(useErrors);
+    reset();
+  }
+  return samePoints;
+}
+
+const RollingStatistics& SlidingWindowStatistics::moveTo(int firstPoint, int lastPoint)
+{
+  firstPoint = std::clamp(firstPoint, 0, mNPoints);
+  lastPoint = std::clamp(lastPoint, firstPoint, mNPoints);
+
+  if (firstPoint < mFirstPoint || lastPoint < mLastPoint || firstPoint >= mLastPoint) {
+    // no common point with the current window or moving backwards, we start again
+    reset();
+    mFirstPoint = mLastPoint = firstPoint;
+  }
+  for (; mFirstPoint < firstPoint; mFirstPoint++) {
+    mStatistics.remove(mPoints.front().value, mPoints.front().error);
+    mPoints.pop_front();
+    mRemovedSinceRebuild++;
+  }
+  for (; mLastPoint < lastPoint; mLastPoint++) {
+    const auto& point = mPoints.emplace_back(Point{ mXs[mLastPoint], mValues[mLastPoint], getError(mLastPoint) });
+    mStatistics.add(point.value, point.error);
+  }
+  if (mRemovedSinceRebuild > 0 && mRemovedSinceRebuild >= mPoints.size()) {
+    rebuild();
+  }
+  return mStatistics;
+}
+
+void SlidingWindowStatistics::reset()
+{
+  mStatistics.clear();
+  mPoints.clear();
+  mFirstPoint = 0;
+  mLastPoint = 0;
+  mRemovedSinceRebuild = 0;
+}
+
+void SlidingWindowStatistics::rebuild()
+{
+  mStatistics.clear();
+  for (const auto& point : mPoints) {
+    mStatistics.add(point.value, point.error);
+  }
+  mRemovedSinceRebuild = 0;
+}
+
+} // namespace o2::quality_control_modules::common
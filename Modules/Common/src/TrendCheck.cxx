@@ -124,6 +124,7 @@ void TrendCheck::endOfActivity(const Activity& activity)
   mThresholdsTrendBad.clear();
   mThresholdsTrendMedium.clear();
   mQualities.clear();
+  mAverageWindows.clear();
 }
 
 static std::string getBaseName(std::string name)
@@ -134,7 +135,8 @@ static std::string getBaseName(std::string name)
 
 // compute the mean and standard deviation from a given number of points bewfore the last one
 // all points are used if nPointsForAverage <= 0
-static std::optional<std::pair<double, double>> getGraphStatistics(TGraph* graph, int nPointsForAverage)
+// the window of the previous call is moved forward, so that only the new points are processed
+static std::optional<std::pair<double, double>> getGraphStatistics(TGraph* graph, int nPointsForAverage, SlidingWindowStatistics& window)
 {
   std::optional<std::pair<double, double>> result;
 
@@ -154,23 +156,11 @@ static std::optional<std::pair<double, double>> getGraphStatistics(TGraph* graph
     return result;
   }
 
-  // compute the mean of the points
-  double mean = 0;
-  for (int pointIndex = pointIndexMin; pointIndex <= pointIndexMax; pointIndex++) {
-    mean += graph->GetPointY(pointIndex);
-  }
-  mean /= nPointsForStats;
-
-  // compute the standard deviation of the points
-  double stdDev = 0;
-  for (int pointIndex = pointIndexMin; pointIndex <= pointIndexMax; pointIndex++) {
-    double delta = graph->GetPointY(pointIndex) - mean;
-    stdDev += delta * delta;
-  }
-  stdDev /= (nPointsForStats - 1) * nPointsForStats;
-  stdDev = std::sqrt(stdDev);
+  // compute the mean and the standard deviation of the mean of the points
+  window.setSeries(graph->GetX(), graph->GetY(), nullptr, nPoints, false);
+  const auto& statistics = window.moveTo(pointIndexMin, pointIndexMax + 1);
 
-  result = std::make_pair(mean, stdDev);
+  result = std::make_pair(statistics.getMean(), statistics.getStdDevOfMean());
   return result;
 }
 
@@ -183,8 +173,9 @@ double TrendCheck::getInteractionRate()
 ///
 /// \param key string identifying some plot-specific threshold values
 /// \param graph the graph object to be checked
+/// \param window the window of points used for the average of this graph, moved forward from the previous check
 /// \return an array of optional (min,max) threshold values for Bad and Medium qualities
-std::array<std::optional<std::pair<double, double>>, 2> TrendCheck::getThresholds(std::string plotName, TGraph* graph)
+std::array<std::optional<std::pair<double, double>>, 2> TrendCheck::getThresholds(std::string plotName, TGraph* graph, SlidingWindowStatistics& window)
 {
   double rate = getInteractionRate();
   std::array<std::optional<std::pair<double, double>>, 2> result = mThresholds->getThresholdsForPlot(plotName, rate);
@@ -195,7 +186,7 @@ std::array<std::optional<std::pair<double, double>>, 2> TrendCheck::getThreshold
 
   if (mTrendCheckMode != ExpectedRange) {
     // the thresholds retrieved from the configuration need to be converted into absolute values
-    auto graphStatistics = getGraphStatistics(graph, mNPointsForAverage);
+    auto graphStatistics = getGraphStatistics(graph, mNPointsForAverage, window);
     if (!graphStatistics) {
       result[0].reset();
       result[1].reset();
@@ -317,7 +308,7 @@ Quality TrendCheck::check(std::map<std::string, std::shared_ptr<MonitorObject>>*
       double value = graph->GetPointY(nPoints - 1);
 
       // get acceptable range for the current plot
-      auto thresholds = getThresholds(key, graph);
+      auto thresholds = getThresholds(key, graph, mAverageWindows[graphName]);
       // check that at least the thresholds for Bad quality are available
       if (!thresholds[0]) {
         continue;
@@ -18,6 +18,8 @@
 #include "Common/TH1Ratio.h"
 #include "Common/TH2Ratio.h"
 
+#include <TBufferFile.h>
+
 #define BOOST_TEST_MODULE CommonHistRatios test
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
@@ -152,6 +154,61 @@ BOOST_AUTO_TEST_CASE(test_TH1FRatioClone)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_TH1FRatioLazy)
+{
+  auto histo1 = std::make_unique<TH1FRatio>("test1", "test1", 100, 0, 10.0, false);
+  auto histo2 = std::make_unique<TH1FRatio>("test2", "test2", 100, 0, 10.0, false);
+  auto histoLazy = std::make_unique<TH1FRatio>("testLazy", "testLazy", 100, 0, 10.0, false);
+  auto histoMerged = std::make_unique<TH1FRatio>("testMerged", "testMerged", 100, 0, 10.0, false);
+  histo1->setLazyRatio();
+  histo2->setLazyRatio();
+  histoLazy->setLazyRatio();
+
+  for (int bin = 1; bin <= 100; bin++) {
+    histo1->getNum()->SetBinContent(bin, bin * bin * 4);
+    histo1->getDen()->SetBinContent(bin, bin * 3);
+
+    histo2->getNum()->SetBinContent(bin, bin * bin * 5);
+    histo2->getDen()->SetBinContent(bin, bin * 4);
+  }
+
+  histo1->update();
+  histo2->update();
+  BOOST_REQUIRE_EQUAL(histo1->isRatioUpToDate(), false);
+  // the stale ratio has a single empty bin on the range of the numerator
+  BOOST_REQUIRE_EQUAL(histo1->GetNbinsX(), 1);
+  BOOST_REQUIRE_EQUAL(histo1->GetXaxis()->GetXmax(), 10.0);
+  BOOST_REQUIRE_EQUAL(histo1->GetBinContent(1), 0);
+
+  histoLazy->merge(histo1.get());
+  histoLazy->merge(histo2.get());
+  BOOST_REQUIRE_EQUAL(histoLazy->isRatioUpToDate(), false);
+
+  histo1->setLazyRatio(false);
+  histo2->setLazyRatio(false);
+  histoMerged->merge(histo1.get());
+  histoMerged->merge(histo2.get());
+
+  TBufferFile bufferLazy(TBuffer::kWrite);
+  bufferLazy.WriteObject(histoLazy.get());
+  TBufferFile bufferMerged(TBuffer::kWrite);
+  bufferMerged.WriteObject(histoMerged.get());
+  BOOST_CHECK_LT(bufferLazy.Length(), bufferMerged.Length());
+
+  // the state of the lazy ratio survives the serialization
+  std::unique_ptr<TH1FRatio> histoLazyClone((TH1FRatio*)histoLazy->Clone("testLazy_clone"));
+  BOOST_REQUIRE_EQUAL(histoLazyClone->hasLazyRatio(), true);
+  BOOST_REQUIRE_EQUAL(histoLazyClone->isRatioUpToDate(), false);
+
+  histoLazyClone->computeLazyContent();
+  BOOST_REQUIRE_EQUAL(histoLazyClone->isRatioUpToDate(), true);
+  BOOST_REQUIRE_EQUAL(histoLazyClone->GetNcells(), histoMerged->GetNcells());
+  for (int bin = 1; bin <= 100; bin++) {
+    BOOST_REQUIRE_EQUAL(histoLazyClone->GetBinContent(bin), histoMerged->GetBinContent(bin));
+    BOOST_REQUIRE_EQUAL(histoLazyClone->GetBinError(bin), histoMerged->GetBinError(bin));
+  }
+}
+
 BOOST_AUTO_TEST_CASE(test_TH2FRatioUniform)
 {
   auto histo1 = std::make_unique<TH2FRatio>("test1", "test1", 10, 0, 10.0, 10, 0, 10.0, true);
@@ -303,3 +360,39 @@ BOOST_AUTO_TEST_CASE(test_TH2FRatioClone)
     }
   }
 }
+
+BOOST_AUTO_TEST_CASE(test_TH2FRatioLazy)
+{
+  auto histo1 = std::make_unique<TH2FRatio>("test1", "test1", 10, 0, 10.0, 10, 0, 10.0, true);
+  auto histoLazy = std::make_unique<TH2FRatio>("testLazy", "testLazy", 10, 0, 10.0, 10, 0, 10.0, true);
+  auto histoMerged = std::make_unique<TH2FRatio>("testMerged", "testMerged", 10, 0, 10.0, 10, 0, 10.0, true);
+  histoLazy->setLazyRatio();
+
+  for (int ybin = 1; ybin <= 10; ybin++) {
+    for (int xbin = 1; xbin <= 10; xbin++) {
+      histo1->getNum()->SetBinContent(xbin, ybin, xbin * ybin * 4);
+    }
+  }
+  histo1->getDen()->SetBinContent(1, 1, 2);
+  histo1->update();
+
+  histoLazy->merge(histo1.get());
+  histoMerged->merge(histo1.get());
+  BOOST_REQUIRE_EQUAL(histoLazy->isRatioUpToDate(), false);
+  BOOST_REQUIRE_EQUAL(histoLazy->GetNcells(), 9);
+
+  TBufferFile bufferLazy(TBuffer::kWrite);
+  bufferLazy.WriteObject(histoLazy.get());
+  TBufferFile bufferMerged(TBuffer::kWrite);
+  bufferMerged.WriteObject(histoMerged.get());
+  BOOST_CHECK_LT(bufferLazy.Length(), bufferMerged.Length());
+
+  histoLazy->computeLazyContent();
+  BOOST_REQUIRE_EQUAL(histoLazy->isRatioUpToDate(), true);
+  BOOST_REQUIRE_EQUAL(histoLazy->GetNcells(), histoMerged->GetNcells());
+  for (int ybin = 1; ybin <= 10; ybin++) {
+    for (int xbin = 1; xbin <= 10; xbin++) {
+      BOOST_REQUIRE_EQUAL(histoLazy->GetBinContent(xbin, ybin), histoMerged->GetBinContent(xbin, ybin));
+    }
+  }
+}
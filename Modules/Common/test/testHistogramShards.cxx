@@ -0,0 +1,113 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testHistogramShards.cxx
+///
+
+#include "Common/HistogramShards.h"
+
+#include <TH1D.h>
+#include <TH2D.h>
+#include <thread>
+
+#define BOOST_TEST_MODULE HistogramShards test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control_modules::common;
+
+BOOST_AUTO_TEST_CASE(test_HistogramShards1D)
+{
+  TH1D reference("reference", "reference", 20, -10, 10);
+  TH1D sharded("sharded", "sharded", 20, -10, 10);
+  reference.SetDirectory(nullptr);
+  sharded.SetDirectory(nullptr);
+
+  const size_t nThreads = 4;
+  HistogramShards shards(nThreads);
+  shards.add(&sharded);
+  BOOST_CHECK(shards.contains(&sharded));
+  BOOST_CHECK(!shards.contains(&reference));
+
+  // values include under- and overflows
+  for (int i = 0; i < 1000; i++) {
+    reference.Fill(i % 25 - 12.5);
+  }
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nThreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (size_t i = t; i < 1000; i += nThreads) {
+        shards.fill(t, &sharded, static_cast<int>(i) % 25 - 12.5);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // nothing is published before merging
+  BOOST_CHECK_EQUAL(sharded.GetEntries(), 0);
+  shards.merge();
+
+  for (int bin = 0; bin <= sharded.GetNbinsX() + 1; bin++) {
+    BOOST_CHECK_EQUAL(sharded.GetBinContent(bin), reference.GetBinContent(bin));
+  }
+  BOOST_CHECK_EQUAL(sharded.GetEntries(), reference.GetEntries());
+  BOOST_CHECK_CLOSE(sharded.GetMean(), reference.GetMean(), 1e-9);
+  BOOST_CHECK_CLOSE(sharded.GetStdDev(), reference.GetStdDev(), 1e-9);
+
+  // the shards are emptied after merging
+  shards.merge();
+  BOOST_CHECK_EQUAL(sharded.GetEntries(), reference.GetEntries());
+}
+
+BOOST_AUTO_TEST_CASE(test_HistogramShards2DWeighted)
+{
+  TH2D reference("reference2d", "reference2d", 10, 0, 10, 5, 0, 5);
+  TH2D sharded("sharded2d", "sharded2d", 10, 0, 10, 5, 0, 5);
+  reference.SetDirectory(nullptr);
+  sharded.SetDirectory(nullptr);
+
+  HistogramShards shards(2);
+  shards.add(&sharded);
+
+  for (int i = 0; i < 100; i++) {
+    double x = i % 10 + 0.5, y = i % 5 + 0.5, w = 1 + i % 3;
+    reference.Fill(x, y, w);
+    shards.fill(i % 2, &sharded, x, y, w);
+  }
+  shards.merge();
+
+  BOOST_REQUIRE(sharded.GetSumw2N() > 0);
+  for (int bin = 0; bin < sharded.GetNcells(); bin++) {
+    BOOST_CHECK_EQUAL(sharded.GetBinContent(bin), reference.GetBinContent(bin));
+    BOOST_CHECK_EQUAL(sharded.GetBinError(bin), reference.GetBinError(bin));
+  }
+  BOOST_CHECK_EQUAL(sharded.GetEntries(), reference.GetEntries());
+  BOOST_CHECK_CLOSE(sharded.GetMean(1), reference.GetMean(1), 1e-9);
+  BOOST_CHECK_CLOSE(sharded.GetMean(2), reference.GetMean(2), 1e-9);
+  BOOST_CHECK_CLOSE(sharded.GetCorrelationFactor(), reference.GetCorrelationFactor(), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(test_HistogramShardsUnsupported)
+{
+  HistogramShards shards(2);
+  TH1D extendable("extendable", "extendable", 10, 0, 10);
+  extendable.SetDirectory(nullptr);
+  extendable.SetCanExtend(TH1::kAllAxes);
+  BOOST_CHECK_THROW(shards.add(&extendable), std::invalid_argument);
+
+  TH1D notRegistered("notRegistered", "notRegistered", 10, 0, 10);
+  notRegistered.SetDirectory(nullptr);
+  BOOST_CHECK_THROW(shards.fill(0, &notRegistered, 1), std::out_of_range);
+}
@@ -0,0 +1,211 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file    testRollingStatistics.cxx
+///
+
+#include "Common/RollingStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#define BOOST_TEST_MODULE RollingStatistics test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control_modules::common;
+
+namespace
+{
+
+// the two-pass computation of the points [firstPoint, lastPoint), as the trending checks were doing before
+std::pair<double, double> computeTwoPass(const std::vector<double>& values, const std::vector<double>& errors, bool useErrors, int firstPoint, int lastPoint)
+{
+  const int n = lastPoint - firstPoint;
+  double sum = 0., sumSquare = 0., sumOfWeights = 0., sumOfSquaredWeights = 0.;
+  for (int i = firstPoint; i < lastPoint; i++) {
+    double weight = useErrors ? 1. / std::pow(errors[i], 2.) : 1.;
+    sum += values[i] * weight;
+    sumSquare += values[i] * values[i] * weight;
+    sumOfWeights += weight;
+    sumOfSquaredWeights += weight * weight;
+  }
+  double mean = sum / sumOfWeights;
+  if (n == 1) {
+    return { mean, useErrors ? std::sqrt(1. / sumOfWeights) : 0. };
+  }
+  if (!useErrors) {
+    double squaredDeviations = 0.;
+    for (int i = firstPoint; i < lastPoint; i++) {
+      squaredDeviations += (values[i] - mean) * (values[i] - mean);
+    }
+    return { mean, std::sqrt(squaredDeviations / (n * (n - 1.))) };
+  }
+  double ratioSumWeight = sumOfSquaredWeights / (sumOfWeights * sumOfWeights);
+  return { mean, std::sqrt((sumSquare / sumOfWeights - mean * mean) * (1. / (1. - ratioSumWeight)) * ratioSumWeight) };
+}
+
+void checkSame(const RollingStatistics& statistics, const std::pair<double, double>& expected)
+{
+  BOOST_CHECK_CLOSE(statistics.getMean(), expected.first, 1e-7);
+  BOOST_CHECK_SMALL(statistics.getStdDevOfMean() - expected.second, 1e-7 * (1. + expected.second));
+}
+
+// the points get increasing timestamps, as in a trending graph
+void fillSeries(std::mt19937& generator, size_t nPoints, std::vector<double>& xs, std::vector<double>& values, std::vector<double>& errors)
+{
+  std::normal_distribution<double> valueDistribution(100., 5.);
+  std::uniform_real_distribution<double> errorDistribution(0.5, 3.);
+  for (size_t i = 0; i < nPoints; i++) {
+    xs.push_back(xs.empty() ? 1000. : xs.back() + 60.);
+    values.push_back(valueDistribution(generator));
+    errors.push_back(errorDistribution(generator));
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_RollingStatisticsAddRemove)
+{
+  RollingStatistics statistics;
+  BOOST_CHECK_EQUAL(statistics.getN(), 0);
+  BOOST_CHECK(std::isnan(statistics.getMean()));
+  BOOST_CHECK(std::isnan(statistics.getStdDevOfMean()));
+
+  statistics.add(2.);
+  BOOST_CHECK_EQUAL(statistics.getMean(), 2.);
+  BOOST_CHECK_EQUAL(statistics.getStdDevOfMean(), 0.);
+
+  statistics.add(4.);
+  statistics.add(6.);
+  BOOST_CHECK_CLOSE(statistics.getMean(), 4., 1e-9);
+  BOOST_CHECK_CLOSE(statistics.getStdDevOfMean(), std::sqrt(8. / 6.), 1e-9);
+
+  statistics.remove(2.);
+  BOOST_CHECK_EQUAL(statistics.getN(), 2);
+  BOOST_CHECK_CLOSE(statistics.getMean(), 5., 1e-9);
+  BOOST_CHECK_CLOSE(statistics.getStdDevOfMean(), 1., 1e-9);
+
+  statistics.remove(4.);
+  statistics.remove(6.);
+  BOOST_CHECK_EQUAL(statistics.getN(), 0);
+  BOOST_CHECK(std::isnan(statistics.getMean()));
+
+  RollingStatistics weighted(true);
+  weighted.add(3., 2.);
+  BOOST_CHECK_EQUAL(weighted.getMean(), 3.);
+  BOOST_CHECK_CLOSE(weighted.getStdDevOfMean(), 2., 1e-9);
+  // points with the same value do not end up with a NaN because of the rounding
+  weighted.add(3., 1.);
+  weighted.add(3., 0.7);
+  BOOST_CHECK_CLOSE(weighted.getMean(), 3., 1e-9);
+  BOOST_CHECK_SMALL(weighted.getStdDevOfMean(), 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(test_RollingStatisticsMask)
+{
+  std::vector<double> values{ 1., 2., 3., 100., 5., 200. };
+  std::vector<double> errors{ 1., 1., 1., 1., 1., 1. };
+
+  RollingStatistics statistics;
+  // the masked points are counted from the first point
+  statistics.add(values.data(), nullptr, 1, 6, { 2, 4, 10 });
+  BOOST_CHECK_EQUAL(statistics.getN(), 3);
+  checkSame(statistics, computeTwoPass({ 2., 3., 5. }, {}, false, 0, 3));
+
+  RollingStatistics weighted(true);
+  weighted.add(values.data(), errors.data(), 0, 6, { 3, 5 });
+  BOOST_CHECK_EQUAL(weighted.getN(), 4);
+  checkSame(weighted, computeTwoPass({ 1., 2., 3., 5. }, { 1., 1., 1., 1. }, true, 0, 4));
+}
+
+BOOST_AUTO_TEST_CASE(test_SlidingWindowStatistics)
+{
+  std::mt19937 generator(42);
+  std::vector<double> xs;
+  std::vector<double> values;
+  std::vector<double> errors;
+  fillSeries(generator, 5000, xs, values, errors);
+  const int nPoints = values.size();
+
+  for (bool useErrors : { false, true }) {
+    for (int windowSize : { 1, 2, 10, 100 }) {
+      // the window follows the points of a trending graph, as the band of CheckOfTrendings
+      SlidingWindowStatistics window;
+      window.setSeries(xs.data(), values.data(), errors.data(), nPoints, useErrors);
+      for (int lastPoint = 1; lastPoint < nPoints; lastPoint++) {
+        int firstPoint = std::max(0, lastPoint - windowSize);
+        const auto& statistics = window.moveTo(firstPoint, lastPoint);
+        BOOST_REQUIRE_EQUAL(statistics.getN(), lastPoint - firstPoint);
+        checkSame(statistics, computeTwoPass(values, errors, useErrors, firstPoint, lastPoint));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_SlidingWindowStatisticsGrowingGraph)
+{
+  std::mt19937 generator(7);
+  std::vector<double> xs;
+  std::vector<double> values;
+  std::vector<double> errors;
+  fillSeries(generator, 20, xs, values, errors);
+  const int windowSize = 10;
+
+  // the graph grows by one point at each check, the window is kept
+  SlidingWindowStatistics window;
+  window.setSeries(xs.data(), values.data(), errors.data(), values.size(), true);
+  window.moveTo(values.size() - windowSize, values.size());
+  for (int check = 0; check < 50; check++) {
+    fillSeries(generator, 1, xs, values, errors);
+    const int nPoints = values.size();
+    BOOST_CHECK(window.setSeries(xs.data(), values.data(), errors.data(), nPoints, true));
+    checkSame(window.moveTo(nPoints - windowSize, nPoints), computeTwoPass(values, errors, true, nPoints - windowSize, nPoints));
+  }
+
+  // the oldest point is dropped, all the points move by one
+  xs.erase(xs.begin());
+  values.erase(values.begin());
+  errors.erase(errors.begin());
+  int nPoints = values.size();
+  BOOST_CHECK(!window.setSeries(xs.data(), values.data(), errors.data(), nPoints, true));
+  checkSame(window.moveTo(nPoints - windowSize, nPoints), computeTwoPass(values, errors, true, nPoints - windowSize, nPoints));
+
+  // the errors are not used anymore
+  BOOST_CHECK(!window.setSeries(xs.data(), values.data(), errors.data(), nPoints, false));
+  checkSame(window.moveTo(nPoints - windowSize, nPoints), computeTwoPass(values, errors, false, nPoints - windowSize, nPoints));
+
+  // the window moves backwards
+  checkSame(window.moveTo(3, 8), computeTwoPass(values, errors, false, 3, 8));
+  // and jumps forward
+  checkSame(window.moveTo(30, 35), computeTwoPass(values, errors, false, 30, 35));
+}
+
+BOOST_AUTO_TEST_CASE(test_SlidingWindowStatisticsSameValues)
+{
+  // a trend with a constant value, the values alone do not tell that the oldest point was dropped
+  std::vector<double> xs{ 10., 20., 30., 40., 50., 60. };
+  std::vector<double> values(xs.size(), 5.);
+
+  SlidingWindowStatistics window;
+  window.setSeries(xs.data(), values.data(), nullptr, xs.size(), false);
+  window.moveTo(2, 6);
+  BOOST_CHECK(window.setSeries(xs.data(), values.data(), nullptr, xs.size(), false));
+
+  xs.erase(xs.begin());
+  xs.push_back(70.);
+  BOOST_CHECK(!window.setSeries(xs.data(), values.data(), nullptr, xs.size(), false));
+  BOOST_CHECK_EQUAL(window.moveTo(2, 6).getN(), 4);
+}
@@ -24,6 +24,7 @@
 #include "CommonDataFormat/RangeReference.h"
 #include "Headers/DataHeader.h"
 #include "DataFormatsEMCAL/TriggerRecord.h"
+#include "EMCAL/EventCombiner.h"
 #include "QualityControl/PostProcessingInterface.h"
 
 class TH1;
@@ -163,35 +164,10 @@ class CellTask final : public TaskInterface
   std::string getConfigValueLower(const std::string_view key);
 
  private:
-  struct SubEvent {
-    header::DataHeader::SubSpecificationType mSpecification;
-    dataformats::RangeReference<int, int> mCellRange;
-  };
-
-  struct CombinedEvent {
-    InteractionRecord mInteractionRecord;
-    uint32_t mTriggerType;
-    std::vector<SubEvent> mSubevents;
-
-    [[nodiscard]] int getNumberOfObjects() const
-    {
-      int nObjects = 0;
-      for (auto ev : mSubevents) {
-        nObjects += ev.mCellRange.getEntries();
-      }
-      return nObjects;
-    }
-
-    int getNumberOfSubevents()
-    {
-      return mSubevents.size();
-    };
-  };
   void parseMultiplicityRanges();
   void initDefaultMultiplicityRanges();
   void loadCalibrationObjects(o2::framework::ProcessingContext& ctx);
 
-  [[nodiscard]] std::vector<CombinedEvent> buildCombinedEvents(const std::unordered_map<header::DataHeader::SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>>& triggerrecords) const;
   TaskSettings mTaskSettings;                                      ///< Settings of the task steered via task parameters
   Bool_t mIgnoreTriggerTypes = false;                              ///< Do not differenciate between trigger types, treat all triggers as phys. triggers
   std::map<std::string, CellHistograms> mHistogramContainer;       ///< Container with histograms per trigger class
@@ -200,6 +176,7 @@ class CellTask final : public TaskInterface
   const o2::emcal::TimeCalibrationParams* mTimeCalib = nullptr;    ///< EMCAL time calib
   const o2::emcal::GainCalibrationFactors* mEnergyCalib = nullptr; ///< EMCAL energy calibration
   int mTimeFramesPerCycles = 0;                                    ///< TF per cycles
+  EventCombiner mEventCombiner;                                    //!< Combination of the subevents from the different FLPs
 
   TH1* mEvCounterTF = nullptr;      ///< Number of Events per timeframe
   TH1* mEvCounterTFPHYS = nullptr;  ///< Number of Events per timeframe per PHYS
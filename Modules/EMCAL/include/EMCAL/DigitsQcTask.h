@@ -28,6 +28,7 @@
 #include "CommonDataFormat/RangeReference.h"
 #include "Headers/DataHeader.h"
 #include "DataFormatsEMCAL/TriggerRecord.h"
+#include "EMCAL/EventCombiner.h"
 
 class TH1;
 class TH2;
@@ -124,37 +125,13 @@ class DigitsQcTask final : public TaskInterface
   std::string getConfigValueLower(const std::string_view key);
 
  private:
-  struct SubEvent {
-    header::DataHeader::SubSpecificationType mSpecification;
-    dataformats::RangeReference<int, int> mCellRange;
-  };
-
-  struct CombinedEvent {
-    InteractionRecord mInteractionRecord;
-    uint32_t mTriggerType;
-    std::vector<SubEvent> mSubevents;
-
-    int getNumberOfObjects() const
-    {
-      int nObjects = 0;
-      for (auto ev : mSubevents) {
-        nObjects += ev.mCellRange.getEntries();
-      }
-      return nObjects;
-    }
-
-    int getNumberOfSubevents()
-    {
-      return mSubevents.size();
-    };
-  };
-  std::vector<CombinedEvent> buildCombinedEvents(const std::unordered_map<header::DataHeader::SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>>& triggerrecords) const;
   Bool_t mIgnoreTriggerTypes = false;                          ///< Do not differenciate between trigger types, treat all triggers as phys. triggers
   std::map<std::string, DigitsHistograms> mHistogramContainer; ///< Container with histograms per trigger class
   o2::emcal::Geometry* mGeometry = nullptr;                    ///< EMCAL geometry
   o2::emcal::BadChannelMap* mBadChannelMap;                    ///< EMCAL channel map
   o2::emcal::TimeCalibrationParams* mTimeCalib;                ///< EMCAL time calib
   int mTimeFramesPerCycles = 0;                                ///< TF per cycles
+  EventCombiner mEventCombiner;                                //!< Combination of the subevents from the different FLPs
 };
 
 } // namespace emcal
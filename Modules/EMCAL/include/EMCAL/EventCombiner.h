@@ -0,0 +1,91 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef QC_MODULE_EMCAL_EVENTCOMBINER_H
+#define QC_MODULE_EMCAL_EVENTCOMBINER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <gsl/span>
+#include "CommonDataFormat/InteractionRecord.h"
+#include "CommonDataFormat/RangeReference.h"
+#include "Headers/DataHeader.h"
+#include "DataFormatsEMCAL/TriggerRecord.h"
+
+namespace o2::quality_control_modules::emcal
+{
+
+/// \class EventCombiner
+/// \brief Combines the subevents sent by the EMCAL FLPs for the same interaction into one event
+/// \ingroup EMCALQCTasks
+///
+/// The trigger records of each subspecification are sorted by interaction record, so the events are
+/// obtained with a k-way merge of the trigger record spans, in a single pass over all the records.
+/// The memory of the events is reused from one timeframe to the next one.
+///
+/// The result is the same as searching each interaction record in all the spans:
+/// - events are ordered by interaction record,
+/// - subevents are ordered as the subspecifications in the input map,
+/// - the trigger type of an event is the one of its first subevent,
+/// - if a span contains several records with the same interaction record, only the first one is used.
+/// Spans which are not sorted are sorted on a copy first, keeping the order of records with the same interaction record.
+class EventCombiner
+{
+ public:
+  using TriggerRecordSubevents = std::unordered_map<header::DataHeader::SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>>;
+
+  struct SubEvent {
+    header::DataHeader::SubSpecificationType mSpecification;
+    dataformats::RangeReference<int, int> mCellRange;
+  };
+
+  struct CombinedEvent {
+    InteractionRecord mInteractionRecord;
+    uint32_t mTriggerType;
+    gsl::span<const SubEvent> mSubevents;
+
+    [[nodiscard]] int getNumberOfObjects() const
+    {
+      int nObjects = 0;
+      for (const auto& ev : mSubevents) {
+        nObjects += ev.mCellRange.getEntries();
+      }
+      return nObjects;
+    }
+
+    [[nodiscard]] int getNumberOfSubevents() const
+    {
+      return mSubevents.size();
+    };
+  };
+
+  /// \brief Combine the subevents of a timeframe
+  /// \param triggerrecords Trigger records per subspecification
+  /// \return Combined events, valid until the next call
+  const std::vector<CombinedEvent>& combine(const TriggerRecordSubevents& triggerrecords);
+
+ private:
+  struct Cursor {
+    header::DataHeader::SubSpecificationType mSpecification;
+    gsl::span<const o2::emcal::TriggerRecord> mRecords;
+    size_t mPosition;
+  };
+
+  std::vector<Cursor> mCursors;
+  std::vector<std::vector<o2::emcal::TriggerRecord>> mSortedCopies;
+  std::vector<SubEvent> mSubevents;
+  std::vector<CombinedEvent> mEvents;
+};
+
+} // namespace o2::quality_control_modules::emcal
+
+#endif // QC_MODULE_EMCAL_EVENTCOMBINER_H
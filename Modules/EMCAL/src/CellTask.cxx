@@ -39,7 +39,6 @@
 #include <Framework/InputRecordWalker.h>
 #include <CommonConstants/Triggers.h>
 #include "EMCAL/DrawGridlines.h"
-#include <set>
 
 namespace o2::quality_control_modules::emcal
 {
@@ -397,7 +396,7 @@ void CellTask::monitorData(o2::framework::ProcessingContext& ctx)
     triggerRecordSubevents[subspecification] = ctx.inputs().get<gsl::span<o2::emcal::TriggerRecord>>(trgrecorddata);
   }
 
-  auto combinedEvents = buildCombinedEvents(triggerRecordSubevents);
+  const auto& combinedEvents = mEventCombiner.combine(triggerRecordSubevents);
 
   //  ILOG(Info, Support) <<"Received " << cellcontainer.size() << " cells " << ENDM;
   int eventcounter = 0;
@@ -410,7 +409,7 @@ void CellTask::monitorData(o2::framework::ProcessingContext& ctx)
   std::array<double, 20> totalEnergies;
   std::fill(numCellsSM.begin(), numCellsSM.end(), 0);
   std::fill(numCellsSM_Thres.begin(), numCellsSM_Thres.end(), 0);
-  for (auto trg : combinedEvents) {
+  for (const auto& trg : combinedEvents) {
     if (!trg.getNumberOfObjects()) {
       continue;
     }
@@ -726,45 +725,6 @@ void CellTask::parseMultiplicityRanges()
   }
 }
 
-std::vector<CellTask::CombinedEvent> CellTask::buildCombinedEvents(const std::unordered_map<header::DataHeader::SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>>& triggerrecords) const
-{
-  std::vector<CellTask::CombinedEvent> events;
-
-  // Search interaction records from all subevents
-  std::set<o2::InteractionRecord> allInteractions;
-  for (auto& [subspecification, trgrec] : triggerrecords) {
-    for (auto rec : trgrec) {
-      auto eventIR = rec.getBCData();
-      if (allInteractions.find(eventIR) == allInteractions.end()) {
-        allInteractions.insert(eventIR);
-      }
-    }
-  }
-
-  // iterate over all subevents for all bunch crossings
-  for (auto collision : allInteractions) {
-    CombinedEvent nextevent;
-    nextevent.mInteractionRecord = collision;
-    bool first = true,
-         hasSubevent = false;
-    for (auto [subspecification, records] : triggerrecords) {
-      auto found = std::find_if(records.begin(), records.end(), [&collision](const o2::emcal::TriggerRecord& rec) { return rec.getBCData() == collision; });
-      if (found != records.end()) {
-        hasSubevent = true;
-        if (first) {
-          nextevent.mTriggerType = found->getTriggerBits();
-          first = false;
-        }
-        nextevent.mSubevents.push_back({ subspecification, o2::dataformats::RangeReference(found->getFirstEntry(), found->getNumberOfObjects()) });
-      }
-    }
-    if (hasSubevent) {
-      events.emplace_back(nextevent);
-    }
-  }
-  return events;
-}
-
 bool CellTask::hasConfigValue(const std::string_view key)
 {
   if (auto param = mCustomParameters.find(key.data()); param != mCustomParameters.end()) {
@@ -17,7 +17,6 @@
 #include <boost/algorithm/string.hpp>
 #include <algorithm>
 #include <iostream>
-#include <set>
 
 #include <TCanvas.h>
 #include <TH2.h>
@@ -207,7 +206,7 @@ void DigitsQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     triggerRecordSubevents[subspecification] = ctx.inputs().get<gsl::span<o2::emcal::TriggerRecord>>(trgrecorddata);
   }
 
-  auto combinedEvents = buildCombinedEvents(triggerRecordSubevents);
+  const auto& combinedEvents = mEventCombiner.combine(triggerRecordSubevents);
 
   //  ILOG(Info, Support) <<"Received " << digitcontainer.size() << " digits " << ENDM;
   int eventcounter = 0;
@@ -215,7 +214,7 @@ void DigitsQcTask::monitorData(o2::framework::ProcessingContext& ctx)
   int eventcounterPHYS = 0;
   std::array<int, 20> numDigitsSM;
   std::fill(numDigitsSM.begin(), numDigitsSM.end(), 0);
-  for (auto trg : combinedEvents) {
+  for (const auto& trg : combinedEvents) {
     if (!trg.getNumberOfObjects()) {
       continue;
     }
@@ -316,43 +315,6 @@ void DigitsQcTask::reset()
     mDigitsMaxSM->Reset();
 }
 
-std::vector<DigitsQcTask::CombinedEvent> DigitsQcTask::buildCombinedEvents(const std::unordered_map<header::DataHeader::SubSpecificationType, gsl::span<const o2::emcal::TriggerRecord>>& triggerrecords) const
-{
-  std::vector<DigitsQcTask::CombinedEvent> events;
-
-  // Search interaction records from all subevents
-  std::set<o2::InteractionRecord> allInteractions;
-  for (auto& [subspecification, trgrec] : triggerrecords) {
-    for (auto rec : trgrec) {
-      auto eventIR = rec.getBCData();
-      if (allInteractions.find(eventIR) == allInteractions.end())
-        allInteractions.insert(eventIR);
-    }
-  }
-
-  // iterate over all subevents for all bunch crossings
-  for (auto collision : allInteractions) {
-    CombinedEvent nextevent;
-    nextevent.mInteractionRecord = collision;
-    bool first = true,
-         hasSubevent = false;
-    for (auto [subspecification, records] : triggerrecords) {
-      auto found = std::find_if(records.begin(), records.end(), [&collision](const o2::emcal::TriggerRecord& rec) { return rec.getBCData() == collision; });
-      if (found != records.end()) {
-        hasSubevent = true;
-        if (first) {
-          nextevent.mTriggerType = found->getTriggerBits();
-          first = false;
-        }
-        nextevent.mSubevents.push_back({ subspecification, o2::dataformats::RangeReference(found->getFirstEntry(), found->getNumberOfObjects()) });
-      }
-    }
-    if (hasSubevent)
-      events.emplace_back(nextevent);
-  }
-  return events;
-}
-
 bool DigitsQcTask::hasConfigValue(const std::string_view key)
 {
   if (auto param = mCustomParameters.find(key.data()); param != mCustomParameters.end()) {
@@ -0,0 +1,89 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   EventCombiner.cxx
+///
+
+#include <algorithm>
+#include "EMCAL/EventCombiner.h"
+
+namespace o2::quality_control_modules::emcal
+{
+
+const std::vector<EventCombiner::CombinedEvent>& EventCombiner::combine(const TriggerRecordSubevents& triggerrecords)
+{
+  auto byInteraction = [](const o2::emcal::TriggerRecord& first, const o2::emcal::TriggerRecord& second) { return first.getBCData() < second.getBCData(); };
+
+  mEvents.clear();
+  mSubevents.clear();
+  mCursors.clear();
+  size_t nRecords = 0, nSortedCopies = 0;
+  for (const auto& [subspecification, records] : triggerrecords) {
+    if (records.empty()) {
+      continue;
+    }
+    gsl::span<const o2::emcal::TriggerRecord> sortedRecords = records;
+    if (!std::is_sorted(records.begin(), records.end(), byInteraction)) {
+      if (mSortedCopies.size() == nSortedCopies) {
+        mSortedCopies.emplace_back();
+      }
+      auto& copy = mSortedCopies[nSortedCopies++];
+      copy.assign(records.begin(), records.end());
+      std::stable_sort(copy.begin(), copy.end(), byInteraction);
+      sortedRecords = copy;
+    }
+    mCursors.push_back({ subspecification, sortedRecords, 0 });
+    nRecords += records.size();
+  }
+  // there are never more subevents than records, the spans of the events stay valid while filling
+  mSubevents.reserve(nRecords);
+
+  while (true) {
+    // the next interaction is the smallest one at the head of the spans, there are only a few tens of them
+    const InteractionRecord* next = nullptr;
+    for (const auto& cursor : mCursors) {
+      if (cursor.mPosition < cursor.mRecords.size()) {
+        const auto& interaction = cursor.mRecords[cursor.mPosition].getBCData();
+        if (next == nullptr || interaction < *next) {
+          next = &interaction;
+        }
+      }
+    }
+    if (next == nullptr) {
+      break;
+    }
+
+    CombinedEvent nextevent;
+    nextevent.mInteractionRecord = *next;
+    const auto firstSubevent = mSubevents.size();
+    for (auto& cursor : mCursors) {
+      auto& position = cursor.mPosition;
+      if (position == cursor.mRecords.size() || !(cursor.mRecords[position].getBCData() == nextevent.mInteractionRecord)) {
+        continue;
+      }
+      const auto& record = cursor.mRecords[position];
+      if (mSubevents.size() == firstSubevent) {
+        nextevent.mTriggerType = record.getTriggerBits();
+      }
+      mSubevents.push_back({ cursor.mSpecification, o2::dataformats::RangeReference(record.getFirstEntry(), record.getNumberOfObjects()) });
+      // further records of the same interaction in this subspecification are ignored
+      while (position < cursor.mRecords.size() && cursor.mRecords[position].getBCData() == nextevent.mInteractionRecord) {
+        position++;
+      }
+    }
+    nextevent.mSubevents = gsl::span<const SubEvent>(mSubevents.data() + firstSubevent, mSubevents.size() - firstSubevent);
+    mEvents.push_back(nextevent);
+  }
+  return mEvents;
+}
+
+} // namespace o2::quality_control_modules::emcal
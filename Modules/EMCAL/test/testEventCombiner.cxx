@@ -0,0 +1,153 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   testEventCombiner.cxx
+///
+
+#include "EMCAL/EventCombiner.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+#define BOOST_TEST_MODULE EventCombiner test
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+
+using namespace o2::quality_control_modules::emcal;
+using o2::InteractionRecord;
+using o2::emcal::TriggerRecord;
+
+namespace
+{
+
+struct ExpectedSubEvent {
+  o2::header::DataHeader::SubSpecificationType mSpecification;
+  int mFirstEntry;
+  int mEntries;
+};
+
+struct ExpectedEvent {
+  InteractionRecord mInteractionRecord;
+  uint32_t mTriggerType;
+  std::vector<ExpectedSubEvent> mSubevents;
+};
+
+// the search of every interaction record in all the spans, as the tasks were doing before
+std::vector<ExpectedEvent> combineBySearch(const EventCombiner::TriggerRecordSubevents& triggerrecords)
+{
+  std::set<InteractionRecord> allInteractions;
+  for (const auto& [subspecification, records] : triggerrecords) {
+    for (const auto& record : records) {
+      allInteractions.insert(record.getBCData());
+    }
+  }
+
+  std::vector<ExpectedEvent> events;
+  for (const auto& collision : allInteractions) {
+    ExpectedEvent nextevent{ collision, 0, {} };
+    for (const auto& [subspecification, records] : triggerrecords) {
+      auto found = std::find_if(records.begin(), records.end(), [&collision](const TriggerRecord& rec) { return rec.getBCData() == collision; });
+      if (found != records.end()) {
+        if (nextevent.mSubevents.empty()) {
+          nextevent.mTriggerType = found->getTriggerBits();
+        }
+        nextevent.mSubevents.push_back({ subspecification, found->getFirstEntry(), found->getNumberOfObjects() });
+      }
+    }
+    events.push_back(nextevent);
+  }
+  return events;
+}
+
+void checkSameEvents(const std::vector<EventCombiner::CombinedEvent>& events, const std::vector<ExpectedEvent>& expected)
+{
+  BOOST_REQUIRE_EQUAL(events.size(), expected.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    BOOST_CHECK(events[i].mInteractionRecord == expected[i].mInteractionRecord);
+    BOOST_CHECK_EQUAL(events[i].mTriggerType, expected[i].mTriggerType);
+    BOOST_REQUIRE_EQUAL(events[i].getNumberOfSubevents(), expected[i].mSubevents.size());
+    for (size_t j = 0; j < expected[i].mSubevents.size(); j++) {
+      BOOST_CHECK_EQUAL(events[i].mSubevents[j].mSpecification, expected[i].mSubevents[j].mSpecification);
+      BOOST_CHECK_EQUAL(events[i].mSubevents[j].mCellRange.getFirstEntry(), expected[i].mSubevents[j].mFirstEntry);
+      BOOST_CHECK_EQUAL(events[i].mSubevents[j].mCellRange.getEntries(), expected[i].mSubevents[j].mEntries);
+    }
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(empty_input)
+{
+  EventCombiner combiner;
+  EventCombiner::TriggerRecordSubevents triggerrecords;
+  BOOST_CHECK(combiner.combine(triggerrecords).empty());
+
+  std::vector<TriggerRecord> noRecords;
+  triggerrecords[0] = noRecords;
+  triggerrecords[1] = noRecords;
+  BOOST_CHECK(combiner.combine(triggerrecords).empty());
+}
+
+BOOST_AUTO_TEST_CASE(combine_subevents)
+{
+  std::vector<TriggerRecord> records0{ { InteractionRecord(10, 1), 1, 0, 5 }, { InteractionRecord(20, 1), 1, 5, 3 } };
+  std::vector<TriggerRecord> records1{ { InteractionRecord(20, 1), 2, 0, 4 }, { InteractionRecord(30, 1), 2, 4, 1 } };
+  EventCombiner::TriggerRecordSubevents triggerrecords{ { 0, records0 }, { 1, records1 } };
+
+  EventCombiner combiner;
+  const auto& events = combiner.combine(triggerrecords);
+  BOOST_REQUIRE_EQUAL(events.size(), 3);
+  BOOST_CHECK(events[0].mInteractionRecord == InteractionRecord(10, 1));
+  BOOST_CHECK_EQUAL(events[0].getNumberOfSubevents(), 1);
+  BOOST_CHECK_EQUAL(events[0].getNumberOfObjects(), 5);
+  BOOST_CHECK(events[1].mInteractionRecord == InteractionRecord(20, 1));
+  BOOST_CHECK_EQUAL(events[1].getNumberOfSubevents(), 2);
+  BOOST_CHECK_EQUAL(events[1].getNumberOfObjects(), 7);
+  BOOST_CHECK(events[2].mInteractionRecord == InteractionRecord(30, 1));
+  BOOST_CHECK_EQUAL(events[2].mTriggerType, 2);
+  BOOST_CHECK_EQUAL(events[2].getNumberOfObjects(), 1);
+  checkSameEvents(events, combineBySearch(triggerrecords));
+}
+
+BOOST_AUTO_TEST_CASE(same_as_search)
+{
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> nRecordsDistribution(0, 50);
+  std::uniform_int_distribution<int> bcDistribution(0, 40);
+  std::uniform_int_distribution<int> entriesDistribution(0, 20);
+  std::uniform_int_distribution<uint32_t> triggerDistribution(0, 0xFF);
+
+  EventCombiner combiner;
+  for (int iteration = 0; iteration < 100; iteration++) {
+    // the combiner is reused on purpose, as the tasks do from one timeframe to the next one
+    std::vector<std::vector<TriggerRecord>> records(20);
+    EventCombiner::TriggerRecordSubevents triggerrecords;
+    for (size_t subspecification = 0; subspecification < records.size(); subspecification++) {
+      auto& subeventRecords = records[subspecification];
+      int firstEntry = 0;
+      for (int i = nRecordsDistribution(generator); i > 0; i--) {
+        auto entries = entriesDistribution(generator);
+        // a small range of bunch crossings gives both interactions shared by FLPs and repeated records
+        subeventRecords.emplace_back(InteractionRecord(bcDistribution(generator), 1 + iteration % 3), triggerDistribution(generator), firstEntry, entries);
+        firstEntry += entries;
+      }
+      if (subspecification % 5 != 0) {
+        std::stable_sort(subeventRecords.begin(), subeventRecords.end(), [](const TriggerRecord& first, const TriggerRecord& second) { return first.getBCData() < second.getBCData(); });
+      }
+      triggerrecords[subspecification] = subeventRecords;
+    }
+    checkSameEvents(combiner.combine(triggerrecords), combineBySearch(triggerrecords));
+  }
+}
@@ -0,0 +1,142 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DigitQcEngine.h
+/// \brief Allocation-free building blocks of the digit loop, shared by the FT0, FV0 and FDD DigitQcTasks
+
+#ifndef QC_MODULE_FIT_DIGITQCENGINE_H
+#define QC_MODULE_FIT_DIGITQCENGINE_H
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+class TH1;
+
+namespace o2::quality_control_modules::fit
+{
+
+/// \brief Per-channel and per-PM state of the digit loop, kept in flat arrays.
+///
+/// The lookup tables (channel ID -> PM hash, group of each PM) are filled once in initialize().
+/// The per-digit accumulators (FEE modules which sent data, sum of amplitudes per PM) are reused between digits,
+/// only the entries touched by the previous digit are cleared, so that processing a digit does not allocate.
+/// PMs are split in two groups whose amplitudes are summed separately: the A and C sides for FT0 and FDD,
+/// the inner and outer rings for FV0.
+class DigitQcEngine
+{
+ public:
+  static constexpr std::size_t sMaxChannels = 256; // channel IDs are stored on 8 bits in ChannelData
+  static constexpr std::size_t sMaxModules = 256;  // PM hashes are stored on 8 bits
+  using ChannelMask_t = std::bitset<sMaxChannels>;
+
+  struct SumAmplitudes {
+    int first = 0;  // A side for FT0 and FDD, inner rings for FV0
+    int second = 0; // C side for FT0 and FDD, outer rings for FV0
+  };
+
+  DigitQcEngine();
+
+  static ChannelMask_t makeChannelMask(const std::set<unsigned int>& chIDs);
+
+  void setModule(unsigned int chID, uint8_t moduleHash) { mChID2Module[chID] = moduleHash; }
+  uint8_t getModule(unsigned int chID) const { return mChID2Module[chID]; }
+  void setModuleGroup(uint8_t moduleHash, bool isFirstGroup) { mModuleIsFirstGroup[moduleHash] = isFirstGroup; }
+  bool isModuleInFirstGroup(uint8_t moduleHash) const { return mModuleIsFirstGroup[moduleHash]; }
+  bool isChannelInFirstGroup(unsigned int chID) const { return mModuleIsFirstGroup[mChID2Module[chID]]; }
+
+  /// Clears the accumulators of the previous digit
+  void startDigit();
+  /// Marks a FEE module as having sent data in the current digit
+  void addModule(uint8_t moduleHash)
+  {
+    if (!mModuleSeen[moduleHash]) {
+      mModuleSeen[moduleHash] = true;
+      mModules.push_back(moduleHash);
+    }
+  }
+  /// Marks the PM of a channel as having sent data in the current digit
+  void addChannelModule(unsigned int chID) { addModule(mChID2Module[chID]); }
+  /// Adds the amplitude of a channel to the sum of its PM
+  void addAmplitude(unsigned int chID, int amplitude)
+  {
+    const auto moduleHash = mChID2Module[chID];
+    if (!mModuleHasAmplitude[moduleHash]) {
+      mModuleHasAmplitude[moduleHash] = true;
+      mModulesWithAmplitude.push_back(moduleHash);
+    }
+    mModuleSumAmplitude[moduleHash] += amplitude;
+  }
+  /// FEE modules which sent data in the current digit, in ascending order of hash
+  const std::vector<uint8_t>& getModules();
+  /// Sums of amplitudes of both groups, where the sum of each PM is divided by 8 as the TCM does
+  SumAmplitudes getSumAmplitudes() const;
+
+ private:
+  std::array<uint8_t, sMaxChannels> mChID2Module{};
+  std::bitset<sMaxModules> mModuleIsFirstGroup;
+
+  std::bitset<sMaxModules> mModuleSeen;
+  std::vector<uint8_t> mModules;
+  std::bitset<sMaxModules> mModuleHasAmplitude;
+  std::vector<uint8_t> mModulesWithAmplitude;
+  std::array<int, sMaxModules> mModuleSumAmplitude{};
+};
+
+/// \brief Buffers the fills of a histogram and applies them at once with TH1::FillN.
+///
+/// Tasks add the coordinates of all the entries of a TF and flush them at the end of monitorData().
+/// The buffer is also flushed when it reaches its capacity, so that its size does not depend on the TF length.
+/// The memory of the buffer is kept between flushes.
+/// The statistics of the histogram are the same as if it was filled entry by entry.
+/// A buffer filled with one coordinate must be bound to a 1D histogram, since TH2::FillN ignores one coordinate.
+class FillBuffer
+{
+ public:
+  static constexpr std::size_t sDefaultCapacity = 1 << 14;
+
+  explicit FillBuffer(TH1* histogram = nullptr, std::size_t capacity = sDefaultCapacity);
+
+  void setHistogram(TH1* histogram);
+  void fill(double x)
+  {
+    mDimension = 1;
+    mX.push_back(x);
+    if (mX.size() >= mCapacity) {
+      flush();
+    }
+  }
+  void fill(double x, double y)
+  {
+    mDimension = 2;
+    mX.push_back(x);
+    mY.push_back(y);
+    if (mX.size() >= mCapacity) {
+      flush();
+    }
+  }
+  void flush();
+  std::size_t size() const { return mX.size(); }
+
+ private:
+  TH1* mHistogram = nullptr;
+  std::size_t mCapacity;
+  int mDimension = 0; // number of coordinates of the entries, 0 until the first fill
+  std::vector<double> mX;
+  std::vector<double> mY;
+};
+
+} // namespace o2::quality_control_modules::fit
+
+#endif // QC_MODULE_FIT_DIGITQCENGINE_H
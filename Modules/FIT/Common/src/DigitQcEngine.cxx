@@ -0,0 +1,102 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   DigitQcEngine.cxx
+
+#include "FITCommon/DigitQcEngine.h"
+
+#include <TH1.h>
+#include <algorithm>
+#include <cassert>
+
+namespace o2::quality_control_modules::fit
+{
+
+DigitQcEngine::DigitQcEngine()
+{
+  mModules.reserve(sMaxModules);
+  mModulesWithAmplitude.reserve(sMaxModules);
+}
+
+DigitQcEngine::ChannelMask_t DigitQcEngine::makeChannelMask(const std::set<unsigned int>& chIDs)
+{
+  ChannelMask_t mask;
+  for (const auto chID : chIDs) {
+    if (chID < sMaxChannels) {
+      mask[chID] = true;
+    }
+  }
+  return mask;
+}
+
+void DigitQcEngine::startDigit()
+{
+  for (const auto moduleHash : mModules) {
+    mModuleSeen[moduleHash] = false;
+  }
+  mModules.clear();
+  for (const auto moduleHash : mModulesWithAmplitude) {
+    mModuleHasAmplitude[moduleHash] = false;
+    mModuleSumAmplitude[moduleHash] = 0;
+  }
+  mModulesWithAmplitude.clear();
+}
+
+const std::vector<uint8_t>& DigitQcEngine::getModules()
+{
+  // a few modules at most, sorting them keeps the order in which std::set used to give them
+  std::sort(mModules.begin(), mModules.end());
+  return mModules;
+}
+
+DigitQcEngine::SumAmplitudes DigitQcEngine::getSumAmplitudes() const
+{
+  SumAmplitudes sums;
+  for (const auto moduleHash : mModulesWithAmplitude) {
+    if (mModuleIsFirstGroup[moduleHash]) {
+      sums.first += (mModuleSumAmplitude[moduleHash] >> 3);
+    } else {
+      sums.second += (mModuleSumAmplitude[moduleHash] >> 3);
+    }
+  }
+  return sums;
+}
+
+FillBuffer::FillBuffer(TH1* histogram, std::size_t capacity) : mHistogram(histogram), mCapacity(std::max<std::size_t>(capacity, 1))
+{
+}
+
+void FillBuffer::setHistogram(TH1* histogram)
+{
+  flush();
+  assert(histogram == nullptr || mDimension != 1 || histogram->GetDimension() == 1);
+  mHistogram = histogram;
+}
+
+void FillBuffer::flush()
+{
+  if (mX.empty()) {
+    return;
+  }
+  if (mHistogram != nullptr) {
+    if (mY.empty()) {
+      assert(mHistogram->GetDimension() == 1);
+      mHistogram->FillN(static_cast<int>(mX.size()), mX.data(), nullptr, 1);
+    } else {
+      mHistogram->FillN(static_cast<int>(mX.size()), mX.data(), mY.data(), nullptr, 1);
+    }
+  }
+  mX.clear();
+  mY.clear();
+}
+
+} // namespace o2::quality_control_modules::fit
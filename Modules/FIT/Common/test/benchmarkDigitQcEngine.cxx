@@ -0,0 +1,282 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   benchmarkDigitQcEngine.cxx
+///
+/// Compares the per-digit processing of the FIT DigitQcTasks done with node-based containers and direct histogram fills
+/// to the one done with DigitQcEngine and FillBuffers, on synthetic digits.
+///
+
+#include "FITCommon/DigitQcEngine.h"
+
+#include <TH1F.h>
+#include <TH2F.h>
+#include <TString.h>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace bpo = boost::program_options;
+using namespace o2::quality_control_modules::fit;
+
+namespace
+{
+
+constexpr unsigned int sNChannels = 208;
+constexpr unsigned int sChannelsPerPM = 12;
+constexpr unsigned int sNPMsA = 8;
+
+struct SyntheticChannel {
+  uint8_t chID;
+  uint8_t bits;
+  int16_t time;
+  int16_t amplitude;
+};
+
+struct SyntheticTF {
+  std::vector<SyntheticChannel> channels;
+  std::vector<std::pair<size_t, size_t>> digits; // first channel and number of channels of each digit
+};
+
+SyntheticTF generateTF(size_t nDigits, size_t channelsPerDigit, std::mt19937& generator)
+{
+  std::uniform_int_distribution<unsigned int> channel(0, sNChannels - 1);
+  std::uniform_int_distribution<unsigned int> bits(0, 255);
+  std::normal_distribution<double> time(0, 50);
+  std::exponential_distribution<double> amplitude(0.01);
+  std::poisson_distribution<size_t> multiplicity(channelsPerDigit);
+  SyntheticTF tf;
+  for (size_t i = 0; i < nDigits; i++) {
+    const auto first = tf.channels.size();
+    const auto n = std::min<size_t>(multiplicity(generator), sNChannels);
+    for (size_t c = 0; c < n; c++) {
+      tf.channels.push_back({ static_cast<uint8_t>(channel(generator)), static_cast<uint8_t>(bits(generator)), static_cast<int16_t>(time(generator)), static_cast<int16_t>(amplitude(generator)) });
+    }
+    tf.digits.emplace_back(first, n);
+  }
+  return tf;
+}
+
+struct Histograms {
+  explicit Histograms(const std::string& suffix)
+    : time2Ch(("time" + suffix).c_str(), "time", sNChannels, 0, sNChannels, 410, -2050, 2050),
+      amp2Ch(("amp" + suffix).c_str(), "amp", sNChannels, 0, sNChannels, 420, -100, 4100),
+      chDataBits(("bits" + suffix).c_str(), "bits", sNChannels, 0, sNChannels, 8, 0, 8),
+      channelID(("chid" + suffix).c_str(), "chid", sNChannels, 0, sNChannels),
+      feeModules(("fee" + suffix).c_str(), "fee", 3564, 0, 3564, 20, 0, 20),
+      sumAmp(("sumamp" + suffix).c_str(), "sumamp", 1000, 0, 10000)
+  {
+  }
+  TH2F time2Ch;
+  TH2F amp2Ch;
+  TH2F chDataBits;
+  TH1F channelID;
+  TH2F feeModules;
+  TH1F sumAmp;
+  std::map<unsigned int, TH1F*> ampPerChannel;
+};
+
+// the digit loop as it was written with std::set and std::map
+void processLegacy(const SyntheticTF& tf, Histograms& h, const std::set<unsigned int>& allowedChIDs, const std::map<uint8_t, bool>& pmHash2isAside)
+{
+  auto mapPMhash2isAside = pmHash2isAside;
+  for (size_t iDigit = 0; iDigit < tf.digits.size(); iDigit++) {
+    const auto [first, n] = tf.digits[iDigit];
+    std::set<uint8_t> setFEEmodules{};
+    std::map<uint8_t, int> mapPMhash2sumAmpl;
+    for (const auto& entry : mapPMhash2isAside) {
+      mapPMhash2sumAmpl.insert({ entry.first, 0 });
+    }
+    for (size_t c = first; c < first + n; c++) {
+      const auto& ch = tf.channels[c];
+      h.time2Ch.Fill(ch.chID, ch.time);
+      h.amp2Ch.Fill(ch.chID, ch.amplitude);
+      h.channelID.Fill(ch.chID);
+      if (allowedChIDs.size() != 0 && allowedChIDs.find(ch.chID) != allowedChIDs.end()) {
+        h.ampPerChannel[ch.chID]->Fill(ch.amplitude);
+      }
+      for (int bit = 0; bit < 8; bit++) {
+        if (ch.bits & (1 << bit)) {
+          h.chDataBits.Fill(ch.chID, bit);
+        }
+      }
+      const uint8_t pmHash = ch.chID / sChannelsPerPM;
+      setFEEmodules.insert(pmHash);
+      mapPMhash2sumAmpl[pmHash] += ch.amplitude;
+    }
+    int sumA = 0;
+    int sumC = 0;
+    for (const auto& entry : mapPMhash2sumAmpl) {
+      if (mapPMhash2isAside[entry.first]) {
+        sumA += (entry.second >> 3);
+      } else {
+        sumC += (entry.second >> 3);
+      }
+    }
+    h.sumAmp.Fill(sumA + sumC);
+    for (const auto& feeHash : setFEEmodules) {
+      h.feeModules.Fill(static_cast<double>(iDigit % 3564), static_cast<double>(feeHash));
+    }
+  }
+}
+
+// the same loop with DigitQcEngine and FillBuffers
+struct EngineProcessing {
+  EngineProcessing(Histograms& h, const std::set<unsigned int>& allowedChIDs)
+    : mask(DigitQcEngine::makeChannelMask(allowedChIDs)),
+      fillTime2Ch(&h.time2Ch),
+      fillAmp2Ch(&h.amp2Ch),
+      fillChDataBits(&h.chDataBits),
+      fillChannelID(&h.channelID),
+      fillFeeModules(&h.feeModules)
+  {
+    for (unsigned int chID = 0; chID < sNChannels; chID++) {
+      engine.setModule(chID, chID / sChannelsPerPM);
+    }
+    for (unsigned int pm = 0; pm <= sNChannels / sChannelsPerPM; pm++) {
+      engine.setModuleGroup(pm, pm < sNPMsA);
+    }
+    for (const auto& [chID, histogram] : h.ampPerChannel) {
+      ampPerChannel[chID] = histogram;
+    }
+    for (unsigned int byte = 0; byte < 256; byte++) {
+      for (int bit = 0; bit < 8; bit++) {
+        if (byte & (1 << bit)) {
+          bitBinPos[byte].push_back(bit);
+        }
+      }
+    }
+  }
+
+  void process(const SyntheticTF& tf, Histograms& h)
+  {
+    for (size_t iDigit = 0; iDigit < tf.digits.size(); iDigit++) {
+      const auto [first, n] = tf.digits[iDigit];
+      engine.startDigit();
+      for (size_t c = first; c < first + n; c++) {
+        const auto& ch = tf.channels[c];
+        fillTime2Ch.fill(ch.chID, ch.time);
+        fillAmp2Ch.fill(ch.chID, ch.amplitude);
+        fillChannelID.fill(ch.chID);
+        if (mask[ch.chID]) {
+          ampPerChannel[ch.chID]->Fill(ch.amplitude);
+        }
+        for (const auto& binPos : bitBinPos[ch.bits]) {
+          fillChDataBits.fill(ch.chID, binPos);
+        }
+        engine.addChannelModule(ch.chID);
+        engine.addAmplitude(ch.chID, ch.amplitude);
+      }
+      const auto sums = engine.getSumAmplitudes();
+      h.sumAmp.Fill(sums.first + sums.second);
+      for (const auto& feeHash : engine.getModules()) {
+        fillFeeModules.fill(static_cast<double>(iDigit % 3564), static_cast<double>(feeHash));
+      }
+    }
+    fillTime2Ch.flush();
+    fillAmp2Ch.flush();
+    fillChDataBits.flush();
+    fillChannelID.flush();
+    fillFeeModules.flush();
+  }
+
+  DigitQcEngine engine;
+  DigitQcEngine::ChannelMask_t mask;
+  std::array<TH1F*, DigitQcEngine::sMaxChannels> ampPerChannel{};
+  std::array<std::vector<double>, 256> bitBinPos;
+  FillBuffer fillTime2Ch;
+  FillBuffer fillAmp2Ch;
+  FillBuffer fillChDataBits;
+  FillBuffer fillChannelID;
+  FillBuffer fillFeeModules;
+};
+
+} // namespace
+
+int main(int argc, const char* argv[])
+{
+  bpo::options_description desc{ "Options" };
+  desc.add_options()                                                                                                 //
+    ("help,h", "Help screen")                                                                                        //
+    ("digits,d", bpo::value<size_t>()->default_value(20000), "Number of digits per TF")                              //
+    ("channels,c", bpo::value<size_t>()->default_value(30), "Average number of channels per digit")                  //
+    ("allowed-channels,a", bpo::value<size_t>()->default_value(24), "Number of channels with their own histograms") //
+    ("tfs,t", bpo::value<size_t>()->default_value(20), "Number of TFs");
+
+  bpo::variables_map vm;
+  store(parse_command_line(argc, argv, desc), vm);
+  if (vm.count("help")) {
+    std::cout << desc << std::endl;
+    return 0;
+  }
+  notify(vm);
+  const auto nDigits = vm["digits"].as<size_t>();
+  const auto nChannels = vm["channels"].as<size_t>();
+  const auto nAllowed = std::min<size_t>(vm["allowed-channels"].as<size_t>(), sNChannels);
+  const auto nTFs = vm["tfs"].as<size_t>();
+
+  TH1::AddDirectory(false);
+  std::mt19937 generator{ 42 };
+  std::vector<SyntheticTF> tfs;
+  for (size_t i = 0; i < nTFs; i++) {
+    tfs.push_back(generateTF(nDigits, nChannels, generator));
+  }
+  std::set<unsigned int> allowedChIDs;
+  for (size_t i = 0; i < nAllowed; i++) {
+    allowedChIDs.insert(i * sNChannels / nAllowed);
+  }
+  std::map<uint8_t, bool> pmHash2isAside;
+  for (unsigned int pm = 0; pm <= sNChannels / sChannelsPerPM; pm++) {
+    pmHash2isAside.insert({ pm, pm < sNPMsA });
+  }
+
+  Histograms legacyHistograms("Legacy");
+  Histograms engineHistograms("Engine");
+  std::vector<std::unique_ptr<TH1F>> ampHistograms;
+  for (const auto chID : allowedChIDs) {
+    for (auto* h : { &legacyHistograms, &engineHistograms }) {
+      ampHistograms.push_back(std::make_unique<TH1F>(Form("amp%u_%p", chID, (void*)h), "amp", 420, -100, 4100));
+      h->ampPerChannel[chID] = ampHistograms.back().get();
+    }
+  }
+  EngineProcessing engineProcessing(engineHistograms, allowedChIDs);
+
+  std::chrono::duration<double, std::milli> legacyTime{ 0 }, engineTime{ 0 };
+  for (const auto& tf : tfs) {
+    auto start = std::chrono::steady_clock::now();
+    processLegacy(tf, legacyHistograms, allowedChIDs, pmHash2isAside);
+    auto legacyEnd = std::chrono::steady_clock::now();
+    engineProcessing.process(tf, engineHistograms);
+    auto engineEnd = std::chrono::steady_clock::now();
+    legacyTime += legacyEnd - start;
+    engineTime += engineEnd - legacyEnd;
+  }
+
+  const bool identical = legacyHistograms.time2Ch.GetEntries() == engineHistograms.time2Ch.GetEntries() &&
+                         legacyHistograms.chDataBits.Integral() == engineHistograms.chDataBits.Integral() &&
+                         legacyHistograms.feeModules.Integral() == engineHistograms.feeModules.Integral() &&
+                         legacyHistograms.sumAmp.GetMean() == engineHistograms.sumAmp.GetMean();
+
+  const double nAllDigits = static_cast<double>(nDigits * nTFs);
+  std::cout << nTFs << " TFs of " << nDigits << " digits with " << nChannels << " channels on average:" << std::endl;
+  std::cout << "  std::set/std::map, direct fills : " << legacyTime.count() / nTFs << " ms/TF, " << legacyTime.count() * 1e6 / nAllDigits << " ns/digit" << std::endl;
+  std::cout << "  DigitQcEngine, FillBuffers      : " << engineTime.count() / nTFs << " ms/TF, " << engineTime.count() * 1e6 / nAllDigits << " ns/digit" << std::endl;
+  std::cout << "  histograms are " << (identical ? "identical" : "DIFFERENT") << std::endl;
+  return identical ? 0 : 1;
+}
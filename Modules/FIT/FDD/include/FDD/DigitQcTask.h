@@ -41,6 +41,7 @@
 #include "QualityControl/TaskInterface.h"
 #include "FDDBase/Constants.h"
 #include "FITCommon/DetectorFIT.h"
+#include "FITCommon/DigitQcEngine.h"
 
 using namespace o2::quality_control::core;
 
@@ -120,10 +121,11 @@ class DigitQcTask final : public TaskInterface
   TList* mListHistGarbage;
   std::set<unsigned int> mSetAllowedChIDs;
   std::set<unsigned int> mSetAllowedChIDsAmpVsTime;
+  fit::DigitQcEngine::ChannelMask_t mMaskAllowedChIDs;
+  fit::DigitQcEngine::ChannelMask_t mMaskAllowedChIDsAmpVsTime;
   std::array<o2::InteractionRecord, sNCHANNELS_PM> mStateLastIR2Ch;
-  std::array<uint8_t, sNCHANNELS_PM> mChID2PMhash; // map chID->hashed PM value
-  uint8_t mTCMhash;                                // hash value for TCM, and bin position in hist
-  std::map<uint8_t, bool> mMapPMhash2isAside;
+  fit::DigitQcEngine mDigitQcEngine; // chID->hashed PM value, PM side and per digit sums, in flat arrays
+  uint8_t mTCMhash;                  // hash value for TCM, and bin position in hist
 
   typename Detector_t::TrgMap_t mMapPMbits = Detector_t::sMapPMbits;
   typename Detector_t::TrgMap_t mMapTechTrgBits = Detector_t::sMapTechTrgBits;
@@ -199,6 +201,9 @@ class DigitQcTask final : public TaskInterface
   std::unique_ptr<TH1D> mHistCycleDurationNTF;
   std::unique_ptr<TH1D> mHistCycleDurationRange;
   std::map<unsigned int, TH2F*> mMapHistAmpVsTime;
+  // the same histograms indexed by channel ID, for the digit loop
+  std::array<TH1F*, fit::DigitQcEngine::sMaxChannels> mArrHistAmp1DCoincidence{};
+  std::array<TH2F*, fit::DigitQcEngine::sMaxChannels> mArrHistAmpVsTime{};
   std::unique_ptr<TH2F> mHistBCvsTrg;
   std::unique_ptr<TH2F> mHistBCvsFEEmodules;
   std::unique_ptr<TH2F> mHistOrbitVsTrg;
@@ -212,6 +217,18 @@ class DigitQcTask final : public TaskInterface
   std::unique_ptr<TH1F> mHistTriggersSw;
   std::unique_ptr<TH2F> mHistTriggersSoftwareVsTCM;
   std::unique_ptr<TH2F> mHistBcVsFeeForVtxTrg;
+  // per channel and per digit fills, applied once per TF
+  fit::FillBuffer mFillTime2Ch;
+  fit::FillBuffer mFillAmp2Ch;
+  fit::FillBuffer mFillEventDensity2Ch;
+  fit::FillBuffer mFillChannelID;
+  fit::FillBuffer mFillNumADC;
+  fit::FillBuffer mFillNumCFD;
+  fit::FillBuffer mFillChDataBits;
+  fit::FillBuffer mFillOrbit2BC;
+  fit::FillBuffer mFillBC;
+  fit::FillBuffer mFillBCvsFEEmodules;
+  fit::FillBuffer mFillOrbitVsFEEmodules;
   // Hashed maps
   static const size_t mapSize = 256;
   const std::array<std::vector<double>, mapSize> mHashedBitBinPos;                        // map with bit position for 1 byte trg signal, for 1 Dim hists;
@@ -270,15 +270,15 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
     const auto& pairIt = mapFEE2hash.insert({ moduleName, binPos });
     if (pairIt.second) {
       if (moduleName.find("PMA") != std::string::npos)
-        mMapPMhash2isAside.insert({ binPos, true });
+        mDigitQcEngine.setModuleGroup(binPos, true);
       else if (moduleName.find("PMC") != std::string::npos)
-        mMapPMhash2isAside.insert({ binPos, false });
+        mDigitQcEngine.setModuleGroup(binPos, false);
       binPos++;
     }
     if (std::regex_match(strChID, std::regex("[[\\d]{1,3}"))) {
       int chID = std::stoi(strChID);
       if (chID < sNCHANNELS_PM) {
-        mChID2PMhash[chID] = mapFEE2hash[moduleName];
+        mDigitQcEngine.setModule(chID, mapFEE2hash[moduleName]);
       } else {
         LOG(error) << "Incorrect LUT entry: chID " << strChID << " | " << moduleName;
       }
@@ -336,6 +336,8 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   for (const auto& entry : vecChannelIDsAmpVsTime) {
     mSetAllowedChIDsAmpVsTime.insert(entry);
   }
+  mMaskAllowedChIDs = DigitQcEngine::makeChannelMask(mSetAllowedChIDs);
+  mMaskAllowedChIDsAmpVsTime = DigitQcEngine::makeChannelMask(mSetAllowedChIDsAmpVsTime);
 
   for (const auto& chID : mSetAllowedChIDs) {
     auto pairHistAmpCoincidence = mMapHistAmp1DCoincidence.insert({ chID, new TH1F(Form("Amp_channelCoincidence%i", chID), Form("AmplitudeCoincidence, channel %i", chID), 4200, -100, 4100) });
@@ -343,6 +345,9 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
       getObjectsManager()->startPublishing(pairHistAmpCoincidence.first->second);
       mListHistGarbage->Add(pairHistAmpCoincidence.first->second);
     }
+    if (chID < DigitQcEngine::sMaxChannels) {
+      mArrHistAmp1DCoincidence[chID] = pairHistAmpCoincidence.first->second;
+    }
   }
   for (const auto& chID : mSetAllowedChIDsAmpVsTime) {
     auto pairHistAmpVsTime = mMapHistAmpVsTime.insert({ chID, new TH2F(Form("Amp_vs_time_channel%i", chID), Form("Amplitude vs time, channel %i;Amp;Time", chID), 420, -100, 4100, 410, -2050, 2050) });
@@ -350,6 +355,9 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
       mListHistGarbage->Add(pairHistAmpVsTime.first->second);
       getObjectsManager()->startPublishing(pairHistAmpVsTime.first->second);
     }
+    if (chID < DigitQcEngine::sMaxChannels) {
+      mArrHistAmpVsTime[chID] = pairHistAmpVsTime.first->second;
+    }
   }
 
   rebinFromConfig(); // after all histos are created
@@ -413,6 +421,17 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
     TH1* obj = dynamic_cast<TH1*>(getObjectsManager()->getMonitorObject(i)->getObject());
     obj->SetTitle((string("FDD ") + obj->GetTitle()).c_str());
   }
+  mFillTime2Ch.setHistogram(mHistTime2Ch.get());
+  mFillAmp2Ch.setHistogram(mHistAmp2Ch.get());
+  mFillEventDensity2Ch.setHistogram(mHistEventDensity2Ch.get());
+  mFillChannelID.setHistogram(mHistChannelID.get());
+  mFillNumADC.setHistogram(mHistNumADC.get());
+  mFillNumCFD.setHistogram(mHistNumCFD.get());
+  mFillChDataBits.setHistogram(mHistChDataBits.get());
+  mFillOrbit2BC.setHistogram(mHistOrbit2BC.get());
+  mFillBC.setHistogram(mHistBC.get());
+  mFillBCvsFEEmodules.setHistogram(mHistBCvsFEEmodules.get());
+  mFillOrbitVsFEEmodules.setHistogram(mHistOrbitVsFEEmodules.get());
   // Timestamp
   mMetaAnchorOutput = o2::quality_control_modules::common::getFromConfig<std::string>(mCustomParameters, "metaAnchorOutput", "CycleDurationNTF");
   mTimestampMetaField = o2::quality_control_modules::common::getFromConfig<std::string>(mCustomParameters, "timestampMetaField", "timestampTF");
@@ -505,20 +524,20 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     if (digit.mTriggers.getTimeA() == o2::fit::Triggers::DEFAULT_TIME && digit.mTriggers.getTimeC() == o2::fit::Triggers::DEFAULT_TIME) {
       isTCM = false;
     }
-    mHistOrbit2BC->Fill(digit.getIntRecord().orbit % sOrbitsPerTF, digit.getIntRecord().bc);
-    mHistBC->Fill(digit.getBC());
+    mFillOrbit2BC.fill(digit.getIntRecord().orbit % sOrbitsPerTF, digit.getIntRecord().bc);
+    mFillBC.fill(digit.getBC());
 
     // Fill the amplitude, if there is a coincidence of the signals in in the front or back layers
     bool hasData[16] = { 0 };
     for (const auto& chData : vecChData) {
-      if (mSetAllowedChIDs.find(static_cast<unsigned int>(chData.mPMNumber)) != mSetAllowedChIDs.end()) {
+      if (mMaskAllowedChIDs[chData.mPMNumber]) {
         if (static_cast<int>(chData.mPMNumber) < 16) {
           hasData[static_cast<int>(chData.mPMNumber)] = 1;
         }
       }
     } // ak
 
-    std::set<uint8_t> setFEEmodules{};
+    mDigitQcEngine.startDigit();
     // reset triggers
     for (auto& entry : mMapTrgSoftware) {
       mMapTrgSoftware[entry.first] = false;
@@ -538,91 +557,43 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     // Initialize array elements to zero using std::fill
     std::fill(ChVertexArray.begin(), ChVertexArray.end(), 0);
 
-    std::map<uint8_t, int> mapPMhash2sumAmpl;
-    for (const auto& entry : mMapPMhash2isAside) {
-      mapPMhash2sumAmpl.insert({ entry.first, 0 });
-    }
     for (const auto& chData : vecChData) {
       if (static_cast<int>(chData.mPMNumber) < sNCHANNELS_C)
         mPMChargeTotalCside += chData.mChargeADC;
       else
         mPMChargeTotalAside += chData.mChargeADC;
 
-      mHistTime2Ch->Fill(static_cast<Double_t>(chData.mPMNumber), static_cast<Double_t>(chData.mTime));
-      mHistAmp2Ch->Fill(static_cast<Double_t>(chData.mPMNumber), static_cast<Double_t>(chData.mChargeADC));
-      mHistEventDensity2Ch->Fill(static_cast<Double_t>(chData.mPMNumber), static_cast<Double_t>(digit.mIntRecord.differenceInBC(mStateLastIR2Ch[chData.mPMNumber])));
+      mFillTime2Ch.fill(static_cast<Double_t>(chData.mPMNumber), static_cast<Double_t>(chData.mTime));
+      mFillAmp2Ch.fill(static_cast<Double_t>(chData.mPMNumber), static_cast<Double_t>(chData.mChargeADC));
+      mFillEventDensity2Ch.fill(static_cast<Double_t>(chData.mPMNumber), static_cast<Double_t>(digit.mIntRecord.differenceInBC(mStateLastIR2Ch[chData.mPMNumber])));
       mStateLastIR2Ch[chData.mPMNumber] = digit.mIntRecord;
-      mHistChannelID->Fill(chData.mPMNumber);
+      mFillChannelID.fill(chData.mPMNumber);
       if (chData.mChargeADC > 0) {
-        mHistNumADC->Fill(chData.mPMNumber);
+        mFillNumADC.fill(chData.mPMNumber);
       }
-      mHistNumCFD->Fill(chData.mPMNumber);
-      if (mSetAllowedChIDs.size() != 0 && mSetAllowedChIDs.find(static_cast<unsigned int>(chData.mPMNumber)) != mSetAllowedChIDs.end()) {
-        if (static_cast<int>(chData.mPMNumber) == 0 && hasData[4]) {
-          mMapHistAmp1DCoincidence[0]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 1 && hasData[5]) {
-          mMapHistAmp1DCoincidence[1]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 2 && hasData[6]) {
-          mMapHistAmp1DCoincidence[2]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 3 && hasData[7]) {
-          mMapHistAmp1DCoincidence[3]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 4 && hasData[0]) {
-          mMapHistAmp1DCoincidence[4]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 5 && hasData[1]) {
-          mMapHistAmp1DCoincidence[5]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 6 && hasData[2]) {
-          mMapHistAmp1DCoincidence[6]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 7 && hasData[3]) {
-          mMapHistAmp1DCoincidence[7]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 8 && hasData[12]) {
-          mMapHistAmp1DCoincidence[8]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 9 && hasData[13]) {
-          mMapHistAmp1DCoincidence[9]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 10 && hasData[14]) {
-          mMapHistAmp1DCoincidence[10]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 11 && hasData[15]) {
-          mMapHistAmp1DCoincidence[11]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 12 && hasData[8]) {
-          mMapHistAmp1DCoincidence[12]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 13 && hasData[9]) {
-          mMapHistAmp1DCoincidence[13]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 14 && hasData[10]) {
-          mMapHistAmp1DCoincidence[14]->Fill(chData.mChargeADC);
-        }
-        if (static_cast<int>(chData.mPMNumber) == 15 && hasData[11]) {
-          mMapHistAmp1DCoincidence[15]->Fill(chData.mChargeADC);
+      mFillNumCFD.fill(chData.mPMNumber);
+      if (mMaskAllowedChIDs[chData.mPMNumber]) {
+        // channels 0-3 and 4-7 (C side), 8-11 and 12-15 (A side) are in coincidence
+        if (static_cast<int>(chData.mPMNumber) < 16 && hasData[chData.mPMNumber ^ 4]) {
+          mArrHistAmp1DCoincidence[chData.mPMNumber]->Fill(chData.mChargeADC);
         }
       }
-      if (mSetAllowedChIDsAmpVsTime.size() != 0 && mSetAllowedChIDsAmpVsTime.find(static_cast<unsigned int>(chData.mPMNumber)) != mSetAllowedChIDsAmpVsTime.end()) {
-        mMapHistAmpVsTime[chData.mPMNumber]->Fill(chData.mChargeADC, chData.mTime);
+      if (mMaskAllowedChIDsAmpVsTime[chData.mPMNumber]) {
+        mArrHistAmpVsTime[chData.mPMNumber]->Fill(chData.mChargeADC, chData.mTime);
       }
       for (const auto& binPos : mHashedBitBinPos[chData.mFEEBits]) {
-        mHistChDataBits->Fill(chData.mPMNumber, binPos);
+        mFillChDataBits.fill(chData.mPMNumber, binPos);
       }
 
-      setFEEmodules.insert(mChID2PMhash[chData.mPMNumber]);
+      mDigitQcEngine.addChannelModule(chData.mPMNumber);
 
       if (chIsVertexEvent(chData, true)) {
-        if (!mMapPMhash2isAside[mChID2PMhash[static_cast<uint8_t>(chData.mPMNumber)]]) {
+        if (!mDigitQcEngine.isChannelInFirstGroup(chData.mPMNumber)) {
           pmSumTimeC += chData.mTime;
           pmNChanC++;
           if ((int)chData.mPMNumber < sNCHANNELS_Physics)
             ChVertexArray[chData.mPMNumber] = 1;
-        } else if (mMapPMhash2isAside[mChID2PMhash[static_cast<uint8_t>(chData.mPMNumber)]]) {
+        } else {
           pmSumTimeA += chData.mTime;
           pmNChanA++;
           if ((int)chData.mPMNumber < sNCHANNELS_Physics)
@@ -639,16 +610,13 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
       }
 
       if (chData.getFlag(o2::fdd::ChannelData::kIsCFDinADCgate)) {
-        mapPMhash2sumAmpl[mChID2PMhash[static_cast<uint8_t>(chData.mPMNumber)]] += static_cast<Int_t>(chData.mChargeADC);
+        mDigitQcEngine.addAmplitude(chData.mPMNumber, static_cast<Int_t>(chData.mChargeADC));
       }
     }
 
-    for (const auto& entry : mapPMhash2sumAmpl) {
-      if (mMapPMhash2isAside[entry.first])
-        pmSumAmplA += static_cast<int>(entry.second >> 3);
-      else
-        pmSumAmplC += static_cast<int>(entry.second >> 3);
-    }
+    const auto pmSumAmplAC = mDigitQcEngine.getSumAmplitudes();
+    pmSumAmplA = pmSumAmplAC.first;
+    pmSumAmplC = pmSumAmplAC.second;
     auto pmNChan = pmNChanA + pmNChanC;
     auto pmSumAmpl = pmSumAmplA + pmSumAmplC;
     if (isTCM) {
@@ -671,12 +639,12 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     mPMChargeTotalCside = static_cast<int>(mPMChargeTotalCside >> 3);
 
     if (isTCM) {
-      setFEEmodules.insert(mTCMhash);
+      mDigitQcEngine.addModule(mTCMhash);
       mHist2CorrTCMchAndPMch->Fill(digit.mTriggers.getAmplA() + digit.mTriggers.getAmplC(), (digit.mTriggers.getAmplA() + digit.mTriggers.getAmplC()) - (mPMChargeTotalAside + mPMChargeTotalCside));
     }
-    for (const auto& feeHash : setFEEmodules) {
-      mHistBCvsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
-      mHistOrbitVsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().orbit % sOrbitsPerTF), static_cast<double>(feeHash));
+    for (const auto& feeHash : mDigitQcEngine.getModules()) {
+      mFillBCvsFEEmodules.fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
+      mFillOrbitVsFEEmodules.fill(static_cast<double>(digit.getIntRecord().orbit % sOrbitsPerTF), static_cast<double>(feeHash));
       if (digit.mTriggers.getVertex())
         mHistBcVsFeeForVtxTrg->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
     }
@@ -828,6 +796,17 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
     // end of triggers re-computation
   }
+  mFillTime2Ch.flush();
+  mFillAmp2Ch.flush();
+  mFillEventDensity2Ch.flush();
+  mFillChannelID.flush();
+  mFillNumADC.flush();
+  mFillNumCFD.flush();
+  mFillChDataBits.flush();
+  mFillOrbit2BC.flush();
+  mFillBC.flush();
+  mFillBCvsFEEmodules.flush();
+  mFillOrbitVsFEEmodules.flush();
 }
 
 void DigitQcTask::endOfCycle()
@@ -42,6 +42,7 @@
 #include "DataFormatsFT0/ChannelData.h"
 #include "FITCommon/DetectorFIT.h"
 #include "FITCommon/HelperFIT.h"
+#include "FITCommon/DigitQcEngine.h"
 
 using namespace o2::quality_control::core;
 
@@ -91,12 +92,15 @@ class DigitQcTask final : public TaskInterface
   TList* mListHistGarbage;
   std::set<unsigned int> mSetAllowedChIDs;
   std::set<unsigned int> mSetAllowedChIDsAmpVsTime;
+  fit::DigitQcEngine::ChannelMask_t mMaskAllowedChIDs;
+  fit::DigitQcEngine::ChannelMask_t mMaskAllowedChIDsAmpVsTime;
   std::array<o2::InteractionRecord, sNCHANNELS_PM> mStateLastIR2Ch;
-  std::array<uint8_t, sNCHANNELS_PM> mChID2PMhash; // map chID->hashed PM value
-  uint8_t mTCMhash;                                // hash value for TCM, and bin position in hist
-  std::map<uint8_t, bool> mMapPMhash2isAside;
+  fit::DigitQcEngine mDigitQcEngine; // chID->hashed PM value, PM side and per digit sums, in flat arrays
+  uint8_t mTCMhash;                  // hash value for TCM, and bin position in hist
   typename Detector_t::TrgMap_t mMapPMbits = Detector_t::sMapPMbits;
+  uint8_t mMaskPMbits = 0; // bits of mMapPMbits, to fill the per channel bit histograms
   typename Detector_t::TrgMap_t mMapTechTrgBitsExtra = Detector_t::sMapTechTrgBitsExtra;
+  std::vector<unsigned int> mVecTrgWords; // trigger bits fired in the current digit, reused between digits
   typename Detector_t::TrgMap_t mMapTrgBits = Detector_t::sMapTrgBits;
   using DataTCM_t = o2::quality_control_modules::fit::DataTCM<typename Detector_t::Digit_t>;
   using TrgValidation_t = o2::quality_control_modules::fit::TrgValidation<typename Detector_t::Digit_t>;
@@ -133,6 +137,11 @@ class DigitQcTask final : public TaskInterface
   std::map<unsigned int, TH1F*> mMapHistTime1D;
   std::map<unsigned int, TH1F*> mMapHistPMbits;
   std::map<unsigned int, TH2F*> mMapHistAmpVsTime;
+  // the same histograms indexed by channel ID, for the digit loop
+  std::array<TH1F*, fit::DigitQcEngine::sMaxChannels> mArrHistAmp1D{};
+  std::array<TH1F*, fit::DigitQcEngine::sMaxChannels> mArrHistTime1D{};
+  std::array<TH1F*, fit::DigitQcEngine::sMaxChannels> mArrHistPMbits{};
+  std::array<TH2F*, fit::DigitQcEngine::sMaxChannels> mArrHistAmpVsTime{};
   std::unique_ptr<TH2F> mHistBCvsTrg;
   std::unique_ptr<TH2F> mHistBCvsFEEmodules;
   std::unique_ptr<TH2F> mHistOrbitVsTrg;
@@ -144,6 +153,16 @@ class DigitQcTask final : public TaskInterface
   std::unique_ptr<TH2F> mHistPmTcmSumAmpC;
   std::unique_ptr<TH2F> mHistPmTcmAverageTimeC;
   std::unique_ptr<TH2F> mHistTriggersSoftwareVsTCM;
+  // per channel and per digit fills, applied once per TF
+  fit::FillBuffer mFillTime2Ch;
+  fit::FillBuffer mFillAmp2Ch;
+  fit::FillBuffer mFillChannelID;
+  fit::FillBuffer mFillChDataBits;
+  fit::FillBuffer mFillChIDperBC;
+  fit::FillBuffer mFillOrbit2BC;
+  fit::FillBuffer mFillBC;
+  fit::FillBuffer mFillBCvsFEEmodules;
+  fit::FillBuffer mFillOrbitVsFEEmodules;
 
   // Hashed maps
   static const size_t mapSize = 256;
@@ -138,15 +138,15 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
     const auto& pairIt = mapFEE2hash.insert({ moduleName, binPos });
     if (pairIt.second) {
       if (moduleName.find("PMA") != std::string::npos)
-        mMapPMhash2isAside.insert({ binPos, true });
+        mDigitQcEngine.setModuleGroup(binPos, true);
       else if (moduleName.find("PMC") != std::string::npos)
-        mMapPMhash2isAside.insert({ binPos, false });
+        mDigitQcEngine.setModuleGroup(binPos, false);
       binPos++;
     }
     if (std::regex_match(strChID, std::regex("[\\d]{1,3}"))) {
       int chID = std::stoi(strChID);
       if (chID < sNCHANNELS_PM) {
-        mChID2PMhash[chID] = mapFEE2hash[moduleName];
+        mDigitQcEngine.setModule(chID, mapFEE2hash[moduleName]);
       } else {
         LOG(error) << "Incorrect LUT entry: chID " << strChID << " | " << moduleName;
       }
@@ -195,6 +195,12 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   for (const auto& entry : vecChannelIDsAmpVsTime) {
     mSetAllowedChIDsAmpVsTime.insert(entry);
   }
+  mVecTrgWords.reserve(mMapTechTrgBitsExtra.size());
+  mMaskAllowedChIDs = DigitQcEngine::makeChannelMask(mSetAllowedChIDs);
+  mMaskAllowedChIDsAmpVsTime = DigitQcEngine::makeChannelMask(mSetAllowedChIDsAmpVsTime);
+  for (const auto& entry : mMapPMbits) {
+    mMaskPMbits |= (1 << entry.first);
+  }
 
   for (const auto& chID : mSetAllowedChIDs) {
     auto pairHistAmp = mMapHistAmp1D.insert({ chID, new TH1F(Form("Amp_channel%i", chID), Form("Amplitude, channel %i", chID), 4200, -100, 4100) });
@@ -215,6 +221,11 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
       mListHistGarbage->Add(pairHistBits.first->second);
       getObjectsManager()->startPublishing(pairHistBits.first->second);
     }
+    if (chID < DigitQcEngine::sMaxChannels) {
+      mArrHistAmp1D[chID] = pairHistAmp.first->second;
+      mArrHistTime1D[chID] = pairHistTime.first->second;
+      mArrHistPMbits[chID] = pairHistBits.first->second;
+    }
   }
   for (const auto& chID : mSetAllowedChIDsAmpVsTime) {
     auto pairHistAmpVsTime = mMapHistAmpVsTime.insert({ chID, new TH2F(Form("Amp_vs_time_channel%i", chID), Form("Amplitude vs time, channel %i;Amp;Time", chID), 420, -100, 4100, 410, -2050, 2050) });
@@ -222,6 +233,9 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
       mListHistGarbage->Add(pairHistAmpVsTime.first->second);
       getObjectsManager()->startPublishing(pairHistAmpVsTime.first->second);
     }
+    if (chID < DigitQcEngine::sMaxChannels) {
+      mArrHistAmpVsTime[chID] = pairHistAmpVsTime.first->second;
+    }
   }
 
   rebinFromConfig(); // after all histos are created
@@ -238,6 +252,16 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   mUpTimeGate_ChID = o2::quality_control_modules::common::getFromConfig<int>(mCustomParameters, "upTimeGate_ChID", 192);
   mHistChIDperBC = helper::registerHist<TH2F>(getObjectsManager(), PublicationPolicy::Forever, "COLZ", "ChannelIDperBC", Form("FT0 ChannelID per BC, bad PM bit suppression %i, good PM checking %i, gate (%i,%i)", mBadPMbits_ChID, mGoodPMbits_ChID, mLowTimeGate_ChID, mUpTimeGate_ChID), sBCperOrbit, 0, sBCperOrbit, sNCHANNELS_PM, 0, sNCHANNELS_PM);
 
+  mFillTime2Ch.setHistogram(mHistTime2Ch.get());
+  mFillAmp2Ch.setHistogram(mHistAmp2Ch.get());
+  mFillChannelID.setHistogram(mHistChannelID.get());
+  mFillChDataBits.setHistogram(mHistChDataBits.get());
+  mFillChIDperBC.setHistogram(mHistChIDperBC.get());
+  mFillOrbit2BC.setHistogram(mHistOrbit2BC.get());
+  mFillBC.setHistogram(mHistBC.get());
+  mFillBCvsFEEmodules.setHistogram(mHistBCvsFEEmodules.get());
+  mFillOrbitVsFEEmodules.setHistogram(mHistOrbitVsFEEmodules.get());
+
   // Timestamp
   mMetaAnchorOutput = o2::quality_control_modules::common::getFromConfig<std::string>(mCustomParameters, "metaAnchorOutput", "CycleDurationNTF");
   mTimestampMetaField = o2::quality_control_modules::common::getFromConfig<std::string>(mCustomParameters, "timestampMetaField", "timestampTF");
@@ -322,10 +346,10 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     if (digit.mTriggers.getTimeA() == o2::fit::Triggers::DEFAULT_TIME && digit.mTriggers.getTimeC() == o2::fit::Triggers::DEFAULT_TIME) {
       isTCM = false;
     }
-    mHistOrbit2BC->Fill(digit.getIntRecord().orbit % sOrbitsPerTF, digit.getIntRecord().bc);
-    mHistBC->Fill(digit.getBC());
+    mFillOrbit2BC.fill(digit.getIntRecord().orbit % sOrbitsPerTF, digit.getIntRecord().bc);
+    mFillBC.fill(digit.getBC());
 
-    std::set<uint8_t> setFEEmodules{};
+    mDigitQcEngine.startDigit();
 
     int32_t pmSumAmplA = 0;
     int32_t pmSumAmplC = 0;
@@ -336,54 +360,45 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     int pmAverTimeA{ 0 };
     int pmAverTimeC{ 0 };
 
-    std::map<uint8_t, int> mapPMhash2sumAmpl;
-    for (const auto& entry : mMapPMhash2isAside) {
-      mapPMhash2sumAmpl.insert({ entry.first, 0 });
-    }
     for (const auto& chData : vecChData) {
-      mHistTime2Ch->Fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.CFDTime));
-      mHistAmp2Ch->Fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.QTCAmpl));
+      mFillTime2Ch.fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.CFDTime));
+      mFillAmp2Ch.fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.QTCAmpl));
       mStateLastIR2Ch[chData.ChId] = digit.mIntRecord;
-      mHistChannelID->Fill(chData.ChId);
-      if (mSetAllowedChIDs.size() != 0 && mSetAllowedChIDs.find(static_cast<unsigned int>(chData.ChId)) != mSetAllowedChIDs.end()) {
-        mMapHistAmp1D[chData.ChId]->Fill(chData.QTCAmpl);
-        mMapHistTime1D[chData.ChId]->Fill(chData.CFDTime);
-        for (const auto& entry : mMapPMbits) {
-          if ((chData.ChainQTC & (1 << entry.first))) {
-            mMapHistPMbits[chData.ChId]->Fill(entry.first);
-          }
+      mFillChannelID.fill(chData.ChId);
+      if (mMaskAllowedChIDs[chData.ChId]) {
+        mArrHistAmp1D[chData.ChId]->Fill(chData.QTCAmpl);
+        mArrHistTime1D[chData.ChId]->Fill(chData.CFDTime);
+        for (const auto& binPos : mHashedBitBinPos[chData.ChainQTC & mMaskPMbits]) {
+          mArrHistPMbits[chData.ChId]->Fill(binPos);
         }
       }
-      if (mSetAllowedChIDsAmpVsTime.size() != 0 && mSetAllowedChIDsAmpVsTime.find(static_cast<unsigned int>(chData.ChId)) != mSetAllowedChIDsAmpVsTime.end()) {
-        mMapHistAmpVsTime[chData.ChId]->Fill(chData.QTCAmpl, chData.CFDTime);
+      if (mMaskAllowedChIDsAmpVsTime[chData.ChId]) {
+        mArrHistAmpVsTime[chData.ChId]->Fill(chData.QTCAmpl, chData.CFDTime);
       }
       for (const auto& binPos : mHashedBitBinPos[chData.ChainQTC]) {
-        mHistChDataBits->Fill(chData.ChId, binPos);
+        mFillChDataBits.fill(chData.ChId, binPos);
       }
 
-      setFEEmodules.insert(mChID2PMhash[chData.ChId]);
+      mDigitQcEngine.addChannelModule(chData.ChId);
 
       if (((chData.ChainQTC & mPMbitsToCheck_ChID) == mGoodPMbits_ChID) && std::abs(static_cast<Int_t>(chData.CFDTime)) < mTrgValidation.mTrgOrGate) {
-        if (!mMapPMhash2isAside[mChID2PMhash[static_cast<uint8_t>(chData.ChId)]]) {
+        if (!mDigitQcEngine.isChannelInFirstGroup(chData.ChId)) {
           pmSumTimeC += chData.CFDTime;
           pmNChanC++;
-        } else if (mMapPMhash2isAside[mChID2PMhash[static_cast<uint8_t>(chData.ChId)]]) {
+        } else {
           pmSumTimeA += chData.CFDTime;
           pmNChanA++;
         }
-        mHistChIDperBC->Fill(digit.getBC(), chData.ChId);
+        mFillChIDperBC.fill(digit.getBC(), chData.ChId);
       }
       if (chData.getFlag(o2::ft0::ChannelData::kIsCFDinADCgate)) {
-        mapPMhash2sumAmpl[mChID2PMhash[static_cast<uint8_t>(chData.ChId)]] += static_cast<Int_t>(chData.QTCAmpl);
+        mDigitQcEngine.addAmplitude(chData.ChId, static_cast<Int_t>(chData.QTCAmpl));
       }
     }
 
-    for (const auto& entry : mapPMhash2sumAmpl) {
-      if (mMapPMhash2isAside[entry.first])
-        pmSumAmplA += (entry.second >> 3);
-      else
-        pmSumAmplC += (entry.second >> 3);
-    }
+    const auto pmSumAmpl = mDigitQcEngine.getSumAmplitudes();
+    pmSumAmplA = pmSumAmpl.first;
+    pmSumAmplC = pmSumAmpl.second;
 
     if (isTCM) {
       if (pmNChanA > 1) {
@@ -400,7 +415,7 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
       } else {
         pmAverTimeC = 0;
       }
-      setFEEmodules.insert(mTCMhash);
+      mDigitQcEngine.addModule(mTCMhash);
 
     } else {
       pmAverTimeA = o2::fit::Triggers::DEFAULT_TIME;
@@ -408,9 +423,9 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
     auto vtxPos = (pmNChanA && pmNChanC) ? (pmAverTimeC - pmAverTimeA) / 2 : 0;
 
-    for (const auto& feeHash : setFEEmodules) {
-      mHistBCvsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
-      mHistOrbitVsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().orbit % sOrbitsPerTF), static_cast<double>(feeHash));
+    for (const auto& feeHash : mDigitQcEngine.getModules()) {
+      mFillBCvsFEEmodules.fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
+      mFillOrbitVsFEEmodules.fill(static_cast<double>(digit.getIntRecord().orbit % sOrbitsPerTF), static_cast<double>(feeHash));
     }
 
     if (isTCM && digit.mTriggers.getDataIsValid() && !digit.mTriggers.getOutputsAreBlocked()) {
@@ -434,7 +449,8 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
       mHistTimeSum2Diff->Fill((digit.mTriggers.getTimeC() - digit.mTriggers.getTimeA()) * sCFDChannel2NS / 2, (digit.mTriggers.getTimeC() + digit.mTriggers.getTimeA()) * sCFDChannel2NS / 2);
     }
     if (isTCM) {
-      std::vector<unsigned int> vecTrgWords{};
+      auto& vecTrgWords = mVecTrgWords;
+      vecTrgWords.clear();
       const uint64_t trgWordExt = digit.mTriggers.getExtendedTrgWordFT0();
       for (const auto& entry : mMapTechTrgBitsExtra) {
         const auto& trgBit = entry.first;
@@ -459,6 +475,15 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
     // end of triggers re-computation
   }
+  mFillTime2Ch.flush();
+  mFillAmp2Ch.flush();
+  mFillChannelID.flush();
+  mFillChDataBits.flush();
+  mFillChIDperBC.flush();
+  mFillOrbit2BC.flush();
+  mFillBC.flush();
+  mFillBCvsFEEmodules.flush();
+  mFillOrbitVsFEEmodules.flush();
 }
 
 void DigitQcTask::endOfCycle()
@@ -41,6 +41,7 @@
 #include "DataFormatsFV0/ChannelData.h"
 
 #include "FITCommon/DetectorFIT.h"
+#include "FITCommon/DigitQcEngine.h"
 
 using namespace o2::quality_control::core;
 
@@ -116,10 +117,10 @@ class DigitQcTask final : public TaskInterface
   TList* mListHistGarbage;
   std::set<unsigned int> mSetAllowedChIDs;
   std::set<unsigned int> mSetAllowedChIDsAmpVsTime;
+  fit::DigitQcEngine::ChannelMask_t mMaskAllowedChIDsAmpVsTime;
   std::array<o2::InteractionRecord, sNCHANNELS_FV0_PLUSREF> mStateLastIR2Ch;
-  std::array<uint8_t, sNCHANNELS_FV0_PLUSREF> mChID2PMhash; // map chID->hashed PM value
-  uint8_t mTCMhash;                                         // hash value for TCM, and bin position in hist
-  std::map<uint8_t, bool> mMapPMhash2isInner;
+  fit::DigitQcEngine mDigitQcEngine; // chID->hashed PM value, inner PMs and per digit sums, in flat arrays
+  uint8_t mTCMhash;                  // hash value for TCM, and bin position in hist
 
   typename Detector_t::TrgMap_t mMapPMbits = Detector_t::sMapPMbits;
   typename Detector_t::TrgMap_t mMapTechTrgBits = Detector_t::sMapTechTrgBits;
@@ -177,6 +178,7 @@ class DigitQcTask final : public TaskInterface
   std::unique_ptr<TH1D> mHistCycleDurationNTF;
   std::unique_ptr<TH1D> mHistCycleDurationRange;
   std::map<unsigned int, TH2F*> mMapHistAmpVsTime;
+  std::array<TH2F*, fit::DigitQcEngine::sMaxChannels> mArrHistAmpVsTime{}; // the same histograms indexed by channel ID
   std::unique_ptr<TH2F> mHistBCvsTrg;
   std::unique_ptr<TH2F> mHistBCvsFEEmodules;
   std::unique_ptr<TH2F> mHistBcVsFeeForOrATrg;
@@ -191,6 +193,18 @@ class DigitQcTask final : public TaskInterface
   std::unique_ptr<TH2F> mHistPmTcmAverageTimeA;
   std::unique_ptr<TH1F> mHistTriggersSw;
   std::unique_ptr<TH2F> mHistTriggersSoftwareVsTCM;
+  // per channel and per digit fills, applied once per TF
+  fit::FillBuffer mFillTime2Ch;
+  fit::FillBuffer mFillAmp2Ch;
+  fit::FillBuffer mFillEventDensity2Ch;
+  fit::FillBuffer mFillChannelID;
+  fit::FillBuffer mFillNumADC;
+  fit::FillBuffer mFillNumCFD;
+  fit::FillBuffer mFillChDataBits;
+  fit::FillBuffer mFillOrbit2BC;
+  fit::FillBuffer mFillBC;
+  fit::FillBuffer mFillBCvsFEEmodules;
+  fit::FillBuffer mFillOrbitVsFEEmodules;
 
   // Hashed maps
   static const size_t mapSize = 256;
@@ -232,6 +232,7 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   auto lutSorted = lut;
   std::sort(lutSorted.begin(), lutSorted.end(), [](const auto& first, const auto& second) { return first.mModuleName < second.mModuleName; });
   uint8_t binPos{ 0 };
+  std::bitset<DigitQcEngine::sMaxModules> pmHashesWithGroup; // the first channel of a PM decides whether it is inner
   for (const auto& lutEntry : lutSorted) {
     const auto& moduleName = lutEntry.mModuleName;
     const auto& moduleType = lutEntry.mModuleType;
@@ -243,8 +244,12 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
     if (std::regex_match(strChID, std::regex("[[\\d]{1,3}"))) {
       int chID = std::stoi(strChID);
       if (chID < sNCHANNELS_FV0_PLUSREF) {
-        mChID2PMhash[chID] = mapFEE2hash[moduleName];
-        mMapPMhash2isInner.insert({ mapFEE2hash[moduleName], chID < sNCHANNELS_FV0_INNER });
+        const auto pmHash = mapFEE2hash[moduleName];
+        mDigitQcEngine.setModule(chID, pmHash);
+        if (!pmHashesWithGroup[pmHash]) {
+          mDigitQcEngine.setModuleGroup(pmHash, chID < sNCHANNELS_FV0_INNER);
+          pmHashesWithGroup[pmHash] = true;
+        }
       } else {
         LOG(error) << "Incorrect LUT entry: chID " << strChID << " | " << moduleName;
       }
@@ -305,6 +310,7 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
   for (const auto& entry : vecChannelIDsAmpVsTime) {
     mSetAllowedChIDsAmpVsTime.insert(entry);
   }
+  mMaskAllowedChIDsAmpVsTime = DigitQcEngine::makeChannelMask(mSetAllowedChIDsAmpVsTime);
 
   for (const auto& chID : mSetAllowedChIDsAmpVsTime) {
     auto pairHistAmpVsTime = mMapHistAmpVsTime.insert({ chID, new TH2F(Form("Amp_vs_time_channel%i", chID), Form("Amplitude vs time, channel %i;Amp;Time", chID), 420, -100, 4100, 410, -2050, 2050) });
@@ -312,6 +318,9 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
       mListHistGarbage->Add(pairHistAmpVsTime.first->second);
       getObjectsManager()->startPublishing(pairHistAmpVsTime.first->second);
     }
+    if (chID < DigitQcEngine::sMaxChannels) {
+      mArrHistAmpVsTime[chID] = pairHistAmpVsTime.first->second;
+    }
   }
 
   rebinFromConfig(); // after all histos are created
@@ -374,6 +383,17 @@ void DigitQcTask::initialize(o2::framework::InitContext& /*ctx*/)
     TH1* obj = dynamic_cast<TH1*>(getObjectsManager()->getMonitorObject(i)->getObject());
     obj->SetTitle((string("FV0 ") + obj->GetTitle()).c_str());
   }
+  mFillTime2Ch.setHistogram(mHistTime2Ch.get());
+  mFillAmp2Ch.setHistogram(mHistAmp2Ch.get());
+  mFillEventDensity2Ch.setHistogram(mHistEventDensity2Ch.get());
+  mFillChannelID.setHistogram(mHistChannelID.get());
+  mFillNumADC.setHistogram(mHistNumADC.get());
+  mFillNumCFD.setHistogram(mHistNumCFD.get());
+  mFillChDataBits.setHistogram(mHistChDataBits.get());
+  mFillOrbit2BC.setHistogram(mHistOrbit2BC.get());
+  mFillBC.setHistogram(mHistBC.get());
+  mFillBCvsFEEmodules.setHistogram(mHistBCvsFEEmodules.get());
+  mFillOrbitVsFEEmodules.setHistogram(mHistOrbitVsFEEmodules.get());
   // Timestamp
   mMetaAnchorOutput = o2::quality_control_modules::common::getFromConfig<std::string>(mCustomParameters, "metaAnchorOutput", "CycleDurationNTF");
   mTimestampMetaField = o2::quality_control_modules::common::getFromConfig<std::string>(mCustomParameters, "timestampMetaField", "timestampTF");
@@ -460,10 +480,10 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     if (digit.mTriggers.getTimeA() == o2::fit::Triggers::DEFAULT_TIME && digit.mTriggers.getTimeC() == o2::fit::Triggers::DEFAULT_TIME) {
       isTCM = false;
     }
-    mHistOrbit2BC->Fill(digit.getIntRecord().orbit % sOrbitsPerTF, digit.getIntRecord().bc);
-    mHistBC->Fill(digit.getBC());
+    mFillOrbit2BC.fill(digit.getIntRecord().orbit % sOrbitsPerTF, digit.getIntRecord().bc);
+    mFillBC.fill(digit.getBC());
 
-    std::set<uint8_t> setFEEmodules{};
+    mDigitQcEngine.startDigit();
     // reset triggers
     for (auto& entry : mMapTrgSoftware) {
       mMapTrgSoftware[entry.first] = false;
@@ -475,29 +495,24 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     Int_t pmSumTime = 0;
     Int_t pmAverTime = 0;
 
-    std::map<uint8_t, int> mapPMhash2sumAmpl;
-    for (const auto& entry : mMapPMhash2isInner) {
-      mapPMhash2sumAmpl.insert({ entry.first, 0 });
-    }
-
     for (const auto& chData : vecChData) {
-      mHistTime2Ch->Fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.CFDTime));
-      mHistAmp2Ch->Fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.QTCAmpl));
-      mHistEventDensity2Ch->Fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(digit.mIntRecord.differenceInBC(mStateLastIR2Ch[chData.ChId])));
+      mFillTime2Ch.fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.CFDTime));
+      mFillAmp2Ch.fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(chData.QTCAmpl));
+      mFillEventDensity2Ch.fill(static_cast<Double_t>(chData.ChId), static_cast<Double_t>(digit.mIntRecord.differenceInBC(mStateLastIR2Ch[chData.ChId])));
       mStateLastIR2Ch[chData.ChId] = digit.mIntRecord;
-      mHistChannelID->Fill(chData.ChId);
+      mFillChannelID.fill(chData.ChId);
       if (chData.QTCAmpl > 0) {
-        mHistNumADC->Fill(chData.ChId);
+        mFillNumADC.fill(chData.ChId);
       }
-      mHistNumCFD->Fill(chData.ChId);
-      if (mSetAllowedChIDsAmpVsTime.size() != 0 && mSetAllowedChIDsAmpVsTime.find(static_cast<unsigned int>(chData.ChId)) != mSetAllowedChIDsAmpVsTime.end()) {
-        mMapHistAmpVsTime[chData.ChId]->Fill(chData.QTCAmpl, chData.CFDTime);
+      mFillNumCFD.fill(chData.ChId);
+      if (mMaskAllowedChIDsAmpVsTime[chData.ChId]) {
+        mArrHistAmpVsTime[chData.ChId]->Fill(chData.QTCAmpl, chData.CFDTime);
       }
       for (const auto& binPos : mHashedBitBinPos[chData.ChainQTC]) {
-        mHistChDataBits->Fill(chData.ChId, binPos);
+        mFillChDataBits.fill(chData.ChId, binPos);
       }
 
-      setFEEmodules.insert(mChID2PMhash[chData.ChId]);
+      mDigitQcEngine.addChannelModule(chData.ChId);
 
       if (chData.ChId >= sNCHANNELS_FV0) { // skip reference PMT
         continue;
@@ -512,16 +527,13 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
         }
       }
       if (chData.getFlag(o2::fv0::ChannelData::kIsCFDinADCgate)) {
-        mapPMhash2sumAmpl[mChID2PMhash[static_cast<uint8_t>(chData.ChId)]] += static_cast<Int_t>(chData.QTCAmpl);
+        mDigitQcEngine.addAmplitude(chData.ChId, static_cast<Int_t>(chData.QTCAmpl));
       }
     } // channel data loop
 
-    for (const auto& entry : mapPMhash2sumAmpl) {
-      if (mMapPMhash2isInner[entry.first])
-        pmSumAmplIn += static_cast<int>(entry.second >> 3);
-      else
-        pmSumAmplOut += static_cast<int>(entry.second >> 3);
-    }
+    const auto pmSumAmplInOut = mDigitQcEngine.getSumAmplitudes();
+    pmSumAmplIn = pmSumAmplInOut.first;
+    pmSumAmplOut = pmSumAmplInOut.second;
 
     auto pmNChan = pmNChanIn + pmNChanOut;
     auto pmSumAmpl = pmSumAmplIn + pmSumAmplOut;
@@ -532,10 +544,10 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
 
     if (isTCM) {
-      setFEEmodules.insert(mTCMhash);
+      mDigitQcEngine.addModule(mTCMhash);
     }
-    for (const auto& feeHash : setFEEmodules) {
-      mHistBCvsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
+    for (const auto& feeHash : mDigitQcEngine.getModules()) {
+      mFillBCvsFEEmodules.fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
       if (digit.mTriggers.getOrA())
         mHistBcVsFeeForOrATrg->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
       if (digit.mTriggers.getOrAOut())
@@ -546,7 +558,7 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
         mHistBcVsFeeForChargeTrg->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
       if (digit.mTriggers.getOrAIn())
         mHistBcVsFeeForOrAInTrg->Fill(static_cast<double>(digit.getIntRecord().bc), static_cast<double>(feeHash));
-      mHistOrbitVsFEEmodules->Fill(static_cast<double>(digit.getIntRecord().orbit % sOrbitsPerTF), static_cast<double>(feeHash));
+      mFillOrbitVsFEEmodules.fill(static_cast<double>(digit.getIntRecord().orbit % sOrbitsPerTF), static_cast<double>(feeHash));
     }
 
     if (isTCM && digit.mTriggers.getDataIsValid() && !digit.mTriggers.getOutputsAreBlocked()) {
@@ -626,6 +638,17 @@ void DigitQcTask::monitorData(o2::framework::ProcessingContext& ctx)
       // end of triggers re-computation
     }
   } // digit loop
+  mFillTime2Ch.flush();
+  mFillAmp2Ch.flush();
+  mFillEventDensity2Ch.flush();
+  mFillChannelID.flush();
+  mFillNumADC.flush();
+  mFillNumCFD.flush();
+  mFillChDataBits.flush();
+  mFillOrbit2BC.flush();
+  mFillBC.flush();
+  mFillBCvsFEEmodules.flush();
+  mFillOrbitVsFEEmodules.flush();
 }
 
 void DigitQcTask::endOfCycle()
@@ -19,6 +19,7 @@
 
 #include "QualityControl/TaskInterface.h"
 #include "Common/TH2Ratio.h"
+#include "Common/HistogramShards.h"
 
 #include <DataFormatsITSMFT/TopologyDictionary.h>
 #include <ITSBase/GeometryTGeo.h>
@@ -67,6 +68,7 @@ class ITSClusterTask : public TaskInterface
   void addObject(TObject* aObject);
   void getJsonParameters();
   void createAllHistos();
+  void createHistogramShards();
   void addLines();
 
   float getHorizontalBin(float z, int chip, int layer, int lane = 0);
@@ -76,6 +78,7 @@ class ITSClusterTask : public TaskInterface
   static constexpr int NLayerIB = 3;
 
   std::vector<TObject*> mPublishedObjects;
+  std::unique_ptr<HistogramShards> mHistogramShards; //! per-thread buffers of the histograms filled in parallel
 
   // Inner barrel
   TH1D* hClusterTopologySummaryIB[NLayer][48][9] = { { { nullptr } } };
@@ -19,6 +19,8 @@
 #define QC_MODULE_ITS_ITSFHRTASK_H
 
 #include "QualityControl/TaskInterface.h"
+#include "Common/HistogramShards.h"
+#include "ITS/PixelHitCounter.h"
 #include <ITSMFTReconstruction/ChipMappingITS.h>
 #include <ITSMFTReconstruction/PixelData.h>
 #include <ITSBase/GeometryTGeo.h>
@@ -66,6 +68,7 @@ class ITSFhrTask final : public TaskInterface
   void createOccupancyPlots();
   void setPlotsFormat();
   void getParameters(); // get Task parameters from json file
+  void fillStaveHitmaps(); // export the hits counted since the last cycle to the stave hitmaps
   void resetGeneralPlots();
   void resetOccupancyPlots();
   void resetObject(TH1* obj);
@@ -91,7 +94,6 @@ class ITSFhrTask final : public TaskInterface
   const float MidPointRad[7] = { 23.49, 31.586, 39.341, 197.598, 246.944, 345.348, 394.883 };                                                                                                                                                                               // mid point radius
 
   int mNThreads = 1;
-  std::unordered_map<unsigned int, int> mHitPixelID_Hash[7][48][2][14][14]; // layer, stave, substave, hic, chip
 
   o2::itsmft::RawPixelDecoder<o2::itsmft::ChipMappingITS>* mDecoder = nullptr;
   ChipPixelData* mChipDataBuffer = nullptr;
@@ -107,7 +109,10 @@ class ITSFhrTask final : public TaskInterface
   float mPhysicalOccupancyOB = 4.3e-5;
   double mCutTFForSparse = 1; // cut to stop THnSparse filling after mCutTrgForSparse triggers
   int mDoHitmapFilter = 1;    // do filtering of noise pixel vector
-  std::unordered_map<unsigned int, int>*** mHitPixelID_InStave = nullptr /* = new std::unordered_map<unsigned int, int>**[NStaves[lay]]*/;
+  std::vector<PixelHitCounter> mHitCounters;    //! hits per pixel, [stave][hic][chip]
+  std::vector<PixelHitCounter> mHitmapCounters; //! hits per pixel not yet exported to mStaveHitmap, [stave][hic][chip]
+  PixelHitCounter& getHitCounter(int stave, int hic, int chip) { return mHitCounters[(stave * nHicPerStave[mLayer] + hic) * nChipsPerHic[mLayer] + chip]; }
+  PixelHitCounter& getHitmapCounter(int stave, int hic, int chip) { return mHitmapCounters[(stave * nHicPerStave[mLayer] + hic) * nChipsPerHic[mLayer] + chip]; }
   int** mHitnumberLane = nullptr /* = new int*[NStaves[lay]]*/; // IB : hitnumber[stave][chip]; OB : hitnumber[stave][lane]
   double** mOccupancyLane /* = new double*[NStaves[lay]]*/;     // IB : occupancy[stave][chip]; OB : occupancy[stave][Lane]
   int*** mErrorCount = nullptr /* = new int**[NStaves[lay]]*/;  // IB : errorcount[stave][FEE][errorid]
@@ -142,6 +147,7 @@ class ITSFhrTask final : public TaskInterface
   TH2D* mChipStaveOccupancy = nullptr;
   TH2I* mChipStaveEventHitCheck = nullptr;
   TH1D* mOccupancyPlot = nullptr;
+  std::unique_ptr<o2::quality_control_modules::common::HistogramShards> mOccupancyShards; //! per-thread buffers of mOccupancyPlot
   bool mIgnoreRampUpData = true;
   // Geometry decoder
   o2::its::GeometryTGeo* mGeom = nullptr;
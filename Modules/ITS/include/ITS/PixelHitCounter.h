@@ -0,0 +1,152 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   PixelHitCounter.h
+///
+
+#ifndef QC_MODULE_ITS_PIXELHITCOUNTER_H
+#define QC_MODULE_ITS_PIXELHITCOUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace o2::quality_control_modules::its
+{
+
+/// \brief Counts the hits of each pixel of one ALPIDE chip.
+///
+/// As long as few pixels fired, the counters are kept in a flat open-addressing hash table (no allocation per pixel,
+/// no pointer chasing). Once the table would take a sizeable fraction of the memory of a dense chip image, the counter
+/// switches to a dense block of counters with a bitmap of fired pixels, so that iterating stays proportional
+/// to the number of fired pixels in both modes.
+/// The counter is not thread-safe, each chip is expected to be filled by one thread at a time.
+class PixelHitCounter
+{
+ public:
+  static constexpr int NCols = 1024;
+  static constexpr int NRows = 512;
+  static constexpr uint32_t NPixels = NCols * NRows;
+
+  struct PixelCount {
+    int col;
+    int row;
+    uint32_t count;
+  };
+
+  void add(int col, int row, uint32_t hits = 1);
+  uint32_t getCount(int col, int row) const;
+
+  /// \brief Number of pixels with at least one hit
+  size_t getNFiredPixels() const { return mNFired; }
+  /// \brief Sum of the hits of all the pixels
+  uint64_t getNHits() const { return mNHits; }
+  /// \brief Average number of hits per pixel and trigger
+  double getOccupancy(uint64_t nTriggers) const { return nTriggers > 0 ? (double)mNHits / ((double)nTriggers * NPixels) : 0.; }
+  /// \brief The n pixels with the most hits, sorted by decreasing number of hits, then by row and column
+  std::vector<PixelCount> getTopN(size_t n) const;
+  bool isDense() const { return !mCounts.empty(); }
+
+  /// \brief Calls f(col, row, count) for each fired pixel, in no particular order
+  template <typename F>
+  void forEach(F&& f) const;
+  /// \brief Removes the pixels for which pred(col, row, count) is true
+  template <typename P>
+  void removeIf(P&& pred);
+
+  void clear();
+
+ private:
+  struct Slot {
+    uint32_t pixel;
+    uint32_t count;
+  };
+  static constexpr uint32_t EmptyPixel = UINT32_MAX;
+  static constexpr size_t InitialCapacity = 64;
+  // above this number of slots (8 bytes each), the dense representation is cheaper
+  static constexpr size_t MaxSparseCapacity = NPixels / 4;
+
+  static constexpr uint32_t pixelIndex(int col, int row) { return (uint32_t)row * NCols + (uint32_t)col; }
+  size_t slotIndex(uint32_t pixel) const { return (size_t)((pixel * 2654435761u) >> mShift); }
+  void insert(uint32_t pixel, uint32_t hits);
+  void rehash(size_t capacity);
+  void makeDense();
+  void set(uint32_t pixel, uint32_t hits);
+
+  // sparse representation
+  std::vector<Slot> mSlots;
+  int mShift = 32;
+  // dense representation
+  std::vector<uint32_t> mCounts;
+  std::vector<uint64_t> mFired;
+
+  size_t mNFired = 0;
+  uint64_t mNHits = 0;
+};
+
+template <typename F>
+void PixelHitCounter::forEach(F&& f) const
+{
+  if (isDense()) {
+    for (size_t word = 0; word < mFired.size(); word++) {
+      for (uint64_t bits = mFired[word]; bits != 0; bits &= bits - 1) {
+        uint32_t pixel = word * 64 + __builtin_ctzll(bits);
+        f((int)(pixel % NCols), (int)(pixel / NCols), mCounts[pixel]);
+      }
+    }
+  } else {
+    for (const auto& slot : mSlots) {
+      if (slot.pixel != EmptyPixel) {
+        f((int)(slot.pixel % NCols), (int)(slot.pixel / NCols), slot.count);
+      }
+    }
+  }
+}
+
+template <typename P>
+void PixelHitCounter::removeIf(P&& pred)
+{
+  if (isDense()) {
+    for (size_t word = 0; word < mFired.size(); word++) {
+      for (uint64_t bits = mFired[word]; bits != 0; bits &= bits - 1) {
+        int bit = __builtin_ctzll(bits);
+        uint32_t pixel = word * 64 + bit;
+        if (pred((int)(pixel % NCols), (int)(pixel / NCols), mCounts[pixel])) {
+          mNHits -= mCounts[pixel];
+          mNFired--;
+          mCounts[pixel] = 0;
+          mFired[word] &= ~(1ull << bit);
+        }
+      }
+    }
+    return;
+  }
+  // open addressing does not allow to just empty a slot, thus the kept pixels are inserted again
+  std::vector<Slot> kept;
+  kept.reserve(mNFired);
+  for (const auto& slot : mSlots) {
+    if (slot.pixel != EmptyPixel && !pred((int)(slot.pixel % NCols), (int)(slot.pixel / NCols), slot.count)) {
+      kept.push_back(slot);
+    }
+  }
+  if (kept.size() == mNFired) {
+    return;
+  }
+  clear();
+  for (const auto& slot : kept) {
+    insert(slot.pixel, slot.count);
+  }
+}
+
+} // namespace o2::quality_control_modules::its
+
+#endif // QC_MODULE_ITS_PIXELHITCOUNTER_H
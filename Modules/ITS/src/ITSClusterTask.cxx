@@ -91,6 +91,7 @@ void ITSClusterTask::initialize(o2::framework::InitContext& /*ctx*/)
   setZBinningOB();
 
   createAllHistos();
+  createHistogramShards();
   mGeneralOccupancy = std::make_unique<TH2DRatio>("General/General_Occupancy", "General Cluster Occupancy (max n_clusters/event/chip)", 24, -12, 12, 14, 0, 14, true);
 
   addObject(mGeneralOccupancy.get());
@@ -139,20 +140,40 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
   auto clusArr = ctx.inputs().get<gsl::span<o2::itsmft::CompClusterExt>>("compclus");
   auto clusRofArr = ctx.inputs().get<gsl::span<o2::itsmft::ROFRecord>>("clustersrof");
   auto clusPatternArr = ctx.inputs().get<gsl::span<unsigned char>>("patterns");
-  auto pattIt = clusPatternArr.begin();
 
   // Reset this histo to have the latest picture
   hEmptyLaneFractionGlobal->Reset("ICES");
 
+  // The patterns of the clusters are stored one after another, thus we find where the patterns of each ROF start,
+  // so that the ROFs can be processed in parallel
+  std::vector<decltype(clusPatternArr.begin())> rofPattIt;
+  rofPattIt.reserve(clusRofArr.size());
+  auto nextPattIt = clusPatternArr.begin();
+  for (const auto& ROF : clusRofArr) {
+    rofPattIt.push_back(nextPattIt);
+    for (int icl = ROF.getFirstEntry(); icl < ROF.getFirstEntry() + ROF.getNEntries(); icl++) {
+      auto ClusterID = clusArr[icl].getPatternID();
+      if (ClusterID == o2::itsmft::CompCluster::InvalidPatternID || mDict->isGroup(ClusterID)) {
+        o2::itsmft::ClusterPattern::skipPattern(nextPattIt);
+      }
+    }
+  }
+
 #ifdef WITH_OPENMP
   omp_set_num_threads(mNThreads);
 #pragma omp parallel for schedule(dynamic)
 #endif
 
-  // Filling cluster histogram for each ROF by open_mp
+  // Filling cluster histogram for each ROF by open_mp, each thread fills its own histogram shard
   for (unsigned int iROF = 0; iROF < clusRofArr.size(); iROF++) {
 
+#ifdef WITH_OPENMP
+    const int thread = omp_get_thread_num();
+#else
+    const int thread = 0;
+#endif
     const auto& ROF = clusRofArr[iROF];
+    auto pattIt = rofPattIt[iROF];
     const auto bcdata = ROF.getBCData();
     int nClustersForBunchCrossing = 0;
     int nLongClusters[ChipBoundary[NLayerIB]] = {};
@@ -226,37 +247,37 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
       }
 
       if (lay < NLayerIB) {
-        hAverageClusterOccupancySummaryIB[lay]->getNum()->Fill(chip, sta);
-        hAverageClusterSizeSummaryIB[lay]->getNum()->Fill(chip, sta, (double)npix);
-        hAverageClusterSizeSummaryIB[lay]->getDen()->Fill(chip, sta, 1.);
+        mHistogramShards->fill(thread, hAverageClusterOccupancySummaryIB[lay]->getNum(), chip, sta);
+        mHistogramShards->fill(thread, hAverageClusterSizeSummaryIB[lay]->getNum(), chip, sta, (double)npix);
+        mHistogramShards->fill(thread, hAverageClusterSizeSummaryIB[lay]->getDen(), chip, sta, 1.);
         if (mDoPublish1DSummary == 1) {
-          hClusterTopologySummaryIB[lay][sta][chip]->Fill(ClusterID);
+          mHistogramShards->fill(thread, hClusterTopologySummaryIB[lay][sta][chip], ClusterID);
         }
 
-        hClusterSizeLayerSummary[lay]->Fill(npix);
-        hClusterTopologyLayerSummary[lay]->Fill(ClusterID);
+        mHistogramShards->fill(thread, hClusterSizeLayerSummary[lay], npix);
+        mHistogramShards->fill(thread, hClusterTopologyLayerSummary[lay], ClusterID);
 
         if (isGrouped) {
           if (mDoPublish1DSummary == 1) {
-            hGroupedClusterSizeSummaryIB[lay][sta][chip]->Fill(npix);
+            mHistogramShards->fill(thread, hGroupedClusterSizeSummaryIB[lay][sta][chip], npix);
           }
-          hGroupedClusterSizeLayerSummary[lay]->Fill(npix);
+          mHistogramShards->fill(thread, hGroupedClusterSizeLayerSummary[lay], npix);
         }
       } else {
-        hAverageClusterOccupancySummaryOB[lay]->getNum()->Fill(lane, sta, 1. / (mNChipsPerHic[lay] / mNLanePerHic[lay])); // 14 To have occupation per chip -> 7 because we're considering lanes
-        hAverageClusterSizeSummaryOB[lay]->getNum()->Fill(lane, sta, (double)npix);
-        hAverageClusterSizeSummaryOB[lay]->getDen()->Fill(lane, sta, 1);
+        mHistogramShards->fill(thread, hAverageClusterOccupancySummaryOB[lay]->getNum(), lane, sta, 1. / (mNChipsPerHic[lay] / mNLanePerHic[lay])); // 14 To have occupation per chip -> 7 because we're considering lanes
+        mHistogramShards->fill(thread, hAverageClusterSizeSummaryOB[lay]->getNum(), lane, sta, (double)npix);
+        mHistogramShards->fill(thread, hAverageClusterSizeSummaryOB[lay]->getDen(), lane, sta, 1);
         if (mDoPublish1DSummary == 1) {
-          hClusterTopologySummaryOB[lay][sta]->Fill(ClusterID);
-          hClusterSizeSummaryOB[lay][sta]->Fill(npix);
+          mHistogramShards->fill(thread, hClusterTopologySummaryOB[lay][sta], ClusterID);
+          mHistogramShards->fill(thread, hClusterSizeSummaryOB[lay][sta], npix);
         }
-        hClusterSizeLayerSummary[lay]->Fill(npix);
-        hClusterTopologyLayerSummary[lay]->Fill(ClusterID);
+        mHistogramShards->fill(thread, hClusterSizeLayerSummary[lay], npix);
+        mHistogramShards->fill(thread, hClusterTopologyLayerSummary[lay], ClusterID);
         if (isGrouped) {
           if (mDoPublish1DSummary == 1) {
-            hGroupedClusterSizeSummaryOB[lay][sta]->Fill(npix);
+            mHistogramShards->fill(thread, hGroupedClusterSizeSummaryOB[lay][sta], npix);
           }
-          hGroupedClusterSizeLayerSummary[lay]->Fill(npix);
+          mHistogramShards->fill(thread, hGroupedClusterSizeLayerSummary[lay], npix);
         }
       }
 
@@ -266,14 +287,14 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
         float phi = (float)TMath::ATan2(gloC.Y(), gloC.X());
 
         phi = (float)(phi * 180 / TMath::Pi());
-        hAverageClusterOccupancySummaryZPhi[lay]->getNum()->Fill(gloC.Z(), phi);
-        hAverageClusterSizeSummaryZPhi[lay]->getNum()->Fill(gloC.Z(), phi, (float)npix);
+        mHistogramShards->fill(thread, hAverageClusterOccupancySummaryZPhi[lay]->getNum(), gloC.Z(), phi);
+        mHistogramShards->fill(thread, hAverageClusterSizeSummaryZPhi[lay]->getNum(), gloC.Z(), phi, (float)npix);
 
-        hAverageClusterOccupancySummaryFine[lay]->getNum()->Fill(getHorizontalBin(locC.Z(), chip, lay, lane), getVerticalBin(locC.X(), sta, lay));
-        hAverageClusterSizeSummaryFine[lay]->getNum()->Fill(getHorizontalBin(locC.Z(), chip, lay, lane), getVerticalBin(locC.X(), sta, lay), (float)npix);
+        mHistogramShards->fill(thread, hAverageClusterOccupancySummaryFine[lay]->getNum(), getHorizontalBin(locC.Z(), chip, lay, lane), getVerticalBin(locC.X(), sta, lay));
+        mHistogramShards->fill(thread, hAverageClusterSizeSummaryFine[lay]->getNum(), getHorizontalBin(locC.Z(), chip, lay, lane), getVerticalBin(locC.X(), sta, lay), (float)npix);
       }
     }
-    hClusterVsBunchCrossing->Fill(bcdata.bc, nClustersForBunchCrossing); // we count only the number of clusters, not their sizes
+    mHistogramShards->fill(thread, hClusterVsBunchCrossing, bcdata.bc, nClustersForBunchCrossing); // we count only the number of clusters, not their sizes
 
     // filling these anomaly plots once per ROF, ignoring chips w/o long clusters
     for (int ichip = 0; ichip < ChipBoundary[NLayerIB]; ichip++) {
@@ -286,10 +307,11 @@ void ITSClusterTask::monitorData(o2::framework::ProcessingContext& ctx)
       while (ichip >= ChipBoundary[ilayer + 1]) {
         ilayer++;
       }
-      hLongClustersPerChip[ilayer]->Fill(ichip, nLong);
-      hMultPerChipWhenLongClusters[ilayer]->Fill(ichip, nHitsFromClusters[ichip]);
+      mHistogramShards->fill(thread, hLongClustersPerChip[ilayer], ichip, nLong);
+      mHistogramShards->fill(thread, hMultPerChipWhenLongClusters[ilayer], ichip, nHitsFromClusters[ichip]);
     }
   }
+  mHistogramShards->merge();
 
   if ((int)clusRofArr.size() > 0) {
 
@@ -650,6 +672,19 @@ void ITSClusterTask::addObject(TObject* aObject)
     mPublishedObjects.push_back(aObject);
 }
 
+void ITSClusterTask::createHistogramShards()
+{
+  mHistogramShards = std::make_unique<HistogramShards>(mNThreads);
+  for (auto* object : mPublishedObjects) {
+    if (auto* ratio = dynamic_cast<TH2DRatio*>(object)) {
+      mHistogramShards->add(ratio->getNum());
+      mHistogramShards->add(ratio->getDen());
+    } else if (auto* histogram = dynamic_cast<TH1*>(object)) {
+      mHistogramShards->add(histogram);
+    }
+  }
+}
+
 void ITSClusterTask::publishHistos()
 {
   for (unsigned int iObj = 0; iObj < mPublishedObjects.size(); iObj++) {
@@ -70,10 +70,6 @@ ITSFhrTask::~ITSFhrTask()
       delete[] mErrorCount[istave][ilink];
     }
     delete[] mErrorCount[istave];
-    for (int ihic = 0; ihic < nHicPerStave[mLayer]; ihic++) {
-      delete[] mHitPixelID_InStave[istave][ihic];
-    }
-    delete[] mHitPixelID_InStave[istave];
   }
   delete[] mHitnumberLane;
   delete[] mOccupancyLane;
@@ -81,7 +77,6 @@ ITSFhrTask::~ITSFhrTask()
   delete[] mChipZ;
   delete[] mChipStat;
   delete[] mErrorCount;
-  delete[] mHitPixelID_InStave;
 }
 
 void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
@@ -105,6 +100,10 @@ void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
   createGeneralPlots();
   createOccupancyPlots();
   setPlotsFormat();
+  mOccupancyShards = std::make_unique<HistogramShards>(mNThreads);
+  if (mOccupancyPlot) {
+    mOccupancyShards->add(mOccupancyPlot);
+  }
   mDecoder = new o2::itsmft::RawPixelDecoder<o2::itsmft::ChipMappingITS>();
   mDecoder->init();
   mDecoder->setSkipRampUpData(mIgnoreRampUpData);
@@ -115,7 +114,8 @@ void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
 
   if (mLayer != -1) {
     // define the hitnumber, occupancy, errorcount array
-    mHitPixelID_InStave = new std::unordered_map<unsigned int, int>**[NStaves[mLayer]];
+    mHitCounters.resize(NStaves[mLayer] * nHicPerStave[mLayer] * nChipsPerHic[mLayer]);
+    mHitmapCounters.resize(NStaves[mLayer] * nHicPerStave[mLayer] * nChipsPerHic[mLayer]);
     mHitnumberLane = new int*[NStaves[mLayer]];
     mOccupancyLane = new double*[NStaves[mLayer]];
     mChipPhi = new double*[NStaves[mLayer]];
@@ -176,10 +176,6 @@ void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
         mChipZ[istave] = new double[nChipsPerHic[mLayer]];
 
         mChipStat[istave] = new int[nChipsPerHic[mLayer]];
-        mHitPixelID_InStave[istave] = new std::unordered_map<unsigned int, int>*[nHicPerStave[mLayer]];
-        for (int ihic = 0; ihic < nHicPerStave[mLayer]; ihic++) {
-          mHitPixelID_InStave[istave][ihic] = new std::unordered_map<unsigned int, int>[nChipsPerHic[mLayer]];
-        }
         for (int ichip = 0; ichip < nChipsPerHic[mLayer]; ichip++) {
           mHitnumberLane[istave][ichip] = 0;
           mOccupancyLane[istave][ichip] = 0;
@@ -199,10 +195,6 @@ void ITSFhrTask::initialize(o2::framework::InitContext& /*ctx*/)
         mChipZ[istave] = new double[nHicPerStave[mLayer] * nChipsPerHic[mLayer]];
 
         mChipStat[istave] = new int[nHicPerStave[mLayer] * nChipsPerHic[mLayer]];
-        mHitPixelID_InStave[istave] = new std::unordered_map<unsigned int, int>*[nHicPerStave[mLayer]];
-        for (int ihic = 0; ihic < nHicPerStave[mLayer]; ihic++) {
-          mHitPixelID_InStave[istave][ihic] = new std::unordered_map<unsigned int, int>[nChipsPerHic[mLayer]];
-        }
         for (int ichip = 0; ichip < nHicPerStave[mLayer] * nChipsPerHic[mLayer]; ichip++) {
           mChipPhi[istave][ichip] = 0;
           mChipZ[istave][ichip] = 0;
@@ -487,56 +479,46 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
     }
   }
 
+  unsigned long nHitsTF = 0;
 #ifdef WITH_OPENMP
   omp_set_num_threads(mNThreads);
-#pragma omp parallel for schedule(dynamic)
+#pragma omp parallel for schedule(dynamic) reduction(+ \
+                                                     : nHitsTF)
 #endif
-  // save digit hit vector to unordered_map by openMP multiple threads
+  // save digit hit vector to the pixel hit counters by openMP multiple threads
   // the reason of this step is: it will spend many time If we THnSparse::Fill the THnspase hit by hit.
-  // So we want save hit information to undordered_map and fill THnSparse by THnSparse::SetBinContent (pixel by pixel)
+  // So we count the hits of each pixel and fill THnSparse in bulk in endOfCycle (pixel by pixel)
   for (int i = 0; i < (int)activeStaves.size(); i++) {
     int istave = activeStaves[i];
     if (mLayer < NLayerIB) {
       for (auto& digit : digVec[istave][0]) {
         int chip = digit.getChipIndex() % 9;
-        mHitPixelID_InStave[istave][0][chip][1000 * digit.getColumn() + digit.getRow()]++;
-        nHitsTotal++;
+        getHitCounter(istave, 0, chip).add(digit.getColumn(), digit.getRow());
+        nHitsTF++;
         if (mTFCount <= mCutTFForSparse) {
-          Double_t pixelPos[2] = { 1. * (digit.getColumn() + (1024 * chip)), 1. * digit.getRow() };
-          mStaveHitmap[istave]->Fill(pixelPos);
+          getHitmapCounter(istave, 0, chip).add(digit.getColumn(), digit.getRow());
         }
       }
     } else {
       for (int ihic = 0; ihic < nHicPerStave[mLayer]; ihic++) {
         for (auto& digit : digVec[istave][ihic]) {
           int chip = ((digit.getChipIndex() - ChipBoundary[mLayer]) % (14 * nHicPerStave[mLayer])) % 14;
-          mHitPixelID_InStave[istave][ihic][chip][1000 * digit.getColumn() + digit.getRow()]++;
-          nHitsTotal++;
-          int ilink = ihic / (nHicPerStave[mLayer] / 2);
+          getHitCounter(istave, ihic, chip).add(digit.getColumn(), digit.getRow());
+          nHitsTF++;
           if (mTFCount <= mCutTFForSparse) {
-            if (chip < 7) {
-              Double_t pixelPos[2] = { 1. * ((ihic % (nHicPerStave[mLayer] / NSubStave[mLayer]) * ((nChipsPerHic[mLayer] / 2) * NCols)) + chip * NCols + digit.getColumn()), 1. * (NRows - digit.getRow() - 1 + (1024 * ilink)) };
-              mStaveHitmap[istave]->Fill(pixelPos);
-            } else {
-              Double_t pixelPos[2] = { 1. * ((ihic % (nHicPerStave[mLayer] / NSubStave[mLayer]) * ((nChipsPerHic[mLayer] / 2) * NCols)) + (nChipsPerHic[mLayer] / 2) * NCols - (chip - 7) * NCols - digit.getColumn() * 1.), 1. * (NRows + digit.getRow() + (1024 * ilink)) };
-              mStaveHitmap[istave]->Fill(pixelPos);
-            }
+            getHitmapCounter(istave, ihic, chip).add(digit.getColumn(), digit.getRow());
           }
         }
       }
     }
   }
 
+  nHitsTotal += nHitsTF;
+
   // Reset Error plots
   mErrorPlots->Reset();
   mErrorVsFeeid->Reset(); // Error is   statistic by decoder so if we didn't reset decoder, then we need reset Error plots, and use TH::SetBinContent function
 
-  // define tmp occupancy plot, which will use for multiple threads
-  TH1D** occupancyPlotTmp = new TH1D*[(int)activeStaves.size()];
-  for (int i = 0; i < (int)activeStaves.size(); i++) {
-    occupancyPlotTmp[i] = new TH1D("", "", 300, -15, 0);
-  }
-
   int totalhit = 0;
 
 #ifdef WITH_OPENMP
@@ -545,7 +527,13 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
                                                      : totalhit)
 #endif
   // fill Monitor Objects use openMP multiple threads, and calculate the occupancy
+  // the occupancy plot is filled through per-thread shards, which are merged after the loop
   for (int i = 0; i < (int)activeStaves.size(); i++) {
+#ifdef WITH_OPENMP
+    const int thread = omp_get_thread_num();
+#else
+    const int thread = 0;
+#endif
     int istave = activeStaves[i];
     if (digVec[istave][0].size() < 1 && mLayer < NLayerIB) {
       continue;
@@ -565,27 +553,21 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
 
         mNoisyPixelNumber[mLayer][istave] = 0;
         for (int ichip = 0 + (ilink * 3); ichip < (ilink * 3) + 3; ichip++) {
-          std::unordered_map<unsigned int, int>::iterator iter;
+          auto& hitCounter = getHitCounter(istave, 0, ichip);
 
           if (mDoHitmapFilter == 1) {
-            for (auto iter = mHitPixelID_InStave[istave][0][ichip].begin(); iter != mHitPixelID_InStave[istave][0][ichip].end();) {
-              if ((double)iter->second / 10 < (double)nHitsTotal / ((ChipBoundary[mLayer + 1] - ChipBoundary[mLayer]) * 1024 * 512)) { // noisy if more than 3x of averaged per chip
-                mHitPixelID_InStave[istave][0][ichip].erase(iter++);
-              } else {
-                ++iter;
-              }
-            }
+            double averageHits = (double)nHitsTotal / ((ChipBoundary[mLayer + 1] - ChipBoundary[mLayer]) * 1024 * 512);
+            hitCounter.removeIf([averageHits](int, int, uint32_t hits) { return (double)hits / 10 < averageHits; }); // noisy if more than 3x of averaged per chip
           }
 
-          for (auto iter = mHitPixelID_InStave[istave][0][ichip].begin(); iter != mHitPixelID_InStave[istave][0][ichip].end(); iter++) {
-            if ((iter->second > mHitCutForNoisyPixel) &&
-                (iter->second / (double)GBTLinkInfo->statistics.nTriggers) > mOccupancyCutForNoisyPixel) {
+          hitCounter.forEach([&](int, int, uint32_t hits) {
+            if (((int)hits > mHitCutForNoisyPixel) &&
+                (hits / (double)GBTLinkInfo->statistics.nTriggers) > mOccupancyCutForNoisyPixel) {
               mNoisyPixelNumber[mLayer][istave]++; // count only in 10000 events as soon as nTriggers is 1e6
-              occupancyPlotTmp[i]->Fill(log10((double)iter->second / GBTLinkInfo->statistics.nTriggers));
+              mOccupancyShards->fill(thread, mOccupancyPlot, log10((double)hits / GBTLinkInfo->statistics.nTriggers));
             }
-
-            totalhit += (int)iter->second;
-          }
+          });
+          totalhit += (int)hitCounter.getNHits();
 
           mOccupancyLane[istave][ichip] = mHitnumberLane[istave][ichip] / (GBTLinkInfo->statistics.nTriggers * 1024. * 512.);
         }
@@ -609,23 +591,18 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
           for (int ichip = 0; ichip < nChipsPerHic[mLayer]; ichip++) {
             if (GBTLinkInfo->statistics.nTriggers > 0) {
 
+              auto& hitCounter = getHitCounter(istave, ihic + ilink * ((nHicPerStave[mLayer] / NSubStave[mLayer])), ichip);
               if (mDoHitmapFilter == 1) {
-                for (auto iter = mHitPixelID_InStave[istave][ihic + ilink * ((nHicPerStave[mLayer] / NSubStave[mLayer]))][ichip].begin(); iter != mHitPixelID_InStave[istave][ihic + ilink * ((nHicPerStave[mLayer] / NSubStave[mLayer]))][ichip].end();) {
-                  if ((double)iter->second / 100 < (double)nHitsTotal / ((ChipBoundary[mLayer + 1] - ChipBoundary[mLayer]) * 1024 * 512)) { // noisy if more than 3x of averaged per chip
-                    mHitPixelID_InStave[istave][ihic + ilink * ((nHicPerStave[mLayer] / NSubStave[mLayer]))][ichip].erase(iter++);
-
-                  } else {
-                    ++iter;
-                  }
-                }
+                double averageHits = (double)nHitsTotal / ((ChipBoundary[mLayer + 1] - ChipBoundary[mLayer]) * 1024 * 512);
+                hitCounter.removeIf([averageHits](int, int, uint32_t hits) { return (double)hits / 100 < averageHits; }); // noisy if more than 3x of averaged per chip
               }
-              for (auto iter = mHitPixelID_InStave[istave][ihic + ilink * ((nHicPerStave[mLayer] / NSubStave[mLayer]))][ichip].begin(); iter != mHitPixelID_InStave[istave][ihic + ilink * ((nHicPerStave[mLayer] / NSubStave[mLayer]))][ichip].end(); iter++) {
-                if ((iter->second > mHitCutForNoisyPixel) &&
-                    (iter->second / (double)GBTLinkInfo->statistics.nTriggers) > mOccupancyCutForNoisyPixel) {
+              hitCounter.forEach([&](int, int, uint32_t hits) {
+                if (((int)hits > mHitCutForNoisyPixel) &&
+                    (hits / (double)GBTLinkInfo->statistics.nTriggers) > mOccupancyCutForNoisyPixel) {
                   mNoisyPixelNumber[mLayer][istave]++;
-                  occupancyPlotTmp[i]->Fill(log10((double)iter->second / GBTLinkInfo->statistics.nTriggers));
+                  mOccupancyShards->fill(thread, mOccupancyPlot, log10((double)hits / GBTLinkInfo->statistics.nTriggers));
                 }
-              }
+              });
             }
           }
 
@@ -646,10 +623,11 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
       }
     }
   }
-  // fill Occupancy plots, chip stave occupancy plots and error statistic plots
+  mOccupancyShards->merge();
+
+  // fill chip stave occupancy plots and error statistic plots
   for (int i = 0; i < (int)activeStaves.size(); i++) {
     int istave = activeStaves[i];
-    mOccupancyPlot->Add(occupancyPlotTmp[i]);
     if (mLayer < NLayerIB) {
       for (int ichip = 0; ichip < nChipsPerHic[mLayer]; ichip++) {
         mChipStaveOccupancy->SetBinContent(ichip + 1, istave + 1, mOccupancyLane[istave][ichip]);
@@ -715,11 +693,6 @@ void ITSFhrTask::monitorData(o2::framework::ProcessingContext& ctx)
   }
   delete[] digVec;
 
-  for (int i = 0; i < (int)activeStaves.size(); i++) {
-    delete occupancyPlotTmp[i];
-  }
-  delete[] occupancyPlotTmp;
-
   end = std::chrono::high_resolution_clock::now();
   difference = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
 
@@ -749,6 +722,45 @@ void ITSFhrTask::getParameters()
 void ITSFhrTask::endOfCycle()
 {
   ILOG(Debug, Devel) << "endOfCycle" << ENDM;
+  fillStaveHitmaps();
+}
+
+void ITSFhrTask::fillStaveHitmaps()
+{
+  if (mLayer < 0 || mHitmapCounters.empty()) {
+    return;
+  }
+  for (int istave = 0; istave < NStaves[mLayer]; istave++) {
+    auto* hitmap = mStaveHitmap[istave];
+    // AddBinContent() does not count the entries, they are added once per stave, one per hit as with Fill()
+    Long64_t nHits = 0;
+    for (int ihic = 0; ihic < nHicPerStave[mLayer]; ihic++) {
+      for (int ichip = 0; ichip < nChipsPerHic[mLayer]; ichip++) {
+        auto& hitmapCounter = getHitmapCounter(istave, ihic, ichip);
+        hitmapCounter.forEach([&](int col, int row, uint32_t hits) {
+          Double_t pixelPos[2];
+          if (mLayer < NLayerIB) {
+            pixelPos[0] = 1. * (col + (1024 * ichip));
+            pixelPos[1] = 1. * row;
+          } else if (ichip < 7) {
+            int ilink = ihic / (nHicPerStave[mLayer] / 2);
+            pixelPos[0] = 1. * ((ihic % (nHicPerStave[mLayer] / NSubStave[mLayer]) * ((nChipsPerHic[mLayer] / 2) * NCols)) + ichip * NCols + col);
+            pixelPos[1] = 1. * (NRows - row - 1 + (1024 * ilink));
+          } else {
+            int ilink = ihic / (nHicPerStave[mLayer] / 2);
+            pixelPos[0] = 1. * ((ihic % (nHicPerStave[mLayer] / NSubStave[mLayer]) * ((nChipsPerHic[mLayer] / 2) * NCols)) + (nChipsPerHic[mLayer] / 2) * NCols - (ichip - 7) * NCols - col * 1.);
+            pixelPos[1] = 1. * (NRows + row + (1024 * ilink));
+          }
+          hitmap->AddBinContent(hitmap->GetBin(pixelPos), hits);
+        });
+        nHits += hitmapCounter.getNHits();
+        hitmapCounter.clear();
+      }
+    }
+    if (nHits > 0) {
+      hitmap->SetEntries(hitmap->GetEntries() + nHits);
+    }
+  }
 }
 
 void ITSFhrTask::endOfActivity(const Activity& /*activity*/)
@@ -801,7 +813,8 @@ void ITSFhrTask::reset()
       for (int ichip = 0; ichip < nChipsPerHic[mLayer]; ichip++) {
         mHitnumberLane[istave][ichip] = 0;
         mOccupancyLane[istave][ichip] = 0;
-        mHitPixelID_InStave[istave][0][ichip].clear();
+        getHitCounter(istave, 0, ichip).clear();
+        getHitmapCounter(istave, 0, ichip).clear();
         mChipStat[istave][ichip] = 0;
       }
     }
@@ -818,7 +831,8 @@ void ITSFhrTask::reset()
         mOccupancyLane[istave][2 * ihic] = 0;
         mOccupancyLane[istave][2 * ihic + 1] = 0;
         for (int ichip = 0; ichip < nChipsPerHic[mLayer]; ichip++) {
-          mHitPixelID_InStave[istave][ihic][ichip].clear();
+          getHitCounter(istave, ihic, ichip).clear();
+          getHitmapCounter(istave, ihic, ichip).clear();
           mChipStat[istave][ihic * nChipsPerHic[mLayer] + ichip] = 0;
         }
       }
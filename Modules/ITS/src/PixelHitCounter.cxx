@@ -0,0 +1,149 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+///
+/// \file   PixelHitCounter.cxx
+///
+
+#include "ITS/PixelHitCounter.h"
+
+#include <algorithm>
+
+namespace o2::quality_control_modules::its
+{
+
+void PixelHitCounter::add(int col, int row, uint32_t hits)
+{
+  insert(pixelIndex(col, row), hits);
+}
+
+void PixelHitCounter::insert(uint32_t pixel, uint32_t hits)
+{
+  mNHits += hits;
+  if (isDense()) {
+    set(pixel, hits);
+    return;
+  }
+  if (mSlots.empty()) {
+    rehash(InitialCapacity);
+  }
+  const size_t mask = mSlots.size() - 1;
+  for (size_t i = slotIndex(pixel);; i = (i + 1) & mask) {
+    auto& slot = mSlots[i];
+    if (slot.pixel == pixel) {
+      slot.count += hits;
+      return;
+    }
+    if (slot.pixel == EmptyPixel) {
+      slot = { pixel, hits };
+      mNFired++;
+      // keeping the load factor below 1/2 keeps the probe sequences short
+      if (2 * mNFired > mSlots.size()) {
+        if (2 * mSlots.size() > MaxSparseCapacity) {
+          makeDense();
+        } else {
+          rehash(2 * mSlots.size());
+        }
+      }
+      return;
+    }
+  }
+}
+
+void PixelHitCounter::set(uint32_t pixel, uint32_t hits)
+{
+  if (mCounts[pixel] == 0) {
+    mFired[pixel / 64] |= 1ull << (pixel % 64);
+    mNFired++;
+  }
+  mCounts[pixel] += hits;
+}
+
+void PixelHitCounter::rehash(size_t capacity)
+{
+  std::vector<Slot> slots(capacity, Slot{ EmptyPixel, 0 });
+  mSlots.swap(slots);
+  mShift = 32 - __builtin_ctzll(capacity);
+  const size_t mask = capacity - 1;
+  for (const auto& slot : slots) {
+    if (slot.pixel == EmptyPixel) {
+      continue;
+    }
+    size_t i = slotIndex(slot.pixel);
+    while (mSlots[i].pixel != EmptyPixel) {
+      i = (i + 1) & mask;
+    }
+    mSlots[i] = slot;
+  }
+}
+
+void PixelHitCounter::makeDense()
+{
+  mCounts.assign(NPixels, 0);
+  mFired.assign(NPixels / 64, 0);
+  mNFired = 0;
+  for (const auto& slot : mSlots) {
+    if (slot.pixel != EmptyPixel) {
+      set(slot.pixel, slot.count);
+    }
+  }
+  std::vector<Slot>().swap(mSlots);
+}
+
+uint32_t PixelHitCounter::getCount(int col, int row) const
+{
+  const uint32_t pixel = pixelIndex(col, row);
+  if (isDense()) {
+    return mCounts[pixel];
+  }
+  if (mSlots.empty()) {
+    return 0;
+  }
+  const size_t mask = mSlots.size() - 1;
+  for (size_t i = slotIndex(pixel);; i = (i + 1) & mask) {
+    if (mSlots[i].pixel == pixel) {
+      return mSlots[i].count;
+    }
+    if (mSlots[i].pixel == EmptyPixel) {
+      return 0;
+    }
+  }
+}
+
+std::vector<PixelHitCounter::PixelCount> PixelHitCounter::getTopN(size_t n) const
+{
+  std::vector<PixelCount> pixels;
+  pixels.reserve(mNFired);
+  forEach([&pixels](int col, int row, uint32_t count) { pixels.push_back({ col, row, count }); });
+  n = std::min(n, pixels.size());
+  // the pixels with the same number of hits are sorted by position, so that the result does not depend on the representation
+  std::partial_sort(pixels.begin(), pixels.begin() + n, pixels.end(), [](const PixelCount& a, const PixelCount& b) {
+    return a.count != b.count ? a.count > b.count : pixelIndex(a.col, a.row) < pixelIndex(b.col, b.row);
+  });
+  pixels.resize(n);
+  return pixels;
+}
+
+void PixelHitCounter::clear()
+{
+  // a chip which became dense goes back to the sparse representation, most likely it was a transient noise burst
+  if (isDense()) {
+    std::vector<uint32_t>().swap(mCounts);
+    std::vector<uint64_t>().swap(mFired);
+    rehash(InitialCapacity);
+  } else {
+    std::fill(mSlots.begin(), mSlots.end(), Slot{ EmptyPixel, 0 });
+  }
+  mNFired = 0;
+  mNHits = 0;
+}
+
+} // namespace o2::quality_control_modules::its
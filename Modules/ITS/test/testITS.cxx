@@ -14,23 +14,229 @@
 /// \author
 ///
 
-#include "QualityControl/TaskFactory.h"
+#include "ITS/PixelHitCounter.h"
 
-#define BOOST_TEST_MODULE Publisher test
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#define BOOST_TEST_MODULE ITS test
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 
 #include <boost/test/unit_test.hpp>
 
-namespace o2
+namespace o2::quality_control_modules::its
+{
+
+namespace
+{
+
+// (row, col) -> hits, thus ordered as the pixel indices
+using Reference = std::map<std::pair<int, int>, uint32_t>;
+
+void add(PixelHitCounter& counter, Reference& reference, int col, int row, uint32_t hits)
+{
+  counter.add(col, row, hits);
+  reference[{ row, col }] += hits;
+}
+
+void checkSame(const PixelHitCounter& counter, const Reference& reference)
 {
-namespace quality_control_modules
+  uint64_t nHits = 0;
+  for (const auto& [pixel, count] : reference) {
+    nHits += count;
+  }
+  BOOST_CHECK_EQUAL(counter.getNFiredPixels(), reference.size());
+  BOOST_CHECK_EQUAL(counter.getNHits(), nHits);
+
+  Reference iterated;
+  counter.forEach([&iterated](int col, int row, uint32_t count) { iterated[{ row, col }] += count; });
+  BOOST_CHECK(iterated == reference);
+
+  for (const auto& [pixel, count] : reference) {
+    BOOST_REQUIRE_EQUAL(counter.getCount(pixel.second, pixel.first), count);
+  }
+  // pixels which did not fire
+  for (int row = 0; row < PixelHitCounter::NRows; row += 37) {
+    for (int col = 0; col < PixelHitCounter::NCols; col += 41) {
+      if (reference.count({ row, col }) == 0) {
+        BOOST_REQUIRE_EQUAL(counter.getCount(col, row), 0);
+      }
+    }
+  }
+}
+
+std::vector<PixelHitCounter::PixelCount> getTopN(const Reference& reference, size_t n)
+{
+  std::vector<PixelHitCounter::PixelCount> pixels;
+  for (const auto& [pixel, count] : reference) {
+    pixels.push_back({ pixel.second, pixel.first, count });
+  }
+  // the reference is ordered by pixel, thus a stable sort keeps this order among the pixels with the same count
+  std::stable_sort(pixels.begin(), pixels.end(), [](const auto& a, const auto& b) { return a.count > b.count; });
+  pixels.resize(std::min(n, pixels.size()));
+  return pixels;
+}
+
+void checkTopN(const PixelHitCounter& counter, const Reference& reference, size_t n)
 {
-namespace itstaskraw
+  auto expected = getTopN(reference, n);
+  auto topN = counter.getTopN(n);
+  BOOST_REQUIRE_EQUAL(topN.size(), expected.size());
+  for (size_t i = 0; i < topN.size(); i++) {
+    BOOST_TEST_CONTEXT("pixel " << i)
+    {
+      BOOST_CHECK_EQUAL(topN[i].col, expected[i].col);
+      BOOST_CHECK_EQUAL(topN[i].row, expected[i].row);
+      BOOST_CHECK_EQUAL(topN[i].count, expected[i].count);
+    }
+  }
+}
+
+// fills the chip until it becomes dense, each pixel fired once in a scattered order
+void fillUntilDense(PixelHitCounter& counter, Reference& reference)
 {
+  for (uint32_t i = 0; !counter.isDense(); i++) {
+    BOOST_REQUIRE(i < PixelHitCounter::NPixels);
+    // 7 and the number of pixels are coprime, thus each pixel is visited once
+    uint32_t pixel = (i * 7u) % PixelHitCounter::NPixels;
+    add(counter, reference, pixel % PixelHitCounter::NCols, pixel / PixelHitCounter::NCols, i % 5 + 1);
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_pixel_hit_counter_rehash)
+{
+  PixelHitCounter counter;
+  Reference reference;
+  checkSame(counter, reference);
+
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> colDistribution(0, PixelHitCounter::NCols - 1);
+  std::uniform_int_distribution<int> rowDistribution(0, 63); // a region of the chip, so that some pixels fire several times
+  std::uniform_int_distribution<uint32_t> hitsDistribution(1, 3);
+  // the table starts with 64 slots and grows many times meanwhile
+  for (int i = 1; i <= 20000; i++) {
+    add(counter, reference, colDistribution(generator), rowDistribution(generator), hitsDistribution(generator));
+    if (i == 10 || i == 33 || i == 100 || i == 1000 || i == 20000) {
+      BOOST_TEST_CONTEXT("after " << i << " hits")
+      {
+        checkSame(counter, reference);
+      }
+    }
+  }
+  BOOST_CHECK(!counter.isDense());
+  BOOST_CHECK_LT(reference.size(), 20000);
+
+  counter.clear();
+  reference.clear();
+  checkSame(counter, reference);
+  add(counter, reference, 5, 6, 2);
+  checkSame(counter, reference);
+}
+
+BOOST_AUTO_TEST_CASE(test_pixel_hit_counter_dense)
+{
+  PixelHitCounter counter;
+  Reference reference;
+  fillUntilDense(counter, reference);
+
+  // the switch happens once the table would take a quarter of the pixels, with the load factor at 1/2
+  BOOST_CHECK_EQUAL(reference.size(), PixelHitCounter::NPixels / 8 + 1);
+  checkSame(counter, reference);
+
+  // fired and new pixels in the dense representation
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int> colDistribution(0, PixelHitCounter::NCols - 1);
+  std::uniform_int_distribution<int> rowDistribution(0, PixelHitCounter::NRows - 1);
+  for (int i = 0; i < 10000; i++) {
+    add(counter, reference, colDistribution(generator), rowDistribution(generator), 1);
+  }
+  BOOST_CHECK(counter.isDense());
+  checkSame(counter, reference);
+
+  // back to the sparse representation
+  counter.clear();
+  reference.clear();
+  BOOST_CHECK(!counter.isDense());
+  checkSame(counter, reference);
+  add(counter, reference, 1023, 511, 4);
+  checkSame(counter, reference);
+}
+
+BOOST_AUTO_TEST_CASE(test_pixel_hit_counter_remove_if)
+{
+  auto noisy = [](int col, int row, uint32_t count) { return count >= 3 || (col + row) % 10 == 0; };
+  auto removeFromReference = [&noisy](Reference& reference) {
+    std::erase_if(reference, [&noisy](const auto& item) { return noisy(item.first.second, item.first.first, item.second); });
+  };
+
+  // sparse
+  PixelHitCounter counter;
+  Reference reference;
+  std::mt19937 generator(3);
+  std::uniform_int_distribution<int> colDistribution(0, 99);
+  std::uniform_int_distribution<int> rowDistribution(0, 99);
+  for (int i = 0; i < 3000; i++) {
+    add(counter, reference, colDistribution(generator), rowDistribution(generator), 1);
+  }
+  counter.removeIf(noisy);
+  removeFromReference(reference);
+  BOOST_CHECK(!reference.empty());
+  checkSame(counter, reference);
+  // the kept pixels are still found when they fire again
+  for (int i = 0; i < 1000; i++) {
+    add(counter, reference, colDistribution(generator), rowDistribution(generator), 1);
+  }
+  checkSame(counter, reference);
+  // nothing to remove
+  counter.removeIf([](int, int, uint32_t) { return false; });
+  checkSame(counter, reference);
+
+  // dense
+  PixelHitCounter denseCounter;
+  Reference denseReference;
+  fillUntilDense(denseCounter, denseReference);
+  denseCounter.removeIf(noisy);
+  removeFromReference(denseReference);
+  BOOST_CHECK(denseCounter.isDense());
+  checkSame(denseCounter, denseReference);
+  add(denseCounter, denseReference, 0, 0, 1);
+  checkSame(denseCounter, denseReference);
+}
+
+BOOST_AUTO_TEST_CASE(test_pixel_hit_counter_top_n)
+{
+  PixelHitCounter counter;
+  Reference reference;
+  checkTopN(counter, reference, 5);
+
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<int> colDistribution(0, PixelHitCounter::NCols - 1);
+  std::uniform_int_distribution<int> rowDistribution(0, PixelHitCounter::NRows - 1);
+  // few different counts, thus many ties
+  std::uniform_int_distribution<uint32_t> hitsDistribution(1, 4);
+  for (int i = 0; i < 500; i++) {
+    add(counter, reference, colDistribution(generator), rowDistribution(generator), hitsDistribution(generator));
+  }
+  for (size_t n : { 0, 1, 10, 100, 10000 }) {
+    BOOST_TEST_CONTEXT("sparse, n = " << n)
+    {
+      checkTopN(counter, reference, n);
+    }
+  }
 
-BOOST_AUTO_TEST_CASE(instantiate_task) { BOOST_CHECK(true); }
+  fillUntilDense(counter, reference);
+  for (size_t n : { 1, 10, 100 }) {
+    BOOST_TEST_CONTEXT("dense, n = " << n)
+    {
+      checkTopN(counter, reference, n);
+    }
+  }
+}
 
-} // namespace itstaskraw
-} // namespace quality_control_modules
-} // namespace o2
+} // namespace o2::quality_control_modules::its
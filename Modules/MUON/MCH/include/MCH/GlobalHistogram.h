@@ -17,7 +17,10 @@
 #ifndef QC_MODULE_MUONCHAMBERS_GLOBALHISTOGRAM_H
 #define QC_MODULE_MUONCHAMBERS_GLOBALHISTOGRAM_H
 
+#include <array>
 #include <map>
+#include <memory>
+#include <vector>
 #include <TH2.h>
 
 namespace o2
@@ -37,6 +40,20 @@ class DetectorHistogram
   void Fill(double padX, double padY, double padSizeX, double padSizeY, double val = 1);
   void Set(double padX, double padY, double padSizeX, double padSizeY, double val);
 
+  // same as above, for a pad identified by its ID in the segmentation of the detection element.
+  // The bins covered by each pad are computed once per detection element and cathode, and the bin contents
+  // are then accessed directly.
+  void Fill(int padId, double val = 1);
+  void Set(int padId, double val);
+
+  // range of bins covered by a pad, in each direction
+  struct PadBins {
+    int16_t xMin{ 0 };
+    int16_t xMax{ -1 };
+    int16_t yMin{ 0 };
+    int16_t yMax{ -1 };
+  };
+
   int getNbinsX();
   int getNbinsY();
   float getXmin();
@@ -49,6 +66,10 @@ class DetectorHistogram
  private:
   void init();
   void addContour();
+  PadBins getPadBins(double padX, double padY, double padSizeX, double padSizeY);
+  const PadBins* findPadBins(int padId);
+  // adds a value to all the bins covered by a pad, the entries and the statistics are updated once per pad
+  void addToPadBins(const PadBins& bins, double val);
 
   int mDeId{ 0 };
   int mCathode{ 0 };
@@ -64,6 +85,9 @@ class DetectorHistogram
 
   float mHistWidth{ 0 };
   float mHistHeight{ 0 };
+
+  // bins covered by each pad of the detection element, indexed by pad ID, shared by the histograms of the same DE and cathode
+  std::shared_ptr<const std::vector<PadBins>> mPadBins;
 };
 
 class GlobalHistogram
@@ -95,11 +119,25 @@ class GlobalHistogram
   void getDeCenterST4(int de, float& xB0, float& yB0, float& xNB0, float& yNB0);
   void getDeCenterST5(int de, float& xB0, float& yB0, float& xNB0, float& yNB0);
 
+  // destination bin and the corresponding range of bins in the histogram of a detection element
+  struct BinMapping {
+    int dstBin;
+    int srcBinXmin;
+    int srcBinXmax;
+    int srcBinYmin;
+    int srcBinYmax;
+  };
+  // computes the mapping between the bins of this histogram and the ones of the DE histograms, only once per DE
+  const std::array<std::pair<size_t, size_t>, 2>& getBinMappings(int de, TH2F* hist[2]);
+
   TString mName;
   TString mTitle;
   int mId;
   float mScaleFactor;
   std::pair<TH2F*, bool> mHist;
+
+  std::vector<BinMapping> mBinMappings;
+  std::map<int, std::array<std::pair<size_t, size_t>, 2>> mDeBinMappings; // range in mBinMappings for the bending and non-bending cathodes of each DE
 };
 
 } // namespace muonchambers
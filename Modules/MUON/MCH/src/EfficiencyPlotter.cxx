@@ -125,16 +125,12 @@ void EfficiencyPlotter::fillGlobalHistograms(TH2F* h)
 
       double eff = h->GetBinContent(i, j);
 
-      double padX = segment.padPositionX(padId);
-      double padY = segment.padPositionY(padId);
-      float padSizeX = segment.padSizeX(padId);
-      float padSizeY = segment.padSizeY(padId);
       int cathode = segment.isBendingPad(padId) ? 0 : 1;
 
       // Fill 2D rate histograms
       auto hEfficiency = mHistogramEfficiencyDE[cathode].find(deId);
       if ((hEfficiency != mHistogramEfficiencyDE[cathode].end()) && (hEfficiency->second != NULL)) {
-        hEfficiency->second->Set(padX, padY, padSizeX, padSizeY, eff);
+        hEfficiency->second->Set(padId, eff);
       }
     }
   }
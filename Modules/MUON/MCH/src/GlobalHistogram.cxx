@@ -15,6 +15,7 @@
 ///
 
 #include <iostream>
+#include <mutex>
 #include <TLine.h>
 #include <TList.h>
 
@@ -313,12 +314,8 @@ void DetectorHistogram::addContour()
   }
 }
 
-void DetectorHistogram::Fill(double padX, double padY, double padSizeX, double padSizeY, double val)
+DetectorHistogram::PadBins DetectorHistogram::getPadBins(double padX, double padY, double padSizeX, double padSizeY)
 {
-  if (!mHist.first) {
-    return;
-  }
-
   padX += mShiftX;
   padY += mShiftY;
 
@@ -329,46 +326,141 @@ void DetectorHistogram::Fill(double padX, double padY, double padSizeX, double p
     padY *= -1.0;
   }
 
-  int binx_min = mHist.first->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
-  int binx_max = mHist.first->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
-  int biny_min = mHist.first->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
-  int biny_max = mHist.first->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
-  for (int by = biny_min; by <= biny_max; by++) {
-    float y = mHist.first->GetYaxis()->GetBinCenter(by);
-    for (int bx = binx_min; bx <= binx_max; bx++) {
-      float x = mHist.first->GetXaxis()->GetBinCenter(bx);
-      mHist.first->Fill(x, y, val);
+  PadBins bins;
+  bins.xMin = mHist.first->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
+  bins.xMax = mHist.first->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
+  bins.yMin = mHist.first->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
+  bins.yMax = mHist.first->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
+  return bins;
+}
+
+const DetectorHistogram::PadBins* DetectorHistogram::findPadBins(int padId)
+{
+  if (!mPadBins) {
+    // the binning only depends on the detection element, thus the table is shared by all the histograms of a given DE and cathode
+    static std::mutex cacheMutex;
+    static std::map<std::pair<int, int>, std::shared_ptr<const std::vector<PadBins>>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto& padBins = cache[{ mDeId, mCathode }];
+    if (!padBins) {
+      const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(mDeId);
+      auto table = std::make_shared<std::vector<PadBins>>(segment.nofPads());
+      for (int pad = 0; pad < segment.nofPads(); pad++) {
+        if (segment.isBendingPad(pad) != (mCathode == 0)) {
+          continue;
+        }
+        (*table)[pad] = getPadBins(segment.padPositionX(pad), segment.padPositionY(pad), segment.padSizeX(pad), segment.padSizeY(pad));
+      }
+      padBins = table;
     }
+    mPadBins = padBins;
+  }
+
+  if (padId < 0 || padId >= (int)mPadBins->size()) {
+    return nullptr;
   }
+  return &(*mPadBins)[padId];
 }
 
-void DetectorHistogram::Set(double padX, double padY, double padSizeX, double padSizeY, double val)
+void DetectorHistogram::Fill(double padX, double padY, double padSizeX, double padSizeY, double val)
 {
   if (!mHist.first) {
     return;
   }
 
-  padX += mShiftX;
-  padY += mShiftY;
+  addToPadBins(getPadBins(padX, padY, padSizeX, padSizeY), val);
+}
 
-  if (mFlipX) {
-    padX *= -1.0;
+void DetectorHistogram::Fill(int padId, double val)
+{
+  if (!mHist.first) {
+    return;
   }
-  if (mFlipY) {
-    padY *= -1.0;
+  auto bins = findPadBins(padId);
+  if (!bins) {
+    return;
+  }
+  addToPadBins(*bins, val);
+}
+
+void DetectorHistogram::addToPadBins(const PadBins& bins, double val)
+{
+  if (bins.xMin > bins.xMax || bins.yMin > bins.yMax) {
+    return;
   }
 
-  int binx_min = mHist.first->GetXaxis()->FindBin(padX - padSizeX / 2 + 0.1);
-  int binx_max = mHist.first->GetXaxis()->FindBin(padX + padSizeX / 2 - 0.1);
-  int biny_min = mHist.first->GetYaxis()->FindBin(padY - padSizeY / 2 + 0.1);
-  int biny_max = mHist.first->GetYaxis()->FindBin(padY + padSizeY / 2 - 0.1);
-  for (int by = biny_min; by <= biny_max; by++) {
-    for (int bx = binx_min; bx <= binx_max; bx++) {
+  // same result as TH2::Fill() at the center of each bin, without looking up the bins again
+  auto* hist = mHist.first;
+  double stats[TH1::kNstat] = { 0 };
+  hist->GetStats(stats);
+  TArrayD* sumw2 = hist->GetSumw2N() > 0 ? hist->GetSumw2() : nullptr;
+  const int nbinsX = hist->GetNbinsX();
+  const int nbinsY = hist->GetNbinsY();
+  for (int by = bins.yMin; by <= bins.yMax; by++) {
+    double y = hist->GetYaxis()->GetBinCenter(by);
+    for (int bx = bins.xMin; bx <= bins.xMax; bx++) {
+      int bin = hist->GetBin(bx, by);
+      hist->AddBinContent(bin, val);
+      if (sumw2) {
+        sumw2->fArray[bin] += val * val;
+      }
+      // the underflow and overflow bins do not enter the statistics
+      if (bx < 1 || bx > nbinsX || by < 1 || by > nbinsY) {
+        continue;
+      }
+      double x = hist->GetXaxis()->GetBinCenter(bx);
+      stats[0] += val;
+      stats[1] += val * val;
+      stats[2] += val * x;
+      stats[3] += val * x * x;
+      stats[4] += val * y;
+      stats[5] += val * y * y;
+      stats[6] += val * x * y;
+    }
+  }
+  hist->PutStats(stats);
+  hist->SetEntries(hist->GetEntries() + (bins.xMax - bins.xMin + 1) * (bins.yMax - bins.yMin + 1));
+}
+
+void DetectorHistogram::Set(double padX, double padY, double padSizeX, double padSizeY, double val)
+{
+  if (!mHist.first) {
+    return;
+  }
+
+  auto bins = getPadBins(padX, padY, padSizeX, padSizeY);
+  for (int by = bins.yMin; by <= bins.yMax; by++) {
+    for (int bx = bins.xMin; bx <= bins.xMax; bx++) {
       mHist.first->SetBinContent(bx, by, val);
     }
   }
 }
 
+void DetectorHistogram::Set(int padId, double val)
+{
+  if (!mHist.first) {
+    return;
+  }
+  auto bins = findPadBins(padId);
+  if (!bins || bins->xMin > bins->xMax) {
+    return;
+  }
+
+  auto* hist = mHist.first;
+  Float_t* contents = hist->GetArray();
+  const int nx = hist->GetNbinsX() + 2;
+  for (int by = bins->yMin; by <= bins->yMax; by++) {
+    for (int bx = bins->xMin; bx <= bins->xMax; bx++) {
+      contents[by * nx + bx] = val;
+    }
+  }
+  // the statistics are computed again from the bin contents when needed, like after TH1::SetBinContent
+  double stats[TH1::kNstat] = { 0 };
+  hist->PutStats(stats);
+  hist->SetEntries(hist->GetEntries() + (bins->xMax - bins->xMin + 1) * (bins->yMax - bins->yMin + 1));
+}
+
 static float getGlobalHistDeWidth(int id)
 {
   float result{ 0 };
@@ -460,6 +552,10 @@ void GlobalHistogram::init()
   mHist.first->GetYaxis()->Set(getGlobalHistHeight(mId) / mScaleFactor, 0, getGlobalHistHeight(mId));
   mHist.first->SetBinsLength();
 
+  // the binning might have changed
+  mBinMappings.clear();
+  mDeBinMappings.clear();
+
   switch (mId) {
     case 0:
       initST12();
@@ -890,11 +986,109 @@ void GlobalHistogram::set_includeNull(std::map<int, std::shared_ptr<DetectorHist
   set(histB, histNB, true, true);
 }
 
+const std::array<std::pair<size_t, size_t>, 2>& GlobalHistogram::getBinMappings(int de, TH2F* hist[2])
+{
+  auto found = mDeBinMappings.find(de);
+  if (found != mDeBinMappings.end()) {
+    return found->second;
+  }
+
+  float xB0, yB0, xNB0, yNB0;
+  getDeCenter(de, xB0, yB0, xNB0, yNB0);
+
+  float x0[2] = { xB0, xNB0 };
+  float y0[2] = { yB0, yNB0 };
+
+  const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
+  const o2::mch::mapping::CathodeSegmentation& csegmentB = segment.bending();
+  o2::mch::contour::BBox<double> bboxB = o2::mch::mapping::getBBox(csegmentB);
+
+  const o2::mch::mapping::CathodeSegmentation& csegmentNB = segment.nonBending();
+  o2::mch::contour::BBox<double> bboxNB = o2::mch::mapping::getBBox(csegmentNB);
+
+  float xMin[2] = { static_cast<float>(xB0 - bboxB.width() / 2), static_cast<float>(xNB0 - bboxNB.width() / 2) };
+  float xMax[2] = { static_cast<float>(xB0 + bboxB.width() / 2), static_cast<float>(xNB0 + bboxNB.width() / 2) };
+  float yMin[2] = { static_cast<float>(yB0 + bboxB.ymin()), static_cast<float>(yNB0 + bboxNB.ymin()) };
+  float yMax[2] = { static_cast<float>(yB0 + bboxB.ymax()), static_cast<float>(yNB0 + bboxNB.ymax()) };
+
+  if (mId == 0) {
+    bool flipX = getDetectorFlipX(de);
+    bool flipY = getDetectorFlipY(de);
+    float shiftX = getDetectorShiftX(de);
+    float shiftY = getDetectorShiftY(de);
+    xMin[0] = flipX ? xB0 - 1.0 * (bboxB.width() + shiftX) : xB0 + shiftX;
+    xMin[1] = flipX ? xNB0 - 1.0 * (bboxNB.width() + shiftX) : xNB0 + shiftX;
+    xMax[0] = flipX ? xB0 - shiftX : (xB0 + bboxB.width() + shiftX);
+    xMax[1] = flipX ? xNB0 - shiftX : (xNB0 + bboxNB.width() + shiftX);
+
+    yMin[0] = flipY ? yB0 - 1.0 * (bboxB.height() + shiftY) : yB0 + shiftY;
+    yMin[1] = flipY ? yNB0 - 1.0 * (bboxNB.height() + shiftY) : yNB0 + shiftY;
+    yMax[0] = flipY ? yB0 - shiftY : (yB0 + bboxB.height() + shiftY);
+    yMax[1] = flipY ? yNB0 - shiftY : (yNB0 + bboxNB.height() + shiftY);
+  }
+
+  float binWidthX = getHist()->GetXaxis()->GetBinWidth(1);
+  float binWidthY = getHist()->GetYaxis()->GetBinWidth(1);
+
+  std::array<std::pair<size_t, size_t>, 2> ranges;
+
+  // loop on bending and non-bending planes
+  for (int i = 0; i < 2; i++) {
+    ranges[i].first = mBinMappings.size();
+
+    // loop on destination bins
+    int binXmin = getHist()->GetXaxis()->FindBin(xMin[i] + binWidthX / 2);
+    int binXmax = getHist()->GetXaxis()->FindBin(xMax[i] - binWidthX / 2);
+    int binYmin = getHist()->GetYaxis()->FindBin(yMin[i] + binWidthY / 2);
+    int binYmax = getHist()->GetYaxis()->FindBin(yMax[i] - binWidthY / 2);
+
+    for (int by = binYmin; by <= binYmax; by++) {
+      // vertical boundaries of current bin, in DE coordinates
+      float minY = getHist()->GetYaxis()->GetBinLowEdge(by) - y0[i];
+      float maxY = getHist()->GetYaxis()->GetBinUpEdge(by) - y0[i];
+
+      // find Y bin range in source histogram
+      int srcBinYmin = hist[i]->GetYaxis()->FindBin(minY);
+      if (hist[i]->GetYaxis()->GetBinCenter(srcBinYmin) < minY) {
+        srcBinYmin += 1;
+      }
+      int srcBinYmax = hist[i]->GetYaxis()->FindBin(maxY);
+      if (hist[i]->GetYaxis()->GetBinCenter(srcBinYmax) > maxY) {
+        srcBinYmax -= 1;
+      }
+
+      for (int bx = binXmin; bx <= binXmax; bx++) {
+        // horizontal boundaries of current bin, in DE coordinates
+        float minX = getHist()->GetXaxis()->GetBinLowEdge(bx) - x0[i];
+        float maxX = getHist()->GetXaxis()->GetBinUpEdge(bx) - x0[i];
+
+        // find X bin range in source histogram
+        int srcBinXmin = hist[i]->GetXaxis()->FindBin(minX);
+        if (hist[i]->GetXaxis()->GetBinCenter(srcBinXmin) < minX) {
+          srcBinXmin += 1;
+        }
+        int srcBinXmax = hist[i]->GetXaxis()->FindBin(maxX);
+        if (hist[i]->GetXaxis()->GetBinCenter(srcBinXmax) > maxX) {
+          srcBinXmax -= 1;
+        }
+
+        mBinMappings.push_back({ getHist()->GetBin(bx, by), srcBinXmin, srcBinXmax, srcBinYmin, srcBinYmax });
+      }
+    }
+    ranges[i].second = mBinMappings.size();
+  }
+
+  return mDeBinMappings.emplace(de, ranges).first->second;
+}
+
 void GlobalHistogram::set(std::map<int, std::shared_ptr<DetectorHistogram>>& histB, std::map<int, std::shared_ptr<DetectorHistogram>>& histNB, bool doAverage, bool includeNullBins)
 {
   int deMin = (mId == 0) ? 100 : 500;
   int deMax = (mId == 0) ? 403 : 1100;
 
+  Float_t* dstContents = getHist()->GetArray();
+  Long64_t nSetBins = 0;
+
   for (auto& ih : histB) {
     int de = ih.first;
     if (de < deMin || de > deMax) {
@@ -922,111 +1116,46 @@ void GlobalHistogram::set(std::map<int, std::shared_ptr<DetectorHistogram>>& his
     }
 
     TH2F* hist[2] = { hB->getHist(), hNB->getHist() };
-
-    float xB0, yB0, xNB0, yNB0;
-    getDeCenter(de, xB0, yB0, xNB0, yNB0);
-
-    float x0[2] = { xB0, xNB0 };
-    float y0[2] = { yB0, yNB0 };
-
-    const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
-    const o2::mch::mapping::CathodeSegmentation& csegmentB = segment.bending();
-    o2::mch::contour::BBox<double> bboxB = o2::mch::mapping::getBBox(csegmentB);
-    o2::mch::contour::Contour<double> envelopB = o2::mch::mapping::getEnvelop(csegmentB);
-
-    const o2::mch::mapping::CathodeSegmentation& csegmentNB = segment.nonBending();
-    o2::mch::contour::BBox<double> bboxNB = o2::mch::mapping::getBBox(csegmentNB);
-    o2::mch::contour::Contour<double> envelopNB = o2::mch::mapping::getEnvelop(csegmentNB);
-
-    float xMin[2] = { static_cast<float>(xB0 - bboxB.width() / 2), static_cast<float>(xNB0 - bboxNB.width() / 2) };
-    float xMax[2] = { static_cast<float>(xB0 + bboxB.width() / 2), static_cast<float>(xNB0 + bboxNB.width() / 2) };
-    float yMin[2] = { static_cast<float>(yB0 + bboxB.ymin()), static_cast<float>(yNB0 + bboxNB.ymin()) };
-    float yMax[2] = { static_cast<float>(yB0 + bboxB.ymax()), static_cast<float>(yNB0 + bboxNB.ymax()) };
-
-    if (mId == 0) {
-      bool flipX = getDetectorFlipX(de);
-      bool flipY = getDetectorFlipY(de);
-      float shiftX = getDetectorShiftX(de);
-      float shiftY = getDetectorShiftY(de);
-      xMin[0] = flipX ? xB0 - 1.0 * (bboxB.width() + shiftX) : xB0 + shiftX;
-      xMin[1] = flipX ? xNB0 - 1.0 * (bboxNB.width() + shiftX) : xNB0 + shiftX;
-      xMax[0] = flipX ? xB0 - shiftX : (xB0 + bboxB.width() + shiftX);
-      xMax[1] = flipX ? xNB0 - shiftX : (xNB0 + bboxNB.width() + shiftX);
-
-      yMin[0] = flipY ? yB0 - 1.0 * (bboxB.height() + shiftY) : yB0 + shiftY;
-      yMin[1] = flipY ? yNB0 - 1.0 * (bboxNB.height() + shiftY) : yNB0 + shiftY;
-      yMax[0] = flipY ? yB0 - shiftY : (yB0 + bboxB.height() + shiftY);
-      yMax[1] = flipY ? yNB0 - shiftY : (yNB0 + bboxNB.height() + shiftY);
-    }
-
-    float binWidthX = getHist()->GetXaxis()->GetBinWidth(1);
-    float binWidthY = getHist()->GetYaxis()->GetBinWidth(1);
+    const auto& ranges = getBinMappings(de, hist);
 
     // loop on bending and non-bending planes
     for (int i = 0; i < 2; i++) {
-
-      if (hist[i] == nullptr) {
-        continue;
-      }
+      const Float_t* srcContents = hist[i]->GetArray();
+      const int srcNx = hist[i]->GetNbinsX() + 2;
 
       // loop on destination bins
-      int binXmin = getHist()->GetXaxis()->FindBin(xMin[i] + binWidthX / 2);
-      int binXmax = getHist()->GetXaxis()->FindBin(xMax[i] - binWidthX / 2);
-      int binYmin = getHist()->GetYaxis()->FindBin(yMin[i] + binWidthY / 2);
-      int binYmax = getHist()->GetYaxis()->FindBin(yMax[i] - binWidthY / 2);
-
-      for (int by = binYmin; by <= binYmax; by++) {
-        // vertical boundaries of current bin, in DE coordinates
-        float minY = getHist()->GetYaxis()->GetBinLowEdge(by) - y0[i];
-        float maxY = getHist()->GetYaxis()->GetBinUpEdge(by) - y0[i];
-
-        // find Y bin range in source histogram
-        int srcBinYmin = hist[i]->GetYaxis()->FindBin(minY);
-        if (hist[i]->GetYaxis()->GetBinCenter(srcBinYmin) < minY) {
-          srcBinYmin += 1;
-        }
-        int srcBinYmax = hist[i]->GetYaxis()->FindBin(maxY);
-        if (hist[i]->GetYaxis()->GetBinCenter(srcBinYmax) > maxY) {
-          srcBinYmax -= 1;
-        }
-
-        for (int bx = binXmin; bx <= binXmax; bx++) {
-          // horizontal boundaries of current bin, in DE coordinates
-          float minX = getHist()->GetXaxis()->GetBinLowEdge(bx) - x0[i];
-          float maxX = getHist()->GetXaxis()->GetBinUpEdge(bx) - x0[i];
-
-          // find X bin range in source histogram
-          int srcBinXmin = hist[i]->GetXaxis()->FindBin(minX);
-          if (hist[i]->GetXaxis()->GetBinCenter(srcBinXmin) < minX) {
-            srcBinXmin += 1;
-          }
-          int srcBinXmax = hist[i]->GetXaxis()->FindBin(maxX);
-          if (hist[i]->GetXaxis()->GetBinCenter(srcBinXmax) > maxX) {
-            srcBinXmax -= 1;
-          }
-
-          // loop on source bins, and compute the sum or average
-          int nBins = 0;
-          float tot = 0;
-          for (int sby = srcBinYmin; sby <= srcBinYmax; sby++) {
-            for (int sbx = srcBinXmin; sbx <= srcBinXmax; sbx++) {
-              float val = hist[i]->GetBinContent(sbx, sby);
-              if (val == 0 && !includeNullBins) {
-                continue;
-              }
-              nBins += 1;
-              tot += val;
+      for (size_t m = ranges[i].first; m < ranges[i].second; m++) {
+        const auto& mapping = mBinMappings[m];
+
+        // loop on source bins, and compute the sum or average
+        int nBins = 0;
+        float tot = 0;
+        for (int sby = mapping.srcBinYmin; sby <= mapping.srcBinYmax; sby++) {
+          for (int sbx = mapping.srcBinXmin; sbx <= mapping.srcBinXmax; sbx++) {
+            float val = srcContents[sby * srcNx + sbx];
+            if (val == 0 && !includeNullBins) {
+              continue;
             }
+            nBins += 1;
+            tot += val;
           }
+        }
 
-          if (doAverage && (nBins > 0)) {
-            tot /= nBins;
-          }
-          getHist()->SetBinContent(bx, by, tot);
+        if (doAverage && (nBins > 0)) {
+          tot /= nBins;
         }
+        dstContents[mapping.dstBin] = tot;
+        nSetBins += 1;
       }
     }
   }
+
+  if (nSetBins > 0) {
+    // same bookkeeping as TH1::SetBinContent, the statistics are computed again from the bin contents when needed
+    double stats[TH1::kNstat] = { 0 };
+    getHist()->PutStats(stats);
+    getHist()->SetEntries(getHist()->GetEntries() + nSetBins);
+  }
 }
 
 } // namespace muonchambers
@@ -98,16 +98,12 @@ void HeartBeatPacketsPlotter::update(TH2F* h)
         continue;
       }
 
-      double padX = segment.padPositionX(padId);
-      double padY = segment.padPositionY(padId);
-      float padSizeX = segment.padSizeX(padId);
-      float padSizeY = segment.padSizeY(padId);
       int cathode = segment.isBendingPad(padId) ? 0 : 1;
 
       // Fill 2D rate histograms
       auto hRate = mHistogramHBRateDE[cathode].find(deId);
       if ((hRate != mHistogramHBRateDE[cathode].end()) && (hRate->second != NULL)) {
-        hRate->second->Set(padX, padY, padSizeX, padSizeY, nHB);
+        hRate->second->Set(padId, nHB);
       }
     }
   }
@@ -257,24 +257,20 @@ void PedestalsTask::PlotPedestalDE(uint16_t solarID, uint8_t dsID, uint8_t chann
     return;
   }
 
-  double padX = segment.padPositionX(padId);
-  double padY = segment.padPositionY(padId);
-  double padSizeX = segment.padSizeX(padId);
-  double padSizeY = segment.padSizeY(padId);
   int cathode = segment.isBendingPad(padId) ? 0 : 1;
 
   // Fill the histograms for each detection element
   auto hStatXY = mHistogramStatXY[cathode].find(deId);
   if ((hStatXY != mHistogramStatXY[cathode].end()) && (hStatXY->second != NULL)) {
-    hStatXY->second->Set(padX, padY, padSizeX, padSizeY, stat);
+    hStatXY->second->Set(padId, stat);
   }
   auto hPedXY = mHistogramPedestalsXY[cathode].find(deId);
   if ((hPedXY != mHistogramPedestalsXY[cathode].end()) && (hPedXY->second != NULL)) {
-    hPedXY->second->Set(padX, padY, padSizeX, padSizeY, mean);
+    hPedXY->second->Set(padId, mean);
   }
   auto hNoiseXY = mHistogramNoiseXY[cathode].find(deId);
   if ((hNoiseXY != mHistogramNoiseXY[cathode].end()) && (hNoiseXY->second != NULL)) {
-    hNoiseXY->second->Set(padX, padY, padSizeX, padSizeY, rms);
+    hNoiseXY->second->Set(padId, rms);
   }
 }
 
@@ -315,16 +311,12 @@ void PedestalsTask::PlotBadChannelDE(uint16_t solarID, uint8_t dsID, uint8_t cha
     return;
   }
 
-  double padX = segment.padPositionX(padId);
-  double padY = segment.padPositionY(padId);
-  double padSizeX = segment.padSizeX(padId);
-  double padSizeY = segment.padSizeY(padId);
   int cathode = segment.isBendingPad(padId) ? 0 : 1;
 
   // Fill the histograms for each detection element
   auto hXY = mHistogramBadChannelsXY[cathode].find(deId);
   if ((hXY != mHistogramBadChannelsXY[cathode].end()) && (hXY->second != NULL)) {
-    hXY->second->Set(padX, padY, padSizeX, padSizeY, 0.000001);
+    hXY->second->Set(padId, 0.000001);
   }
 }
 
@@ -421,8 +413,6 @@ void PedestalsTask::processElecMaps()
 
       // update 2D maps in detector coordinates
       const o2::mch::mapping::Segmentation& segment = o2::mch::mapping::segmentation(de);
-      float padX = segment.padPositionX(padId);
-      float padY = segment.padPositionY(padId);
       float padSizeX = segment.padSizeX(padId);
       float padSizeY = segment.padSizeY(padId);
       int cathode = segment.isBendingPad(padId) ? 0 : 1;
@@ -430,22 +420,22 @@ void PedestalsTask::processElecMaps()
       // Fill the histograms for each detection element
       auto hXY = mHistogramBadChannelsXY[cathode].find(de);
       if ((hXY != mHistogramBadChannelsXY[cathode].end()) && (hXY->second != NULL)) {
-        hXY->second->Set(padX, padY, padSizeX, padSizeY, bad);
+        hXY->second->Set(padId, bad);
       }
 
       hXY = mHistogramStatXY[cathode].find(de);
       if ((hXY != mHistogramStatXY[cathode].end()) && (hXY->second != NULL)) {
-        hXY->second->Set(padX, padY, padSizeX, padSizeY, stat);
+        hXY->second->Set(padId, stat);
       }
 
       hXY = mHistogramPedestalsXY[cathode].find(de);
       if ((hXY != mHistogramPedestalsXY[cathode].end()) && (hXY->second != NULL)) {
-        hXY->second->Set(padX, padY, padSizeX, padSizeY, ped);
+        hXY->second->Set(padId, ped);
       }
 
       hXY = mHistogramNoiseXY[cathode].find(de);
       if ((hXY != mHistogramNoiseXY[cathode].end()) && (hXY->second != NULL)) {
-        hXY->second->Set(padX, padY, padSizeX, padSizeY, noise);
+        hXY->second->Set(padId, noise);
       }
 
       // fill 1D noise distributions
@@ -182,16 +182,12 @@ void RatesPlotter::fillGlobalHistos(TH2F* h)
       }
       mHistogramRatePerStation->Fill(rate, stationId);
 
-      double padX = segment.padPositionX(padId);
-      double padY = segment.padPositionY(padId);
-      float padSizeX = segment.padSizeX(padId);
-      float padSizeY = segment.padSizeY(padId);
       int cathode = segment.isBendingPad(padId) ? 0 : 1;
 
       // Fill 2D rate histograms
       auto hRate = mHistogramRateDE[cathode].find(deId);
       if ((hRate != mHistogramRateDE[cathode].end()) && (hRate->second != NULL)) {
-        hRate->second->Set(padX, padY, padSizeX, padSizeY, rate);
+        hRate->second->Set(padId, rate);
       }
     }
   }
@@ -82,8 +82,10 @@ void TrendingHits::trendValues(const Trigger& t, repository::DatabaseInterface&
             : t.activity.mValidity.getMax() / 1000; // ROOT expects seconds since epoch.
   mMetaData.runNumber = t.activity.mId;
 
-  for (auto& dataSource : mConfig.dataSources) {
-    if (!reductor_helpers::updateReductor(mReductors[dataSource.name].get(), t, dataSource, qcdb, *this)) {
+  auto updated = reductor_helpers::updateReductors(mReductors, t, mConfig.dataSources, qcdb, *this);
+  for (size_t i = 0; i < mConfig.dataSources.size(); i++) {
+    const auto& dataSource = mConfig.dataSources[i];
+    if (!updated[i]) {
       ILOG(Error, Support) << "Failed to update reductor for data sources with path '" << dataSource.path
                            << "', name '" << dataSource.name
                            << "', type '" << dataSource.type << "'." << ENDM;
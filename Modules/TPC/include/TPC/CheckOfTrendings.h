@@ -18,6 +18,7 @@
 #define QC_MODULE_TPC_CHECKOFTRENDINGS_H
 
 #include "QualityControl/CheckInterface.h"
+#include "Common/RollingStatistics.h"
 
 class TGraph;
 class TCanvas;
@@ -60,6 +61,14 @@ class CheckOfTrendings : public o2::quality_control::checker::CheckInterface
 
   std::vector<float> mStdev;
 
+  /// windows of the last points of a graph, kept from one check to the next one so that only the new points are processed
+  struct GraphWindows {
+    common::SlidingWindowStatistics mMeanCheck;
+    common::SlidingWindowStatistics mExpectedValueCheck;
+    common::SlidingWindowStatistics mRangeCheck;
+  };
+  std::vector<GraphWindows> mGraphWindows; //!
+
   int mPointToTakeForExpectedValueCheck;
   int mPointToTakeForMeanCheck;
   int mPointToTakeForRangeCheck;
@@ -79,7 +79,7 @@ void getTimestamp(const std::string& metaInfo, std::vector<long>& timeStamps);
 /// \param limit Most recent timestamp to be processed
 std::vector<long> getDataTimestamps(const o2::ccdb::CcdbApi& cdbApi, const std::string_view path, const unsigned int nFiles, const long limit);
 
-/// \brief Calculates mean and stddev from yValues of a TGraph. Overloaded function, actual calculation in retrieveStatistics
+/// \brief Calculates mean and stddev from yValues of a TGraph. Overloaded function, actual calculation in common::RollingStatistics
 /// \param yValues const double* pointer to yValues of TGraph (via TGraph->GetY())
 /// \param yErrors const double* pointer to y uncertainties of TGraph (via TGraph->GetEY())
 /// \param useErrors bool whether uncertainties should be used in calculation of mean and stddev of mean
@@ -100,7 +100,7 @@ void calculateStatistics(const double* yValues, const double* yErrors, bool useE
 /// \param maskPoints std::vector<int>&, points of the selected TGraph-points that should be masked
 void calculateStatistics(const double* yValues, const double* yErrors, bool useErrors, const int firstPoint, const int lastPoint, double& mean, double& stddevOfMean, std::vector<int>& maskPoints);
 
-/// \brief Calculates mean and stddev from yValues of a TGraph. Overloaded function, actual calculation in retrieveStatistics
+/// \brief Calculates mean and stddev from yValues of a TGraph. Overloaded function, actual calculation in common::RollingStatistics
 /// \param values std::vector<double>& vector that contains the data points
 /// \param errors std::vector<double>& vector that contains the data errors
 /// \param useErrors bool whether uncertainties should be used in calculation of mean and stddev of mean
@@ -41,6 +41,21 @@
 namespace o2::quality_control_modules::tpc
 {
 
+// mean and stddev of the mean of the points [firstPoint, lastPoint) of a graph,
+// moving the window of the previous check so that only the points which entered or left it are processed
+static void calculateWindowStatistics(common::SlidingWindowStatistics& window, const double* xValues, const double* yValues, const double* yErrors, bool useErrors, const int nPoints,
+                                      const int firstPoint, const int lastPoint, double& mean, double& stddevOfMean)
+{
+  if (lastPoint - firstPoint <= 0) {
+    ILOG(Error, Support) << "In calculateWindowStatistics(), the first and last point of the range have to differ!" << ENDM;
+    return;
+  }
+  window.setSeries(xValues, yValues, yErrors, nPoints, useErrors);
+  const auto& statistics = window.moveTo(firstPoint, lastPoint);
+  mean = statistics.getMean();
+  stddevOfMean = statistics.getStdDevOfMean();
+}
+
 void CheckOfTrendings::configure()
 {
   // Backwards compability for old choice
@@ -158,6 +173,10 @@ Quality CheckOfTrendings::check(std::map<std::string, std::shared_ptr<MonitorObj
     totalQuality.addMetadata(Quality::Null.getName(), "Multiple Graphs found even though this is not a slice trending");
     return totalQuality;
   }
+  if (mGraphWindows.size() != graphs.size()) {
+    mGraphWindows.clear();
+    mGraphWindows.resize(graphs.size());
+  }
 
   for (size_t iGraph = 0; iGraph < graphs.size(); iGraph++) {
     std::string padNullString = "";
@@ -181,6 +200,7 @@ Quality CheckOfTrendings::check(std::map<std::string, std::shared_ptr<MonitorObj
       continue;
     }
 
+    const double* xValues = graphs[iGraph]->GetX();
     const double* yValues = graphs[iGraph]->GetY();
     const double* yErrors = graphs[iGraph]->GetEY(); // returns nullptr for TGraph (no errors)
 
@@ -189,8 +209,7 @@ Quality CheckOfTrendings::check(std::map<std::string, std::shared_ptr<MonitorObj
       useErrors = false;
       ILOG(Info, Support) << "NO ERRORS" << ENDM;
     } else {
-      const std::vector<double> vErr(yErrors, yErrors + nBins);
-      if (std::find(vErr.begin(), vErr.end(), 0.0) != vErr.end()) {
+      if (std::find(yErrors, yErrors + nBins, 0.0) != yErrors + nBins) {
         useErrors = false;
         ILOG(Info, Support) << "Cannot take uncertainties of points into account for check of trending. At least one uncertainty is zero" << ENDM;
       }
@@ -214,7 +233,7 @@ Quality CheckOfTrendings::check(std::map<std::string, std::shared_ptr<MonitorObj
           pointNumberForMean = nBins - 1;
         }
 
-        calculateStatistics(yValues, yErrors, useErrors, nBins - 1 - pointNumberForMean, nBins - 1, mean, stddevOfMean);
+        calculateWindowStatistics(mGraphWindows[iGraph].mMeanCheck, xValues, yValues, yErrors, useErrors, nBins, nBins - 1 - pointNumberForMean, nBins - 1, mean, stddevOfMean);
 
         double lastPointError = 0.;
         if (useErrors) {
@@ -265,7 +284,7 @@ Quality CheckOfTrendings::check(std::map<std::string, std::shared_ptr<MonitorObj
         qualitiesOfPad.push_back(Quality::Null);
         padNullString += "ExpectedValueCheck: Only one data point without errors \n";
       } else {
-        calculateStatistics(yValues, yErrors, useErrors, nBins - pointNumber, nBins, mean, stddevOfMean);
+        calculateWindowStatistics(mGraphWindows[iGraph].mExpectedValueCheck, xValues, yValues, yErrors, useErrors, nBins, nBins - pointNumber, nBins, mean, stddevOfMean);
         mStdev.push_back(stddevOfMean);
 
         double nSigma = -1.;
@@ -299,7 +318,7 @@ Quality CheckOfTrendings::check(std::map<std::string, std::shared_ptr<MonitorObj
         pointNumber = nBins;
       }
 
-      calculateStatistics(yValues, yErrors, useErrors, nBins - pointNumber, nBins, mean, stddevOfMean);
+      calculateWindowStatistics(mGraphWindows[iGraph].mRangeCheck, xValues, yValues, yErrors, useErrors, nBins, nBins - pointNumber, nBins, mean, stddevOfMean);
 
       if (std::abs(mean - mExpectedPhysicsValue) > mRangeBad) {
         qualitiesOfPad.push_back(Quality::Bad);
@@ -526,20 +545,23 @@ void CheckOfTrendings::beautify(std::shared_ptr<MonitorObject> mo, Quality check
       TGraph* stddevGraphBadDown = new TGraph();
 
       const int nPoints = graphs[iGraph]->GetN();
+      const double* xValues = graphs[iGraph]->GetX();
       const double* yValues = graphs[iGraph]->GetY();
       const double* yErrors = graphs[iGraph]->GetEY(); // returns nullptr for TGraph (no errors)
       bool useErrors = true;
       if (yErrors == nullptr) {
         useErrors = false;
       } else {
-        const std::vector<double> vErr(yErrors, yErrors + nPoints);
-        if (std::find(vErr.begin(), vErr.end(), 0.0) != vErr.end()) {
+        if (std::find(yErrors, yErrors + nPoints, 0.0) != yErrors + nPoints) {
           useErrors = false;
           ILOG(Info, Support) << "Cannot take uncertainties of points into account for check of trending. At least one uncertainty is zero" << ENDM;
         }
       }
 
       if (nPoints > 2) {
+        // the window slides along the graph, each point enters and leaves it once
+        common::SlidingWindowStatistics window;
+        window.setSeries(xValues, yValues, yErrors, nPoints, useErrors);
         for (int nBins = 1; nBins < nPoints; nBins++) {
           int pointNumberForMean = mPointToTakeForMeanCheck;
           if ((nBins) < mPointToTakeForMeanCheck) {
@@ -548,7 +570,11 @@ void CheckOfTrendings::beautify(std::shared_ptr<MonitorObject> mo, Quality check
 
           double mean = 0.;
           double stdevMean = 0.;
-          calculateStatistics(yValues, yErrors, useErrors, nBins - pointNumberForMean, nBins, mean, stdevMean);
+          if (pointNumberForMean > 0) {
+            const auto& statistics = window.moveTo(nBins - pointNumberForMean, nBins);
+            mean = statistics.getMean();
+            stdevMean = statistics.getStdDevOfMean();
+          }
 
           double lastPointError = 0.;
           if (useErrors) {
@@ -26,6 +26,7 @@
 // QC includes
 #include "TPC/Utility.h"
 #include "QualityControl/QcInfoLogger.h"
+#include "Common/RollingStatistics.h"
 
 // external includes
 #include <Framework/Logger.h>
@@ -233,28 +234,8 @@ std::vector<long> getDataTimestamps(const o2::ccdb::CcdbApi& cdbApi, const std::
 
 void calculateStatistics(const double* yValues, const double* yErrors, bool useErrors, const int firstPoint, const int lastPoint, double& mean, double& stddevOfMean)
 {
-  // yErrors returns nullptr for TGraph (no errors)
-  if (lastPoint - firstPoint <= 0) {
-    ILOG(Error, Support) << "In calculateStatistics(), the first and last point of the range have to differ!" << ENDM;
-    return;
-  }
-
-  if (useErrors && !yErrors) {
-    ILOG(Error, Support) << "In calculateStatistics(): requested to use errors of data but TGraph does not contain errors." << ENDM;
-    useErrors = false;
-  }
-
-  std::vector<double> v(yValues + firstPoint, yValues + lastPoint);
-  std::vector<double> vErr;
-
-  if (useErrors) {
-    const std::vector<double> vErr_temp(yErrors + firstPoint, yErrors + lastPoint);
-    for (int i = 0; i < vErr_temp.size(); i++) {
-      vErr.push_back(vErr_temp[i]);
-    }
-  }
-
-  retrieveStatistics(v, vErr, useErrors, mean, stddevOfMean);
+  std::vector<int> noMaskedPoints;
+  calculateStatistics(yValues, yErrors, useErrors, firstPoint, lastPoint, mean, stddevOfMean, noMaskedPoints);
 }
 
 void calculateStatistics(const double* yValues, const double* yErrors, bool useErrors, const int firstPoint, const int lastPoint, double& mean, double& stddevOfMean, std::vector<int>& maskPoints)
@@ -270,25 +251,10 @@ void calculateStatistics(const double* yValues, const double* yErrors, bool useE
     useErrors = false;
   }
 
-  std::vector<double> v;
-  const std::vector<double> v_temp(yValues + firstPoint, yValues + lastPoint);
-  for (int i = 0; i < v_temp.size(); i++) {
-    if (std::find(maskPoints.begin(), maskPoints.end(), i) == maskPoints.end()) { // i is not in the masked points
-      v.push_back(v_temp[i]);
-    }
-  }
-
-  std::vector<double> vErr;
-  if (useErrors) {
-    const std::vector<double> vErr_temp(yErrors + firstPoint, yErrors + lastPoint);
-    for (int i = 0; i < vErr_temp.size(); i++) {
-      if (std::find(maskPoints.begin(), maskPoints.end(), i) == maskPoints.end()) { // i is not in the masked points
-        vErr.push_back(vErr_temp[i]);
-      }
-    }
-  }
-
-  retrieveStatistics(v, vErr, useErrors, mean, stddevOfMean);
+  common::RollingStatistics statistics(useErrors);
+  statistics.add(yValues, useErrors ? yErrors : nullptr, firstPoint, lastPoint, maskPoints);
+  mean = statistics.getMean();
+  stddevOfMean = statistics.getStdDevOfMean();
 }
 
 void retrieveStatistics(std::vector<double>& values, std::vector<double>& errors, bool useErrors, double& mean, double& stddevOfMean)
@@ -298,47 +264,10 @@ void retrieveStatistics(std::vector<double>& values, std::vector<double>& errors
     useErrors = false;
   }
 
-  double sum = 0.;
-  double sumSquare = 0.;
-  double sumOfWeights = 0.;        // sum w_i
-  double sumOfSquaredWeights = 0.; // sum (w_i)^2
-  double weight = 0.;
-
-  if (!useErrors) {
-    // In case of no errors, we set our weights equal to 1
-    sum = std::accumulate(values.begin(), values.end(), 0.0);
-    sumOfWeights = values.size();
-    sumOfSquaredWeights = values.size();
-  } else {
-    // In case of errors, we set our weights equal to 1/sigma_i^2
-    for (size_t i = 0; i < values.size(); i++) {
-      weight = 1. / std::pow(errors[i], 2.);
-      sum += values[i] * weight;
-      sumSquare += values[i] * values[i] * weight;
-      sumOfWeights += weight;
-      sumOfSquaredWeights += weight * weight;
-    }
-  }
-
-  mean = sum / sumOfWeights;
-
-  if (values.size() == 1) { // we only have one point, we keep it's uncertainty
-    if (!useErrors) {
-      stddevOfMean = 0.;
-    } else {
-      stddevOfMean = sqrt(1. / sumOfWeights);
-    }
-  } else { // for >= 2 points, we calculate the spread
-    if (!useErrors) {
-      std::vector<double> diff(values.size());
-      std::transform(values.begin(), values.end(), diff.begin(), [mean](double x) { return x - mean; });
-      double sq_sum = std::inner_product(diff.begin(), diff.end(), diff.begin(), 0.0);
-      stddevOfMean = std::sqrt(sq_sum / (values.size() * (values.size() - 1.)));
-    } else {
-      double ratioSumWeight = sumOfSquaredWeights / (sumOfWeights * sumOfWeights);
-      stddevOfMean = sqrt((sumSquare / sumOfWeights - mean * mean) * (1. / (1. - ratioSumWeight)) * ratioSumWeight);
-    }
-  }
+  common::RollingStatistics statistics(useErrors);
+  statistics.add(values.data(), useErrors ? errors.data() : nullptr, 0, values.size());
+  mean = statistics.getMean();
+  stddevOfMean = statistics.getStdDevOfMean();
 }
 
 void calcMeanAndStddev(const std::vector<float>& values, float& mean, float& stddev)